@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Command line runner for GraphBenchmark:
+//
+// graph_benchmark [options] graph.fb
+//   --warmup N              warmup iterations, default 10
+//   --iterations N          measured iterations, default 100
+//   --threads 1,2,4         thread counts to benchmark
+//   --batch 1,8,32          batch sizes to benchmark
+//   --shape name:1,28,28    placeholder shape override, can be repeated
+//   --output report.json    write JSON report to file instead of stdout
+//   --baseline base.json    compare against baseline report, exit code 3 on latency or throughput regression
+//   --tolerance 0.05        relative tolerance for baseline comparison
+//
+
+#include <performance/benchmarking/GraphBenchmark.h>
+#include <ops/declarable/CustomOperations.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+static std::vector<Nd4jLong> parseList(const std::string &str) {
+    std::vector<Nd4jLong> result;
+    std::stringstream stream(str);
+    std::string item;
+
+    while (std::getline(stream, item, ','))
+        if (!item.empty())
+            result.emplace_back(std::atoll(item.c_str()));
+
+    return result;
+}
+
+static void help(const char *app) {
+    std::cerr << "Usage: " << app << " [--warmup N] [--iterations N] [--threads 1,2,4] [--batch 1,8,32] [--shape name:d0,d1,...] "
+              << "[--output report.json] [--baseline baseline.json] [--tolerance 0.05] graph.fb" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    std::string graphFile;
+    std::string outputFile;
+    std::string baselineFile;
+    int warmup = 10;
+    int iterations = 100;
+    double tolerance = 0.05;
+    std::vector<int> threads;
+    std::vector<int> batchSizes;
+    std::vector<std::pair<std::string, std::vector<Nd4jLong>>> shapes;
+
+    for (int e = 1; e < argc; e++) {
+        std::string arg(argv[e]);
+        bool hasValue = e + 1 < argc;
+
+        if (arg == "-h" || arg == "--help") {
+            help(argv[0]);
+            return EXIT_SUCCESS;
+        } else if (arg == "--warmup" && hasValue) {
+            warmup = std::atoi(argv[++e]);
+        } else if (arg == "--iterations" && hasValue) {
+            iterations = std::atoi(argv[++e]);
+        } else if (arg == "--threads" && hasValue) {
+            for (auto v: parseList(argv[++e]))
+                threads.emplace_back(static_cast<int>(v));
+        } else if (arg == "--batch" && hasValue) {
+            for (auto v: parseList(argv[++e]))
+                batchSizes.emplace_back(static_cast<int>(v));
+        } else if (arg == "--shape" && hasValue) {
+            std::string value(argv[++e]);
+            auto split = value.rfind(':');
+            if (split == std::string::npos) {
+                std::cerr << "Wrong shape definition: " << value << std::endl;
+                return 1;
+            }
+
+            shapes.emplace_back(value.substr(0, split), parseList(value.substr(split + 1)));
+        } else if (arg == "--output" && hasValue) {
+            outputFile = argv[++e];
+        } else if (arg == "--baseline" && hasValue) {
+            baselineFile = argv[++e];
+        } else if (arg == "--tolerance" && hasValue) {
+            tolerance = std::atof(argv[++e]);
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            std::cerr << "Wrong parameter " << arg << std::endl;
+            help(argv[0]);
+            return 1;
+        } else {
+            graphFile = arg;
+        }
+    }
+
+    if (graphFile.empty()) {
+        help(argv[0]);
+        return 1;
+    }
+
+    try {
+        nd4j::GraphBenchmark benchmark(graphFile.c_str(), warmup, iterations);
+        benchmark.setThreads(threads);
+        benchmark.setBatchSizes(batchSizes);
+        for (auto &s: shapes)
+            benchmark.setInputShape(s.first, s.second);
+
+        auto results = benchmark.run();
+        auto json = nd4j::GraphBenchmark::asJson(graphFile, results);
+
+        if (outputFile.empty()) {
+            std::cout << json;
+        } else {
+            std::ofstream out(outputFile);
+            out << json;
+        }
+
+        if (!baselineFile.empty()) {
+            std::ifstream in(baselineFile);
+            if (!in.good()) {
+                std::cerr << "Unable to read baseline file " << baselineFile << std::endl;
+                return 2;
+            }
+
+            std::stringstream buffer;
+            buffer << in.rdbuf();
+
+            auto comparison = nd4j::GraphBenchmark::compare(nd4j::GraphBenchmark::fromJson(buffer.str()), results, tolerance);
+            for (auto &r: comparison._added)
+                std::cerr << "ADDED " << r << std::endl;
+
+            for (auto &r: comparison._missing)
+                std::cerr << "MISSING " << r << std::endl;
+
+            for (auto &r: comparison._regressions)
+                std::cerr << "REGRESSION " << r << std::endl;
+
+            // added or renamed configurations aren't regressions
+            if (!comparison._regressions.empty())
+                return 3;
+        }
+    } catch (std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -22,6 +22,7 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include "Environment.h"
 #include <helpers/StringUtils.h>
 
@@ -43,12 +44,15 @@ namespace nd4j {
     nd4j::Environment::Environment() {
         _tadThreshold.store(8);
         _elementThreshold.store(1024);
+        _sparseThreshold.store(0.0);
         _verbose.store(false);
         _debug.store(false);
         _profile.store(false);
+        _tracing.store(false);
         _precBoost.store(false);
         _leaks.store(false);
         _dataType.store(nd4j::DataType::FLOAT32);
+        _maxThreads.store(std::thread::hardware_concurrency() > 0 ? (int) std::thread::hardware_concurrency() : 1);
 
 #ifndef ANDROID
         const char* omp_threads = std::getenv("OMP_NUM_THREADS");
@@ -155,6 +159,14 @@ namespace nd4j {
         _profile.store(reallyProfile);
     }
 
+    bool Environment::isTracing() {
+        return _tracing.load();
+    }
+
+    void Environment::setTracing(bool reallyTrace) {
+        _tracing.store(reallyTrace);
+    }
+
     bool Environment::isDebugAndVerbose() {
         return this->isDebug() && this->isVerbose();
     }
@@ -179,6 +191,14 @@ namespace nd4j {
         _elementThreshold = threshold;
     }
 
+    double Environment::sparseThreshold() {
+        return _sparseThreshold.load();
+    }
+
+    void Environment::setSparseThreshold(double threshold) {
+        _sparseThreshold.store(threshold);
+    }
+
     int Environment::maxThreads() {
         return _maxThreads.load();
     }
@@ -33,10 +33,12 @@ namespace nd4j{
     private:
         std::atomic<int> _tadThreshold;
         std::atomic<int> _elementThreshold;
+        std::atomic<double> _sparseThreshold;
         std::atomic<bool> _verbose;
         std::atomic<bool> _debug;
         std::atomic<bool> _leaks;
         std::atomic<bool> _profile;
+        std::atomic<bool> _tracing;
         std::atomic<int> _maxThreads;
         std::atomic<nd4j::DataType> _dataType;
         std::atomic<bool> _precBoost;
@@ -73,6 +75,12 @@ namespace nd4j{
         bool isDebugAndVerbose();
         void setDebug(bool reallyDebug);
         void setProfiling(bool reallyProfile);
+
+        /**
+         * Tracing records node/op spans to TraceRecorder, for timeline export
+         */
+        bool isTracing();
+        void setTracing(bool reallyTrace);
         void setLeaksDetector(bool reallyDetect);
         
         int tadThreshold();
@@ -81,6 +89,13 @@ namespace nd4j{
         int elementwiseThreshold();
         void setElementwiseThreshold(int threshold);
 
+        /**
+         * Dense matrix with fraction of non-zero elements at or below this threshold is multiplied as sparse one
+         * by matmul/xw_plus_b. Sparse detection scans x before every multiplication, so it's opt-in: 0 (default) disables sparse path
+         */
+        double sparseThreshold();
+        void setSparseThreshold(double threshold);
+
         int maxThreads();
         void setMaxThreads(int max);
 
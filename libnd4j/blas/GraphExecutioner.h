@@ -69,7 +69,15 @@ namespace nd4j {
         static Graph *importFromTensorFlow(const char *fileName);
 
 
-        static Graph *importFromFlatBuffers(const char *filename);
+        /**
+         * This method reads given FlatBuffers file, and returns Graph instance
+         *
+         * @param filename
+         * @param zeroCopy if TRUE, file is memory-mapped and aligned native-order arrays reference it directly, instead of being copied.
+         *                 Pages are loaded on first access, and mapping is released together with Graph
+         * @return
+         */
+        static Graph *importFromFlatBuffers(const char *filename, bool zeroCopy = false);
 
         static Graph *importFromFlatPointer(Nd4jPointer ptr);
     };
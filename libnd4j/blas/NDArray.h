@@ -255,6 +255,12 @@ namespace nd4j {
          */
         void setAttached(bool reallyAttached);
 
+        /**
+         * This method allows to set _isView flag, for arrays sharing buffer with other array
+         * @param reallyView
+         */
+        void setView(bool reallyView);
+
         void tickWriteHost() const;
         void tickWriteDevice() const;
         void tickReadHost() const;
@@ -772,6 +778,25 @@ namespace nd4j {
 
         template <typename T>
         void applyTriplewiseLambda(NDArray* second, NDArray *third, const std::function<T(T, T, T)>& func, NDArray* target = nullptr);
+
+        /**
+        *  same as above, but func is a template parameter, so it's inlined into the loop and can be vectorized.
+        *  These overloads are picked for lambdas passed directly, std::function arguments still go to the methods above
+        */
+        template <typename T, typename Lambda>
+        void applyLambda(Lambda func, NDArray* target = nullptr);
+
+        template <typename T, typename Lambda>
+        void applyPairwiseLambda(const NDArray* other, Lambda func, NDArray* target = nullptr);
+
+        template <typename T, typename Lambda>
+        void applyIndexedLambda(Lambda func, NDArray* target = nullptr);
+
+        template <typename T, typename Lambda>
+        void applyIndexedPairwiseLambda(NDArray* other, Lambda func, NDArray* target = nullptr);
+
+        template <typename T, typename Lambda>
+        void applyTriplewiseLambda(NDArray* second, NDArray *third, Lambda func, NDArray* target = nullptr);
 #endif
 
         /**
@@ -2207,4 +2232,8 @@ Nd4jLong* NDArray::getSpecialShapeInfo() const{
 
 }
 
+#if !defined(__CUDABLAS__)
+#include "cpu/NDArrayInlineLambda.hpp"
+#endif
+
 #endif
@@ -1344,6 +1344,11 @@ void NDArray::setAttached(bool reallyAttached) {
     _isAttached = reallyAttached;
 };
 
+//////////////////////////////////////////////////////////////////////////
+void NDArray::setView(bool reallyView) {
+    _isView = reallyView;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // calculate strides
 void NDArray::updateStrides(const char order) {
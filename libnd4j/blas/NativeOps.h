@@ -856,6 +856,33 @@ ND4J_EXPORT void enableDebugMode(bool reallyEnable);
  */
 ND4J_EXPORT void enableVerboseMode(bool reallyEnable);
 
+/**
+ * This method enables or disables recording of node/op spans
+ *
+ * @param reallyEnable
+ */
+ND4J_EXPORT void enableTracing(bool reallyEnable);
+
+/**
+ * This method writes spans recorded so far as Chrome Trace Event JSON, and drops them
+ *
+ * @param fileName
+ * @return 0 on success, error code otherwise
+ */
+ND4J_EXPORT int dumpTrace(const char *fileName);
+
+/**
+ * This method sets max number of host pool workers running at the same time, shared by all callers
+ *
+ * @param budget
+ */
+ND4J_EXPORT void setConcurrencyBudget(int budget);
+
+/**
+ * This method returns current host pool concurrency budget
+ */
+ND4J_EXPORT int getConcurrencyBudget();
+
 /**
  *
  * @param gridSize
@@ -31,6 +31,7 @@
 #include <Scope.h>
 #include <GraphExecutioner.h>
 #include <graph/TimeHolder.h>
+#include <graph/MappedFile.h>
 #include <loops/scalar.h>
 #include <loops/pairwise_transform.h>
 #include <loops/transform_same.h>
@@ -55,6 +56,8 @@
 #include <exceptions/graph_execution_exception.h>
 #include <exceptions/no_results_exception.h>
 #include <graph/FlatUtils.h>
+#include <graph/optimization/GraphOptimizer.h>
+#include <graph/profiling/TraceRecorder.h>
 
 namespace nd4j{
 namespace graph {
@@ -180,6 +183,8 @@ namespace graph {
 
     } else if (node->hasCustomOp()) {
         // if we have something to execute - lets just execute it.
+        // outputs of view-capable ops might alias their inputs, Graph never marks consumers of such outputs inplace
+        context.allowViewOutputs(true);
         auto status = node->getCustomOp()->execute(&context);
         if (status != ND4J_STATUS_OK)
             return status;
@@ -218,6 +223,18 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     Nd4jLong tb0 = Environment::getInstance()->isProfiling() ? GraphProfile::currentTime() : 0L;
     graph->buildGraph();
 
+    // rewrites are applied once per graph, before its first execution
+    if (!graph->optimized()) {
+        GraphOptimizer optimizer;
+        optimizer.optimize(graph, __variableSpace);
+
+        if (Environment::getInstance()->isDebugAndVerbose())
+            optimizer.printOut();
+    }
+
+    // executions within other VariableSpaces (proxies, clones) need results of folded nodes as well
+    graph->injectFoldedConstants(__variableSpace);
+
     auto footprintForward = nd4j::memory::MemoryRegistrator::getInstance()->getGraphMemoryFootprint(graph->hashCode());
     if (footprintForward > 0) {
         if (__variableSpace->launchContext()->getWorkspace() != nullptr) {
@@ -435,12 +452,16 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
 
                 auto timeStart = std::chrono::system_clock::now();
+                Nd4jLong traceStart = Environment::getInstance()->isTracing() ? TraceRecorder::currentTime() : 0L;
 
                 // actual node execution happens right here
                 Nd4jStatus status = executeFlatNode(graph, node, __variableSpace);
 
                 auto timeEnd = std::chrono::system_clock::now();
 
+                if (Environment::getInstance()->isTracing())
+                    TraceRecorder::getInstance()->recordSpan("node", node->name() != nullptr ? node->name()->c_str() : "", node->id(), traceStart, TraceRecorder::currentTime());
+
                 auto outerTime = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
 
 
@@ -887,7 +908,17 @@ flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuff
         *
         *   PLEASE NOTE: This method is mostly suited for tests and debugging/profiling
         */
-        Graph* GraphExecutioner::importFromFlatBuffers(const char *filename) {
+        Graph* GraphExecutioner::importFromFlatBuffers(const char *filename, bool zeroCopy) {
+            if (zeroCopy) {
+                auto file = new MappedFile(filename);
+                try {
+                    return new Graph(GetFlatGraph(file->data()), nullptr, file);
+                } catch (...) {
+                    delete file;
+                    throw;
+                }
+            }
+
             auto data = readFlatBuffers(filename);
             auto restoredGraph = importFromFlatPointer(reinterpret_cast<Nd4jPointer>(data));
             delete[] data;
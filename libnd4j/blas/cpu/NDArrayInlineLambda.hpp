@@ -0,0 +1,238 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Lambda overloads of NDArray::apply*Lambda. Unlike std::function versions, func is a template parameter here,
+// so it gets inlined into the loop and the loop can be vectorized
+//
+
+#ifndef LIBND4J_NDARRAY_INLINE_LAMBDA_HPP
+#define LIBND4J_NDARRAY_INLINE_LAMBDA_HPP
+
+#include <array/DataTypeUtils.h>
+#include <openmp_pragmas.h>
+#include <stdexcept>
+
+namespace nd4j {
+
+//////////////////////////////////////////////////////////////////////////
+template<typename T, typename Lambda>
+void NDArray::applyLambda(Lambda func, NDArray* target) {
+    if (target == nullptr)
+        target = this;
+
+    if(dataType() != DataTypeUtils::fromT<T>())
+        throw std::runtime_error("NDArray::applyLambda<T> method: wrong template parameter T, its type should be the same as type of this array!");
+    if(dataType() != target->dataType())
+        throw std::runtime_error("NDArray::applyLambda<T> method: types of this and target array should match !");
+
+    auto f = this->bufferAsT<T>();
+    auto z = target->bufferAsT<T>();
+    const Nd4jLong len = _length;
+
+    if (this->ordering() == target->ordering() && (this->ews() == 1 && target->ews() == 1)) {
+
+        PRAGMA_OMP_PARALLEL_FOR_SIMD
+        for (Nd4jLong e = 0; e < len; e++)
+            z[e] = func(f[e]);
+    } else {
+
+        PRAGMA_OMP_PARALLEL_FOR_SIMD
+        for (Nd4jLong e = 0; e < len; e++) {
+
+            auto xOffset = this->getOffset(e);
+            auto zOffset = f == z ? xOffset : target->getOffset(e);
+
+            z[zOffset] = func(f[xOffset]);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template<typename T, typename Lambda>
+void NDArray::applyPairwiseLambda(const NDArray* other, Lambda func, NDArray* target) {
+    if (target == nullptr)
+        target = this;
+
+    if (other == nullptr) {
+        nd4j_printf("applyPairwiseLambda requires both operands to be valid NDArrays, but Y is NULL\n","");
+        throw std::runtime_error("Other is null");
+    }
+
+    if(dataType() != DataTypeUtils::fromT<T>())
+        throw std::runtime_error("NDArray::applyPairwiseLambda<T> method: wrong template parameter T, its type should be the same as type of this array!");
+    if(dataType() != other->dataType() || dataType() != target->dataType())
+        throw std::runtime_error("NDArray::applyPairwiseLambda<T> method: all three arrays (this, other, target) must have the same type !");
+
+    if (this->lengthOf() != other->lengthOf()) {
+        nd4j_printf("applyPairwiseLambda requires both operands to have the same shape\n","");
+        throw std::runtime_error("Shapes mismach");
+    }
+
+    auto f = this->bufferAsT<T>();
+    auto s = other->bufferAsT<T>();
+    auto z = target->bufferAsT<T>();
+    const Nd4jLong len = _length;
+
+    if (this->ordering() == other->ordering() && this->ordering() == target->ordering() && (this->ews() == 1 && target->ews() == 1) && this->ews() == other->ews()) {
+
+        PRAGMA_OMP_PARALLEL_FOR_SIMD
+        for (Nd4jLong e = 0; e < len; e++)
+            z[e] = func(f[e], s[e]);
+    } else {
+
+        PRAGMA_OMP_PARALLEL_FOR_SIMD
+        for (Nd4jLong e = 0; e < len; e++) {
+
+            auto xOffset = this->getOffset(e);
+            auto yOffset = other->getOffset(e);
+            auto zOffset = f == z ? xOffset : target->getOffset(e);
+
+            z[zOffset] = func(f[xOffset], s[yOffset]);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template<typename T, typename Lambda>
+void NDArray::applyIndexedLambda(Lambda func, NDArray* target) {
+    if (target == nullptr)
+        target = this;
+
+    if(dataType() != DataTypeUtils::fromT<T>())
+        throw std::runtime_error("NDArray::applyIndexedLambda<T> method: wrong template parameter T, its type should be the same as type of this array!");
+    if(dataType() != target->dataType())
+        throw std::runtime_error("NDArray::applyIndexedLambda<T> method: types of this and target array should match !");
+
+    auto f = this->bufferAsT<T>();
+    auto z = target->bufferAsT<T>();
+    const Nd4jLong len = _length;
+
+    if (this->ordering() == target->ordering() && (this->ews() == 1 && target->ews() == 1)) {
+
+        PRAGMA_OMP_PARALLEL_FOR_SIMD
+        for (Nd4jLong e = 0; e < len; e++)
+            z[e] = func(e, f[e]);
+    } else {
+
+        PRAGMA_OMP_PARALLEL_FOR_SIMD
+        for (Nd4jLong e = 0; e < len; e++) {
+
+            auto xOffset = this->getOffset(e);
+            auto zOffset = f == z ? xOffset : target->getOffset(e);
+
+            z[zOffset] = func(e, f[xOffset]);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template<typename T, typename Lambda>
+void NDArray::applyIndexedPairwiseLambda(NDArray* other, Lambda func, NDArray* target) {
+    if (target == nullptr)
+        target = this;
+
+    if (other == nullptr) {
+        nd4j_printf("applyIndexedPairwiseLambda requires both operands to be valid NDArrays, but Y is NULL\n","");
+        throw std::runtime_error("Other is null");
+    }
+    if(dataType() != DataTypeUtils::fromT<T>())
+        throw std::runtime_error("NDArray::applyIndexedPairwiseLambda<T> method: wrong template parameter T, its type should be the same as type of this array!");
+    if(dataType() != target->dataType())
+        throw std::runtime_error("NDArray::applyIndexedPairwiseLambda<T> method: types of this and target array should match !");
+    if (this->lengthOf() != other->lengthOf()) {
+        nd4j_printf("applyIndexedPairwiseLambda requires both operands to have the same shape\n","");
+        throw std::runtime_error("Shapes mismach");
+    }
+
+    auto f = this->bufferAsT<T>();
+    auto s = other->bufferAsT<T>();
+    auto z = target->bufferAsT<T>();
+    const Nd4jLong len = _length;
+
+    if (this->ordering() == other->ordering() && this->ordering() == target->ordering() && (this->ews() == 1 && target->ews() == 1) && this->ews() == other->ews()) {
+
+        PRAGMA_OMP_PARALLEL_FOR_SIMD
+        for (Nd4jLong e = 0; e < len; e++)
+            z[e] = func(e, f[e], s[e]);
+    } else {
+
+        PRAGMA_OMP_PARALLEL_FOR_SIMD
+        for (Nd4jLong e = 0; e < len; e++) {
+
+            auto xOffset = this->getOffset(e);
+            auto yOffset = other->getOffset(e);
+            auto zOffset = f == z ? xOffset : target->getOffset(e);
+
+            z[zOffset] = func(e, f[xOffset], s[yOffset]);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template<typename T, typename Lambda>
+void NDArray::applyTriplewiseLambda(NDArray* second, NDArray *third, Lambda func, NDArray* target) {
+    if (target == nullptr)
+        target = this;
+
+    if (second == nullptr) {
+        nd4j_printf("applyTriplewiseLambda requires three operands to be valid NDArrays, but Second is NULL\n","");
+        throw std::runtime_error("second is null");
+    }
+
+    if (third == nullptr) {
+        nd4j_printf("applyTriplewiseLambda requires three operands to be valid NDArrays, but Third is NULL\n","");
+        throw std::runtime_error("third is null");
+    }
+    if(dataType() != DataTypeUtils::fromT<T>())
+        throw std::runtime_error("NDArray::applyTriplewiseLambda<T> method: wrong template parameter T, its type should be the same as type of this array!");
+    if(dataType() != second->dataType() || dataType() != third->dataType() || dataType() != target->dataType())
+        throw std::runtime_error("NDArray::applyTriplewiseLambda<T> method: bother four arrays (this, second, third, target) should have the same type !");
+
+    if (this->lengthOf() != second->lengthOf() || this->lengthOf() != third->lengthOf() || !this->isSameShape(second) || !this->isSameShape(third)) {
+        nd4j_printf("applyTriplewiseLambda requires all operands to have the same shape\n","");
+        throw std::runtime_error("Shapes mismach");
+    }
+
+    auto f = this->bufferAsT<T>();
+    auto s = second->bufferAsT<T>();
+    auto t = third->bufferAsT<T>();
+    auto z = target->bufferAsT<T>();
+    const Nd4jLong len = _length;
+
+    if (this->ordering() == second->ordering() && this->ordering() == third->ordering()  && this->ordering() == target->ordering() && (this->ews() == 1 && target->ews() == 1) && this->ews() == second->ews() && this->ews() == third->ews()) {
+
+        PRAGMA_OMP_PARALLEL_FOR_SIMD
+        for (Nd4jLong e = 0; e < len; e++)
+            z[e] = func(f[e], s[e], t[e]);
+    } else {
+
+        PRAGMA_OMP_PARALLEL_FOR_SIMD
+        for (Nd4jLong e = 0; e < len; e++) {
+
+            auto tOffset = this->getOffset(e);
+            auto uOffset = second->getOffset(e);
+            auto vOffset = third->getOffset(e);
+            auto zOffset = f == z ? tOffset : target->getOffset(e);
+
+            z[zOffset] = func(f[tOffset], s[uOffset], t[vOffset]);
+        }
+    }
+}
+
+}
+
+#endif //LIBND4J_NDARRAY_INLINE_LAMBDA_HPP
@@ -50,6 +50,8 @@
 #include <loops/random.h>
 #include <pointercast.h>
 #include <exceptions/datatype_exception.h>
+#include <helpers/TransposeHelper.h>
+#include <op_enums.h>
 
 
 #ifdef _OPENMP
@@ -1047,6 +1049,10 @@ void NativeOpExecutioner::execTransformAny(nd4j::LaunchContext  *lc,
     auto xType = nd4j::ArrayOptions::dataType(hXShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(hZShapeInfo);
 
+    // plain copy between different layouts, i.e. permute/transpose, goes to tiled kernel
+    if (opNum == nd4j::transform::AnyOps::Assign && xType == zType && nd4j::TransposeHelper::copy(hX, hXShapeInfo, hZ, hZShapeInfo, allowParallelism))
+        return;
+
     BUILD_DOUBLE_SELECTOR(xType, zType, functions::transform::TransformAny, ::exec(opNum, hX, hXShapeInfo, hZ, hZShapeInfo, extraParams, tadShapeInfo, tadOffsets, allowParallelism), LIBND4J_TYPES, LIBND4J_TYPES);
 }
 
@@ -51,6 +51,8 @@ using namespace nd4j;
 #include <loops/special_kernels.h>
 #include <performance/benchmarking/FullBenchmarkSuit.h>
 #include <performance/benchmarking/LightBenchmarkSuit.h>
+#include <graph/profiling/TraceRecorder.h>
+#include <execution/Executor.h>
 
 cudaDeviceProp *deviceProperties;
 cudaFuncAttributes *funcAttributes = new cudaFuncAttributes[64];
@@ -1234,6 +1236,29 @@ void enableVerboseMode(bool reallyEnable) {
 	nd4j::Environment::getInstance()->setVerbose(reallyEnable);
 }
 
+void enableTracing(bool reallyEnable) {
+	nd4j::Environment::getInstance()->setTracing(reallyEnable);
+}
+
+int dumpTrace(const char *fileName) {
+	auto status = nd4j::graph::TraceRecorder::getInstance()->writeChromeTrace(fileName);
+	nd4j::graph::TraceRecorder::getInstance()->reset();
+	return status;
+}
+
+void setConcurrencyBudget(int budget) {
+	try {
+		nd4j::Executor::setConcurrencyBudget(budget);
+	} catch (std::exception &e) {
+		nd4j::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+		nd4j::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+	}
+}
+
+int getConcurrencyBudget() {
+	return nd4j::Executor::concurrencyBudget();
+}
+
 int getDeviceMajor(int device) {
 	return deviceProperties[device].major;
 }
@@ -61,8 +61,30 @@ namespace nd4j {
 
         // maximum number of elements
         int _height = 0;
+
+        // contiguous mode: all elements are views of single growable buffer [capacity, elementShape]
+        bool _contiguous = false;
+        NDArray* _storage = nullptr;
+        std::vector<Nd4jLong> _elementShape;
+        Nd4jLong _elementLength = 0;
+        Nd4jLong _capacity = 0;
+
+        // true if storage is shared with array returned by stack(), so it must be copied before next write
+        bool _stacked = false;
+
+        NDArray* elementView(int idx);
+        void reallocate(Nd4jLong capacity);
+        void detach();
+        bool storeContiguous(int idx, NDArray* array);
+        Nd4jStatus validate(NDArray* array);
     public:
-        NDArrayList(int height, bool expandable = false);
+        /**
+         * @param height - expected number of elements
+         * @param expandable - whether list may grow beyond height
+         * @param contiguous - if true, elements are stored in single buffer once element shape is known (i.e. after first write).
+         *                     stack() is zero-copy then, and list falls back to separate arrays if element of other shape is written
+         */
+        NDArrayList(int height, bool expandable = false, bool contiguous = false);
         ~NDArrayList();
 
         nd4j::DataType dataType();
@@ -71,6 +93,14 @@ namespace nd4j {
         NDArray* readRaw(int idx);
         Nd4jStatus write(int idx, NDArray* array);
 
+        /**
+         * This method copies given array into list. Unlike write(), array ownership stays with caller,
+         * so no intermediate copy is needed in contiguous mode
+         */
+        Nd4jStatus writeCopy(int idx, NDArray* array);
+
+        bool isContiguous();
+
         NDArray* pick(std::initializer_list<int> indices);
         NDArray* pick(std::vector<int>& indices);
         bool isWritten(int index);
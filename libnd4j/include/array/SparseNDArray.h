@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Sparse array in CSR or COO format, with conversions to and from dense NDArray
+//
+
+#ifndef LIBND4J_SPARSENDARRAY_H
+#define LIBND4J_SPARSENDARRAY_H
+
+#include <NDArray.h>
+#include <array/SparseType.h>
+#include <vector>
+
+namespace nd4j {
+    /**
+     * Components are kept as plain dense NDArrays, indices are always INT64:
+     *   CSR (rank 2 only): pointers [rows + 1], indices [nnz] - column of each value, values [nnz]
+     *   COO (any rank):    indices [nnz, rank], values [nnz], entries are sorted in row-major order
+     *
+     * Data is accessed on host side
+     */
+    class ND4J_EXPORT SparseNDArray {
+    private:
+        SparseType _format = SparseType::CSR;
+        std::vector<Nd4jLong> _shape;
+        NDArray _values;
+        NDArray _indices;
+        NDArray _pointers;
+
+        SparseNDArray(SparseType format, const std::vector<Nd4jLong> &shape, NDArray &&values, NDArray &&indices, NDArray &&pointers);
+
+    public:
+        SparseNDArray() = default;
+        ~SparseNDArray() = default;
+
+        SparseNDArray(const SparseNDArray &other);
+        SparseNDArray(SparseNDArray &&other) = default;
+        SparseNDArray& operator=(const SparseNDArray &other);
+        SparseNDArray& operator=(SparseNDArray &&other) = default;
+
+        /**
+         * These methods build sparse array out of its components, index arrays of other integer types are converted to INT64
+         *
+         * @param shape - shape of equivalent dense array
+         */
+        static SparseNDArray csr(const std::vector<Nd4jLong> &shape, const NDArray &pointers, const NDArray &columns, const NDArray &values);
+        static SparseNDArray coo(const std::vector<Nd4jLong> &shape, const NDArray &indices, const NDArray &values);
+
+        /**
+         * This method collects non-zero elements of dense array. Rows are scanned in parallel
+         */
+        static SparseNDArray fromDense(const NDArray &dense, SparseType format = SparseType::CSR);
+
+        /**
+         * This method returns dense array, duplicate entries are summed up
+         */
+        NDArray toDense(char order = 'c') const;
+
+        SparseNDArray toCsr() const;
+        SparseNDArray toCoo() const;
+
+        /**
+         * Elementwise product with dense array of the same shape. Result has the same sparsity pattern as this array
+         */
+        SparseNDArray multiply(const NDArray &dense) const;
+
+        FORCEINLINE SparseType format() const { return _format; }
+        FORCEINLINE const std::vector<Nd4jLong>& shape() const { return _shape; }
+        FORCEINLINE int rankOf() const { return (int) _shape.size(); }
+        FORCEINLINE Nd4jLong sizeAt(int dim) const { return _shape.at(dim < 0 ? dim + _shape.size() : dim); }
+        FORCEINLINE nd4j::DataType dataType() const { return _values.dataType(); }
+
+        Nd4jLong lengthOf() const;
+        Nd4jLong nnz() const;
+
+        /**
+         * This method returns fraction of stored elements, i.e. nnz / length
+         */
+        double density() const;
+
+        FORCEINLINE const NDArray& values() const { return _values; }
+        FORCEINLINE const NDArray& indices() const { return _indices; }
+        FORCEINLINE const NDArray& pointers() const { return _pointers; }
+    };
+}
+
+#endif //LIBND4J_SPARSENDARRAY_H
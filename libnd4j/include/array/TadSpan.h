@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Allocation-free access to TADs of an NDArray, built on top of TadPack
+//
+
+#ifndef LIBND4J_TADSPAN_H
+#define LIBND4J_TADSPAN_H
+
+#include <NDArray.h>
+#include <array/TadPack.h>
+#include <vector>
+
+namespace nd4j {
+    /**
+     * This class is lightweight replacement for NDArray::allTensorsAlongDimension() for cases where only element access is needed.
+     * TADs are addressed by index and no NDArray is created per TAD, so iteration over span allocates nothing.
+     *
+     * Span works with host buffer of array
+     */
+    class ND4J_EXPORT TadSpan {
+    private:
+        TadPack _pack;
+        int8_t *_buffer = nullptr;
+        Nd4jLong *_tadShapeInfo = nullptr;
+        Nd4jLong *_tadOffsets = nullptr;
+        Nd4jLong _numTads = 0;
+        Nd4jLong _tadLength = 0;
+
+        // > 0 if element e of each TAD lives at e * _ews
+        Nd4jLong _ews = 0;
+        int _sizeOfT = 0;
+        nd4j::DataType _dataType = nd4j::DataType::INHERIT;
+
+    public:
+        /**
+         * @param array - array to iterate over
+         * @param dimensions - dimensions of TAD, same as for allTensorsAlongDimension()
+         */
+        TadSpan(const NDArray &array, const std::vector<int> &dimensions);
+        ~TadSpan() = default;
+
+        FORCEINLINE Nd4jLong size() const { return _numTads; }
+        FORCEINLINE Nd4jLong tadLength() const { return _tadLength; }
+        FORCEINLINE nd4j::DataType dataType() const { return _dataType; }
+        FORCEINLINE Nd4jLong* tadShapeInfo() const { return _tadShapeInfo; }
+
+        /**
+         * This method returns stride between consecutive elements of any TAD, or 0 if TADs can't be walked with single stride
+         */
+        FORCEINLINE Nd4jLong ews() const { return _ews; }
+
+        /**
+         * This method returns offset of element e within any TAD, in elements
+         */
+        FORCEINLINE Nd4jLong elementOffset(Nd4jLong e) const {
+            return _ews > 0 ? e * _ews : shape::getIndexOffset(e, _tadShapeInfo);
+        }
+
+        /**
+         * This method returns pointer to the first element of TAD
+         */
+        template <typename T>
+        FORCEINLINE T* at(Nd4jLong tad) const {
+            return reinterpret_cast<T*>(_buffer) + _tadOffsets[tad];
+        }
+
+        /**
+         * This method returns reference to element e of TAD
+         */
+        template <typename T>
+        FORCEINLINE T& t(Nd4jLong tad, Nd4jLong e) const {
+            return at<T>(tad)[elementOffset(e)];
+        }
+
+        /**
+         * This method copies TAD sourceTad of source span into TAD tad of this span.
+         * Data types and TAD lengths should match
+         */
+        void assign(Nd4jLong tad, const TadSpan &source, Nd4jLong sourceTad);
+
+        /**
+         * This method copies whole source array into TAD tad of this span.
+         * Data types should match, source length should be equal to TAD length
+         */
+        void assign(Nd4jLong tad, const NDArray &source);
+    };
+}
+
+#endif //LIBND4J_TADSPAN_H
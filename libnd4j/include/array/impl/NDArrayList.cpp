@@ -25,8 +25,9 @@
 #include <ops/declarable/CustomOperations.h>
 
 namespace nd4j {
-    NDArrayList::NDArrayList(int height, bool expandable) {
+    NDArrayList::NDArrayList(int height, bool expandable, bool contiguous) {
         _expandable = expandable;
+        _contiguous = contiguous;
         _elements.store(0);
         _counter.store(0);
         _id.first = 0;
@@ -41,6 +42,8 @@ namespace nd4j {
             delete v.second;
 
         _chunks.clear();
+
+        delete _storage;
     }
 
     NDArray* NDArrayList::read(int idx) {
@@ -60,14 +63,122 @@ namespace nd4j {
         return _chunks[idx];
     }
 
+    bool NDArrayList::isContiguous() {
+        return _contiguous;
+    }
+
+    NDArray* NDArrayList::elementView(int idx) {
+        return new NDArray(_storage->dataBuffer(), ShapeDescriptor(_dtype, 'c', _elementShape), _context, idx * _elementLength);
+    }
+
+    void NDArrayList::reallocate(Nd4jLong capacity) {
+        std::vector<Nd4jLong> shape(_elementShape);
+        shape.insert(shape.begin(), capacity);
+
+        auto storage = new NDArray('c', shape, _dtype, _context);
+        if (_storage != nullptr) {
+            shape[0] = nd4j::math::nd4j_min<Nd4jLong>(_capacity, capacity);
+            NDArray head(storage->dataBuffer(), ShapeDescriptor(_dtype, 'c', shape), _context);
+            head.assign(_storage);
+            delete _storage;
+        }
+
+        _storage = storage;
+        _capacity = capacity;
+        _stacked = false;
+
+        // existing views are updated in place, so pointers returned by readRaw() stay valid
+        for (auto const& v : _chunks) {
+            auto view = elementView(v.first);
+            *v.second = std::move(*view);
+            delete view;
+        }
+    }
+
+    void NDArrayList::detach() {
+        for (auto const& v : _chunks) {
+            auto copy = v.second->dup();
+            *v.second = std::move(*copy);
+            delete copy;
+        }
+
+        delete _storage;
+        _storage = nullptr;
+        _capacity = 0;
+        _stacked = false;
+        _contiguous = false;
+    }
+
+    Nd4jStatus NDArrayList::writeCopy(int idx, NDArray* array) {
+        if (!_contiguous)
+            return write(idx, array->dup(array->ordering()));
+
+        auto status = validate(array);
+        if (status != Status::OK())
+            return status;
+
+        if (storeContiguous(idx, array))
+            return Status::OK();
+
+        return write(idx, array->dup(array->ordering()));
+    }
+
+    bool NDArrayList::storeContiguous(int idx, NDArray* array) {
+        if (!_contiguous || array->isEmpty())
+            return false;
+
+        if (_storage == nullptr) {
+            // reference element shape is taken from first written element
+            if (!_chunks.empty()) {
+                detach();
+                return false;
+            }
+
+            _elementShape = array->getShapeAsVector();
+            _elementLength = array->lengthOf();
+            reallocate(nd4j::math::nd4j_max<Nd4jLong>(_height, idx + 1));
+        } else if (!array->isSameShape(_elementShape)) {
+            detach();
+            return false;
+        }
+
+        if (idx >= _capacity)
+            reallocate(nd4j::math::nd4j_max<Nd4jLong>(idx + 1, 2 * _capacity));
+        else if (_stacked)
+            reallocate(_capacity);
+
+        if (_chunks.count(idx) == 0) {
+            _chunks[idx] = elementView(idx);
+            _elements++;
+        }
+
+        _chunks[idx]->assign(array);
+        return true;
+    }
+
     Nd4jStatus NDArrayList::write(int idx, NDArray* array) {
+        auto status = validate(array);
+        if (status != Status::OK())
+            return status;
+
+        if (storeContiguous(idx, array)) {
+            delete array;
+            return Status::OK();
+        }
+
         if (_chunks.count(idx) == 0)
             _elements++;
         else {
             delete _chunks[idx];
         }
 
+        // storing reference
+        _chunks[idx] = array;
+
+        return Status::OK();
+    }
 
+    Nd4jStatus NDArrayList::validate(NDArray* array) {
         // we store reference shape on first write
         if (_chunks.empty()) {
             _dtype = array->dataType();
@@ -114,11 +225,6 @@ namespace nd4j {
             } else
                 return Status::CODE(ND4J_STATUS_BAD_INPUT, "NDArrayList: all arrays must have same size along inner dimensions");
         }
-        
-        //_elements++;
-
-        // storing reference
-        _chunks[idx] = array;
 
         return Status::OK();
     }
@@ -132,7 +238,38 @@ namespace nd4j {
     }
 
     void NDArrayList::unstack(NDArray* array, int axis) {
+        if (axis < 0)
+            axis += array->rankOf();
+
         _axis = axis;
+
+        // whole input is copied once, with unstack axis moved to the front. Elements are views of that copy
+        if (_chunks.empty() && _storage == nullptr && array->rankOf() > 0 && !array->isEmpty()) {
+            std::vector<int> permutation({axis});
+            _elementShape.clear();
+            for (int e = 0; e < array->rankOf(); e++)
+                if (e != axis) {
+                    permutation.emplace_back(e);
+                    _elementShape.emplace_back(array->sizeAt(e));
+                }
+
+            _contiguous = true;
+            _dtype = array->dataType();
+            _capacity = array->sizeAt(axis);
+            _elementLength = _capacity > 0 ? array->lengthOf() / _capacity : 0;
+
+            _shape = _elementShape;
+            _shape.insert(_shape.begin(), 1);
+
+            _storage = array->permute(permutation).dup('c');
+
+            for (int e = 0; e < _capacity; e++)
+                _chunks[e] = elementView(e);
+
+            _elements.store((int) _capacity);
+            return;
+        }
+
         std::vector<int> args({axis});
         auto newAxis = ShapeUtils::evalDimsToExclude(array->rankOf(), args);
         auto result = array->allTensorsAlongDimension(newAxis);
@@ -144,13 +281,23 @@ namespace nd4j {
     }
 
     NDArray* NDArrayList::stack() {
+        int numElements = _elements.load();
+
+        // contiguous storage with elements [0..numElements) written: stacked array is just a view
+        if (_storage != nullptr && numElements > 0 && _chunks.begin()->first == 0 && _chunks.rbegin()->first == numElements - 1) {
+            std::vector<Nd4jLong> shape(_elementShape);
+            shape.insert(shape.begin(), numElements);
+
+            _stacked = true;
+            return new NDArray(_storage->dataBuffer(), ShapeDescriptor(_dtype, 'c', shape), _context);
+        }
+
         // FIXME: this is bad for perf, but ok as poc
         nd4j::ops::stack op;
         std::vector<NDArray*> inputs;
         std::vector<double> targs;
         std::vector<Nd4jLong> iargs({0});
         std::vector<bool> bargs;
-        int numElements = _elements.load();
 
         for (int e = 0; e < numElements; e++) {
             _chunks[e]->syncToDevice();
@@ -226,13 +373,27 @@ namespace nd4j {
     }
 
     NDArrayList* NDArrayList::clone() {
-        auto list = new NDArrayList(_height, _expandable);
+        auto list = new NDArrayList(_height, _expandable, _contiguous);
         list->_axis = _axis;
         list->_id.first = _id.first;
         list->_id.second = _id.second;
         list->_name = _name;
+        list->_dtype = _dtype;
+        list->_shape = _shape;
         list->_elements.store(_elements.load());
 
+        if (_storage != nullptr) {
+            list->_storage = _storage->dup();
+            list->_elementShape = _elementShape;
+            list->_elementLength = _elementLength;
+            list->_capacity = _capacity;
+
+            for (auto const& v : _chunks)
+                list->_chunks[v.first] = list->elementView(v.first);
+
+            return list;
+        }
+
         for (auto const& v : _chunks) {
             list->_chunks[v.first] = v.second->dup();
         }
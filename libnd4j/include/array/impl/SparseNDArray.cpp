@@ -0,0 +1,402 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// SparseNDArray implementation
+//
+
+#include "../SparseNDArray.h"
+#include <execution/Executor.h>
+#include <ops/specials_sparse.h>
+#include <helpers/shape.h>
+#include <stdexcept>
+
+namespace nd4j {
+    static NDArray asLongs(const NDArray &array) {
+        if (array.dataType() == nd4j::DataType::INT64)
+            return array;
+
+        std::unique_ptr<NDArray> result(array.cast(nd4j::DataType::INT64));
+        return *result;
+    }
+
+    // COO array has no pointers, and default NDArray can't be copied
+    static NDArray copyOf(const NDArray &array) {
+        return array.getShapeInfo() == nullptr ? NDArray() : NDArray(array);
+    }
+
+    static void unravel(Nd4jLong index, const std::vector<Nd4jLong> &shape, Nd4jLong *coords) {
+        for (int d = (int) shape.size() - 1; d > 0; d--) {
+            coords[d] = index % shape[d];
+            index /= shape[d];
+        }
+        coords[0] = index;
+    }
+
+    // dense array is scanned twice: non-zeros are counted per row first, then every row is written at its own position
+    template <typename T>
+    static void fromDense_(const NDArray &dense, SparseType format, const std::vector<Nd4jLong> &shape, NDArray &values, NDArray &indices, NDArray &pointers) {
+        const Nd4jLong rows = shape[0];
+        const Nd4jLong rowLength = rows > 0 ? dense.lengthOf() / rows : 0;
+        const int rank = (int) shape.size();
+
+        auto x = dense.bufferAsT<T>();
+        auto xShapeInfo = dense.getShapeInfo();
+        const bool linear = dense.ordering() == 'c' && dense.ews() == 1;
+
+        std::vector<Nd4jLong> counts(rows + 1, 0);
+        Executor::parallel_for(0, rows, [&](Nd4jLong from, Nd4jLong to) {
+            for (Nd4jLong r = from; r < to; r++) {
+                Nd4jLong count = 0;
+                for (Nd4jLong j = 0; j < rowLength; j++) {
+                    auto i = r * rowLength + j;
+                    if (x[linear ? i : shape::getIndexOffset(i, xShapeInfo)] != static_cast<T>(0))
+                        count++;
+                }
+                counts[r + 1] = count;
+            }
+        });
+
+        for (Nd4jLong r = 0; r < rows; r++)
+            counts[r + 1] += counts[r];
+
+        const auto nnz = counts[rows];
+        values = NDArray('c', {nnz}, dense.dataType(), dense.getContext());
+        if (format == SparseType::CSR)
+            indices = NDArray('c', {nnz}, nd4j::DataType::INT64, dense.getContext());
+        else
+            indices = NDArray('c', {nnz, (Nd4jLong) rank}, nd4j::DataType::INT64, dense.getContext());
+
+        auto z = values.bufferAsT<T>();
+        auto zIndices = indices.bufferAsT<Nd4jLong>();
+
+        Executor::parallel_for(0, rows, [&](Nd4jLong from, Nd4jLong to) {
+            for (Nd4jLong r = from; r < to; r++) {
+                auto p = counts[r];
+                for (Nd4jLong j = 0; j < rowLength; j++) {
+                    auto i = r * rowLength + j;
+                    auto v = x[linear ? i : shape::getIndexOffset(i, xShapeInfo)];
+                    if (v == static_cast<T>(0))
+                        continue;
+
+                    z[p] = v;
+                    if (format == SparseType::CSR)
+                        zIndices[p] = j;
+                    else
+                        unravel(i, shape, zIndices + p * rank);
+
+                    p++;
+                }
+            }
+        });
+
+        if (format == SparseType::CSR) {
+            pointers = NDArray('c', {rows + 1}, nd4j::DataType::INT64, dense.getContext());
+            std::copy(counts.begin(), counts.end(), pointers.bufferAsT<Nd4jLong>());
+            pointers.tickWriteHost();
+        }
+
+        values.tickWriteHost();
+        indices.tickWriteHost();
+    }
+
+    template <typename T>
+    static void toDense_(SparseType format, const NDArray &values, const NDArray &indices, const NDArray &pointers, NDArray &target) {
+        auto z = target.bufferAsT<T>();
+        auto stride = shape::stride(target.getShapeInfo());
+        const int rank = target.rankOf();
+        const auto nnz = values.lengthOf();
+        auto v = values.bufferAsT<T>();
+        auto idx = indices.bufferAsT<Nd4jLong>();
+
+        if (format == SparseType::CSR) {
+            auto ptr = pointers.bufferAsT<Nd4jLong>();
+
+            // rows are independent, so they're scattered in parallel
+            Executor::parallel_for(0, target.sizeAt(0), [&](Nd4jLong from, Nd4jLong to) {
+                for (Nd4jLong r = from; r < to; r++)
+                    for (Nd4jLong p = ptr[r]; p < ptr[r + 1]; p++)
+                        z[r * stride[0] + idx[p] * stride[1]] += v[p];
+            });
+        } else {
+            for (Nd4jLong p = 0; p < nnz; p++) {
+                Nd4jLong offset = 0;
+                for (int d = 0; d < rank; d++)
+                    offset += idx[p * rank + d] * stride[d];
+
+                z[offset] += v[p];
+            }
+        }
+    }
+
+    // elementwise product, logical AND for bool values
+    template <typename T>
+    static FORCEINLINE T product(T a, T b) {
+        return a * b;
+    }
+
+    template <>
+    FORCEINLINE bool product<bool>(bool a, bool b) {
+        return a && b;
+    }
+
+    template <typename T>
+    static void multiply_(SparseType format, const NDArray &values, const NDArray &indices, const NDArray &pointers, const NDArray &dense, NDArray &target) {
+        auto x = dense.bufferAsT<T>();
+        auto stride = shape::stride(dense.getShapeInfo());
+        const int rank = dense.rankOf();
+        auto v = values.bufferAsT<T>();
+        auto z = target.bufferAsT<T>();
+        auto idx = indices.bufferAsT<Nd4jLong>();
+
+        if (format == SparseType::CSR) {
+            auto ptr = pointers.bufferAsT<Nd4jLong>();
+
+            Executor::parallel_for(0, dense.sizeAt(0), [&](Nd4jLong from, Nd4jLong to) {
+                for (Nd4jLong r = from; r < to; r++)
+                    for (Nd4jLong p = ptr[r]; p < ptr[r + 1]; p++)
+                        z[p] = product<T>(v[p], x[r * stride[0] + idx[p] * stride[1]]);
+            });
+        } else {
+            Executor::parallel_for(0, values.lengthOf(), [&](Nd4jLong from, Nd4jLong to) {
+                for (Nd4jLong p = from; p < to; p++) {
+                    Nd4jLong offset = 0;
+                    for (int d = 0; d < rank; d++)
+                        offset += idx[p * rank + d] * stride[d];
+
+                    z[p] = product<T>(v[p], x[offset]);
+                }
+            }, 1024);
+        }
+    }
+
+    template <typename T>
+    static void sortCoo_(NDArray &indices, NDArray &values, int rank) {
+        nd4j::sparse::SparseUtils<T>::sortCooIndicesGeneric(indices.bufferAsT<Nd4jLong>(), values.bufferAsT<T>(), values.lengthOf(), rank);
+    }
+
+    SparseNDArray::SparseNDArray(SparseType format, const std::vector<Nd4jLong> &shape, NDArray &&values, NDArray &&indices, NDArray &&pointers) {
+        _format = format;
+        _shape = shape;
+        _values = std::move(values);
+        _indices = std::move(indices);
+        _pointers = std::move(pointers);
+    }
+
+    SparseNDArray::SparseNDArray(const SparseNDArray &other) {
+        *this = other;
+    }
+
+    SparseNDArray& SparseNDArray::operator=(const SparseNDArray &other) {
+        if (this == &other)
+            return *this;
+
+        _format = other._format;
+        _shape = other._shape;
+        _values = copyOf(other._values);
+        _indices = copyOf(other._indices);
+        _pointers = copyOf(other._pointers);
+
+        return *this;
+    }
+
+    SparseNDArray SparseNDArray::csr(const std::vector<Nd4jLong> &shape, const NDArray &pointers, const NDArray &columns, const NDArray &values) {
+        if (shape.size() != 2)
+            throw std::invalid_argument("SparseNDArray::csr: CSR array must have rank 2");
+
+        if (!pointers.isZ() || !columns.isZ())
+            throw std::invalid_argument("SparseNDArray::csr: pointers and columns must have integer type");
+
+        if (pointers.lengthOf() != shape[0] + 1 || columns.lengthOf() != values.lengthOf())
+            throw std::invalid_argument("SparseNDArray::csr: lengths of components don't match shape");
+
+        auto ptr = asLongs(pointers);
+        auto cols = asLongs(columns);
+        ptr.syncToHost();
+        if (ptr.e<Nd4jLong>(shape[0]) != values.lengthOf())
+            throw std::invalid_argument("SparseNDArray::csr: last pointer must be equal to number of values");
+
+        NDArray vals(values);
+        return SparseNDArray(SparseType::CSR, shape, std::move(vals), std::move(cols), std::move(ptr));
+    }
+
+    SparseNDArray SparseNDArray::coo(const std::vector<Nd4jLong> &shape, const NDArray &indices, const NDArray &values) {
+        const int rank = (int) shape.size();
+        if (rank < 1)
+            throw std::invalid_argument("SparseNDArray::coo: rank must be at least 1");
+
+        if (!indices.isZ() || indices.rankOf() != 2 || indices.sizeAt(0) != values.lengthOf() || indices.sizeAt(1) != rank)
+            throw std::invalid_argument("SparseNDArray::coo: indices must be integer array of shape [nnz, rank]");
+
+        auto idx = asLongs(indices);
+        NDArray vals(values);
+        idx.syncToHost();
+        vals.syncToHost();
+
+        // entries are kept in row-major order, so only unsorted input gets sorted
+        auto pIdx = idx.bufferAsT<Nd4jLong>();
+        bool sorted = true;
+        for (Nd4jLong p = 1; p < vals.lengthOf() && sorted; p++)
+            sorted = !std::lexicographical_compare(pIdx + p * rank, pIdx + (p + 1) * rank, pIdx + (p - 1) * rank, pIdx + p * rank);
+
+        if (!sorted) {
+            BUILD_SINGLE_SELECTOR(vals.dataType(), sortCoo_, (idx, vals, rank), LIBND4J_TYPES);
+            idx.tickWriteHost();
+            vals.tickWriteHost();
+        }
+
+        return SparseNDArray(SparseType::COO, shape, std::move(vals), std::move(idx), NDArray());
+    }
+
+    SparseNDArray SparseNDArray::fromDense(const NDArray &dense, SparseType format) {
+        if (format != SparseType::CSR && format != SparseType::COO)
+            throw std::invalid_argument("SparseNDArray::fromDense: only CSR and COO formats are supported");
+
+        if (dense.rankOf() < 1 || dense.isS())
+            throw std::invalid_argument("SparseNDArray::fromDense: array must be numeric and have rank 1 or higher");
+
+        if (format == SparseType::CSR && dense.rankOf() != 2)
+            throw std::invalid_argument("SparseNDArray::fromDense: CSR array must have rank 2");
+
+        std::vector<Nd4jLong> shape(dense.shapeOf(), dense.shapeOf() + dense.rankOf());
+        NDArray values, indices, pointers;
+
+        dense.syncToHost();
+        BUILD_SINGLE_SELECTOR(dense.dataType(), fromDense_, (dense, format, shape, values, indices, pointers), LIBND4J_TYPES);
+
+        return SparseNDArray(format, shape, std::move(values), std::move(indices), std::move(pointers));
+    }
+
+    NDArray SparseNDArray::toDense(char order) const {
+        NDArray result(order, _shape, dataType(), _values.getContext());
+        result.nullify();
+        result.syncToHost();
+
+        _values.syncToHost();
+        _indices.syncToHost();
+        if (_format == SparseType::CSR)
+            _pointers.syncToHost();
+
+        BUILD_SINGLE_SELECTOR(dataType(), toDense_, (_format, _values, _indices, _pointers, result), LIBND4J_TYPES);
+        result.tickWriteHost();
+
+        return result;
+    }
+
+    SparseNDArray SparseNDArray::toCsr() const {
+        if (_format == SparseType::CSR)
+            return *this;
+
+        if (rankOf() != 2)
+            throw std::runtime_error("SparseNDArray::toCsr: CSR array must have rank 2");
+
+        _indices.syncToHost();
+
+        const auto nnz = this->nnz();
+        NDArray pointers('c', {_shape[0] + 1}, nd4j::DataType::INT64, _values.getContext());
+        NDArray columns('c', {nnz}, nd4j::DataType::INT64, _values.getContext());
+        pointers.nullify();
+        pointers.syncToHost();
+
+        auto ptr = pointers.bufferAsT<Nd4jLong>();
+        auto cols = columns.bufferAsT<Nd4jLong>();
+        auto idx = _indices.bufferAsT<Nd4jLong>();
+
+        // COO entries are sorted by row already
+        for (Nd4jLong p = 0; p < nnz; p++) {
+            ptr[idx[2 * p] + 1]++;
+            cols[p] = idx[2 * p + 1];
+        }
+
+        for (Nd4jLong r = 0; r < _shape[0]; r++)
+            ptr[r + 1] += ptr[r];
+
+        pointers.tickWriteHost();
+        columns.tickWriteHost();
+
+        NDArray values(_values);
+        return SparseNDArray(SparseType::CSR, _shape, std::move(values), std::move(columns), std::move(pointers));
+    }
+
+    SparseNDArray SparseNDArray::toCoo() const {
+        if (_format == SparseType::COO)
+            return *this;
+
+        _indices.syncToHost();
+        _pointers.syncToHost();
+
+        NDArray indices('c', {nnz(), 2}, nd4j::DataType::INT64, _values.getContext());
+        auto idx = indices.bufferAsT<Nd4jLong>();
+        auto ptr = _pointers.bufferAsT<Nd4jLong>();
+        auto cols = _indices.bufferAsT<Nd4jLong>();
+
+        for (Nd4jLong r = 0; r < _shape[0]; r++)
+            for (Nd4jLong p = ptr[r]; p < ptr[r + 1]; p++) {
+                idx[2 * p] = r;
+                idx[2 * p + 1] = cols[p];
+            }
+
+        indices.tickWriteHost();
+
+        NDArray values(_values);
+        return SparseNDArray(SparseType::COO, _shape, std::move(values), std::move(indices), NDArray());
+    }
+
+    SparseNDArray SparseNDArray::multiply(const NDArray &dense) const {
+        if (dense.getShapeAsVector() != _shape)
+            throw std::invalid_argument("SparseNDArray::multiply: dense array must have the same shape as sparse one");
+
+        std::unique_ptr<NDArray> cast;
+        auto x = &dense;
+        if (dense.dataType() != dataType()) {
+            cast.reset(dense.cast(dataType()));
+            x = cast.get();
+        }
+
+        x->syncToHost();
+        _values.syncToHost();
+        _indices.syncToHost();
+        if (_format == SparseType::CSR)
+            _pointers.syncToHost();
+
+        NDArray values('c', {nnz()}, dataType(), _values.getContext());
+        BUILD_SINGLE_SELECTOR(dataType(), multiply_, (_format, _values, _indices, _pointers, *x, values), LIBND4J_TYPES);
+        values.tickWriteHost();
+
+        auto indices = copyOf(_indices);
+        auto pointers = copyOf(_pointers);
+
+        return SparseNDArray(_format, _shape, std::move(values), std::move(indices), std::move(pointers));
+    }
+
+    Nd4jLong SparseNDArray::lengthOf() const {
+        Nd4jLong length = 1;
+        for (auto v: _shape)
+            length *= v;
+
+        return length;
+    }
+
+    Nd4jLong SparseNDArray::nnz() const {
+        return _values.getShapeInfo() == nullptr ? 0 : _values.lengthOf();
+    }
+
+    double SparseNDArray::density() const {
+        auto length = lengthOf();
+        return length > 0 ? static_cast<double>(nnz()) / length : 0.0;
+    }
+}
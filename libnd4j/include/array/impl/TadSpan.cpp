@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// TadSpan implementation
+//
+
+#include "../TadSpan.h"
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/shape.h>
+#include <cstring>
+#include <stdexcept>
+
+namespace nd4j {
+    static FORCEINLINE Nd4jLong linearStride(const Nd4jLong *shapeInfo) {
+        return shape::order(shapeInfo) == 'c' || shape::rank(shapeInfo) <= 1 ? shape::elementWiseStride(shapeInfo) : 0;
+    }
+
+    // elements are moved as raw words of the same width, so one instantiation per element size is enough
+    template <typename B>
+    static void copyElements(int8_t *z, const Nd4jLong *zShapeInfo, Nd4jLong zEws, const int8_t *x, const Nd4jLong *xShapeInfo, Nd4jLong xEws, Nd4jLong length) {
+        auto zB = reinterpret_cast<B*>(z);
+        auto xB = reinterpret_cast<const B*>(x);
+
+        if (zEws == 1 && xEws == 1) {
+            memcpy(zB, xB, length * sizeof(B));
+        } else if (zEws > 0 && xEws > 0) {
+            for (Nd4jLong e = 0; e < length; e++)
+                zB[e * zEws] = xB[e * xEws];
+        } else {
+            for (Nd4jLong e = 0; e < length; e++)
+                zB[shape::getIndexOffset(e, zShapeInfo)] = xB[shape::getIndexOffset(e, xShapeInfo)];
+        }
+    }
+
+    static void copyElements(int sizeOfT, int8_t *z, const Nd4jLong *zShapeInfo, Nd4jLong zEws, const int8_t *x, const Nd4jLong *xShapeInfo, Nd4jLong xEws, Nd4jLong length) {
+        switch (sizeOfT) {
+            case 1: copyElements<uint8_t>(z, zShapeInfo, zEws, x, xShapeInfo, xEws, length); break;
+            case 2: copyElements<uint16_t>(z, zShapeInfo, zEws, x, xShapeInfo, xEws, length); break;
+            case 4: copyElements<uint32_t>(z, zShapeInfo, zEws, x, xShapeInfo, xEws, length); break;
+            case 8: copyElements<uint64_t>(z, zShapeInfo, zEws, x, xShapeInfo, xEws, length); break;
+            default:
+                throw std::runtime_error("TadSpan: unsupported element size");
+        }
+    }
+
+    TadSpan::TadSpan(const NDArray &array, const std::vector<int> &dimensions) {
+        _sizeOfT = array.sizeOfT();
+        _dataType = array.dataType();
+
+        // same as allTensorsAlongDimension(): no dimensions means no TADs
+        if (dimensions.empty())
+            return;
+
+        if (dimensions.back() >= array.rankOf())
+            throw std::runtime_error("TadSpan: all dimensions must be smaller than rank of array");
+
+        array.syncToHost();
+
+        _pack = ConstantTadHelper::getInstance()->tadForDimensions(array.getShapeInfo(), dimensions);
+        _buffer = reinterpret_cast<int8_t*>(array.getBuffer());
+        _tadShapeInfo = _pack.primaryShapeInfo();
+        _tadOffsets = _pack.primaryOffsets();
+        _numTads = _pack.numberOfTads();
+        _tadLength = shape::length(_tadShapeInfo);
+        _ews = linearStride(_tadShapeInfo);
+    }
+
+    void TadSpan::assign(Nd4jLong tad, const TadSpan &source, Nd4jLong sourceTad) {
+        if (source._dataType != _dataType)
+            throw std::runtime_error("TadSpan::assign: data types of spans should be the same");
+
+        if (source._tadLength != _tadLength)
+            throw std::runtime_error("TadSpan::assign: TAD lengths of spans should be the same");
+
+        copyElements(_sizeOfT, _buffer + _tadOffsets[tad] * _sizeOfT, _tadShapeInfo, _ews,
+                     source._buffer + source._tadOffsets[sourceTad] * _sizeOfT, source._tadShapeInfo, source._ews, _tadLength);
+    }
+
+    void TadSpan::assign(Nd4jLong tad, const NDArray &source) {
+        if (source.dataType() != _dataType)
+            throw std::runtime_error("TadSpan::assign: data type of source array should be the same as span data type");
+
+        if (source.lengthOf() != _tadLength)
+            throw std::runtime_error("TadSpan::assign: length of source array should be equal to TAD length");
+
+        source.syncToHost();
+
+        copyElements(_sizeOfT, _buffer + _tadOffsets[tad] * _sizeOfT, _tadShapeInfo, _ews,
+                     reinterpret_cast<int8_t*>(source.getBuffer()), source.getShapeInfo(), linearStride(source.getShapeInfo()), _tadLength);
+    }
+}
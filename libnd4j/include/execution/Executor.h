@@ -21,12 +21,37 @@
 #ifndef DEV_TESTS_EXECUTOR_H
 #define DEV_TESTS_EXECUTOR_H
 
+#include <dll.h>
+#include <pointercast.h>
+#include <functional>
+
 namespace nd4j {
-    class Executor {
+    /**
+     * Entry point for host-side parallelism. All calls are served by the shared ThreadPool
+     */
+    class ND4J_EXPORT Executor {
     public:
-        static void execute() {
-            //
-        }
+        /**
+         * This method executes func over [start, stop) split into contiguous [from, to) chunks of at least grain elements.
+         * maxThreads limits number of chunks, -1 means pool size. Nested calls are executed inline by the calling thread
+         */
+        static void parallel_for(Nd4jLong start, Nd4jLong stop, const std::function<void(Nd4jLong, Nd4jLong)> &func, Nd4jLong grain = 1, int maxThreads = -1);
+
+        /**
+         * This method executes func(taskId) for taskId in [0, numTasks)
+         */
+        static void parallel_tasks(int numTasks, const std::function<void(int)> &func, int maxThreads = -1);
+
+        /**
+         * This method returns number of pool workers available to a single call, limited by Environment::maxThreads()
+         */
+        static int numberOfWorkers();
+
+        /**
+         * Global limit of pool workers running at the same time, shared by all callers
+         */
+        static int concurrencyBudget();
+        static void setConcurrencyBudget(int budget);
     };
 }
 
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Persistent work-stealing thread pool used by Executor
+//
+
+#ifndef LIBND4J_THREADPOOL_H
+#define LIBND4J_THREADPOOL_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nd4j {
+    /**
+     * Single parallel_for call. Lives on the stack of calling thread until all its chunks are finished
+     */
+    class ND4J_EXPORT ParallelRegion {
+    public:
+        const std::function<void(Nd4jLong, Nd4jLong)> *_func = nullptr;
+        int _pending = 0;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::exception_ptr _error;
+
+        void finish(std::exception_ptr error);
+        bool finished();
+        void wait();
+    };
+
+    class ND4J_EXPORT ParallelTask {
+    public:
+        ParallelRegion *_region = nullptr;
+        Nd4jLong _start = 0L;
+        Nd4jLong _stop = 0L;
+    };
+
+    /**
+     * Task queue of one worker. Owner takes tasks from the back, thieves take from the front
+     */
+    class ND4J_EXPORT WorkerQueue {
+    public:
+        std::deque<ParallelTask> _tasks;
+        std::mutex _mutex;
+        int _node = 0;
+
+        void push(const ParallelTask &task);
+        bool popBack(ParallelTask &task);
+        bool popFront(ParallelTask &task);
+    };
+
+    /**
+     * Pool workers are spread over NUMA nodes (if there's more than one) and pinned to cpus of their node.
+     * Idle workers steal from workers of the same node first.
+     *
+     * Number of workers executing tasks at the same time is limited by the global concurrency budget,
+     * so concurrent callers share cores instead of oversubscribing them. Callers always execute chunks of their own regions as well.
+     * Nested regions, i.e. started from within a task, are executed inline
+     */
+    class ND4J_EXPORT ThreadPool {
+    private:
+        static ThreadPool *_INSTANCE;
+
+        std::vector<WorkerQueue*> _queues;
+        std::vector<std::thread> _threads;
+        std::vector<std::vector<int>> _nodes;
+
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::atomic<Nd4jLong> _queued;
+        std::atomic<uint32_t> _rotation;
+        int _budget;
+        int _available;
+        bool _stop = false;
+
+        ThreadPool(int numWorkers);
+        ~ThreadPool();
+
+        void detectNodes();
+        void workerLoop(int workerId);
+        bool take(int workerId, ParallelTask &task);
+        void execute(const ParallelTask &task);
+
+    public:
+        static ThreadPool* getInstance();
+
+        int numberOfWorkers();
+        int numberOfNodes();
+
+        /**
+         * This method returns number of pool workers a single call may use: pool size is fixed at creation,
+         * but Environment::maxThreads() set later lowers it (caller thread counts as one of maxThreads)
+         */
+        int allowedWorkers();
+
+        /**
+         * Budget is max number of pool workers busy at any moment, across all callers
+         */
+        int concurrencyBudget();
+        void setConcurrencyBudget(int budget);
+
+        /**
+         * This method returns TRUE if current thread is executing pool task
+         */
+        static bool isNested();
+
+        /**
+         * This method splits [start, stop) into numChunks contiguous chunks, executes them and returns once all chunks are done.
+         * First exception thrown by func is rethrown here
+         */
+        void run(Nd4jLong start, Nd4jLong stop, int numChunks, const std::function<void(Nd4jLong, Nd4jLong)> &func);
+    };
+}
+
+#endif //LIBND4J_THREADPOOL_H
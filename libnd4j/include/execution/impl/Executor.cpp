@@ -0,0 +1,64 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Executor is thin facade over ThreadPool
+//
+
+#include <execution/Executor.h>
+#include <execution/ThreadPool.h>
+#include <templatemath.h>
+
+namespace nd4j {
+    void Executor::parallel_for(Nd4jLong start, Nd4jLong stop, const std::function<void(Nd4jLong, Nd4jLong)> &func, Nd4jLong grain, int maxThreads) {
+        const auto length = stop - start;
+        if (length <= 0)
+            return;
+
+        auto pool = ThreadPool::getInstance();
+        grain = nd4j::math::nd4j_max<Nd4jLong>(1L, grain);
+
+        // a few chunks per worker, so stealing has something to balance
+        Nd4jLong numChunks = maxThreads > 0 ? maxThreads : (pool->allowedWorkers() + 1) * 2;
+        numChunks = nd4j::math::nd4j_min<Nd4jLong>(numChunks, (length + grain - 1) / grain);
+
+        pool->run(start, stop, (int) numChunks, func);
+    }
+
+    void Executor::parallel_tasks(int numTasks, const std::function<void(int)> &func, int maxThreads) {
+        if (numTasks <= 0)
+            return;
+
+        auto numChunks = maxThreads > 0 ? nd4j::math::nd4j_min<int>(numTasks, maxThreads) : numTasks;
+
+        ThreadPool::getInstance()->run(0, numTasks, numChunks, [&](Nd4jLong from, Nd4jLong to) {
+            for (auto e = from; e < to; e++)
+                func((int) e);
+        });
+    }
+
+    int Executor::numberOfWorkers() {
+        return ThreadPool::getInstance()->allowedWorkers();
+    }
+
+    int Executor::concurrencyBudget() {
+        return ThreadPool::getInstance()->concurrencyBudget();
+    }
+
+    void Executor::setConcurrencyBudget(int budget) {
+        ThreadPool::getInstance()->setConcurrencyBudget(budget);
+    }
+}
@@ -0,0 +1,360 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <execution/ThreadPool.h>
+#include <Environment.h>
+#include <templatemath.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace nd4j {
+    // number of regions current thread is executing, > 0 means nested call
+    static thread_local int _depth = 0;
+
+    class DepthGuard {
+    public:
+        DepthGuard() { _depth++; }
+        ~DepthGuard() { _depth--; }
+    };
+
+    void ParallelRegion::finish(std::exception_ptr error) {
+        // notification happens under lock, so caller can't destroy region before we're done with it
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (error && !_error)
+            _error = error;
+
+        if (--_pending == 0)
+            _condition.notify_all();
+    }
+
+    bool ParallelRegion::finished() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _pending == 0;
+    }
+
+    void ParallelRegion::wait() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [&] { return _pending == 0; });
+    }
+
+    void WorkerQueue::push(const ParallelTask &task) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(task);
+    }
+
+    bool WorkerQueue::popBack(ParallelTask &task) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_tasks.empty())
+            return false;
+
+        task = _tasks.back();
+        _tasks.pop_back();
+        return true;
+    }
+
+    bool WorkerQueue::popFront(ParallelTask &task) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_tasks.empty())
+            return false;
+
+        task = _tasks.front();
+        _tasks.pop_front();
+        return true;
+    }
+
+    // parses lists like "0-3,8-11"
+    static std::vector<int> parseCpuList(const std::string &list) {
+        std::vector<int> result;
+        std::stringstream stream(list);
+        std::string range;
+
+        while (std::getline(stream, range, ',')) {
+            if (range.empty())
+                continue;
+
+            auto dash = range.find('-');
+            auto first = std::atoi(range.substr(0, dash).c_str());
+            auto last = dash == std::string::npos ? first : std::atoi(range.substr(dash + 1).c_str());
+
+            for (int e = first; e <= last; e++)
+                result.emplace_back(e);
+        }
+
+        return result;
+    }
+
+    void ThreadPool::detectNodes() {
+#if defined(__linux__) && !defined(__ANDROID__)
+        std::ifstream online("/sys/devices/system/node/online");
+        std::string nodes;
+        if (online.good() && std::getline(online, nodes)) {
+            for (auto n: parseCpuList(nodes)) {
+                std::ifstream cpus("/sys/devices/system/node/node" + std::to_string(n) + "/cpulist");
+                std::string list;
+                if (cpus.good() && std::getline(cpus, list)) {
+                    auto node = parseCpuList(list);
+                    if (!node.empty())
+                        _nodes.emplace_back(node);
+                }
+            }
+        }
+#endif
+        // single node means no affinity at all
+        if (_nodes.size() < 2)
+            _nodes.clear();
+    }
+
+    ThreadPool::ThreadPool(int numWorkers) {
+        _queued.store(0L);
+        _rotation.store(0);
+        _budget = numWorkers;
+        _available = numWorkers;
+
+        detectNodes();
+
+        for (int e = 0; e < numWorkers; e++) {
+            auto queue = new WorkerQueue();
+            queue->_node = _nodes.empty() ? 0 : e % (int) _nodes.size();
+            _queues.emplace_back(queue);
+        }
+
+        for (int e = 0; e < numWorkers; e++) {
+            _threads.emplace_back(&ThreadPool::workerLoop, this, e);
+
+#if defined(__linux__) && !defined(__ANDROID__)
+            if (!_nodes.empty()) {
+                cpu_set_t cpuset;
+                CPU_ZERO(&cpuset);
+                for (auto cpu: _nodes[_queues[e]->_node])
+                    CPU_SET(cpu, &cpuset);
+
+                pthread_setaffinity_np(_threads.back().native_handle(), sizeof(cpu_set_t), &cpuset);
+            }
+#endif
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _condition.notify_all();
+
+        for (auto &t: _threads)
+            t.join();
+
+        for (auto q: _queues)
+            delete q;
+    }
+
+    ThreadPool* ThreadPool::getInstance() {
+        // caller thread participates in every region, so it's one worker less
+        static std::once_flag flag;
+        std::call_once(flag, [] {
+            auto numWorkers = nd4j::math::nd4j_max<int>(0, Environment::getInstance()->maxThreads() - 1);
+            _INSTANCE = new ThreadPool(numWorkers);
+        });
+
+        return _INSTANCE;
+    }
+
+    int ThreadPool::numberOfWorkers() {
+        return (int) _queues.size();
+    }
+
+    int ThreadPool::allowedWorkers() {
+        auto maxThreads = Environment::getInstance()->maxThreads();
+        return nd4j::math::nd4j_max<int>(0, nd4j::math::nd4j_min<int>(numberOfWorkers(), maxThreads - 1));
+    }
+
+    int ThreadPool::numberOfNodes() {
+        return _nodes.empty() ? 1 : (int) _nodes.size();
+    }
+
+    int ThreadPool::concurrencyBudget() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _budget;
+    }
+
+    void ThreadPool::setConcurrencyBudget(int budget) {
+        if (budget < 0)
+            throw std::invalid_argument("ThreadPool: concurrency budget can't be negative");
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            // workers busy right now return their tokens later, so available might go below zero for a while
+            _available += budget - _budget;
+            _budget = budget;
+        }
+
+        _condition.notify_all();
+    }
+
+    bool ThreadPool::isNested() {
+        return _depth > 0;
+    }
+
+    bool ThreadPool::take(int workerId, ParallelTask &task) {
+        const int numQueues = (int) _queues.size();
+        bool result = false;
+
+        if (workerId >= 0) {
+            // own queue first, then same node, then everyone else
+            result = _queues[workerId]->popBack(task);
+            const auto node = _queues[workerId]->_node;
+
+            for (int e = 1; e < numQueues && !result; e++) {
+                auto victim = (workerId + e) % numQueues;
+                if (_queues[victim]->_node == node)
+                    result = _queues[victim]->popFront(task);
+            }
+
+            for (int e = 1; e < numQueues && !result; e++) {
+                auto victim = (workerId + e) % numQueues;
+                if (_queues[victim]->_node != node)
+                    result = _queues[victim]->popFront(task);
+            }
+        } else {
+            for (int e = 0; e < numQueues && !result; e++)
+                result = _queues[e]->popFront(task);
+        }
+
+        if (result)
+            _queued--;
+
+        return result;
+    }
+
+    void ThreadPool::execute(const ParallelTask &task) {
+        std::exception_ptr error;
+
+        try {
+            DepthGuard guard;
+            (*task._region->_func)(task._start, task._stop);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        task._region->finish(error);
+    }
+
+    void ThreadPool::workerLoop(int workerId) {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [&] { return _stop || (_queued.load() > 0 && _available > 0); });
+
+                if (_stop)
+                    return;
+
+                _available--;
+            }
+
+            // budget token is held while there's work to do
+            ParallelTask task;
+            while (take(workerId, task))
+                execute(task);
+
+            bool hasWork;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _available++;
+                hasWork = _queued.load() > 0;
+            }
+
+            if (hasWork)
+                _condition.notify_one();
+        }
+    }
+
+    void ThreadPool::run(Nd4jLong start, Nd4jLong stop, int numChunks, const std::function<void(Nd4jLong, Nd4jLong)> &func) {
+        const auto length = stop - start;
+        if (length <= 0)
+            return;
+
+        numChunks = (int) nd4j::math::nd4j_min<Nd4jLong>(numChunks, length);
+
+        // no more chunks than threads allowed by Environment, so at most that many threads run them
+        const int allowed = allowedWorkers();
+        if (allowed < numberOfWorkers())
+            numChunks = nd4j::math::nd4j_min<int>(numChunks, allowed + 1);
+        if (numChunks <= 1 || _queues.empty() || isNested()) {
+            DepthGuard guard;
+            func(start, stop);
+            return;
+        }
+
+        ParallelRegion region;
+        region._func = &func;
+        region._pending = numChunks;
+
+        const auto chunk = length / numChunks;
+        const auto remainder = length % numChunks;
+
+        // chunk 0 stays with caller, the rest goes to queues of consecutive workers of one node where possible
+        std::vector<ParallelTask> tasks(numChunks);
+        Nd4jLong offset = start;
+        for (int e = 0; e < numChunks; e++) {
+            tasks[e]._region = &region;
+            tasks[e]._start = offset;
+            offset += chunk + (e < remainder ? 1 : 0);
+            tasks[e]._stop = offset;
+        }
+
+        const int numQueues = (int) _queues.size();
+        const int numNodes = numberOfNodes();
+        const int first = (int) (_rotation.fetch_add(1) % (uint32_t) numQueues);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (int e = 1; e < numChunks; e++) {
+                // queues are interleaved over nodes, so stepping by numNodes keeps region on one node. Other nodes can still steal
+                auto q = (first + (e - 1) * numNodes) % numQueues;
+                _queues[q]->push(tasks[e]);
+            }
+
+            _queued += numChunks - 1;
+        }
+
+        for (int e = 1; e < numChunks; e++)
+            _condition.notify_one();
+
+        execute(tasks[0]);
+
+        // helping while waiting: whatever is still queued anywhere
+        ParallelTask task;
+        while (!region.finished() && take(-1, task))
+            execute(task);
+
+        region.wait();
+
+        if (region._error)
+            std::rethrow_exception(region._error);
+    }
+
+    ThreadPool* ThreadPool::_INSTANCE = 0;
+}
@@ -61,6 +61,9 @@ namespace nd4j {
             std::vector<NDArray*> _fastpath_in;
             std::vector<NDArray*> _fastpath_out;
             std::vector<NDArray*> _handles;
+
+            // outputs of view-capable ops might be published as views of inputs
+            bool _viewOutputs = false;
         public:
             Context(ContextPrototype* prototype, VariableSpace* variableSpace);
 
@@ -172,6 +175,13 @@ namespace nd4j {
              */
             bool isFastPath();
 
+            /**
+             * This method allows view-capable ops to publish outputs aliasing their inputs instead of copies.
+             * Graph executor enables this, since it takes care of inplace execution on top of such outputs
+             */
+            void allowViewOutputs(bool reallyAllow);
+            bool isViewOutputsAllowed();
+
 #ifndef __JAVACPP_HACK__
             std::vector<NDArray*>& fastpath_in();
             std::vector<NDArray*>& fastpath_out();
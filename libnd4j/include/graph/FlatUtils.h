@@ -35,9 +35,25 @@ namespace nd4j {
 
             static std::pair<Nd4jLong, Nd4jLong> fromLongPair(LongPair* pair);
 
-            static NDArray* fromFlatArray(const nd4j::graph::FlatArray* flatArray);
-
-            static flatbuffers::Offset<FlatArray> toFlatArray(flatbuffers::FlatBufferBuilder &builder, NDArray &array);
+            /**
+             * This method restores NDArray from FlatArray
+             *
+             * @param flatArray
+             * @param zeroCopy if TRUE, and payload has native byte order and is aligned for its data type, returned array references FlatBuffer memory instead of copying it.
+             *                 Such arrays must not outlive the FlatBuffer
+             * @return
+             */
+            static NDArray* fromFlatArray(const nd4j::graph::FlatArray* flatArray, bool zeroCopy = false);
+
+            /**
+             * This method serializes NDArray into FlatArray
+             *
+             * @param builder
+             * @param array
+             * @param alignment if > 0, payload is aligned to this number of bytes within resulting FlatBuffer, so it can be used for zero-copy import
+             * @return
+             */
+            static flatbuffers::Offset<FlatArray> toFlatArray(flatbuffers::FlatBufferBuilder &builder, NDArray &array, int alignment = 0);
         };
     }
 }
@@ -34,6 +34,7 @@
 #include <graph/generated/graph_generated.h>
 #include <graph/generated/config_generated.h>
 #include <graph/ExecutorConfiguration.h>
+#include <graph/MappedFile.h>
 #include <ops/declarable/OpDescriptor.h>
 
 namespace nd4j {
@@ -58,6 +59,10 @@ namespace nd4j {
 
             std::mutex _mutexPreprocessing;
             std::atomic<bool> _built;
+            std::atomic<bool> _optimized;
+
+            // results of nodes removed by constant folding, owned by graph
+            std::map<std::pair<int, int>, NDArray*> _folded;
 
             std::vector<int> _output;
             std::vector<int> _autos;
@@ -66,6 +71,9 @@ namespace nd4j {
             std::map<int, Scope*> _mappedScopes;
             std::vector<Scope*> _scopes;
 
+            // mapped FlatBuffers file, variables imported with zero copy reference its memory
+            MappedFile *_mappedFile = nullptr;
+
 ////////////////////////////////////////
             Nd4jStatus validateNode(nd4j::graph::Node *node);
 
@@ -80,7 +88,11 @@ namespace nd4j {
             void prepareOutputs();
 
         public:
-            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr);
+            /**
+             * If mappedFile is provided, flatGraph is expected to live within it: variables are imported without copying where possible,
+             * and Graph takes ownership of the mapping
+             */
+            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr, MappedFile *mappedFile = nullptr);
 
             ~Graph();
 
@@ -145,6 +157,13 @@ namespace nd4j {
              */
             ExecutorConfiguration *getExecutorConfiguration();
 
+            /**
+             * This method returns mapped FlatBuffers file this graph was imported from, or nullptr if graph was imported with copying
+             *
+             * @return
+             */
+            MappedFile *getMappedFile();
+
             /**
              * This method adds specified node (by ID) to de
              * @param id
@@ -209,6 +228,33 @@ namespace nd4j {
              */
             bool hasNode(int nodeId);
 
+            /**
+             * This method removes Node with given ID from the structured representation of the graph and releases it.
+             * Variables produced by this Node are kept within VariableSpace
+             * @param nodeId
+             */
+            void removeNode(int nodeId);
+
+            /**
+             * This method puts given Node to the place of existing Node with the same ID, and releases original one
+             * @param node
+             */
+            void replaceNode(Node *node);
+
+            /**
+             * This method stores copy of array as folded constant, i.e. result of Node removed by constant folding.
+             * Folded constants belong to the graph, so they survive clone() and cloneWithProxy()
+             * @param id
+             * @param array
+             */
+            void addFoldedConstant(const std::pair<int, int> &id, const NDArray &array);
+
+            /**
+             * This method puts folded constants missing in given VariableSpace into it
+             * @param variableSpace
+             */
+            void injectFoldedConstants(VariableSpace *variableSpace);
+
             /**
              * This method returns hash of given Graph instance
              */
@@ -241,6 +287,14 @@ namespace nd4j {
                 return _built.load();
             }
 
+            FORCEINLINE bool optimized() {
+                return _optimized.load();
+            }
+
+            FORCEINLINE void markOptimized(bool reallyOptimized) {
+                _optimized.store(reallyOptimized);
+            }
+
             FORCEINLINE void pullState(Graph *other) {
                 for (int e = 0; e < other->nodes()->size(); e++)
                     this->_nodes->emplace_back(other->nodes()->at(e));
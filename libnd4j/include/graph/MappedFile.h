@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Read-only memory mapping of a file, used for zero-copy graph import
+//
+
+#ifndef LIBND4J_MAPPEDFILE_H
+#define LIBND4J_MAPPEDFILE_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <cstddef>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * File is mapped copy-on-write: pages are read from disk lazily on first access,
+         * and writes (i.e. in-place ops on constants) never reach the file
+         */
+        class ND4J_EXPORT MappedFile {
+        private:
+            void *_data = nullptr;
+            size_t _size = 0;
+#if defined(_WIN32) || defined(_WIN64)
+            void *_mapping = nullptr;
+#endif
+
+        public:
+            /**
+             * Throws std::runtime_error if file can't be opened or mapped
+             */
+            explicit MappedFile(const char *fileName);
+            ~MappedFile();
+
+            MappedFile(const MappedFile &other) = delete;
+            MappedFile& operator=(const MappedFile &other) = delete;
+
+            uint8_t* data() const;
+            size_t size() const;
+
+            /**
+             * This method returns TRUE if given pointer points into this mapping
+             */
+            bool contains(const void *ptr) const;
+        };
+    }
+}
+
+#endif //LIBND4J_MAPPEDFILE_H
@@ -44,6 +44,7 @@ namespace nd4j {
             bool _readOnly = false;
             bool _placeholder = false;
             bool _removable = true;
+            bool _constant = false;
 
             // for now we're setting default to numeric
             // in future we'll be fetching it right from the array, 
@@ -58,7 +59,10 @@ namespace nd4j {
             Variable(bool placeHolder);
             Variable(nd4j::NDArray *arrayw, const char *name, int id, int idx = 0);
             Variable(nd4j::NDArray *array = nullptr, const char *name = nullptr);
-            Variable(const nd4j::graph::FlatVariable *flatVariable);
+            /**
+             * If zeroCopy is TRUE, arrays may reference FlatBuffer memory directly, see FlatUtils::fromFlatArray
+             */
+            Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy = false);
             ~Variable();
 
             Variable* clone();
@@ -78,6 +82,7 @@ namespace nd4j {
             bool isReadOnly();
             bool isEmpty();
             bool isRemovable();
+            bool isConstant();
 
             bool isPlaceholder();
 
@@ -94,6 +99,7 @@ namespace nd4j {
             void markExternal(bool reallyExternal);
             void markReadOnly(bool reallyReadOnly);
             void markRemovable(bool reallyRemovable);
+            void markConstant(bool reallyConstant);
 
             int id();
             int index();
@@ -134,6 +134,14 @@ namespace nd4j {
             return !(_fastpath_in.empty() && _fastpath_out.empty());
         }
 
+        void Context::allowViewOutputs(bool reallyAllow) {
+            _viewOutputs = reallyAllow;
+        }
+
+        bool Context::isViewOutputsAllowed() {
+            return _viewOutputs;
+        }
+
         VariableSpace *Context::getVariableSpace() {
             return _variableSpace;
         }
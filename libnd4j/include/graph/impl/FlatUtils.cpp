@@ -36,7 +36,7 @@ namespace nd4j {
             return std::pair<Nd4jLong, Nd4jLong>(pair->first(), pair->second());
         }
 
-        NDArray* FlatUtils::fromFlatArray(const nd4j::graph::FlatArray *flatArray) {
+        NDArray* FlatUtils::fromFlatArray(const nd4j::graph::FlatArray *flatArray, bool zeroCopy) {
             auto rank = static_cast<int>(flatArray->shape()->Get(0));
             auto newShape = new Nd4jLong[shape::shapeInfoLength(rank)];
             memcpy(newShape, flatArray->shape()->data(), shape::shapeInfoByteLength(rank));
@@ -92,6 +92,19 @@ namespace nd4j {
                 return NDArrayFactory::string_(order, shapeVector, substrings);
             }
 
+            auto payload = (void *)flatArray->buffer()->data();
+            bool isBe = BitwiseUtils::isBE();
+            bool nativeOrder = (isBe && flatArray->byteOrder() == nd4j::graph::ByteOrder_BE) || (!isBe && flatArray->byteOrder() == nd4j::graph::ByteOrder_LE);
+            bool aligned = reinterpret_cast<Nd4jLong>(payload) % DataTypeUtils::sizeOf(dtype) == 0;
+
+            // data is used right where it is, i.e. within mapped file. Buffer doesn't own it
+            if (zeroCopy && nativeOrder && aligned && flatArray->buffer()->size() >= length * DataTypeUtils::sizeOf(dtype)) {
+                auto buffer = std::make_shared<DataBuffer>(payload, length * DataTypeUtils::sizeOf(dtype), dtype, false);
+                auto array = new NDArray(buffer, ShapeDescriptor(newShape, dtype));
+
+                delete[] newShape;
+                return array;
+            }
 
             auto newBuffer = new int8_t[length * DataTypeUtils::sizeOf(dtype)];
 
@@ -103,9 +116,12 @@ namespace nd4j {
             return array;
         }
 
-        flatbuffers::Offset<FlatArray> FlatUtils::toFlatArray(flatbuffers::FlatBufferBuilder &builder, NDArray &array) {
+        flatbuffers::Offset<FlatArray> FlatUtils::toFlatArray(flatbuffers::FlatBufferBuilder &builder, NDArray &array, int alignment) {
             auto byteVector = array.asByteVector();
 
+            if (alignment > 0)
+                builder.ForceVectorAlignment(byteVector.size(), sizeof(int8_t), alignment);
+
             auto fBuffer = builder.CreateVector(byteVector);
             auto fShape = builder.CreateVector(array.getShapeInfoAsFlatVector());
 
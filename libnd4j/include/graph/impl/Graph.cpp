@@ -225,6 +225,10 @@ namespace nd4j {
             return _configuration;
         }
 
+        MappedFile * Graph::getMappedFile() {
+            return _mappedFile;
+        }
+
         std::vector<Variable *> * Graph::fetchOutputs() {
             auto res = new std::vector<Variable *>();
 
@@ -298,11 +302,17 @@ namespace nd4j {
             for (auto v: _scopes)
                 delete v;
 
+            for (auto &v: _folded)
+                delete v.second;
+
             delete _mapped;
             delete _nodes;
             delete _variableSpace;
             delete _onion;
             delete _configuration;
+
+            // arrays referencing mapped memory are gone by now
+            delete _mappedFile;
         }
 
         void Graph::addNode(Node *node) {
@@ -751,9 +761,10 @@ namespace nd4j {
                 Node* node = _mapped->at(v);
                 
                 /**
-                 * Node can be inplace if 2 requirements met:
+                 * Node can be inplace if 3 requirements met:
                  * 1) current node allows in-place modification
                  * 2) source node has only 1 output
+                 * 3) source node doesn't publish views
                  */                
 
                 // checking for first requirement first
@@ -774,6 +785,12 @@ namespace nd4j {
                                 singleInput = false;
                                 break;
                             }
+
+                            // checking for third requirement: output of inputNode might be a view of some other array, so it can't be overwritten
+                            if (inode->getCustomOp() != nullptr && inode->getCustomOp()->hasViewOutputs()) {
+                                singleInput = false;
+                                break;
+                            }
                         }
 
                         node->markInplace(singleInput);
@@ -864,12 +881,13 @@ namespace nd4j {
             }
         }
 
-        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace) {
+        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace, MappedFile *mappedFile) {
             this->_onion = new std::map<int, std::vector<Node *> *>();
             this->_mapped = new std::map<int, Node *> ();
             this->_nodes = new std::vector<int>();
             this->_variableSpace = variableSpace == nullptr ? new VariableSpace() : variableSpace;
             bool trusted = flatGraph != nullptr;
+            this->_optimized.store(false);
 
             // add 0 layer
             this->expandOnion(0);
@@ -891,7 +909,7 @@ namespace nd4j {
                 for (unsigned int e = 0; e < flatGraph->variables()->size(); e++) {
                     auto flatVar = flatGraph->variables()->Get(e);
 
-                    auto var = new Variable(flatVar);
+                    auto var = new Variable(flatVar, mappedFile != nullptr);
                     std::pair<int, int> pair(flatVar->id()->first(), flatVar->id()->second());
                     _variableSpace->putVariable(pair, var);
 
@@ -955,6 +973,9 @@ namespace nd4j {
              */
             if (_configuration->_direction == Direction_FORWARD_ONLY && _configuration->_outputMode == OutputMode_OPTIMIZED)
                 this->tagInplaceNodes();
+
+            // ownership is taken only once graph was built successfully, caller cleans up otherwise
+            _mappedFile = mappedFile;
         }
 
 
@@ -1293,6 +1314,12 @@ namespace nd4j {
             for (auto v: _autos)
                 clone->_autos.emplace_back(v);
 
+            // nodes are cloned as optimized already, so folded constants go along with them
+            for (auto &v: _folded)
+                clone->_folded[v.first] = v.second->dup();
+
+            clone->_optimized.store(_optimized.load());
+
             // transfer scopes
             for (auto &v: _mappedScopes) {
                 auto scp = v.second->clone();
@@ -1344,6 +1371,12 @@ namespace nd4j {
             for (auto v: _autos)
                 clone->_autos.emplace_back(v);
 
+            // nodes are cloned as optimized already, so folded constants go along with them
+            for (auto &v: _folded)
+                clone->_folded[v.first] = v.second->dup();
+
+            clone->_optimized.store(_optimized.load());
+
             // transfer scopes
             for (auto &v: _mappedScopes) {
                 auto scp = v.second->clone();
@@ -1386,6 +1419,58 @@ namespace nd4j {
             return _mapped->at(id);
         }
 
+        void Graph::removeNode(int nodeId) {
+            if (_mapped->count(nodeId) == 0)
+                throw graph_exception("Can't remove unmapped node", nodeId);
+
+            auto node = _mapped->at(nodeId);
+            if (_onion->count(node->getLayer()) > 0) {
+                auto layer = _onion->at(node->getLayer());
+                layer->erase(std::remove(layer->begin(), layer->end(), node), layer->end());
+            }
+
+            _mapped->erase(nodeId);
+            _nodes->erase(std::remove(_nodes->begin(), _nodes->end(), nodeId), _nodes->end());
+            _handles.erase(std::remove(_handles.begin(), _handles.end(), node), _handles.end());
+
+            delete node;
+        }
+
+        void Graph::replaceNode(Node *node) {
+            if (_mapped->count(node->id()) == 0)
+                throw graph_exception("Can't replace unmapped node", node->id());
+
+            auto original = _mapped->at(node->id());
+            node->setLayer(original->getLayer());
+
+            if (_onion->count(original->getLayer()) > 0)
+                std::replace(_onion->at(original->getLayer())->begin(), _onion->at(original->getLayer())->end(), original, node);
+
+            std::replace(_handles.begin(), _handles.end(), original, node);
+            (*_mapped)[node->id()] = node;
+
+            delete original;
+        }
+
+        void Graph::addFoldedConstant(const std::pair<int, int> &id, const NDArray &array) {
+            if (_folded.count(id) > 0)
+                delete _folded[id];
+
+            _folded[id] = array.dup();
+        }
+
+        void Graph::injectFoldedConstants(VariableSpace *variableSpace) {
+            for (auto &v: _folded) {
+                auto id = v.first;
+                if (variableSpace->hasVariable(id))
+                    continue;
+
+                auto var = new Variable(v.second->dup(), nullptr, id.first, id.second);
+                var->markConstant(true);
+                variableSpace->putVariable(id, var);
+            }
+        }
+
         bool Graph::hasScope(int id) {
             return _mappedScopes.count(id) > 0;
         }
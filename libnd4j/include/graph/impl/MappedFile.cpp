@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/MappedFile.h>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace nd4j {
+    namespace graph {
+        MappedFile::MappedFile(const char *fileName) {
+#if defined(_WIN32) || defined(_WIN64)
+            auto file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                throw std::runtime_error("Unable to open file: " + std::string(fileName));
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+                CloseHandle(file);
+                throw std::runtime_error("Unable to map empty file: " + std::string(fileName));
+            }
+
+            _size = static_cast<size_t>(size.QuadPart);
+            _mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+            CloseHandle(file);
+
+            if (_mapping == nullptr)
+                throw std::runtime_error("Unable to map file: " + std::string(fileName));
+
+            _data = MapViewOfFile(_mapping, FILE_MAP_COPY, 0, 0, 0);
+            if (_data == nullptr) {
+                CloseHandle(_mapping);
+                throw std::runtime_error("Unable to map file: " + std::string(fileName));
+            }
+#else
+            auto fd = open(fileName, O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error("Unable to open file: " + std::string(fileName));
+
+            struct stat st;
+            if (fstat(fd, &st) != 0 || st.st_size == 0) {
+                close(fd);
+                throw std::runtime_error("Unable to map empty file: " + std::string(fileName));
+            }
+
+            _size = static_cast<size_t>(st.st_size);
+
+            // private mapping is still valid after descriptor is closed
+            auto ptr = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            close(fd);
+
+            if (ptr == MAP_FAILED)
+                throw std::runtime_error("Unable to map file: " + std::string(fileName));
+
+            _data = ptr;
+#endif
+        }
+
+        MappedFile::~MappedFile() {
+#if defined(_WIN32) || defined(_WIN64)
+            if (_data != nullptr)
+                UnmapViewOfFile(_data);
+
+            if (_mapping != nullptr)
+                CloseHandle(_mapping);
+#else
+            if (_data != nullptr)
+                munmap(_data, _size);
+#endif
+        }
+
+        uint8_t* MappedFile::data() const {
+            return reinterpret_cast<uint8_t *>(_data);
+        }
+
+        size_t MappedFile::size() const {
+            return _size;
+        }
+
+        bool MappedFile::contains(const void *ptr) const {
+            auto p = reinterpret_cast<const uint8_t *>(ptr);
+            return p >= data() && p < data() + _size;
+        }
+    }
+}
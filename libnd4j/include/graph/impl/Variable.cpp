@@ -36,6 +36,7 @@ namespace nd4j {
             result->markExternal(this->_external);
             result->setId(this->_id);
             result->markReadOnly(this->_readOnly);
+            result->markConstant(this->_constant);
             result->setName(&this->_name);
             result->setIndex(this->_index);
 
@@ -57,6 +58,7 @@ namespace nd4j {
             result->_external = this->_external;
             result->_id = this->_id;
             result->_readOnly = this->_readOnly;
+            result->_constant = this->_constant;
             result->_name = this->_name;
             result->_index = this->_index;
 
@@ -140,6 +142,14 @@ namespace nd4j {
             this->_readOnly = reallyReadOnly;
         }
 
+        bool nd4j::graph::Variable::isConstant() {
+            return _constant;
+        }
+
+        void nd4j::graph::Variable::markConstant(bool reallyConstant) {
+            this->_constant = reallyConstant;
+        }
+
         nd4j::NDArray * nd4j::graph::Variable::getNDArray() {
             if (_variableType != VariableType::NDARRAY) {
                 nd4j_printf("Variable[%i:%i/<%s>] is has [%s] type, but NDArray was requested\n", this->_id, this->_index, this->_name.c_str(), EnumUtils::_VariableTypeToString(_variableType));
@@ -189,7 +199,7 @@ namespace nd4j {
         }
 
 
-        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable) {
+        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy) {
             auto vid = flatVariable->id();
             this->_id = vid->first();
             this->_index = vid->second();
@@ -208,7 +218,7 @@ namespace nd4j {
                         // ?????
                         if (flatVariable->ndarray() != nullptr) {
                             auto ar = flatVariable->ndarray();
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar, zeroCopy);
                         }
 
                         _variableType = VariableType::NDARRAY;
@@ -220,12 +230,13 @@ namespace nd4j {
 
                         auto ar = flatVariable->ndarray();
                         if (ar->dtype() == DType_UTF8) {
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar, zeroCopy);
                         } else {
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar, zeroCopy);
                         }
 
                         _variableType = VariableType::NDARRAY;
+                        _constant = true;
                     }
                     break;
                 case VarType_ARRAY: {
@@ -233,7 +244,7 @@ namespace nd4j {
                         // ?????
                         if (flatVariable->ndarray() != nullptr) {
                             auto ar = flatVariable->ndarray();
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar, zeroCopy);
                             // _ndarray->triggerAllocationFlag(true);
                         }
 
@@ -246,7 +257,7 @@ namespace nd4j {
 
                         if (flatVariable->ndarray() != nullptr) {
                             auto ar = flatVariable->ndarray();
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar, zeroCopy);
                             // _ndarray->triggerAllocationFlag(true);
 
                             _variableType = VariableType::NDARRAY;
@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Constant folding: nodes fed by constants only are executed once, and their results become constants
+//
+
+#ifndef LIBND4J_CONSTANTFOLDINGPASS_H
+#define LIBND4J_CONSTANTFOLDINGPASS_H
+
+#include <graph/optimization/OptimizationPass.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This pass executes nodes, whose inputs are CONSTANT variables or results of other folded nodes, once,
+         * and removes them from the graph. Results are stored within Graph as folded constants, so clones get them too.
+         * Only pure ops (see OpDescriptor::isPure) are folded, and graph outputs are never removed.
+         */
+        class ND4J_EXPORT ConstantFoldingPass : public OptimizationPass {
+        protected:
+            static bool isFoldable(Graph *graph, Node *node);
+
+        public:
+            const char* name() override;
+            bool isApplicable(Graph *graph) override;
+            int apply(Graph *graph, VariableSpace *variableSpace) override;
+        };
+    }
+}
+
+#endif //LIBND4J_CONSTANTFOLDINGPASS_H
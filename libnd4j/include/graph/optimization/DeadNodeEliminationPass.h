@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Dead node elimination: nodes that do not contribute to graph outputs are removed
+//
+
+#ifndef LIBND4J_DEADNODEELIMINATIONPASS_H
+#define LIBND4J_DEADNODEELIMINATIONPASS_H
+
+#include <graph/optimization/OptimizationPass.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This pass removes nodes, that do not contribute to graph outputs. Outputs are explicit outputs if defined, auto outputs otherwise.
+         * Applied in OutputMode_OPTIMIZED only, since intermediate results are dropped
+         */
+        class ND4J_EXPORT DeadNodeEliminationPass : public OptimizationPass {
+        public:
+            const char* name() override;
+            bool isApplicable(Graph *graph) override;
+            int apply(Graph *graph, VariableSpace *variableSpace) override;
+        };
+    }
+}
+
+#endif //LIBND4J_DEADNODEELIMINATIONPASS_H
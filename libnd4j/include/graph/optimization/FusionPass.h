@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Op fusion: matmul + bias_add into xw_plus_b, elementwise chains into fused_elementwise, and in-place execution of what's left
+//
+
+#ifndef LIBND4J_FUSIONPASS_H
+#define LIBND4J_FUSIONPASS_H
+
+#include <graph/optimization/OptimizationPass.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This pass merges matmul -> biasadd pairs into single xw_plus_b node, replaces chains of up to MAX_CHAIN single-consumer
+         * elementwise nodes (legacy transform/scalar/pairwise ops, relu, sigmoid, tanh, biasadd) with fused_elementwise nodes,
+         * and marks chains of single-consumer in-place capable ops (i.e. xw_plus_b -> relu) for in-place execution, so each chain reuses one buffer.
+         * Applied in OutputMode_OPTIMIZED only, since intermediate results are dropped
+         */
+        class ND4J_EXPORT FusionPass : public OptimizationPass {
+        protected:
+            static const int MAX_CHAIN = 8;
+
+            /**
+             * This method describes node as fused_elementwise step: 4 integer arguments, T arguments and operand, if any.
+             * Returns FALSE if node can't be fused
+             */
+            static bool asFusedStep(Node *node, std::vector<int> &step, std::vector<double> &tArgs, std::pair<int, int> &operand);
+
+            static int fuseMatmulBias(Graph *graph, VariableSpace *variableSpace);
+            static int fuseElementwiseOps(Graph *graph);
+            static int fuseElementwiseChains(Graph *graph);
+
+        public:
+            const char* name() override;
+            bool isApplicable(Graph *graph) override;
+            int apply(Graph *graph, VariableSpace *variableSpace) override;
+        };
+    }
+}
+
+#endif //LIBND4J_FUSIONPASS_H
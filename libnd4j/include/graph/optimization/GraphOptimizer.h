@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Pluggable pipeline of Graph rewrite passes
+//
+
+#ifndef LIBND4J_GRAPHOPTIMIZER_H
+#define LIBND4J_GRAPHOPTIMIZER_H
+
+#include <graph/optimization/OptimizationPass.h>
+#include <string>
+#include <vector>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class holds statistics of a single pass invocation
+         */
+        class ND4J_EXPORT PassStatistics {
+        private:
+            std::string _name;
+            int _affected;
+            int _nodesBefore;
+            int _nodesAfter;
+            Nd4jLong _time;
+
+        public:
+            PassStatistics(const char *name, int affected, int nodesBefore, int nodesAfter, Nd4jLong time);
+            ~PassStatistics() = default;
+
+            const std::string& name() const;
+
+            // number of nodes affected by the pass
+            int affected() const;
+            int nodesBefore() const;
+            int nodesAfter() const;
+
+            // pass time, in nanoseconds
+            Nd4jLong time() const;
+        };
+
+        /**
+         * This class applies OptimizationPasses to the structured (built) Graph, in order of addition.
+         * Default pipeline is: constant folding, algebraic simplification, fusion, dead node elimination.
+         * Constant folding is always applied, other passes change intermediate results of the graph, so they're applied in OutputMode_OPTIMIZED only
+         */
+        class ND4J_EXPORT GraphOptimizer {
+        protected:
+            std::vector<OptimizationPass*> _passes;
+            std::vector<PassStatistics> _statistics;
+
+        public:
+            explicit GraphOptimizer(bool defaultPipeline = true);
+            ~GraphOptimizer();
+
+            /**
+             * This method appends pass to the pipeline. GraphOptimizer takes ownership of the pass
+             */
+            void addPass(OptimizationPass *pass);
+
+            /**
+             * This method applies all applicable passes to the given graph, and marks graph as optimized
+             * @param graph
+             * @param variableSpace - VariableSpace used for constant folding. Graph VariableSpace is used if nullptr
+             */
+            Nd4jStatus optimize(Graph *graph, VariableSpace *variableSpace = nullptr);
+
+            /**
+             * This method returns statistics of all passes applied during last optimize() call
+             */
+            std::vector<PassStatistics>& statistics();
+
+            void printOut();
+        };
+    }
+}
+
+#endif //LIBND4J_GRAPHOPTIMIZER_H
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Base class for Graph rewrite passes used by GraphOptimizer
+//
+
+#ifndef LIBND4J_OPTIMIZATIONPASS_H
+#define LIBND4J_OPTIMIZATIONPASS_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <graph/Node.h>
+#include <graph/Graph.h>
+#include <graph/VariableSpace.h>
+#include <vector>
+
+namespace nd4j {
+    namespace graph {
+        class ND4J_EXPORT OptimizationPass {
+        protected:
+            /**
+             * This method returns mapped nodes that use any output of the given node as input
+             */
+            static std::vector<Node*> consumersOf(Graph *graph, int nodeId);
+
+            /**
+             * This method returns TRUE if results of the given node are visible outside of the graph:
+             * explicit/auto outputs, or propagation to external variables
+             */
+            static bool isGraphOutput(Graph *graph, Node *node);
+
+            /**
+             * This method replaces input "from" with input "to" in both Node and its ContextPrototype
+             */
+            static void rewireInput(Node *node, const std::pair<int, int> &from, const std::pair<int, int> &to);
+
+            /**
+             * This method returns TRUE if node holds CustomOp with given name
+             */
+            static bool isOp(Node *node, const char *opName);
+
+            /**
+             * This method returns TRUE if node can be touched by rewrites: no logic, scopes, embedded graphs or divergence
+             */
+            static bool isRegular(Node *node);
+
+        public:
+            virtual ~OptimizationPass() = default;
+
+            /**
+             * This method returns human-readable name of the pass, used in statistics
+             */
+            virtual const char* name() = 0;
+
+            /**
+             * This method returns TRUE if pass can be applied to the given graph under its ExecutorConfiguration
+             */
+            virtual bool isApplicable(Graph *graph);
+
+            /**
+             * This method applies pass to the graph
+             * @return number of affected nodes
+             */
+            virtual int apply(Graph *graph, VariableSpace *variableSpace) = 0;
+        };
+    }
+}
+
+#endif //LIBND4J_OPTIMIZATIONPASS_H
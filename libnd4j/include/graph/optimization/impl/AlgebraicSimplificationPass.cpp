@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/optimization/AlgebraicSimplificationPass.h>
+
+namespace nd4j {
+    namespace graph {
+        static char reshapeOrder(Node *node) {
+            auto arguments = node->getContextPrototype()->getIArguments();
+            if (!arguments->empty()) {
+                auto order = (char) -arguments->at(0);
+                if (order == 'c' || order == 'f')
+                    return order;
+            }
+
+            return 'c';
+        }
+
+        const char* AlgebraicSimplificationPass::name() {
+            return "algebraic_simplification";
+        }
+
+        bool AlgebraicSimplificationPass::isApplicable(Graph *graph) {
+            return graph->getExecutorConfiguration()->_outputMode == OutputMode_OPTIMIZED;
+        }
+
+        int AlgebraicSimplificationPass::eliminateIdentities(Graph *graph) {
+            std::vector<int> removed;
+
+            for (auto &v: *graph->getMapped()) {
+                auto node = v.second;
+                if (!isRegular(node) || !isOp(node, "identity") || node->input()->size() != 1 || isGraphOutput(graph, node))
+                    continue;
+
+                // consumers of identity are fed by its input directly
+                std::pair<int, int> from(node->id(), 0);
+                auto to = node->input()->at(0);
+                for (auto consumer: consumersOf(graph, node->id()))
+                    rewireInput(consumer, from, to);
+
+                removed.emplace_back(node->id());
+            }
+
+            for (auto id: removed)
+                graph->removeNode(id);
+
+            return (int) removed.size();
+        }
+
+        int AlgebraicSimplificationPass::collapseReshapes(Graph *graph) {
+            int cnt = 0;
+            std::vector<int> removed;
+
+            for (auto &v: *graph->getMapped()) {
+                auto node = v.second;
+                if (!isRegular(node) || !isOp(node, "reshape") || node->input()->empty())
+                    continue;
+
+                auto from = node->input()->at(0);
+                if (from.second != 0 || !graph->hasNode(from.first))
+                    continue;
+
+                // reshape(reshape(x)) == reshape(x), as long as both reshapes use the same order
+                auto inner = graph->nodeById(from.first);
+                if (!isRegular(inner) || !isOp(inner, "reshape") || inner->input()->empty() || reshapeOrder(inner) != reshapeOrder(node))
+                    continue;
+
+                rewireInput(node, from, inner->input()->at(0));
+                cnt++;
+
+                if (consumersOf(graph, inner->id()).empty() && !isGraphOutput(graph, inner))
+                    removed.emplace_back(inner->id());
+            }
+
+            for (auto id: removed)
+                graph->removeNode(id);
+
+            return cnt + (int) removed.size();
+        }
+
+        int AlgebraicSimplificationPass::apply(Graph *graph, VariableSpace *variableSpace) {
+            return eliminateIdentities(graph) + collapseReshapes(graph);
+        }
+    }
+}
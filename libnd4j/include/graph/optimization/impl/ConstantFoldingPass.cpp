@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/optimization/ConstantFoldingPass.h>
+#include <ops/declarable/DeclarableOp.h>
+#include <GraphExecutioner.h>
+#include <set>
+
+namespace nd4j {
+    namespace graph {
+        const char* ConstantFoldingPass::name() {
+            return "constant_folding";
+        }
+
+        bool ConstantFoldingPass::isApplicable(Graph *graph) {
+            return graph->getExecutorConfiguration()->_outputMode == OutputMode_OPTIMIZED;
+        }
+
+        bool ConstantFoldingPass::isFoldable(Graph *graph, Node *node) {
+            if (!isRegular(node) || node->opType() == OpType_RANDOM || node->input()->empty())
+                return false;
+
+            // removed node can't be fetched as output anymore
+            if (isGraphOutput(graph, node))
+                return false;
+
+            return node->getCustomOp()->isPure();
+        }
+
+        int ConstantFoldingPass::apply(Graph *graph, VariableSpace *variableSpace) {
+            std::set<int> folded;
+            std::vector<int> order;
+
+            for (int l = 0; l < (int) graph->getOnion()->size(); l++) {
+                if (graph->getOnion()->count(l) == 0)
+                    continue;
+
+                for (auto node: *graph->getOnion()->at(l)) {
+                    if (!isFoldable(graph, node))
+                        continue;
+
+                    bool constOnly = true;
+                    for (auto &in: *node->input()) {
+                        if (folded.count(in.first) > 0)
+                            continue;
+
+                        if (in.first < 0 && variableSpace->hasVariable(in)) {
+                            auto var = variableSpace->getVariable(in);
+                            if (var->isConstant() && var->hasNDArray())
+                                continue;
+                        }
+
+                        constOnly = false;
+                        break;
+                    }
+
+                    if (!constOnly)
+                        continue;
+
+                    // if something goes wrong here - node just stays in the graph, and will fail (or not) during real execution
+                    Nd4jStatus status;
+                    try {
+                        status = GraphExecutioner::executeFlatNode(graph, node, variableSpace);
+                    } catch (std::exception &e) {
+                        nd4j_debug("Constant folding failed for Node_%i: %s\n", node->id(), e.what());
+                        continue;
+                    }
+
+                    if (status != Status::OK())
+                        continue;
+
+                    for (int e = 0; variableSpace->hasVariable(node->id(), e); e++) {
+                        auto var = variableSpace->getVariable(node->id(), e);
+                        var->markConstant(true);
+
+                        if (var->hasNDArray())
+                            graph->addFoldedConstant(std::pair<int, int>(node->id(), e), *var->getNDArray());
+                    }
+
+                    folded.insert(node->id());
+                    order.emplace_back(node->id());
+                }
+            }
+
+            for (auto id: order)
+                graph->removeNode(id);
+
+            return (int) order.size();
+        }
+    }
+}
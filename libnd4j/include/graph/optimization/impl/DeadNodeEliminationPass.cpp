@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/optimization/DeadNodeEliminationPass.h>
+#include <deque>
+#include <set>
+
+namespace nd4j {
+    namespace graph {
+        const char* DeadNodeEliminationPass::name() {
+            return "dead_node_elimination";
+        }
+
+        bool DeadNodeEliminationPass::isApplicable(Graph *graph) {
+            return graph->getExecutorConfiguration()->_outputMode == OutputMode_OPTIMIZED;
+        }
+
+        int DeadNodeEliminationPass::apply(Graph *graph, VariableSpace *variableSpace) {
+            std::set<int> live;
+            std::deque<int> queue;
+
+            // explicit outputs have priority over auto outputs. irregular nodes are always kept
+            auto roots = graph->output()->empty() ? graph->autos() : graph->output();
+            if (roots->empty())
+                return 0;
+
+            for (auto &v: *graph->getMapped()) {
+                auto node = v.second;
+                if (!isRegular(node) || node->hasExternalOutputs() || std::find(roots->begin(), roots->end(), node->id()) != roots->end()) {
+                    live.insert(node->id());
+                    queue.emplace_back(node->id());
+                }
+            }
+
+            // everything reachable from live nodes through inputs is live as well
+            while (!queue.empty()) {
+                auto node = graph->nodeById(queue.front());
+                queue.pop_front();
+
+                for (auto &in: *node->input()) {
+                    if (graph->hasNode(in.first) && live.count(in.first) == 0) {
+                        live.insert(in.first);
+                        queue.emplace_back(in.first);
+                    }
+                }
+            }
+
+            std::vector<int> removed;
+            for (auto &v: *graph->getMapped())
+                if (live.count(v.first) == 0)
+                    removed.emplace_back(v.first);
+
+            for (auto id: removed)
+                graph->removeNode(id);
+
+            return (int) removed.size();
+        }
+    }
+}
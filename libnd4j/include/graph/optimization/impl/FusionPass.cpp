@@ -0,0 +1,310 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/optimization/FusionPass.h>
+#include <ops/declarable/OpRegistrator.h>
+#include <loops/fused_chain.h>
+#include <op_enums.h>
+#include <algorithm>
+
+namespace nd4j {
+    namespace graph {
+        const char* FusionPass::name() {
+            return "fusion";
+        }
+
+        bool FusionPass::isApplicable(Graph *graph) {
+            return graph->getExecutorConfiguration()->_outputMode == OutputMode_OPTIMIZED;
+        }
+
+        // rank of variable that is available before execution: from array, or from placeholder shape. -1 if unknown
+        static int knownRank(VariableSpace *variableSpace, std::pair<int, int> &id) {
+            if (!variableSpace->hasVariable(id))
+                return -1;
+
+            auto var = variableSpace->getVariable(id);
+            if (var->hasNDArray())
+                return var->getNDArray()->rankOf();
+
+            if (var->isPlaceholder() && !var->shape().empty())
+                return (int) var->shape().size();
+
+            return -1;
+        }
+
+        int FusionPass::fuseMatmulBias(Graph *graph, VariableSpace *variableSpace) {
+            auto xwOp = nd4j::ops::OpRegistrator::getInstance()->getOperation("xw_plus_b");
+            if (xwOp == nullptr)
+                return 0;
+
+            std::vector<Node*> fused;
+            std::vector<int> removed;
+
+            for (auto &v: *graph->getMapped()) {
+                auto bias = v.second;
+                if (!isRegular(bias) || !isOp(bias, "biasadd") || bias->input()->size() != 2 || !bias->getContextPrototype()->getBArguments()->empty())
+                    continue;
+
+                auto mmulId = bias->input()->at(0);
+                if (mmulId.second != 0 || !graph->hasNode(mmulId.first))
+                    continue;
+
+                auto mmul = graph->nodeById(mmulId.first);
+                if (!isRegular(mmul) || !isOp(mmul, "matmul") || mmul->input()->size() != 2 || isGraphOutput(graph, mmul) || consumersOf(graph, mmul->id()).size() != 1)
+                    continue;
+
+                // transposed operands are not supported by xw_plus_b
+                bool transposed = false;
+                for (auto t: *mmul->getContextPrototype()->getIArguments())
+                    transposed |= t != 0;
+
+                if (transposed)
+                    continue;
+
+                // xw_plus_b is 2D only, so both operand ranks have to be known in advance
+                auto x = mmul->input()->at(0);
+                auto w = mmul->input()->at(1);
+                if (knownRank(variableSpace, x) != 2 || knownRank(variableSpace, w) != 2)
+                    continue;
+
+                auto node = new Node(xwOp, bias->id());
+                if (bias->getName() != nullptr)
+                    node->setName(bias->getName());
+
+                for (auto in: {mmul->input()->at(0), w, bias->input()->at(1)}) {
+                    node->pickInput(in);
+                    node->getContextPrototype()->pickInput(in);
+                }
+
+                for (auto out: *bias->output())
+                    node->pickOutput(out.first, out.second);
+
+                fused.emplace_back(node);
+                removed.emplace_back(mmul->id());
+            }
+
+            for (auto node: fused)
+                graph->replaceNode(node);
+
+            for (auto id: removed)
+                graph->removeNode(id);
+
+            return (int) fused.size();
+        }
+
+        bool FusionPass::asFusedStep(Node *node, std::vector<int> &step, std::vector<double> &tArgs, std::pair<int, int> &operand) {
+            if (!isRegular(node) || node->getContextPrototype() == nullptr || node->input()->empty())
+                return false;
+
+            auto proto = node->getContextPrototype();
+            auto numInputs = node->input()->size();
+            int kind;
+            int opNum = (int) node->opNum();
+
+            tArgs.clear();
+
+            switch (node->opType()) {
+                case OpType_TRANSFORM_SAME:
+                    kind = functions::fused::TRANSFORM_SAME;
+                    break;
+                case OpType_TRANSFORM_STRICT:
+                    kind = functions::fused::TRANSFORM_STRICT;
+                    break;
+                case OpType_SCALAR:
+                    kind = functions::fused::SCALAR;
+                    break;
+                case OpType_PAIRWISE:
+                    kind = functions::fused::PAIRWISE;
+                    break;
+                case OpType_CUSTOM: {
+                        // custom ops with exact legacy counterparts
+                        if (isOp(node, "relu") && numInputs == 1) {
+                            step = {functions::fused::SCALAR, nd4j::scalar::RELU, 0, 1};
+                            tArgs.emplace_back(proto->getTArguments()->empty() ? 0.0 : proto->getTArguments()->at(0));
+                        } else if (isOp(node, "sigmoid") && numInputs == 1) {
+                            step = {functions::fused::TRANSFORM_STRICT, nd4j::transform::Sigmoid, 0, 0};
+                        } else if (isOp(node, "tanh") && numInputs == 1) {
+                            step = {functions::fused::TRANSFORM_STRICT, nd4j::transform::Tanh, 0, 0};
+                        } else if (isOp(node, "biasadd") && numInputs == 2 && (proto->getBArguments()->empty() || !proto->getBArguments()->at(0))) {
+                            // NHWC bias matches last dimension of input, that's exactly what fused pairwise step does with shorter operand
+                            step = {functions::fused::PAIRWISE, nd4j::pairwise::Add, 0, 0};
+                            operand = node->input()->at(1);
+                        } else {
+                            return false;
+                        }
+
+                        return true;
+                    }
+                default:
+                    return false;
+            }
+
+            if (!functions::fused::FusedProgram<float>::isSupported(kind, opNum) || numInputs != (kind == functions::fused::PAIRWISE ? 2 : 1))
+                return false;
+
+            if (kind == functions::fused::PAIRWISE)
+                operand = node->input()->at(1);
+
+            // scalar might be stored in node itself instead of T arguments
+            tArgs = *proto->getTArguments();
+            if (kind == functions::fused::SCALAR && tArgs.empty())
+                tArgs.emplace_back(node->scalar());
+
+            step = {kind, opNum, 0, (int) tArgs.size()};
+            return true;
+        }
+
+        int FusionPass::fuseElementwiseOps(Graph *graph) {
+            auto fusedOp = nd4j::ops::OpRegistrator::getInstance()->getOperation("fused_elementwise");
+            if (fusedOp == nullptr)
+                return 0;
+
+            std::vector<int> step;
+            std::vector<double> tArgs;
+            std::pair<int, int> operand;
+
+            // next extends chain ending at prev, if prev result goes to input 0 of next and nowhere else
+            auto extends = [&] (Node *prev, Node *next) -> bool {
+                if (isGraphOutput(graph, prev))
+                    return false;
+
+                auto consumers = consumersOf(graph, prev->id());
+                if (consumers.size() != 1 || consumers.at(0) != next || next->input()->at(0) != std::pair<int, int>(prev->id(), 0))
+                    return false;
+
+                return std::count_if(next->input()->begin(), next->input()->end(), [&] (const std::pair<int, int> &in) { return in.first == prev->id(); }) == 1;
+            };
+
+            std::vector<std::vector<Node*>> chains;
+            for (auto &v: *graph->getMapped()) {
+                auto node = v.second;
+                if (!asFusedStep(node, step, tArgs, operand))
+                    continue;
+
+                // chains are collected starting from their first node only
+                auto in = node->input()->at(0);
+                if (graph->hasNode(in.first)) {
+                    auto producer = graph->nodeById(in.first);
+                    if (asFusedStep(producer, step, tArgs, operand) && extends(producer, node))
+                        continue;
+                }
+
+                std::vector<Node*> chain({node});
+                while (true) {
+                    auto consumers = consumersOf(graph, chain.back()->id());
+                    if (consumers.size() != 1 || !asFusedStep(consumers.at(0), step, tArgs, operand) || !extends(chain.back(), consumers.at(0)))
+                        break;
+
+                    chain.emplace_back(consumers.at(0));
+                }
+
+                // long chains are split into pieces of MAX_CHAIN nodes
+                for (size_t first = 0; first < chain.size(); first += MAX_CHAIN) {
+                    auto last = nd4j::math::nd4j_min<size_t>(chain.size(), first + MAX_CHAIN);
+                    if (last - first > 1)
+                        chains.emplace_back(chain.begin() + first, chain.begin() + last);
+                }
+            }
+
+            std::vector<Node*> fused;
+            std::vector<int> removed;
+
+            for (auto &chain: chains) {
+                // fused node takes place of the last node, so its consumers stay intact
+                auto last = chain.back();
+                auto node = new Node(fusedOp, last->id());
+                if (last->getName() != nullptr)
+                    node->setName(last->getName());
+
+                auto proto = node->getContextPrototype();
+                std::vector<std::pair<int, int>> inputs({chain.front()->input()->at(0)});
+
+                for (auto n: chain) {
+                    asFusedStep(n, step, tArgs, operand);
+
+                    if (step[0] == functions::fused::PAIRWISE) {
+                        auto position = std::find(inputs.begin() + 1, inputs.end(), operand);
+                        step[2] = (int) (position - inputs.begin());
+
+                        if (position == inputs.end())
+                            inputs.emplace_back(operand);
+                    }
+
+                    proto->getIArguments()->insert(proto->getIArguments()->end(), step.begin(), step.end());
+                    proto->getTArguments()->insert(proto->getTArguments()->end(), tArgs.begin(), tArgs.end());
+
+                    if (n != last)
+                        removed.emplace_back(n->id());
+                }
+
+                for (auto in: inputs) {
+                    node->pickInput(in);
+                    proto->pickInput(in);
+                }
+
+                for (auto out: *last->output())
+                    node->pickOutput(out.first, out.second);
+
+                fused.emplace_back(node);
+            }
+
+            for (auto node: fused)
+                graph->replaceNode(node);
+
+            for (auto id: removed)
+                graph->removeNode(id);
+
+            return (int) fused.size();
+        }
+
+        int FusionPass::fuseElementwiseChains(Graph *graph) {
+            int cnt = 0;
+
+            for (auto &v: *graph->getMapped()) {
+                auto node = v.second;
+                if (node->isInplace() || !isRegular(node) || node->input()->size() != 1 || !node->getCustomOp()->getOpDescriptor()->allowsInplace())
+                    continue;
+
+                // in-place execution overwrites producer results, so producer has to be a node with this single consumer
+                auto in = node->input()->at(0);
+                if (in.second != 0 || !graph->hasNode(in.first))
+                    continue;
+
+                auto producer = graph->nodeById(in.first);
+                if (!isRegular(producer) || producer->getCustomOp()->getOpDescriptor()->getNumberOfOutputs() != 1 || isGraphOutput(graph, producer) || consumersOf(graph, producer->id()).size() != 1)
+                    continue;
+
+                // output of producer might be a view of its input, same as in Graph::tagInplaceNodes()
+                if (producer->getCustomOp()->hasViewOutputs())
+                    continue;
+
+                node->markInplace(true);
+                cnt++;
+            }
+
+            return cnt;
+        }
+
+        int FusionPass::apply(Graph *graph, VariableSpace *variableSpace) {
+            int cnt = fuseMatmulBias(graph, variableSpace);
+#ifndef __CUDABLAS__
+            // there's no fused kernel for CUDA, so fused_elementwise would execute the same steps one by one there
+            cnt += fuseElementwiseOps(graph);
+#endif
+            return cnt + fuseElementwiseChains(graph);
+        }
+    }
+}
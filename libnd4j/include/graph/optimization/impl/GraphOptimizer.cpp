@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/optimization/GraphOptimizer.h>
+#include <graph/optimization/ConstantFoldingPass.h>
+#include <graph/optimization/AlgebraicSimplificationPass.h>
+#include <graph/optimization/FusionPass.h>
+#include <graph/optimization/DeadNodeEliminationPass.h>
+#include <graph/profiling/GraphProfile.h>
+#include <helpers/logger.h>
+
+namespace nd4j {
+    namespace graph {
+        PassStatistics::PassStatistics(const char *name, int affected, int nodesBefore, int nodesAfter, Nd4jLong time) {
+            _name = name;
+            _affected = affected;
+            _nodesBefore = nodesBefore;
+            _nodesAfter = nodesAfter;
+            _time = time;
+        }
+
+        const std::string& PassStatistics::name() const {
+            return _name;
+        }
+
+        int PassStatistics::affected() const {
+            return _affected;
+        }
+
+        int PassStatistics::nodesBefore() const {
+            return _nodesBefore;
+        }
+
+        int PassStatistics::nodesAfter() const {
+            return _nodesAfter;
+        }
+
+        Nd4jLong PassStatistics::time() const {
+            return _time;
+        }
+
+        GraphOptimizer::GraphOptimizer(bool defaultPipeline) {
+            if (defaultPipeline) {
+                addPass(new ConstantFoldingPass());
+                addPass(new AlgebraicSimplificationPass());
+                addPass(new FusionPass());
+                addPass(new DeadNodeEliminationPass());
+            }
+        }
+
+        GraphOptimizer::~GraphOptimizer() {
+            for (auto v: _passes)
+                delete v;
+        }
+
+        void GraphOptimizer::addPass(OptimizationPass *pass) {
+            _passes.emplace_back(pass);
+        }
+
+        Nd4jStatus GraphOptimizer::optimize(Graph *graph, VariableSpace *variableSpace) {
+            auto vs = variableSpace == nullptr ? graph->getVariableSpace() : variableSpace;
+
+            // passes work with structured representation only
+            if (!graph->built())
+                graph->buildGraph();
+
+            _statistics.clear();
+            for (auto pass: _passes) {
+                if (!pass->isApplicable(graph))
+                    continue;
+
+                int before = (int) graph->getMapped()->size();
+                auto timeStart = GraphProfile::currentTime();
+
+                int affected = pass->apply(graph, vs);
+
+                _statistics.emplace_back(PassStatistics(pass->name(), affected, before, (int) graph->getMapped()->size(), GraphProfile::relativeTime(timeStart)));
+            }
+
+            graph->markOptimized(true);
+
+            return Status::OK();
+        }
+
+        std::vector<PassStatistics>& GraphOptimizer::statistics() {
+            return _statistics;
+        }
+
+        void GraphOptimizer::printOut() {
+            nd4j_printf("Graph optimization: %i passes applied\n", (int) _statistics.size());
+            for (auto &s: _statistics)
+                nd4j_printf("    %s: %i nodes affected; nodes: %i -> %i; time: %lld ns\n", s.name().c_str(), s.affected(), s.nodesBefore(), s.nodesAfter(), s.time());
+        }
+    }
+}
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/optimization/OptimizationPass.h>
+#include <ops/declarable/DeclarableOp.h>
+#include <algorithm>
+
+namespace nd4j {
+    namespace graph {
+        std::vector<Node*> OptimizationPass::consumersOf(Graph *graph, int nodeId) {
+            std::vector<Node*> result;
+            for (auto &v: *graph->getMapped()) {
+                for (auto &in: *v.second->input()) {
+                    if (in.first == nodeId) {
+                        result.emplace_back(v.second);
+                        break;
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        bool OptimizationPass::isGraphOutput(Graph *graph, Node *node) {
+            auto outputs = graph->output();
+            if (std::find(outputs->begin(), outputs->end(), node->id()) != outputs->end())
+                return true;
+
+            auto autos = graph->autos();
+            if (std::find(autos->begin(), autos->end(), node->id()) != autos->end())
+                return true;
+
+            return node->hasExternalOutputs();
+        }
+
+        void OptimizationPass::rewireInput(Node *node, const std::pair<int, int> &from, const std::pair<int, int> &to) {
+            std::replace(node->input()->begin(), node->input()->end(), from, to);
+
+            if (node->getContextPrototype() != nullptr) {
+                auto inputs = node->getContextPrototype()->inputs();
+                std::replace(inputs->begin(), inputs->end(), from, to);
+            }
+        }
+
+        bool OptimizationPass::isOp(Node *node, const char *opName) {
+            if (!node->hasCustomOp() || node->getCustomOp()->getOpName() == nullptr)
+                return false;
+
+            return *node->getCustomOp()->getOpName() == opName;
+        }
+
+        bool OptimizationPass::isRegular(Node *node) {
+            if (node->opType() == OpType_LOGIC || node->hasGraphEmbedded() || node->isScoped())
+                return false;
+
+            return node->hasCustomOp() && !node->isDivergencePoint();
+        }
+
+        bool OptimizationPass::isApplicable(Graph *graph) {
+            return true;
+        }
+    }
+}
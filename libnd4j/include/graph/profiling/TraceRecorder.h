@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Timeline recorder for graph nodes and ops, exported as Chrome Trace Event JSON
+//
+
+#ifndef LIBND4J_TRACE_RECORDER_H
+#define LIBND4J_TRACE_RECORDER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define TRACE_MAX_NAME 64
+#define TRACE_MAX_SHAPES 4
+#define TRACE_MAX_RANK 6
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * Single complete span: [begin, end] in nanoseconds
+         */
+        class ND4J_EXPORT TraceEvent {
+        public:
+            const char *_category = nullptr;
+            char _name[TRACE_MAX_NAME];
+            int _nodeId = 0;
+            Nd4jLong _begin = 0L;
+            Nd4jLong _end = 0L;
+
+            // workspace bytes used during span
+            Nd4jLong _bytes = 0L;
+
+            // input shapes, ranks above TRACE_MAX_RANK are truncated
+            int _numShapes = 0;
+            int _ranks[TRACE_MAX_SHAPES];
+            Nd4jLong _dims[TRACE_MAX_SHAPES][TRACE_MAX_RANK];
+
+            void setName(const char *name);
+            void addShape(const Nd4jLong *shapeInfo);
+        };
+
+        /**
+         * Ring buffer owned by one thread. Only owner thread writes, so no locks are involved.
+         * When buffer is full, oldest events are overwritten
+         */
+        class ND4J_EXPORT TraceBuffer {
+        private:
+            std::vector<TraceEvent> _events;
+            std::atomic<Nd4jLong> _head;
+            int _threadId;
+
+        public:
+            TraceBuffer(int threadId, int capacity);
+            ~TraceBuffer() = default;
+
+            // returns slot for the next event. event becomes visible after commit()
+            TraceEvent& next();
+            void commit();
+
+            void reset();
+
+            int threadId();
+
+            // number of events available, up to capacity
+            Nd4jLong size();
+
+            // i-th available event, from oldest to newest
+            TraceEvent& at(Nd4jLong i);
+        };
+
+        /**
+         * This class collects node and op spans when Environment::isTracing() is set, and writes them as Chrome Trace Event JSON,
+         * viewable with chrome://tracing or Perfetto.
+         *
+         * PLEASE NOTE: export and reset are expected to be called while nothing is executed
+         */
+        class ND4J_EXPORT TraceRecorder {
+        private:
+            static TraceRecorder *_INSTANCE;
+
+            // guards buffers registration only, it happens once per thread
+            std::mutex _mutex;
+            std::vector<TraceBuffer*> _buffers;
+            std::atomic<int> _capacity;
+            Nd4jLong _origin;
+
+            TraceRecorder();
+            ~TraceRecorder();
+
+            TraceBuffer* localBuffer();
+
+        public:
+            static TraceRecorder* getInstance();
+
+            /**
+             * Monotonic time in nanoseconds
+             */
+            static Nd4jLong currentTime();
+
+            /**
+             * This method sets capacity (in events) of per-thread buffers created after this call
+             */
+            void setCapacity(int capacity);
+
+            /**
+             * These two methods record span for current thread: beginSpan returns event to be filled, commitSpan publishes it
+             */
+            TraceEvent& beginSpan(const char *category, const char *name, int nodeId, Nd4jLong begin, Nd4jLong end, Nd4jLong bytes = 0L);
+            void commitSpan();
+
+            /**
+             * Shortcut for spans without input shapes
+             */
+            void recordSpan(const char *category, const char *name, int nodeId, Nd4jLong begin, Nd4jLong end, Nd4jLong bytes = 0L);
+
+            /**
+             * This method returns total number of events available
+             */
+            Nd4jLong size();
+
+            /**
+             * This method drops all recorded events
+             */
+            void reset();
+
+            std::string asChromeTrace();
+            Nd4jStatus writeChromeTrace(const char *fileName);
+        };
+    }
+}
+
+#endif //LIBND4J_TRACE_RECORDER_H
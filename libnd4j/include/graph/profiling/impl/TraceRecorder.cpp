@@ -0,0 +1,240 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/profiling/TraceRecorder.h>
+#include <helpers/shape.h>
+#include <helpers/logger.h>
+#include <Status.h>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+
+namespace nd4j {
+    namespace graph {
+        void TraceEvent::setName(const char *name) {
+            if (name == nullptr) {
+                _name[0] = 0;
+                return;
+            }
+
+            strncpy(_name, name, TRACE_MAX_NAME - 1);
+            _name[TRACE_MAX_NAME - 1] = 0;
+        }
+
+        void TraceEvent::addShape(const Nd4jLong *shapeInfo) {
+            if (_numShapes >= TRACE_MAX_SHAPES || shapeInfo == nullptr)
+                return;
+
+            auto rank = shape::rank(shapeInfo);
+            _ranks[_numShapes] = rank;
+            for (int e = 0; e < rank && e < TRACE_MAX_RANK; e++)
+                _dims[_numShapes][e] = shapeInfo[e + 1];
+
+            _numShapes++;
+        }
+
+        TraceBuffer::TraceBuffer(int threadId, int capacity) : _events(capacity) {
+            _threadId = threadId;
+            _head.store(0L);
+        }
+
+        TraceEvent& TraceBuffer::next() {
+            auto &event = _events[_head.load(std::memory_order_relaxed) % _events.size()];
+            event._numShapes = 0;
+            return event;
+        }
+
+        void TraceBuffer::commit() {
+            _head.fetch_add(1L, std::memory_order_release);
+        }
+
+        void TraceBuffer::reset() {
+            _head.store(0L);
+        }
+
+        int TraceBuffer::threadId() {
+            return _threadId;
+        }
+
+        Nd4jLong TraceBuffer::size() {
+            auto head = _head.load(std::memory_order_acquire);
+            return head < (Nd4jLong) _events.size() ? head : (Nd4jLong) _events.size();
+        }
+
+        TraceEvent& TraceBuffer::at(Nd4jLong i) {
+            auto head = _head.load(std::memory_order_acquire);
+            auto first = head < (Nd4jLong) _events.size() ? 0L : head - (Nd4jLong) _events.size();
+            return _events[(first + i) % _events.size()];
+        }
+
+        TraceRecorder::TraceRecorder() {
+            _capacity.store(8192);
+            _origin = currentTime();
+        }
+
+        TraceRecorder::~TraceRecorder() {
+            for (auto v: _buffers)
+                delete v;
+        }
+
+        TraceRecorder* TraceRecorder::getInstance() {
+            if (_INSTANCE == 0)
+                _INSTANCE = new TraceRecorder();
+
+            return _INSTANCE;
+        }
+
+        Nd4jLong TraceRecorder::currentTime() {
+            auto t = std::chrono::steady_clock::now();
+            return (Nd4jLong) std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+        }
+
+        void TraceRecorder::setCapacity(int capacity) {
+            if (capacity < 1)
+                throw std::invalid_argument("TraceRecorder capacity should be positive");
+
+            _capacity.store(capacity);
+        }
+
+        TraceBuffer* TraceRecorder::localBuffer() {
+            // buffers outlive threads, so spans of finished threads can still be exported
+            thread_local TraceBuffer *buffer = nullptr;
+            if (buffer == nullptr) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                buffer = new TraceBuffer((int) _buffers.size(), _capacity.load());
+                _buffers.emplace_back(buffer);
+            }
+
+            return buffer;
+        }
+
+        TraceEvent& TraceRecorder::beginSpan(const char *category, const char *name, int nodeId, Nd4jLong begin, Nd4jLong end, Nd4jLong bytes) {
+            auto &event = localBuffer()->next();
+            event._category = category;
+            event.setName(name);
+            event._nodeId = nodeId;
+            event._begin = begin;
+            event._end = end;
+            event._bytes = bytes;
+
+            return event;
+        }
+
+        void TraceRecorder::commitSpan() {
+            localBuffer()->commit();
+        }
+
+        void TraceRecorder::recordSpan(const char *category, const char *name, int nodeId, Nd4jLong begin, Nd4jLong end, Nd4jLong bytes) {
+            beginSpan(category, name, nodeId, begin, end, bytes);
+            commitSpan();
+        }
+
+        Nd4jLong TraceRecorder::size() {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            Nd4jLong result = 0L;
+            for (auto v: _buffers)
+                result += v->size();
+
+            return result;
+        }
+
+        void TraceRecorder::reset() {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            for (auto v: _buffers)
+                v->reset();
+
+            _origin = currentTime();
+        }
+
+        static void appendEscaped(std::string &result, const char *str) {
+            for (auto c = str; *c != 0; c++) {
+                if (*c == '"' || *c == '\\')
+                    result += '\\';
+
+                if (*c >= 0 && *c < 0x20)
+                    result += ' ';
+                else
+                    result += *c;
+            }
+        }
+
+        std::string TraceRecorder::asChromeTrace() {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            std::string result("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+            char buffer[256];
+            bool first = true;
+
+            for (auto b: _buffers) {
+                // thread names for viewer
+                snprintf(buffer, sizeof(buffer), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%i,\"args\":{\"name\":\"thread_%i\"}}", first ? "" : ",", b->threadId(), b->threadId());
+                result += buffer;
+                first = false;
+
+                for (Nd4jLong e = 0; e < b->size(); e++) {
+                    auto &event = b->at(e);
+
+                    result += ",{\"name\":\"";
+                    appendEscaped(result, event._name);
+                    result += "\",\"cat\":\"";
+                    appendEscaped(result, event._category == nullptr ? "" : event._category);
+
+                    // Chrome trace expects microseconds
+                    snprintf(buffer, sizeof(buffer), "\",\"ph\":\"X\",\"pid\":0,\"tid\":%i,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"node\":%i,\"workspace\":%lld,\"shapes\":\"",
+                             b->threadId(), (event._begin - _origin) / 1000.0, (event._end - event._begin) / 1000.0, event._nodeId, (long long) event._bytes);
+                    result += buffer;
+
+                    for (int s = 0; s < event._numShapes; s++) {
+                        result += s > 0 ? " [" : "[";
+                        for (int d = 0; d < event._ranks[s] && d < TRACE_MAX_RANK; d++) {
+                            snprintf(buffer, sizeof(buffer), d > 0 ? ",%lld" : "%lld", (long long) event._dims[s][d]);
+                            result += buffer;
+                        }
+
+                        if (event._ranks[s] > TRACE_MAX_RANK)
+                            result += ",...";
+
+                        result += "]";
+                    }
+
+                    result += "\"}}";
+                }
+            }
+
+            result += "]}";
+            return result;
+        }
+
+        Nd4jStatus TraceRecorder::writeChromeTrace(const char *fileName) {
+            auto json = asChromeTrace();
+
+            auto file = fopen(fileName, "w");
+            if (file == nullptr) {
+                nd4j_printf("Unable to open trace file [%s] for writing\n", fileName);
+                return Status::THROW("Unable to open trace file");
+            }
+
+            auto written = fwrite(json.c_str(), 1, json.size(), file);
+            fclose(file);
+
+            return written == json.size() ? Status::OK() : Status::THROW("Unable to write trace file");
+        }
+
+        TraceRecorder* TraceRecorder::_INSTANCE = 0;
+    }
+}
@@ -59,6 +59,8 @@ namespace nd4j {
         void benchmarkGEMM(char orderA, std::initializer_list<Nd4jLong> shapeA, char orderB, std::initializer_list<Nd4jLong> shapeB, char orderC, std::initializer_list<Nd4jLong> shapeC);
 
         std::string printHeader();
+
+        Nd4jLong medianTime(const std::function<void ()> &func);
     public:
         BenchmarkHelper(unsigned int warmUpIterations = 10, unsigned int runIterations = 100);
 
@@ -82,6 +84,30 @@ namespace nd4j {
         std::string runOperationSuit(MatrixBenchmark *op, const std::function<void (Parameters &, ResultSet &, ResultSet &, ResultSet &)>& func, ParametersBatch &parametersBatch, const char *message = nullptr);
 
         std::string runOperationSuit(DeclarableBenchmark *op, const std::function<Context* (Parameters &)>& func, ParametersBatch &parametersBatch, const char *message = nullptr);
+
+        /**
+         * This method compares std::function and inlined lambda versions of NDArray::apply*Lambda
+         * on lambdas taken from lstm/gru/loss helpers, for each of given array lengths
+         */
+        std::string runLambdaSuit(const std::vector<Nd4jLong> &lengths);
+
+        /**
+         * This method compares x * 2 + y -> relu -> sigmoid executed as separate ops, as fused_elementwise op
+         * and as compile-time FusedChain, for each of given array lengths. Bandwidth is reported for bytes the chain has to move at least
+         */
+        std::string runFusedChainSuit(const std::vector<Nd4jLong> &lengths);
+
+        /**
+         * This method compares dense mmul against CSR SpMM for [rows, k] x [k, m] product, for each of given densities of left matrix.
+         * Conversion to CSR is timed separately, matmul op column shows what op picks on its own
+         */
+        std::string runSparseMmulSuit(Nd4jLong rows, Nd4jLong k, Nd4jLong m, const std::vector<double> &densities);
+
+        /**
+         * This method compares blocked brute force knn search against VP-tree query for numQueries queries over [numPoints, dim] points.
+         * Tree build is timed separately
+         */
+        std::string runKnnSuit(Nd4jLong numPoints, Nd4jLong dim, Nd4jLong numQueries, int k);
     };
 }
 
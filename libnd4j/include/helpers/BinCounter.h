@@ -0,0 +1,269 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Parallel histogram kernel: bin indices are computed with SIMD, counted in per-task private bins and merged pairwise
+//
+
+#ifndef LIBND4J_BINCOUNTER_H
+#define LIBND4J_BINCOUNTER_H
+
+#include <NDArray.h>
+#include <execution/Executor.h>
+#include <templatemath.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace nd4j {
+    /**
+     * Bins of equal width between min and max, values beyond them (and NaNs) go to the first/last bin
+     */
+    template <typename C>
+    class UniformBins {
+    private:
+        C _min;
+        C _width;
+        C _last;
+
+    public:
+        UniformBins(double min, double max, Nd4jLong numBins) {
+            _min = static_cast<C>(min);
+            _width = static_cast<C>((max - min) / numBins);
+            _last = static_cast<C>(numBins - 1);
+
+            // all values are equal to min then, so they all land in the first bin
+            if (!(_width > (C) 0))
+                _width = (C) 1;
+        }
+
+        FORCEINLINE int operator()(C value) const {
+            C v = (value - _min) / _width;
+            v = v >= (C) 0 ? v : (C) 0;
+            v = v < _last ? v : _last;
+            return static_cast<int>(v);
+        }
+    };
+
+    /**
+     * Bins of histogram_fixed_width: values below second edge go to the first bin, values from last but one edge go to the last bin
+     */
+    template <typename C>
+    class FixedWidthBins {
+    private:
+        C _left;
+        C _width;
+        C _secondEdge;
+        C _lastButOneEdge;
+        C _last;
+
+    public:
+        FixedWidthBins(double leftEdge, double rightEdge, Nd4jLong numBins) {
+            _left = static_cast<C>(leftEdge);
+            _width = (static_cast<C>(rightEdge) - _left) / static_cast<C>(numBins);
+            _secondEdge = _left + _width;
+            _lastButOneEdge = static_cast<C>(rightEdge) - _width;
+            _last = static_cast<C>(numBins - 1);
+        }
+
+        FORCEINLINE int operator()(C value) const {
+            C v = (value - _left) / _width;
+            v = value < _secondEdge ? (C) 0 : v;
+            v = value >= _lastButOneEdge ? _last : v;
+            v = v >= (C) 0 ? v : (C) 0;
+            v = v < _last ? v : _last;
+            return static_cast<int>(v);
+        }
+    };
+
+    class ND4J_EXPORT BinCounter {
+    public:
+        static const Nd4jLong GRAIN = 32768;
+        static const int BATCH = 256;
+
+        /**
+         * Type bin index of X value is computed in: single precision for floating types up to float, double otherwise
+         */
+        template <typename X>
+        using compute_type = typename std::conditional<std::is_same<X, double>::value || std::is_integral<X>::value, double, float>::type;
+
+        /**
+         * Number of copies of histogram one task counts into. Consecutive elements go to different lanes,
+         * so runs of equal values (zeros after relu etc) don't serialize on increments of the same counter
+         */
+        static int numberOfLanes(Nd4jLong length, int numBins) {
+            return numBins <= 1024 && length >= 16L * numBins ? 4 : 1;
+        }
+
+        /**
+         * This method counts length elements x[0], x[stride], ... into lanes, numLanes * numBins counters.
+         * Bin indices of BATCH elements are computed with SIMD first, then scattered into lanes
+         */
+        template <typename X, typename B>
+        static void count(const X *x, Nd4jLong stride, Nd4jLong length, const B &binOf, int numBins, int numLanes, Nd4jLong *lanes) {
+            typedef compute_type<X> C;
+            const int laneMask = numLanes - 1;
+            int idx[BATCH];
+
+            for (Nd4jLong b = 0; b < length; b += BATCH) {
+                const int n = (int) nd4j::math::nd4j_min<Nd4jLong>(BATCH, length - b);
+                const auto batch = x + b * stride;
+
+                if (stride == 1) {
+                    PRAGMA_OMP_SIMD
+                    for (int e = 0; e < n; e++)
+                        idx[e] = binOf(static_cast<C>(batch[e])) + (e & laneMask) * numBins;
+                } else {
+                    PRAGMA_OMP_SIMD
+                    for (int e = 0; e < n; e++)
+                        idx[e] = binOf(static_cast<C>(batch[e * stride])) + (e & laneMask) * numBins;
+                }
+
+                for (int e = 0; e < n; e++)
+                    lanes[idx[e]]++;
+            }
+        }
+
+        /**
+         * This method computes numTads histograms of numBins bins each into result, row per TAD.
+         * countRange(tad, start, stop, lanes, numLanes) should count elements [start, stop) of TAD into lanes with count().
+         *
+         * TADs longer than GRAIN are split into chunks when there are fewer TADs than threads. Chunks count into private bins,
+         * which are merged pairwise in log2(chunks) rounds without any locking. Short TADs are counted whole, many per thread
+         */
+        template <typename F>
+        static void histograms(Nd4jLong numTads, Nd4jLong tadLength, int numBins, const F &countRange, Nd4jLong *result) {
+            if (numTads < 1)
+                return;
+
+            const int numThreads = Executor::numberOfWorkers() + 1;
+            const int numLanes = numberOfLanes(tadLength, numBins);
+            const Nd4jLong laneSize = (Nd4jLong) numLanes * numBins;
+
+            // every chunk should be worth its private bins
+            const Nd4jLong minChunk = nd4j::math::nd4j_max<Nd4jLong>(GRAIN, laneSize);
+            const int chunks = (int) nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>((numThreads + numTads - 1) / numTads, tadLength / minChunk));
+
+            if (chunks == 1) {
+                const auto grain = nd4j::math::nd4j_max<Nd4jLong>(1, GRAIN / nd4j::math::nd4j_max<Nd4jLong>(1, tadLength));
+
+                Executor::parallel_for(0, numTads, [&](Nd4jLong start, Nd4jLong stop) {
+                    std::vector<Nd4jLong> lanes(laneSize);
+                    for (Nd4jLong t = start; t < stop; t++) {
+                        std::fill(lanes.begin(), lanes.end(), 0L);
+                        countRange(t, 0L, tadLength, lanes.data(), numLanes);
+                        fold(lanes.data(), numBins, numLanes, result + t * numBins);
+                    }
+                }, grain);
+                return;
+            }
+
+            const auto numTasks = numTads * chunks;
+            const auto chunk = tadLength / chunks;
+            std::unique_ptr<Nd4jLong[]> partial(new Nd4jLong[numTasks * numBins]);
+
+            Executor::parallel_tasks((int) numTasks, [&](int task) {
+                const Nd4jLong t = task / chunks;
+                const int c = task % chunks;
+                const auto start = c * chunk;
+                const auto stop = c == chunks - 1 ? tadLength : start + chunk;
+
+                std::vector<Nd4jLong> lanes(laneSize, 0L);
+                countRange(t, start, stop, lanes.data(), numLanes);
+                fold(lanes.data(), numBins, numLanes, partial.get() + (Nd4jLong) task * numBins);
+            });
+
+            // every round adds odd partial histograms of each TAD to their even neighbours, halving their number
+            for (int step = 1; step < chunks; step *= 2) {
+                const Nd4jLong pairs = (chunks - step + 2 * step - 1) / (2 * step);
+
+                Executor::parallel_for(0, numTads * pairs, [&](Nd4jLong start, Nd4jLong stop) {
+                    for (Nd4jLong p = start; p < stop; p++) {
+                        auto target = partial.get() + ((p / pairs) * chunks + (p % pairs) * 2 * step) * numBins;
+                        auto source = target + (Nd4jLong) step * numBins;
+
+                        PRAGMA_OMP_SIMD
+                        for (int b = 0; b < numBins; b++)
+                            target[b] += source[b];
+                    }
+                });
+            }
+
+            for (Nd4jLong t = 0; t < numTads; t++)
+                memcpy(result + t * numBins, partial.get() + t * chunks * numBins, numBins * sizeof(Nd4jLong));
+        }
+
+        /**
+         * This method computes histogram of all elements of input into output, binOf maps value to bin
+         */
+        template <typename X, typename B>
+        static void histogram(const NDArray &input, const B &binOf, NDArray &output) {
+            const int numBins = (int) output.lengthOf();
+
+            // order of elements doesn't matter here, so any array with element-wise stride is walked as is
+            std::unique_ptr<NDArray> holder;
+            auto source = &input;
+            if (input.ews() < 1) {
+                holder.reset(input.dup('c'));
+                source = holder.get();
+            }
+
+            const auto x = source->bufferAsT<X>();
+            const auto stride = source->ews();
+
+            store(output, [&](Nd4jLong *result) {
+                histograms(1, source->lengthOf(), numBins, [&](Nd4jLong tad, Nd4jLong start, Nd4jLong stop, Nd4jLong *lanes, int numLanes) {
+                    count(x + start * stride, stride, stop - start, binOf, numBins, numLanes, lanes);
+                }, result);
+            });
+        }
+
+        /**
+         * This method passes counts buffer to func and writes counts into output. Plain INT64 output is used as counts buffer directly
+         */
+        static void store(NDArray &output, const std::function<void(Nd4jLong*)> &func) {
+            if (output.dataType() == nd4j::DataType::INT64 && output.ordering() == 'c' && output.ews() == 1) {
+                func(output.bufferAsT<Nd4jLong>());
+                return;
+            }
+
+            std::vector<Nd4jLong> counts(output.lengthOf(), 0L);
+            func(counts.data());
+
+            for (Nd4jLong e = 0; e < output.lengthOf(); e++)
+                output.p<Nd4jLong>(e, counts[e]);
+        }
+
+    private:
+        static FORCEINLINE void fold(const Nd4jLong *lanes, int numBins, int numLanes, Nd4jLong *target) {
+            memcpy(target, lanes, numBins * sizeof(Nd4jLong));
+
+            for (int l = 1; l < numLanes; l++) {
+                auto lane = lanes + (Nd4jLong) l * numBins;
+
+                PRAGMA_OMP_SIMD
+                for (int b = 0; b < numBins; b++)
+                    target[b] += lane[b];
+            }
+        }
+    };
+}
+
+#endif //LIBND4J_BINCOUNTER_H
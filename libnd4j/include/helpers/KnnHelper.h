@@ -0,0 +1,149 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Exact k nearest neighbours search with blocked distance computation
+//
+
+#ifndef LIBND4J_KNNHELPER_H
+#define LIBND4J_KNNHELPER_H
+
+#include <NDArray.h>
+#include <array/DataTypeUtils.h>
+#include <templatemath.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace nd4j {
+    /**
+     * k best (smallest) distances seen so far, kept as max-heap so the worst one is replaced in O(log k)
+     */
+    template <typename T>
+    class TopK {
+    private:
+        std::vector<std::pair<T, Nd4jLong>> _heap;
+        size_t _k;
+
+    public:
+        explicit TopK(int k) : _k(k) {
+            _heap.reserve(k);
+        }
+
+        /**
+         * This method returns distance a candidate has to beat to get in
+         */
+        FORCEINLINE T worst() const {
+            return _heap.size() < _k ? DataTypeUtils::max<T>() : _heap.front().first;
+        }
+
+        FORCEINLINE void push(T distance, Nd4jLong index) {
+            if (_heap.size() < _k) {
+                _heap.emplace_back(distance, index);
+                std::push_heap(_heap.begin(), _heap.end());
+            } else if (std::make_pair(distance, index) < _heap.front()) {
+                std::pop_heap(_heap.begin(), _heap.end());
+                _heap.back() = std::make_pair(distance, index);
+                std::push_heap(_heap.begin(), _heap.end());
+            }
+        }
+
+        /**
+         * This method returns neighbours sorted by distance, ties go by index. Heap is emptied
+         */
+        std::vector<std::pair<T, Nd4jLong>>& sorted() {
+            std::sort_heap(_heap.begin(), _heap.end());
+            return _heap;
+        }
+    };
+
+    class ND4J_EXPORT KnnHelper {
+    public:
+        enum Metric {
+            EUCLIDEAN = 0,
+            COSINE = 1,
+            MANHATTAN = 2,
+        };
+
+        /**
+         * Distance between two vectors: euclidean, cosine distance (1 - cosine similarity, 1 for zero vectors) or manhattan
+         */
+        template <typename T>
+        static FORCEINLINE T distance(int metric, const T *x, const T *y, Nd4jLong length) {
+            T sum = static_cast<T>(0.f);
+
+            if (metric == MANHATTAN) {
+                PRAGMA_OMP_SIMD_SUM(sum)
+                for (Nd4jLong e = 0; e < length; e++)
+                    sum += nd4j::math::nd4j_abs<T>(x[e] - y[e]);
+
+                return sum;
+            }
+
+            if (metric == COSINE) {
+                T normX = static_cast<T>(0.f);
+                T normY = static_cast<T>(0.f);
+
+                PRAGMA_OMP_SIMD_SUM(sum)
+                for (Nd4jLong e = 0; e < length; e++)
+                    sum += x[e] * y[e];
+
+                PRAGMA_OMP_SIMD_SUM(normX)
+                for (Nd4jLong e = 0; e < length; e++)
+                    normX += x[e] * x[e];
+
+                PRAGMA_OMP_SIMD_SUM(normY)
+                for (Nd4jLong e = 0; e < length; e++)
+                    normY += y[e] * y[e];
+
+                return cosineDistance(sum, normX, normY);
+            }
+
+            PRAGMA_OMP_SIMD_SUM(sum)
+            for (Nd4jLong e = 0; e < length; e++)
+                sum += (x[e] - y[e]) * (x[e] - y[e]);
+
+            return nd4j::math::nd4j_sqrt<T, T>(sum);
+        }
+
+        /**
+         * Cosine distance out of dot product and squared norms
+         */
+        template <typename T>
+        static FORCEINLINE T cosineDistance(T dot, T normX, T normY) {
+            const auto norm = nd4j::math::nd4j_sqrt<T, T>(normX * normY);
+            return norm > static_cast<T>(0.f) ? static_cast<T>(1.f) - dot / norm : static_cast<T>(1.f);
+        }
+
+        /**
+         * This method finds k nearest rows of reference for each row of query, without storing full distance matrix.
+         * Euclidean and cosine distances are computed in [QUERY_BLOCK, REFERENCE_BLOCK] blocks as |q|^2 + |r|^2 - 2 * q.r with gemm,
+         * and merged into per-query heaps in parallel. Manhattan distance is computed directly over the same blocks
+         *
+         * @param query - [M, D] matrix
+         * @param reference - [N, D] matrix of the same floating point type, N >= k
+         * @param indices - INT64 [M, k] matrix, indices of neighbours within reference, nearest first
+         * @param distances - [M, k] matrix of query type
+         */
+        static void search(const NDArray &query, const NDArray &reference, int k, int metric, NDArray &indices, NDArray &distances);
+
+        static const Nd4jLong QUERY_BLOCK = 1024;
+        static const Nd4jLong REFERENCE_BLOCK = 4096;
+    };
+}
+
+#endif //LIBND4J_KNNHELPER_H
@@ -37,12 +37,16 @@ namespace nd4j {
 class ND4J_EXPORT LoopKind {
     
     public:
-        enum Kind {SMALLARR2DX, EWS1, EWSNONZERO, RANK1, RANK2, RANK3, RANK4, RANK5, X_EWSNONZERO, Y_EWSNONZERO, Z_EWSNONZERO, COMMON};
+        enum Kind {SMALLARR2DX, EWS1, EWSNONZERO, RANK1, RANK2, RANK3, RANK4, RANK5, X_EWSNONZERO, Y_EWSNONZERO, Z_EWSNONZERO, COMMON, SPLITK, VERTICAL};
 
         static FORCEINLINE Kind deduceKindOfLoopXZ(const Nd4jLong* xShapeInfo, const Nd4jLong* zShapeInfo);
         static FORCEINLINE Kind deduceKindOfLoopXYZ(const Nd4jLong* xShapeInfo, const Nd4jLong* yShapeInfo, const Nd4jLong* zShapeInfo);
         static FORCEINLINE Kind deduceKindOfLoopTadXZ(const Nd4jLong* xShapeInfo, const Nd4jLong* zShapeInfo, const Nd4jLong* tadShapeInfo);        
         static FORCEINLINE Kind deduceKindOfLoopTadXYZ(const Nd4jLong* xTadShapeInfo, const Nd4jLong* yTadShapeInfo, const Nd4jLong* zShapeInfo);
+
+        // same as above, but may also return SPLITK (few long tads) or VERTICAL (strided tads interleaved over contiguous x)
+        static FORCEINLINE Kind deduceKindOfReduceTadXZ(const Nd4jLong* xShapeInfo, const Nd4jLong* zShapeInfo, const Nd4jLong* tadShapeInfo);
+        static FORCEINLINE Kind deduceKindOfReduce3TadXYZ(const Nd4jLong* xTadShapeInfo, const Nd4jLong* yTadShapeInfo, const Nd4jLong* zShapeInfo);
     
 };
 
@@ -206,6 +210,49 @@ LoopKind::Kind LoopKind::deduceKindOfLoopTadXYZ(const Nd4jLong* xTadShapeInfo, c
     return COMMON;  
 }
 
+//////////////////////////////////////////////////////////////////////////////
+LoopKind::Kind LoopKind::deduceKindOfReduceTadXZ(const Nd4jLong* xShapeInfo, const Nd4jLong* zShapeInfo, const Nd4jLong* tadShapeInfo) {
+
+    const Kind kind = deduceKindOfLoopTadXZ(xShapeInfo, zShapeInfo, tadShapeInfo);
+    if(kind == SMALLARR2DX)
+        return kind;
+
+    const Nd4jLong zLen   = shape::length(zShapeInfo);
+    const Nd4jLong tadLen = shape::length(tadShapeInfo);
+
+    const Nd4jLong xEws = shape::elementWiseStride(xShapeInfo);
+    const Nd4jLong tEws = shape::elementWiseStride(tadShapeInfo);
+    const Nd4jLong zEws = shape::elementWiseStride(zShapeInfo);
+
+    int temp;
+    const bool tVectorOrC = shape::isCommonVector(tadShapeInfo, temp) || shape::order(tadShapeInfo) == 'c';
+
+    // tad element j of every tad lives in j-th contiguous row of x, so rows can be streamed instead of walking columns
+    if(xEws == 1 && tEws > 1 && tEws == zLen && zEws > 0 && tVectorOrC && tadLen * zLen == shape::length(xShapeInfo))
+        return VERTICAL;
+
+    const int maxThreads = Environment::getInstance()->maxThreads();
+    if((kind == EWS1 || kind == EWSNONZERO) && maxThreads > 1 && zLen < maxThreads && tadLen >= 2 * Environment::getInstance()->elementwiseThreshold())
+        return SPLITK;
+
+    return kind;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+LoopKind::Kind LoopKind::deduceKindOfReduce3TadXYZ(const Nd4jLong* xTadShapeInfo, const Nd4jLong* yTadShapeInfo, const Nd4jLong* zShapeInfo) {
+
+    const Kind kind = deduceKindOfLoopTadXYZ(xTadShapeInfo, yTadShapeInfo, zShapeInfo);
+
+    const Nd4jLong zLen   = shape::length(zShapeInfo);
+    const Nd4jLong tadLen = shape::length(xTadShapeInfo);
+
+    const int maxThreads = Environment::getInstance()->maxThreads();
+    if((kind == EWS1 || kind == EWSNONZERO) && maxThreads > 1 && zLen < maxThreads && tadLen >= 2 * Environment::getInstance()->elementwiseThreshold())
+        return SPLITK;
+
+    return kind;
+}
+
 
 
 
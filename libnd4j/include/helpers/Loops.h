@@ -31,6 +31,7 @@
 #include <indexreduce.h>
 #include <helpers/ConstantTadHelper.h>
 #include <openmp_pragmas.h>
+#include <execution/Executor.h>
 
 namespace nd4j {
 
@@ -267,7 +268,7 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                                                   Nd4jLong* tadShapeInfo, Nd4jLong* tadOffsets,
                                                   E* extraParams) {
 
-        const LoopKind::Kind kindOfLoop = LoopKind::deduceKindOfLoopTadXZ(xShapeInfo, zShapeInfo, tadShapeInfo);
+        const LoopKind::Kind kindOfLoop = LoopKind::deduceKindOfReduceTadXZ(xShapeInfo, zShapeInfo, tadShapeInfo);
 
         const Nd4jLong zLen   = shape::length(zShapeInfo);
         const Nd4jLong tadLen = shape::length(tadShapeInfo);
@@ -318,124 +319,241 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 break;
 
             //*********************************************//
-            case LoopKind::EWS1: {
+            case LoopKind::SPLITK: {
+                // few long tads: every tad is split into numSplits parts, partial results are merged afterwards
+                typedef decltype(OpType::startingValue(x)) Acc;
 
-                PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
-                for (uint i = 0; i < zLen; i++) {
-                    auto tad = x + tadOffsets[i];
+                const Nd4jLong numSplits = nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(Environment::getInstance()->maxThreads() / zLen, tadLen / Environment::getInstance()->elementwiseThreshold()));
+                const Nd4jLong span = (tadLen + numSplits - 1) / numSplits;
+
+                auto partials = new Acc[zLen * numSplits];
+
+                Executor::parallel_tasks(zLen * numSplits, [&](int task) {
+                    auto tad = x + tadOffsets[task / numSplits];
                     auto start = OpType::startingValue(tad);
 
-                    for (uint j = 0; j < tadLen; j++)
-                        start = OpType::update(start, OpType::op(tad[j], extraParams), extraParams);
+                    const auto from = (task % numSplits) * span;
+                    const auto to = nd4j::math::nd4j_min<Nd4jLong>(tadLen, from + span);
 
-                    z[i] = OpType::postProcess(start, tadLen, extraParams);
+                    for (auto j = from; j < to; j++)
+                        start = OpType::update(start, OpType::op(tad[j * tadEws], extraParams), extraParams);
+
+                    partials[task] = start;
+                });
+
+                for (Nd4jLong i = 0; i < zLen; i++) {
+                    auto start = partials[i * numSplits];
+
+                    for (Nd4jLong e = 1; e < numSplits; e++)
+                        start = OpType::update(start, partials[i * numSplits + e], extraParams);
+
+                    z[i * zEws] = OpType::postProcess(start, tadLen, extraParams);
                 }
+
+                delete []partials;
             }
                 break;
 
             //*********************************************//
-            case LoopKind::EWSNONZERO: {
+            case LoopKind::VERTICAL: {
+                // j-th elements of all tads form j-th contiguous row of x, so we stream rows and update vector of accumulators
+                typedef decltype(OpType::startingValue(x)) Acc;
 
-                PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
-                for (uint i = 0; i < zLen; i++) {
-                    auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
+                // accumulator k belongs to tad starting at offset k
+                auto zIndex = new Nd4jLong[zLen];
+                for (Nd4jLong i = 0; i < zLen; i++)
+                    zIndex[tadOffsets[i]] = i;
 
-                    for (uint j = 0; j < tadLen; j++)
-                        start = OpType::update(start, OpType::op(tad[j * tadEws], extraParams), extraParams);
+                const int maxThreads = Environment::getInstance()->maxThreads();
 
-                    z[i * zEws] = OpType::postProcess(start, tadLen, extraParams);
+                if (zLen >= 64 * maxThreads || tadLen < maxThreads) {
+                    // wide rows: every thread owns range of accumulators and streams all rows over it
+                    Executor::parallel_for(0, zLen, [&](Nd4jLong from, Nd4jLong to) {
+                        const auto width = to - from;
+                        auto acc = new Acc[width];
+
+                        // some ops (AMax, AMin) start from the first element of their tad
+                        for (Nd4jLong k = 0; k < width; k++)
+                            acc[k] = OpType::startingValue(x + from + k);
+
+                        for (Nd4jLong r = 0; r < tadLen; r++) {
+                            auto row = x + r * zLen + from;
+
+                            PRAGMA_OMP_SIMD
+                            for (Nd4jLong k = 0; k < width; k++)
+                                acc[k] = OpType::update(acc[k], OpType::op(row[k], extraParams), extraParams);
+                        }
+
+                        for (Nd4jLong k = 0; k < width; k++)
+                            z[zIndex[from + k] * zEws] = OpType::postProcess(acc[k], tadLen, extraParams);
+
+                        delete []acc;
+                    }, 64);
+                } else {
+                    // narrow rows: threads take ranges of rows with private accumulators, merged afterwards
+                    const Nd4jLong numChunks = nd4j::math::nd4j_min<Nd4jLong>(maxThreads, tadLen);
+                    const Nd4jLong span = (tadLen + numChunks - 1) / numChunks;
+
+                    auto partials = new Acc[numChunks * zLen];
+
+                    Executor::parallel_tasks(numChunks, [&](int chunk) {
+                        auto acc = partials + chunk * zLen;
+
+                        for (Nd4jLong k = 0; k < zLen; k++)
+                            acc[k] = OpType::startingValue(x + k);
+
+                        const auto to = nd4j::math::nd4j_min<Nd4jLong>(tadLen, (chunk + 1) * span);
+                        for (Nd4jLong r = chunk * span; r < to; r++) {
+                            auto row = x + r * zLen;
+
+                            PRAGMA_OMP_SIMD
+                            for (Nd4jLong k = 0; k < zLen; k++)
+                                acc[k] = OpType::update(acc[k], OpType::op(row[k], extraParams), extraParams);
+                        }
+                    });
+
+                    for (Nd4jLong k = 0; k < zLen; k++) {
+                        auto start = partials[k];
+
+                        for (Nd4jLong e = 1; e < numChunks; e++)
+                            start = OpType::update(start, partials[e * zLen + k], extraParams);
+
+                        z[zIndex[k] * zEws] = OpType::postProcess(start, tadLen, extraParams);
+                    }
+
+                    delete []partials;
                 }
+
+                delete []zIndex;
+            }
+                break;
+
+            //*********************************************//
+            case LoopKind::EWS1: {
+
+                Executor::parallel_for(0, zLen, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i = from; i < to; i++) {
+                        auto tad = x + tadOffsets[i];
+                        auto start = OpType::startingValue(tad);
+
+                        for (uint j = 0; j < tadLen; j++)
+                            start = OpType::update(start, OpType::op(tad[j], extraParams), extraParams);
+
+                        z[i] = OpType::postProcess(start, tadLen, extraParams);
+                    }
+                }, 1, numThreads);
+            }
+                break;
+
+            //*********************************************//
+            case LoopKind::EWSNONZERO: {
+
+                Executor::parallel_for(0, zLen, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i = from; i < to; i++) {
+                        auto tad = x + tadOffsets[i];
+                        auto start = OpType::startingValue(tad);
+
+                        for (uint j = 0; j < tadLen; j++)
+                            start = OpType::update(start, OpType::op(tad[j * tadEws], extraParams), extraParams);
+
+                        z[i * zEws] = OpType::postProcess(start, tadLen, extraParams);
+                    }
+                }, 1, numThreads);
             }
                 break;
 
             //*********************************************//
             case LoopKind::RANK1: {
 
-                PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
-                for (uint i = 0; i < zLen; i++) {
-                    auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
+                Executor::parallel_for(0, zLen, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i = from; i < to; i++) {
+                        auto tad = x + tadOffsets[i];
+                        auto start = OpType::startingValue(tad);
 
-                    for (uint i0 = 0; i0 < tadLen; ++i0)
-                        start = OpType::update(start, OpType::op(tad[i0 * tadStride[0]], extraParams), extraParams);
+                        for (uint i0 = 0; i0 < tadLen; ++i0)
+                            start = OpType::update(start, OpType::op(tad[i0 * tadStride[0]], extraParams), extraParams);
 
-                    z[i] = OpType::postProcess(start, tadLen, extraParams);
-                }
+                        z[i] = OpType::postProcess(start, tadLen, extraParams);
+                    }
+                }, 1, numThreads);
             }
                 break;
 
             //*********************************************//
             case LoopKind::RANK2: {
 
-                PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
-                for (uint i = 0; i < zLen; ++i) {
-                    auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
+                Executor::parallel_for(0, zLen, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i = from; i < to; i++) {
+                        auto tad = x + tadOffsets[i];
+                        auto start = OpType::startingValue(tad);
 
-                    for (uint i0 = 0; i0 < tadShape[0]; ++i0)
-                        for (uint i1 = 0; i1 < tadShape[1]; ++i1)
-                            start = OpType::update(start, OpType::op(tad[i0*tadStride[0] + i1*tadStride[1]], extraParams), extraParams);
+                        for (uint i0 = 0; i0 < tadShape[0]; ++i0)
+                            for (uint i1 = 0; i1 < tadShape[1]; ++i1)
+                                start = OpType::update(start, OpType::op(tad[i0*tadStride[0] + i1*tadStride[1]], extraParams), extraParams);
 
-                    z[i] = OpType::postProcess(start, tadLen, extraParams);
-                }
+                        z[i] = OpType::postProcess(start, tadLen, extraParams);
+                    }
+                }, 1, numThreads);
             }
                 break;
 
             //*********************************************//
             case LoopKind::RANK3: {
 
-                PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
-                for (uint i = 0; i < zLen; ++i) {
-                    auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
+                Executor::parallel_for(0, zLen, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i = from; i < to; i++) {
+                        auto tad = x + tadOffsets[i];
+                        auto start = OpType::startingValue(tad);
 
-                    for (uint i0 = 0; i0 < tadShape[0]; ++i0)
-                        for (uint i1 = 0; i1 < tadShape[1]; ++i1)
-                            for (uint i2 = 0; i2 < tadShape[2]; ++i2)
-                                start = OpType::update(start, OpType::op(tad[i0*tadStride[0] + i1*tadStride[1] + i2*tadStride[2]], extraParams), extraParams);
+                        for (uint i0 = 0; i0 < tadShape[0]; ++i0)
+                            for (uint i1 = 0; i1 < tadShape[1]; ++i1)
+                                for (uint i2 = 0; i2 < tadShape[2]; ++i2)
+                                    start = OpType::update(start, OpType::op(tad[i0*tadStride[0] + i1*tadStride[1] + i2*tadStride[2]], extraParams), extraParams);
 
-                    z[i] = OpType::postProcess(start, tadLen, extraParams);
-                }
+                        z[i] = OpType::postProcess(start, tadLen, extraParams);
+                    }
+                }, 1, numThreads);
             }
                 break;
 
             //*********************************************//
             case LoopKind::RANK4: {
 
-                PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
-                for (uint i = 0; i < zLen; ++i) {
-                    auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
+                Executor::parallel_for(0, zLen, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i = from; i < to; i++) {
+                        auto tad = x + tadOffsets[i];
+                        auto start = OpType::startingValue(tad);
 
-                    for (uint i0 = 0; i0 < tadShape[0]; ++i0)
-                        for (uint i1 = 0; i1 < tadShape[1]; ++i1)
-                            for (uint i2 = 0; i2 < tadShape[2]; ++i2)
-                                for (uint i3 = 0; i3 < tadShape[3]; ++i3)
-                                    start = OpType::update(start, OpType::op(tad[i0*tadStride[0] + i1*tadStride[1] + i2*tadStride[2] + i3*tadStride[3]], extraParams), extraParams);
+                        for (uint i0 = 0; i0 < tadShape[0]; ++i0)
+                            for (uint i1 = 0; i1 < tadShape[1]; ++i1)
+                                for (uint i2 = 0; i2 < tadShape[2]; ++i2)
+                                    for (uint i3 = 0; i3 < tadShape[3]; ++i3)
+                                        start = OpType::update(start, OpType::op(tad[i0*tadStride[0] + i1*tadStride[1] + i2*tadStride[2] + i3*tadStride[3]], extraParams), extraParams);
 
-                    z[i] = OpType::postProcess(start, tadLen, extraParams);
-                }
+                        z[i] = OpType::postProcess(start, tadLen, extraParams);
+                    }
+                }, 1, numThreads);
             }
                 break;
 
             //*********************************************//
             case LoopKind::RANK5: {
 
-                PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
-                for (uint i = 0; i < zLen; ++i) {
-                    auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
+                Executor::parallel_for(0, zLen, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i = from; i < to; i++) {
+                        auto tad = x + tadOffsets[i];
+                        auto start = OpType::startingValue(tad);
 
-                    for (uint i0 = 0; i0 < tadShape[0]; ++i0)
-                        for (uint i1 = 0; i1 < tadShape[1]; ++i1)
-                            for (uint i2 = 0; i2 < tadShape[2]; ++i2)
-                                for (uint i3 = 0; i3 < tadShape[3]; ++i3)
-                                    for (uint i4 = 0; i4 < tadShape[4]; ++i4)
-                                        start = OpType::update(start, OpType::op(tad[i0*tadStride[0] + i1*tadStride[1] + i2*tadStride[2] + i3*tadStride[3] + i4*tadStride[4] ], extraParams), extraParams);
+                        for (uint i0 = 0; i0 < tadShape[0]; ++i0)
+                            for (uint i1 = 0; i1 < tadShape[1]; ++i1)
+                                for (uint i2 = 0; i2 < tadShape[2]; ++i2)
+                                    for (uint i3 = 0; i3 < tadShape[3]; ++i3)
+                                        for (uint i4 = 0; i4 < tadShape[4]; ++i4)
+                                            start = OpType::update(start, OpType::op(tad[i0*tadStride[0] + i1*tadStride[1] + i2*tadStride[2] + i3*tadStride[3] + i4*tadStride[4] ], extraParams), extraParams);
 
-                    z[i] = OpType::postProcess(start, tadLen, extraParams);
-                }
+                        z[i] = OpType::postProcess(start, tadLen, extraParams);
+                    }
+                }, 1, numThreads);
             }
                 break;
 
@@ -444,17 +562,18 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 uint castZShapeInfo[MAX_RANK];
                 const bool canCastZ   = nd4j::DataTypeUtils::castShapeInfo<uint>(zShapeInfo,   castZShapeInfo);
 
-                PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
-                for (uint i = 0; i < zLen; i++) {
-                    auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
+                Executor::parallel_for(0, zLen, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i = from; i < to; i++) {
+                        auto tad = x + tadOffsets[i];
+                        auto start = OpType::startingValue(tad);
 
-                    for (uint j = 0; j < tadLen; j++)
-                        start = OpType::update(start, OpType::op(tad[j * tadEws], extraParams), extraParams);
+                        for (uint j = 0; j < tadLen; j++)
+                            start = OpType::update(start, OpType::op(tad[j * tadEws], extraParams), extraParams);
 
-                    auto zOffset = shape::indexOffset(i, zShapeInfo, castZShapeInfo, canCastZ);
-                    z[zOffset] = OpType::postProcess(start, tadLen, extraParams);
-                }
+                        auto zOffset = shape::indexOffset(i, zShapeInfo, castZShapeInfo, canCastZ);
+                        z[zOffset] = OpType::postProcess(start, tadLen, extraParams);
+                    }
+                }, 1, numThreads);
             }
                 break;
 
@@ -463,18 +582,19 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 uint castTadShapeInfo[MAX_RANK];
                 const bool canCastTad = nd4j::DataTypeUtils::castShapeInfo<uint>(tadShapeInfo, castTadShapeInfo);
 
-                PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
-                for (uint i = 0; i < zLen; i++) {
-                    auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
+                Executor::parallel_for(0, zLen, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i = from; i < to; i++) {
+                        auto tad = x + tadOffsets[i];
+                        auto start = OpType::startingValue(tad);
 
-                    for (uint j = 0; j < tadLen; j++) {
-                        auto tadOffset = shape::indexOffset(j, tadShapeInfo, castTadShapeInfo, canCastTad);
-                        start = OpType::update(start, OpType::op(tad[tadOffset], extraParams), extraParams);
-                    }
+                        for (uint j = 0; j < tadLen; j++) {
+                            auto tadOffset = shape::indexOffset(j, tadShapeInfo, castTadShapeInfo, canCastTad);
+                            start = OpType::update(start, OpType::op(tad[tadOffset], extraParams), extraParams);
+                        }
 
-                    z[i * zEws] = OpType::postProcess(start, tadLen, extraParams);
-                }
+                        z[i * zEws] = OpType::postProcess(start, tadLen, extraParams);
+                    }
+                }, 1, numThreads);
             }
                 break;
 
@@ -509,17 +629,18 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 uint castZShapeInfo[MAX_RANK];
                 const bool canCastZ   = nd4j::DataTypeUtils::castShapeInfo<uint>(zShapeInfo,   castZShapeInfo);
 
-                PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
-                for (uint i = 0; i < zLen; i++) {
-                    auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
+                Executor::parallel_for(0, zLen, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i = from; i < to; i++) {
+                        auto tad = x + tadOffsets[i];
+                        auto start = OpType::startingValue(tad);
 
-                    for (uint j = 0; j < tadLen; j++)
-                        start = OpType::update(start, OpType::op(tad[innertadOffsets[j]], extraParams), extraParams);
+                        for (uint j = 0; j < tadLen; j++)
+                            start = OpType::update(start, OpType::op(tad[innertadOffsets[j]], extraParams), extraParams);
 
-                    auto zOffset = shape::indexOffset(i, zShapeInfo, castZShapeInfo, canCastZ);
-                    z[zOffset] = OpType::postProcess(start, tadLen, extraParams);
-                }
+                        auto zOffset = shape::indexOffset(i, zShapeInfo, castZShapeInfo, canCastZ);
+                        z[zOffset] = OpType::postProcess(start, tadLen, extraParams);
+                    }
+                }, 1, numThreads);
 
                 delete []innertadOffsets;
             }
@@ -603,11 +724,8 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
             //*********************************************//
             case LoopKind::EWS1: {
 
-                PRAGMA_OMP_PARALLEL_THREADS(threadsInfo._numThreads)
-                {
-                    const auto threadNum = omp_get_thread_num();
-                    const auto threadOffset = threadsInfo.getThreadOffset(threadNum);
-                    const auto lenPerThread = static_cast<uint>(threadsInfo.getItersPerThread(threadNum));
+                Executor::parallel_for(0, len, [&](Nd4jLong threadOffset, Nd4jLong stop) {
+                    const auto lenPerThread = static_cast<uint>(stop - threadOffset);
 
                     const auto xi = x + threadOffset;
                     const auto zi = z + threadOffset;
@@ -615,7 +733,7 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                     PRAGMA_OMP_SIMD
                     for (uint i = 0; i < lenPerThread; i++)
                         zi[i] = OpType::op(xi[i], extraParams);
-                }
+                }, 1, threadsInfo._numThreads);
             }
                 break;
 
@@ -624,11 +742,8 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 const uint xEws = shape::elementWiseStride(xShapeInfo);
                 const uint zEws = shape::elementWiseStride(zShapeInfo);
 
-                PRAGMA_OMP_PARALLEL_THREADS(threadsInfo._numThreads)
-                {
-                    const auto threadNum = omp_get_thread_num();
-                    const auto threadOffset = threadsInfo.getThreadOffset(threadNum);
-                    const auto lenPerThread = static_cast<uint>(threadsInfo.getItersPerThread(threadNum));
+                Executor::parallel_for(0, len, [&](Nd4jLong threadOffset, Nd4jLong stop) {
+                    const auto lenPerThread = static_cast<uint>(stop - threadOffset);
 
                     const auto xi = x + threadOffset * xEws;
                     auto zi = z + threadOffset * zEws;
@@ -636,7 +751,7 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                     PRAGMA_OMP_SIMD
                     for (uint i = 0; i < lenPerThread; i++)
                         zi[i*zEws] = OpType::op(xi[i*xEws], extraParams);
-                }
+                }, 1, threadsInfo._numThreads);
             }
                 break;
 
@@ -646,11 +761,8 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 uint castXShapeInfo[MAX_RANK];
                 const bool canCastX = nd4j::DataTypeUtils::castShapeInfo<uint>(xShapeInfo, castXShapeInfo);
 
-                PRAGMA_OMP_PARALLEL_THREADS(threadsInfo._numThreads)
-                {
-                    const auto threadNum = omp_get_thread_num();
-                    const auto threadOffset = threadsInfo.getThreadOffset(threadNum);
-                    const auto lenPerThread = static_cast<uint>(threadsInfo.getItersPerThread(threadNum));
+                Executor::parallel_for(0, len, [&](Nd4jLong threadOffset, Nd4jLong stop) {
+                    const auto lenPerThread = static_cast<uint>(stop - threadOffset);
 
                     auto zi = z + threadOffset * zEws;
 
@@ -668,15 +780,17 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                             zi[i] = OpType::op(x[xOffset], extraParams);
                         }
                     }
-                }
+                }, 1, threadsInfo._numThreads);
             }
                 break;
 
                 //*********************************************//
             case LoopKind::RANK1: {
-                PRAGMA_OMP_PARALLEL_FOR_SIMD_THREADS(threadsInfo._numThreads)
-                for (uint i0 = 0; i0 < len; ++i0)
-                    z[i0 * zStride[0]] = OpType::op(x[i0 * xStride[0]], extraParams);
+                Executor::parallel_for(0, len, [&](Nd4jLong from, Nd4jLong to) {
+                    PRAGMA_OMP_SIMD
+                    for (auto i0 = from; i0 < to; ++i0)
+                        z[i0 * zStride[0]] = OpType::op(x[i0 * xStride[0]], extraParams);
+                }, 1, threadsInfo._numThreads);
             }
                 break;
 
@@ -685,15 +799,15 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 auto uXShape0 = static_cast<uint>(xShape[0]);
                 auto uXShape1 = static_cast<uint>(xShape[1]);
 
-                //PRAGMA_OMP_PARALLEL_FOR_SIMD_THREADS(threadsInfo._numThreads)
-                PRAGMA_OMP_PARALLEL_FOR_SIMD
-                for (uint i0 = 0; i0 < uXShape0; ++i0) {
+                Executor::parallel_for(0, uXShape0, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i0 = from; i0 < to; ++i0) {
 
-                    auto z0 = i0 * zStride[0];
-                    auto x0 = i0 * xStride[0];
-                    for (uint i1 = 0; i1 < uXShape1; ++i1)
-                        z[z0 + i1 * zStride[1]] = OpType::op(x[x0 + i1 * xStride[1]], extraParams);
-                }
+                        auto z0 = i0 * zStride[0];
+                        auto x0 = i0 * xStride[0];
+                        for (uint i1 = 0; i1 < uXShape1; ++i1)
+                            z[z0 + i1 * zStride[1]] = OpType::op(x[x0 + i1 * xStride[1]], extraParams);
+                    }
+                }, 1, threadsInfo._numThreads);
             }
                 break;
 
@@ -703,9 +817,11 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 auto uXShape1 = static_cast<uint>(xShape[1]);
                 auto uXShape2 = static_cast<uint>(xShape[2]);
 
-                PRAGMA_OMP_PARALLEL_FOR_SIMD_THREADS_COLLAPSE(threadsInfo._numThreads, 2)
-                for (uint i0 = 0; i0 < uXShape0; ++i0)
-                    for (uint i1 = 0; i1 < uXShape1; ++i1) {
+                // two outer dimensions flattened, same as collapse(2)
+                Executor::parallel_for(0, (Nd4jLong) uXShape0 * uXShape1, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i = from; i < to; i++) {
+                        const auto i0 = i / uXShape1;
+                        const auto i1 = i % uXShape1;
 
                         auto z0 = i0 * zStride[0] + i1 * zStride[1];
                         auto x0 = i0 * xStride[0] + i1 * xStride[1];
@@ -713,6 +829,7 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                         for (uint i2 = 0; i2 < uXShape2; ++i2)
                             z[z0 + i2 * zStride[2]] = OpType::op(x[x0 + i2 * xStride[2]], extraParams);
                     }
+                }, 1, threadsInfo._numThreads);
             }
                 break;
 
@@ -723,9 +840,11 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 auto uXShape2 = static_cast<uint>(xShape[2]);
                 auto uXShape3 = static_cast<uint>(xShape[3]);
 
-                PRAGMA_OMP_PARALLEL_FOR_SIMD_THREADS_COLLAPSE(threadsInfo._numThreads, 2)
-                for (uint i0 = 0; i0 < uXShape0; ++i0)
-                    for (uint i1 = 0; i1 < uXShape1; ++i1)
+                Executor::parallel_for(0, (Nd4jLong) uXShape0 * uXShape1, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i = from; i < to; i++) {
+                        const auto i0 = i / uXShape1;
+                        const auto i1 = i % uXShape1;
+
                         for (uint i2 = 0; i2 < uXShape2; ++i2) {
 
                             auto x0 = i0 * xStride[0] + i1 * xStride[1] + i2 * xStride[2];
@@ -734,6 +853,8 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                             for (uint i3 = 0; i3 < uXShape3; ++i3)
                                 z[z0 + i3 * zStride[3]] = OpType::op(x[x0 + i3 * xStride[3]], extraParams);
                         }
+                    }
+                }, 1, threadsInfo._numThreads);
             }
                 break;
 
@@ -745,24 +866,26 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 auto uXShape3 = static_cast<uint>(xShape[3]);
                 auto uXShape4 = static_cast<uint>(xShape[4]);
 
-                PRAGMA_OMP_PARALLEL_FOR_SIMD_THREADS_COLLAPSE(threadsInfo._numThreads, 3)
-                for (uint i0 = 0; i0 < uXShape0; ++i0)
-                    for (uint i1 = 0; i1 < uXShape1; ++i1)
-                        for (uint i2 = 0; i2 < uXShape2; ++i2) {
+                Executor::parallel_for(0, (Nd4jLong) uXShape0 * uXShape1 * uXShape2, [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto i = from; i < to; i++) {
+                        const auto i0 = i / (uXShape1 * uXShape2);
+                        const auto i1 = (i / uXShape2) % uXShape1;
+                        const auto i2 = i % uXShape2;
 
-                            auto z0 = i0 * zStride[0] + i1 * zStride[1] + i2 * zStride[2];
-                            auto x0 = i0 * xStride[0] + i1 * xStride[1] + i2 * xStride[2];
+                        auto z0 = i0 * zStride[0] + i1 * zStride[1] + i2 * zStride[2];
+                        auto x0 = i0 * xStride[0] + i1 * xStride[1] + i2 * xStride[2];
 
-                            for (uint i3 = 0; i3 < uXShape3; ++i3) {
+                        for (uint i3 = 0; i3 < uXShape3; ++i3) {
 
-                                auto z1 = z0 + i3 * zStride[3];
-                                auto x1 = x0 + i3 * xStride[3];
+                            auto z1 = z0 + i3 * zStride[3];
+                            auto x1 = x0 + i3 * xStride[3];
 
-                                for (uint i4 = 0; i4 < uXShape4; ++i4)
-                                    z[z1 + i4 * zStride[4]] = OpType::op(x[x1 + i4 * xStride[4]], extraParams);
+                            for (uint i4 = 0; i4 < uXShape4; ++i4)
+                                z[z1 + i4 * zStride[4]] = OpType::op(x[x1 + i4 * xStride[4]], extraParams);
 
-                            }
                         }
+                    }
+                }, 1, threadsInfo._numThreads);
             }
                 break;
 
@@ -774,11 +897,8 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 bool canCastX = DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
                 bool canCastZ = DataTypeUtils::castShapeInfo(zShapeInfo, zShapeInfoCast);
 
-                PRAGMA_OMP_PARALLEL_THREADS(threadsInfo._numThreads)
-                {
-                    auto threadNum = omp_get_thread_num();
-                    auto threadOffset = threadsInfo.getThreadOffset(threadNum);
-                    auto lenPerThread = static_cast<uint>(threadsInfo.getItersPerThread(threadNum));
+                Executor::parallel_for(0, len, [&](Nd4jLong threadOffset, Nd4jLong stop) {
+                    const auto lenPerThread = static_cast<uint>(stop - threadOffset);
 
                     PRAGMA_OMP_SIMD
                     for (uint i = 0; i < lenPerThread; i++) {
@@ -786,7 +906,7 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                         auto zOffset = shape::indexOffset(i + threadOffset, zShapeInfo, zShapeInfoCast, canCastZ);
                         z[zOffset] = OpType::op(x[xOffset], extraParams);
                     }
-                }
+                }, 1, threadsInfo._numThreads);
             }
 
             // default: {
@@ -902,7 +1022,7 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
         }
 
 
-        const LoopKind::Kind kindOfLoop = LoopKind::deduceKindOfLoopTadXYZ(xTadShapeInfo, yTadShapeInfo, zShapeInfo);
+        const LoopKind::Kind kindOfLoop = LoopKind::deduceKindOfReduce3TadXYZ(xTadShapeInfo, yTadShapeInfo, zShapeInfo);
 
         const auto xTadEws = shape::elementWiseStride(xTadShapeInfo);
         const auto yTadEws = shape::elementWiseStride(yTadShapeInfo);
@@ -919,6 +1039,52 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
 
         switch (kindOfLoop) {
 
+            //*********************************************//
+            case LoopKind::SPLITK: {
+                // few long tads: every tad is split into numSplits parts, each part gets its own copy of extraParams
+                const Nd4jLong numSplits = nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(Environment::getInstance()->maxThreads() / zLen, tadLen / Environment::getInstance()->elementwiseThreshold()));
+                const Nd4jLong span = (tadLen + numSplits - 1) / numSplits;
+
+                auto partials = new Z[zLen * numSplits];
+                auto partialParams = new Z[zLen * numSplits * 3];
+
+                Executor::parallel_tasks(zLen * numSplits, [&](int task) {
+                    auto localParams = partialParams + task * 3;
+                    localParams[0] = param0;
+                    localParams[1] = param1;
+                    localParams[2] = param2;
+
+                    const auto i = task / numSplits;
+                    const auto xTad  = xTadOffsets ? x + xTadOffsets[i] : x;
+                    const auto yTad  = yTadOffsets ? y + yTadOffsets[i] : y;
+                          auto start = OpType::startingValue(xTad);
+
+                    const auto from = (task % numSplits) * span;
+                    const auto to = nd4j::math::nd4j_min<Nd4jLong>(tadLen, from + span);
+
+                    for (auto j = from; j < to; j++)
+                        start = OpType::update(start, OpType::op(xTad[j * xTadEws], yTad[j * yTadEws], localParams), localParams);
+
+                    partials[task] = start;
+                });
+
+                for (Nd4jLong i = 0; i < zLen; i++) {
+                    auto totalParams = partialParams + i * numSplits * 3;
+                    auto start = partials[i * numSplits];
+
+                    for (Nd4jLong e = 1; e < numSplits; e++) {
+                        start = OpType::update(start, partials[i * numSplits + e], totalParams);
+                        OpType::aggregateExtraParams(totalParams, partialParams + (i * numSplits + e) * 3);
+                    }
+
+                    z[i * zEws] = OpType::postProcess(start, tadLen, totalParams);
+                }
+
+                delete []partials;
+                delete []partialParams;
+            }
+                break;
+
             //*********************************************//
             case LoopKind::EWS1: {
 
@@ -0,0 +1,259 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Counter-based Philox4x32-10 generator, producing random buffers in bulk
+//
+
+#ifndef LIBND4J_PHILOXRANDOM_H
+#define LIBND4J_PHILOXRANDOM_H
+
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <templatemath.h>
+#include <graph/RandomGenerator.h>
+#include <type_traits>
+
+namespace nd4j {
+    namespace random {
+
+        /**
+         * Philox4x32-10 keyed by root state of RandomGenerator, with node state in upper half of counter.
+         * Value number i is lane i % 4 of block i / 4, so every value depends on seeds and index only:
+         * results are the same for any split of work between threads.
+         *
+         * Blocks are generated in batches of BATCH, with every round applied to the whole batch, so it's vectorized by compiler.
+         * Independent streams (i.e. resampling rounds) of the same generator are selected by stream argument
+         */
+        class ND4J_EXPORT PhiloxRandom {
+        public:
+            static const int BATCH = 16;
+            static const int LENGTH = 4 * BATCH;
+
+        private:
+            uint32_t _key0;
+            uint32_t _key1;
+            uint32_t _node0;
+            uint32_t _node1;
+            uint32_t _stream;
+
+            static FORCEINLINE void mulhilo(uint32_t a, uint32_t b, uint32_t &hi, uint32_t &lo) {
+                auto product = static_cast<uint64_t>(a) * static_cast<uint64_t>(b);
+                hi = static_cast<uint32_t>(product >> 32);
+                lo = static_cast<uint32_t>(product);
+            }
+
+            // computation type of transforms: double for double, float for everything else
+            template <typename T>
+            using Compute = typename std::conditional<std::is_same<T, double>::value, double, float>::type;
+
+            // [0, 1)
+            template <typename C>
+            static FORCEINLINE C unit(uint32_t x) {
+                return std::is_same<C, double>::value ? static_cast<C>(static_cast<double>(x) * 2.3283064365386963e-10) : static_cast<C>(static_cast<float>(x >> 8) * 5.9604644775390625e-8f);
+            }
+
+            // (0, 1], safe for log
+            template <typename C>
+            static FORCEINLINE C unitOpen(uint32_t x) {
+                return std::is_same<C, double>::value ? static_cast<C>((static_cast<double>(x) + 1.0) * 2.3283064365386963e-10) : static_cast<C>(static_cast<float>((x >> 8) + 1) * 5.9604644775390625e-8f);
+            }
+
+        public:
+            explicit PhiloxRandom(nd4j::graph::RandomGenerator &rng, uint32_t stream = 0) {
+                auto root = static_cast<uint64_t>(rng.rootState());
+                auto node = static_cast<uint64_t>(rng.nodeState());
+
+                _key0 = static_cast<uint32_t>(root);
+                _key1 = static_cast<uint32_t>(root >> 32);
+                _node0 = static_cast<uint32_t>(node);
+                _node1 = static_cast<uint32_t>(node >> 32);
+                _stream = stream;
+            }
+
+            /**
+             * This method generates BATCH consecutive blocks starting from block first, lanes of every block are stored next to each other
+             */
+            void blocks(uint64_t first, uint32_t *out) const {
+                uint32_t c0[BATCH], c1[BATCH], c2[BATCH], c3[BATCH];
+
+                PRAGMA_OMP_SIMD
+                for (int j = 0; j < BATCH; j++) {
+                    auto block = first + j;
+                    c0[j] = static_cast<uint32_t>(block);
+                    c1[j] = static_cast<uint32_t>(block >> 32) ^ (_stream << 24);
+                    c2[j] = _node0;
+                    c3[j] = _node1;
+                }
+
+                auto k0 = _key0;
+                auto k1 = _key1;
+                for (int r = 0; r < 10; r++) {
+                    PRAGMA_OMP_SIMD
+                    for (int j = 0; j < BATCH; j++) {
+                        uint32_t hi0, lo0, hi1, lo1;
+                        mulhilo(0xD2511F53u, c0[j], hi0, lo0);
+                        mulhilo(0xCD9E8D57u, c2[j], hi1, lo1);
+
+                        c0[j] = hi1 ^ c1[j] ^ k0;
+                        c1[j] = lo1;
+                        c2[j] = hi0 ^ c3[j] ^ k1;
+                        c3[j] = lo0;
+                    }
+
+                    k0 += 0x9E3779B9u;
+                    k1 += 0xBB67AE85u;
+                }
+
+                for (int j = 0; j < BATCH; j++) {
+                    out[4 * j] = c0[j];
+                    out[4 * j + 1] = c1[j];
+                    out[4 * j + 2] = c2[j];
+                    out[4 * j + 3] = c3[j];
+                }
+            }
+
+            /**
+             * This method generates single block, it's the same block batches contain
+             */
+            FORCEINLINE void block(uint64_t index, uint32_t *out) const {
+                uint32_t c0 = static_cast<uint32_t>(index);
+                uint32_t c1 = static_cast<uint32_t>(index >> 32) ^ (_stream << 24);
+                uint32_t c2 = _node0;
+                uint32_t c3 = _node1;
+
+                auto k0 = _key0;
+                auto k1 = _key1;
+                for (int r = 0; r < 10; r++) {
+                    uint32_t hi0, lo0, hi1, lo1;
+                    mulhilo(0xD2511F53u, c0, hi0, lo0);
+                    mulhilo(0xCD9E8D57u, c2, hi1, lo1);
+
+                    c0 = hi1 ^ c1 ^ k0;
+                    c1 = lo1;
+                    c2 = hi0 ^ c3 ^ k1;
+                    c3 = lo0;
+
+                    k0 += 0x9E3779B9u;
+                    k1 += 0xBB67AE85u;
+                }
+
+                out[0] = c0;
+                out[1] = c1;
+                out[2] = c2;
+                out[3] = c3;
+            }
+
+            /**
+             * This method returns single value with given index, it's the same value bulk methods produce for this index
+             */
+            FORCEINLINE uint32_t value(Nd4jLong index) const {
+                uint32_t out[4];
+                block(static_cast<uint64_t>(index) / 4, out);
+                return out[index % 4];
+            }
+
+            /**
+             * This method returns single normal value with given index, it's the same value gaussian() produces for this index
+             */
+            template <typename T>
+            FORCEINLINE T gaussian(Nd4jLong index, T mean, T stddev) const {
+                typedef Compute<T> C;
+                uint32_t out[4];
+                block(static_cast<uint64_t>(index) / 4, out);
+
+                auto lane = index % 4;
+                auto pair = lane - lane % 2;
+                auto radius = nd4j::math::nd4j_sqrt<C, C>(static_cast<C>(-2.f) * nd4j::math::nd4j_log<C, C>(unitOpen<C>(out[pair]))) * static_cast<C>(stddev);
+                auto angle = static_cast<C>(6.283185307179586) * unit<C>(out[pair + 1]);
+
+                return static_cast<T>((lane % 2 == 0 ? radius * nd4j::math::nd4j_cos<C, C>(angle) : radius * nd4j::math::nd4j_sin<C, C>(angle)) + static_cast<C>(mean));
+            }
+
+            /**
+             * This method stores uniform values of indices [first, first + length) in [from, to) to z with given stride
+             */
+            template <typename T>
+            void uniform(Nd4jLong first, Nd4jLong length, T *z, Nd4jLong zStride, T from, T to) const {
+                typedef Compute<T> C;
+                uint32_t raw[LENGTH];
+                C values[LENGTH];
+
+                const auto cFrom = static_cast<C>(from);
+                const auto cRange = static_cast<C>(to) - static_cast<C>(from);
+
+                for (auto start = first - first % LENGTH; start < first + length; start += LENGTH) {
+                    blocks(static_cast<uint64_t>(start) / 4, raw);
+
+                    PRAGMA_OMP_SIMD
+                    for (int j = 0; j < LENGTH; j++)
+                        values[j] = cFrom + unit<C>(raw[j]) * cRange;
+
+                    store(values, start, first, length, z, zStride);
+                }
+            }
+
+            /**
+             * This method stores normal values of indices [first, first + length) with given mean and stddev to z with given stride.
+             * Box-Muller transform maps lanes 0,1 and lanes 2,3 of every block to two normal values each
+             */
+            template <typename T>
+            void gaussian(Nd4jLong first, Nd4jLong length, T *z, Nd4jLong zStride, T mean, T stddev) const {
+                typedef Compute<T> C;
+                uint32_t raw[LENGTH];
+                C values[LENGTH];
+
+                const auto cMean = static_cast<C>(mean);
+                const auto cStddev = static_cast<C>(stddev);
+                const auto twoPi = static_cast<C>(6.283185307179586);
+
+                for (auto start = first - first % LENGTH; start < first + length; start += LENGTH) {
+                    blocks(static_cast<uint64_t>(start) / 4, raw);
+
+                    PRAGMA_OMP_SIMD
+                    for (int j = 0; j < LENGTH / 2; j++) {
+                        auto radius = nd4j::math::nd4j_sqrt<C, C>(static_cast<C>(-2.f) * nd4j::math::nd4j_log<C, C>(unitOpen<C>(raw[2 * j]))) * cStddev;
+                        auto angle = twoPi * unit<C>(raw[2 * j + 1]);
+
+                        values[2 * j] = radius * nd4j::math::nd4j_cos<C, C>(angle) + cMean;
+                        values[2 * j + 1] = radius * nd4j::math::nd4j_sin<C, C>(angle) + cMean;
+                    }
+
+                    store(values, start, first, length, z, zStride);
+                }
+            }
+
+        private:
+            // copies part of batch [start, start + LENGTH) that falls into [first, first + length)
+            template <typename C, typename T>
+            static FORCEINLINE void store(const C *values, Nd4jLong start, Nd4jLong first, Nd4jLong length, T *z, Nd4jLong zStride) {
+                auto from = nd4j::math::nd4j_max<Nd4jLong>(start, first);
+                auto to = nd4j::math::nd4j_min<Nd4jLong>(start + LENGTH, first + length);
+
+                if (zStride == 1) {
+                    for (auto i = from; i < to; i++)
+                        z[i - first] = static_cast<T>(values[i - start]);
+                } else {
+                    for (auto i = from; i < to; i++)
+                        z[(i - first) * zStride] = static_cast<T>(values[i - start]);
+                }
+            }
+        };
+    }
+}
+
+#endif //LIBND4J_PHILOXRANDOM_H
@@ -0,0 +1,229 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Stable parallel radix partition and open-addressing hash table, used by hash-based set ops
+//
+
+#ifndef LIBND4J_RADIXPARTITION_H
+#define LIBND4J_RADIXPARTITION_H
+
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <execution/Executor.h>
+#include <templatemath.h>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace nd4j {
+    /**
+     * Hash of value, equal values have equal hashes (including -0.0 and 0.0)
+     */
+    class ND4J_EXPORT ValueHash {
+    private:
+        static FORCEINLINE uint64_t mix(uint64_t h) {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        template <typename T>
+        static FORCEINLINE uint64_t bits(T value, std::true_type) {
+            return static_cast<uint64_t>(value);
+        }
+
+        template <typename T>
+        static FORCEINLINE uint64_t bits(T value, std::false_type) {
+            double d = static_cast<double>(value);
+            if (d == 0.0)
+                d = 0.0;
+
+            uint64_t result;
+            memcpy(&result, &d, sizeof(double));
+            return result;
+        }
+
+    public:
+        template <typename T>
+        static FORCEINLINE uint64_t hash(T value) {
+            return mix(bits<T>(value, std::integral_constant<bool, std::is_integral<T>::value>()));
+        }
+    };
+
+    /**
+     * Open-addressing (linear probing) table of keys with non-negative payloads, capacity is fixed at construction
+     */
+    template <typename T>
+    class OpenHashTable {
+    private:
+        std::vector<T> _keys;
+        std::vector<Nd4jLong> _payloads;
+        uint64_t _mask;
+
+    public:
+        explicit OpenHashTable(Nd4jLong expected) {
+            uint64_t capacity = 16;
+            while (capacity < 2 * (uint64_t) expected)
+                capacity <<= 1;
+
+            _keys.resize(capacity);
+            _payloads.resize(capacity, -1);
+            _mask = capacity - 1;
+        }
+
+        /**
+         * This method returns payload of key, given payload is stored if key wasn't there yet
+         */
+        FORCEINLINE Nd4jLong insert(const T &key, uint64_t hash, Nd4jLong payload) {
+            for (auto slot = hash & _mask; ; slot = (slot + 1) & _mask) {
+                if (_payloads[slot] < 0) {
+                    _keys[slot] = key;
+                    _payloads[slot] = payload;
+                    return payload;
+                }
+
+                const T stored = _keys[slot];
+                if (stored == key)
+                    return _payloads[slot];
+            }
+        }
+
+        /**
+         * This method returns payload of key, or -1 if there's no such key
+         */
+        FORCEINLINE Nd4jLong find(const T &key, uint64_t hash) const {
+            for (auto slot = hash & _mask; ; slot = (slot + 1) & _mask) {
+                if (_payloads[slot] < 0)
+                    return -1;
+
+                const T stored = _keys[slot];
+                if (stored == key)
+                    return _payloads[slot];
+            }
+        }
+    };
+
+    class ND4J_EXPORT RadixPartition {
+    public:
+        static const Nd4jLong GRAIN = 32768;
+
+        /**
+         * This method returns number of contiguous chunks [0, length) is split into by partition and prefix methods
+         */
+        static int numberOfChunks(Nd4jLong length) {
+            return (int) nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(length / GRAIN, Executor::numberOfWorkers() + 1));
+        }
+
+        /**
+         * This method groups indices [0, length) by partitionOf(index) within [0, numPartitions), negative partitions are dropped.
+         * Every chunk counts its own histogram first, then scatters to offsets of (partition, chunk), so order of indices within partition is preserved.
+         *
+         * @param order - indices grouped by partition
+         * @param offsets - numPartitions + 1 offsets of partitions within order
+         */
+        template <typename F>
+        static void partition(Nd4jLong length, int numPartitions, const F &partitionOf, std::vector<Nd4jLong> &order, std::vector<Nd4jLong> &offsets) {
+            const int numChunks = numberOfChunks(length);
+            const Nd4jLong chunk = length / numChunks;
+
+            std::vector<int> partitions(length);
+            std::vector<Nd4jLong> counts((size_t) numChunks * numPartitions, 0);
+
+            Executor::parallel_tasks(numChunks, [&](int c) {
+                const auto start = c * chunk;
+                const auto stop = c == numChunks - 1 ? length : start + chunk;
+                auto histogram = counts.data() + (size_t) c * numPartitions;
+
+                for (Nd4jLong e = start; e < stop; e++) {
+                    auto p = partitionOf(e);
+                    partitions[e] = p;
+                    if (p >= 0)
+                        histogram[p]++;
+                }
+            });
+
+            // partitions first, chunks second: deterministic regardless of threads
+            offsets.assign(numPartitions + 1, 0);
+            Nd4jLong total = 0;
+            for (int p = 0; p < numPartitions; p++) {
+                offsets[p] = total;
+                for (int c = 0; c < numChunks; c++) {
+                    auto count = counts[(size_t) c * numPartitions + p];
+                    counts[(size_t) c * numPartitions + p] = total;
+                    total += count;
+                }
+            }
+            offsets[numPartitions] = total;
+
+            order.resize(total);
+            Executor::parallel_tasks(numChunks, [&](int c) {
+                const auto start = c * chunk;
+                const auto stop = c == numChunks - 1 ? length : start + chunk;
+                auto positions = counts.data() + (size_t) c * numPartitions;
+
+                for (Nd4jLong e = start; e < stop; e++)
+                    if (partitions[e] >= 0)
+                        order[positions[partitions[e]]++] = e;
+            });
+        }
+
+        /**
+         * This method replaces flags[e] (0 or 1) with number of set flags before e, and returns total number of set flags
+         */
+        static Nd4jLong exclusivePrefix(std::vector<Nd4jLong> &flags) {
+            const auto length = (Nd4jLong) flags.size();
+            const int numChunks = numberOfChunks(length);
+            const Nd4jLong chunk = length / numChunks;
+
+            std::vector<Nd4jLong> sums(numChunks, 0);
+            Executor::parallel_tasks(numChunks, [&](int c) {
+                const auto start = c * chunk;
+                const auto stop = c == numChunks - 1 ? length : start + chunk;
+                Nd4jLong sum = 0;
+                for (Nd4jLong e = start; e < stop; e++) {
+                    auto flag = flags[e];
+                    flags[e] = sum;
+                    sum += flag;
+                }
+                sums[c] = sum;
+            });
+
+            Nd4jLong total = 0;
+            for (int c = 0; c < numChunks; c++) {
+                auto sum = sums[c];
+                sums[c] = total;
+                total += sum;
+            }
+
+            Executor::parallel_tasks(numChunks, [&](int c) {
+                const auto start = c * chunk;
+                const auto stop = c == numChunks - 1 ? length : start + chunk;
+                if (sums[c] > 0)
+                    for (Nd4jLong e = start; e < stop; e++)
+                        flags[e] += sums[c];
+            });
+
+            return total;
+        }
+    };
+}
+
+#endif //LIBND4J_RADIXPARTITION_H
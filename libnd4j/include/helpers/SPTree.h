@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Barnes-Hut space partitioning tree for t-SNE repulsive forces
+//
+
+#ifndef LIBND4J_SPTREE_H
+#define LIBND4J_SPTREE_H
+
+#include <NDArray.h>
+
+namespace nd4j {
+    /**
+     * Space partitioning tree (quadtree for 2D, octree for 3D etc) over rows of t-SNE embedding.
+     * Nodes are kept in flat arrays, children of a node are 2^D consecutive nodes. Every leaf holds one point, exact duplicates share a leaf.
+     * Tree layout matches SpTree of deeplearning4j-nearestneighbors, so forces are the same, except for duplicate points: here each of them interacts with all others
+     */
+    class ND4J_EXPORT SPTree {
+    public:
+        /**
+         * This method builds tree over rows of data and computes repulsive (non-edge) part of t-SNE gradient for every point in parallel:
+         * negativeForces[i] = sum(q_ij^2 * Z * (y_i - y_j)) and sumQ = sum(q_ij * Z) over j != i, with q_ij * Z = 1 / (1 + |y_i - y_j|^2).
+         * Node is used as summary of its points if its max half-width / distance to its center of mass < theta, so theta = 0 gives exact sums
+         *
+         * @param data - [N, D] matrix, D within [1, MAX_DIMENSIONS]
+         * @param negativeForces - [N, D] matrix of data type
+         * @param sumQ - scalar of data type
+         */
+        static void repulsiveForces(const NDArray &data, double theta, NDArray &negativeForces, NDArray &sumQ);
+
+        static const int MAX_DIMENSIONS = 10;
+    };
+}
+
+#endif //LIBND4J_SPTREE_H
@@ -0,0 +1,49 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Sparse x dense matrix products (SpMV/SpMM) on CSR arrays
+//
+
+#ifndef LIBND4J_SPARSEMMULHELPER_H
+#define LIBND4J_SPARSEMMULHELPER_H
+
+#include <NDArray.h>
+#include <array/SparseNDArray.h>
+
+namespace nd4j {
+    class ND4J_EXPORT SparseMmulHelper {
+    public:
+        /**
+         * This method computes C = alpha * A x B + beta * C. A is sparse [n, k] matrix, B is dense [k, m] matrix ([m, k] if transB)
+         * or [k] vector, C is dense [n, m] matrix or [n] vector. COO matrix is converted to CSR first.
+         *
+         * Rows of C are computed in parallel, all arrays must have the same floating point type
+         */
+        static void mmul(const SparseNDArray &A, const NDArray &B, NDArray &C, double alpha = 1.0, double beta = 0.0, bool transB = false);
+
+        /**
+         * This method computes z = x * y (y transposed if transY) treating dense x as sparse matrix,
+         * if fraction of non-zero elements in x is not above Environment::sparseThreshold(). Used by matmul and xw_plus_b.
+         *
+         * @return false if x isn't sparse enough or arrays aren't suitable, z is left untouched then
+         */
+        static bool mmulIfSparse(const NDArray *x, const NDArray *y, NDArray *z, bool transY = false);
+    };
+}
+
+#endif //LIBND4J_SPARSEMMULHELPER_H
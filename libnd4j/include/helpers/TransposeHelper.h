@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Cache-tiled copy between arrays of the same shape and different layouts, i.e. N-dimensional permute/transpose
+//
+
+#ifndef LIBND4J_TRANSPOSEHELPER_H
+#define LIBND4J_TRANSPOSEHELPER_H
+
+#include <dll.h>
+#include <pointercast.h>
+
+namespace nd4j {
+    class ND4J_EXPORT TransposeHelper {
+    public:
+        /**
+         * This method copies x into z. Both arrays must have the same shape and data type, strides may differ arbitrarily.
+         *
+         * Dimensions contiguous in both arrays are merged first. If innermost dimensions of x and z differ, these two dimensions
+         * are processed in square tiles (with SIMD transposes for 4 and 8 byte types where available), and tiles of all outer dimensions
+         * are processed in parallel. Otherwise rows are copied in parallel.
+         *
+         * @return false if arrays aren't supported (different shapes or data types, strings), nothing is copied then
+         */
+        static bool copy(const void *x, const Nd4jLong *xShapeInfo, void *z, const Nd4jLong *zShapeInfo, bool allowParallelism = true);
+    };
+}
+
+#endif //LIBND4J_TRANSPOSEHELPER_H
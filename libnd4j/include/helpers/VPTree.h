@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Vantage point tree over rows of a matrix, stored in two flat arrays
+//
+
+#ifndef LIBND4J_VPTREE_H
+#define LIBND4J_VPTREE_H
+
+#include <NDArray.h>
+#include <helpers/KnnHelper.h>
+
+namespace nd4j {
+    /**
+     * Tree has implicit layout, so it lives in plain arrays and can be passed between ops:
+     * node covering positions [lo, hi) has vantage point indices[lo] and radius radii[lo].
+     * Points not farther than radius from vantage point occupy [lo + 1, mid), the rest occupy [mid, hi), where mid = lo + 1 + (hi - lo - 1) / 2
+     *
+     * Metric has to satisfy triangle inequality, so only euclidean and manhattan distances are supported
+     */
+    class ND4J_EXPORT VPTree {
+    public:
+        /**
+         * This method builds tree over rows of points, level by level with nodes of each level in parallel
+         *
+         * @param points - [N, D] matrix
+         * @param indices - INT64 [N] vector, permutation of row indices
+         * @param radii - [N] vector of points type
+         */
+        static void build(const NDArray &points, int metric, NDArray &indices, NDArray &radii);
+
+        /**
+         * This method finds k nearest points for each row of queries, queries are processed in parallel.
+         * Output is the same as for KnnHelper::search()
+         */
+        static void query(const NDArray &points, const NDArray &indices, const NDArray &radii, const NDArray &queries, int k, int metric, NDArray &outIndices, NDArray &outDistances);
+
+        FORCEINLINE static Nd4jLong middle(Nd4jLong lo, Nd4jLong hi) {
+            return lo + 1 + (hi - lo - 1) / 2;
+        }
+    };
+}
+
+#endif //LIBND4J_VPTREE_H
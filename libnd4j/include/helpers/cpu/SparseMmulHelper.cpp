@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// SpMV/SpMM kernels, see SparseMmulHelper.h
+//
+
+#include <helpers/SparseMmulHelper.h>
+#include <execution/Executor.h>
+#include <Environment.h>
+#include <templatemath.h>
+#include <stdexcept>
+
+namespace nd4j {
+    // sparse path needs x converted first, that's paid off only if each row of x is used for enough columns of y
+    static const Nd4jLong MIN_SPARSE_COLUMNS = 16;
+
+    template <typename T>
+    static void csrMmul_(const SparseNDArray &a, const NDArray &bArray, Nd4jLong bStride0, Nd4jLong bStride1, Nd4jLong m,
+                         NDArray &zArray, Nd4jLong zStride0, Nd4jLong zStride1, double alpha, double beta) {
+        auto pointers = a.pointers().bufferAsT<Nd4jLong>();
+        auto columns = a.indices().bufferAsT<Nd4jLong>();
+        auto values = a.values().bufferAsT<T>();
+        auto b = bArray.bufferAsT<T>();
+        auto z = zArray.bufferAsT<T>();
+        const auto n = a.sizeAt(0);
+        const T tAlpha = static_cast<T>(alpha);
+        const T tBeta = static_cast<T>(beta);
+
+        // rows with more work per row get smaller chunks
+        const Nd4jLong work = nd4j::math::nd4j_max<Nd4jLong>(1, (pointers[n] / nd4j::math::nd4j_max<Nd4jLong>(1, n) + 1) * m);
+        const Nd4jLong grain = nd4j::math::nd4j_max<Nd4jLong>(1, 32768 / work);
+
+        Executor::parallel_for(0, n, [&](Nd4jLong from, Nd4jLong to) {
+            for (Nd4jLong r = from; r < to; r++) {
+                auto zRow = z + r * zStride0;
+
+                // SpMV: each output element is a sparse dot product
+                if (m == 1) {
+                    T sum = static_cast<T>(0);
+                    for (Nd4jLong p = pointers[r]; p < pointers[r + 1]; p++)
+                        sum += values[p] * b[columns[p] * bStride0];
+
+                    zRow[0] = beta != 0.0 ? tAlpha * sum + tBeta * zRow[0] : tAlpha * sum;
+                    continue;
+                }
+
+                if (beta == 0.0) {
+                    for (Nd4jLong j = 0; j < m; j++)
+                        zRow[j * zStride1] = static_cast<T>(0);
+                } else if (beta != 1.0) {
+                    for (Nd4jLong j = 0; j < m; j++)
+                        zRow[j * zStride1] *= tBeta;
+                }
+
+                // SpMM: row of z accumulates rows of b selected by non-zeros of row of a
+                for (Nd4jLong p = pointers[r]; p < pointers[r + 1]; p++) {
+                    const T v = tAlpha * values[p];
+                    auto bRow = b + columns[p] * bStride0;
+
+                    if (zStride1 == 1 && bStride1 == 1) {
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong j = 0; j < m; j++)
+                            zRow[j] += v * bRow[j];
+                    } else {
+                        for (Nd4jLong j = 0; j < m; j++)
+                            zRow[j * zStride1] += v * bRow[j * bStride1];
+                    }
+                }
+            }
+        }, grain);
+    }
+
+    void SparseMmulHelper::mmul(const SparseNDArray &A, const NDArray &B, NDArray &C, double alpha, double beta, bool transB) {
+        if (A.rankOf() != 2)
+            throw std::invalid_argument("SparseMmulHelper::mmul: sparse array must be a matrix");
+
+        if (A.dataType() != B.dataType() || A.dataType() != C.dataType() || !B.isR())
+            throw std::invalid_argument("SparseMmulHelper::mmul: all arrays must have the same floating point type");
+
+        const auto n = A.sizeAt(0);
+        const auto k = A.sizeAt(1);
+        const bool vector = B.rankOf() == 1;
+
+        Nd4jLong m, bStride0, bStride1, zStride0, zStride1;
+        if (vector) {
+            if (B.lengthOf() != k || C.lengthOf() != n)
+                throw std::invalid_argument("SparseMmulHelper::mmul: wrong shapes for matrix-vector product");
+
+            m = 1;
+            bStride0 = shape::stride(B.getShapeInfo())[0];
+            bStride1 = 0;
+            zStride0 = shape::stride(C.getShapeInfo())[0];
+            zStride1 = 0;
+        } else {
+            if (B.rankOf() != 2 || C.rankOf() != 2)
+                throw std::invalid_argument("SparseMmulHelper::mmul: dense arrays must be matrices");
+
+            auto bStrides = shape::stride(B.getShapeInfo());
+            m = transB ? B.sizeAt(0) : B.sizeAt(1);
+            bStride0 = transB ? bStrides[1] : bStrides[0];
+            bStride1 = transB ? bStrides[0] : bStrides[1];
+
+            if ((transB ? B.sizeAt(1) : B.sizeAt(0)) != k || C.sizeAt(0) != n || C.sizeAt(1) != m)
+                throw std::invalid_argument("SparseMmulHelper::mmul: wrong shapes for matrix product");
+
+            zStride0 = shape::stride(C.getShapeInfo())[0];
+            zStride1 = shape::stride(C.getShapeInfo())[1];
+        }
+
+        SparseNDArray converted;
+        auto csr = &A;
+        if (A.format() != SparseType::CSR) {
+            converted = A.toCsr();
+            csr = &converted;
+        }
+
+        csr->pointers().syncToHost();
+        csr->indices().syncToHost();
+        csr->values().syncToHost();
+        B.syncToHost();
+        C.syncToHost();
+
+        BUILD_SINGLE_SELECTOR(C.dataType(), csrMmul_, (*csr, B, bStride0, bStride1, m, C, zStride0, zStride1, alpha, beta), FLOAT_TYPES);
+
+        C.tickWriteHost();
+    }
+
+    bool SparseMmulHelper::mmulIfSparse(const NDArray *x, const NDArray *y, NDArray *z, bool transY) {
+        auto threshold = Environment::getInstance()->sparseThreshold();
+        if (threshold <= 0.0)
+            return false;
+
+        if (x->rankOf() != 2 || y->rankOf() != 2 || z->rankOf() != 2)
+            return false;
+
+        if (!x->isR() || x->dataType() != y->dataType() || x->dataType() != z->dataType())
+            return false;
+
+        auto m = transY ? y->sizeAt(0) : y->sizeAt(1);
+        if (m < MIN_SPARSE_COLUMNS || x->lengthOf() < Environment::getInstance()->elementwiseThreshold())
+            return false;
+
+        auto nnz = x->reduceNumber(nd4j::reduce::CountNonZero).e<Nd4jLong>(0);
+        if (static_cast<double>(nnz) > threshold * x->lengthOf())
+            return false;
+
+        auto a = SparseNDArray::fromDense(*x, SparseType::CSR);
+        mmul(a, *y, *z, 1.0, 0.0, transY);
+
+        return true;
+    }
+}
@@ -0,0 +1,242 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <helpers/TransposeHelper.h>
+#include <helpers/shape.h>
+#include <array/DataTypeUtils.h>
+#include <execution/Executor.h>
+#include <templatemath.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace nd4j {
+    // side of square tile, in elements
+    static const Nd4jLong TILE_SIZE = 32;
+
+    // minimal number of elements copied by one thread
+    static const Nd4jLong COPY_GRAIN = 32768;
+
+    struct CopyDim {
+        Nd4jLong length;
+        Nd4jLong xStride;
+        Nd4jLong zStride;
+    };
+
+    // z[b * zsB + a] = x[a * xsA + b], i.e. x is contiguous along b, z is contiguous along a
+    template <typename T>
+    static FORCEINLINE Nd4jLong transposeVectorized(const T *x, Nd4jLong xsA, T *z, Nd4jLong zsB, Nd4jLong lenA, Nd4jLong lenB, Nd4jLong &b) {
+#if defined(__SSE2__)
+        if (sizeof(T) == 4) {
+            for (; b + 4 <= lenB; b += 4) {
+                Nd4jLong a = 0;
+                for (; a + 4 <= lenA; a += 4) {
+                    auto r0 = _mm_loadu_ps(reinterpret_cast<const float*>(x + a * xsA + b));
+                    auto r1 = _mm_loadu_ps(reinterpret_cast<const float*>(x + (a + 1) * xsA + b));
+                    auto r2 = _mm_loadu_ps(reinterpret_cast<const float*>(x + (a + 2) * xsA + b));
+                    auto r3 = _mm_loadu_ps(reinterpret_cast<const float*>(x + (a + 3) * xsA + b));
+                    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                    _mm_storeu_ps(reinterpret_cast<float*>(z + b * zsB + a), r0);
+                    _mm_storeu_ps(reinterpret_cast<float*>(z + (b + 1) * zsB + a), r1);
+                    _mm_storeu_ps(reinterpret_cast<float*>(z + (b + 2) * zsB + a), r2);
+                    _mm_storeu_ps(reinterpret_cast<float*>(z + (b + 3) * zsB + a), r3);
+                }
+
+                for (; a < lenA; a++)
+                    for (Nd4jLong k = 0; k < 4; k++)
+                        z[(b + k) * zsB + a] = x[a * xsA + b + k];
+            }
+        } else if (sizeof(T) == 8) {
+            for (; b + 2 <= lenB; b += 2) {
+                Nd4jLong a = 0;
+                for (; a + 2 <= lenA; a += 2) {
+                    auto r0 = _mm_loadu_pd(reinterpret_cast<const double*>(x + a * xsA + b));
+                    auto r1 = _mm_loadu_pd(reinterpret_cast<const double*>(x + (a + 1) * xsA + b));
+                    _mm_storeu_pd(reinterpret_cast<double*>(z + b * zsB + a), _mm_unpacklo_pd(r0, r1));
+                    _mm_storeu_pd(reinterpret_cast<double*>(z + (b + 1) * zsB + a), _mm_unpackhi_pd(r0, r1));
+                }
+
+                for (; a < lenA; a++) {
+                    z[b * zsB + a] = x[a * xsA + b];
+                    z[(b + 1) * zsB + a] = x[a * xsA + b + 1];
+                }
+            }
+        }
+#endif
+        return b;
+    }
+
+    // single tile: dimension A is innermost for z, dimension B is innermost for x
+    template <typename T>
+    static void copyTile(const T *x, Nd4jLong xsA, Nd4jLong xsB, T *z, Nd4jLong zsA, Nd4jLong zsB, Nd4jLong lenA, Nd4jLong lenB) {
+        Nd4jLong b = 0;
+
+        if (xsB == 1 && zsA == 1)
+            transposeVectorized<T>(x, xsA, z, zsB, lenA, lenB, b);
+
+        for (; b < lenB; b++) {
+            auto xRow = x + b * xsB;
+            auto zRow = z + b * zsB;
+            for (Nd4jLong a = 0; a < lenA; a++)
+                zRow[a * zsA] = xRow[a * xsA];
+        }
+    }
+
+    // offsets of element number idx over given dimensions, c order
+    static FORCEINLINE void outerOffsets(Nd4jLong idx, const std::vector<CopyDim> &dims, Nd4jLong &xOffset, Nd4jLong &zOffset) {
+        xOffset = 0;
+        zOffset = 0;
+        for (int e = (int) dims.size() - 1; e >= 0 && idx > 0; e--) {
+            auto coord = idx % dims[e].length;
+            idx /= dims[e].length;
+            xOffset += coord * dims[e].xStride;
+            zOffset += coord * dims[e].zStride;
+        }
+    }
+
+    template <typename T>
+    static void copy_(const T *x, T *z, const std::vector<CopyDim> &dims, Nd4jLong length, bool allowParallelism) {
+        const int maxThreads = allowParallelism ? -1 : 1;
+        const int rank = (int) dims.size();
+
+        // dims are sorted by z strides, so last one is innermost for z. Innermost for x is the one with smallest stride
+        const int a = rank - 1;
+        int b = a;
+        for (int e = 0; e < rank; e++)
+            if (nd4j::math::nd4j_abs<Nd4jLong>(dims[e].xStride) < nd4j::math::nd4j_abs<Nd4jLong>(dims[b].xStride))
+                b = e;
+
+        std::vector<CopyDim> outer;
+        for (int e = 0; e < rank; e++)
+            if (e != a && e != b)
+                outer.emplace_back(dims[e]);
+
+        if (a == b) {
+            // both arrays share innermost dimension, so it's just a copy of rows
+            const auto rowLength = dims[a].length;
+            const auto xs = dims[a].xStride;
+            const auto zs = dims[a].zStride;
+
+            auto func = [&](Nd4jLong start, Nd4jLong stop) {
+                for (Nd4jLong r = start; r < stop; r++) {
+                    Nd4jLong xOffset, zOffset;
+                    outerOffsets(r, outer, xOffset, zOffset);
+
+                    auto xRow = x + xOffset;
+                    auto zRow = z + zOffset;
+                    if (xs == 1 && zs == 1)
+                        memcpy(zRow, xRow, rowLength * sizeof(T));
+                    else
+                        for (Nd4jLong e = 0; e < rowLength; e++)
+                            zRow[e * zs] = xRow[e * xs];
+                }
+            };
+
+            Executor::parallel_for(0, length / rowLength, func, nd4j::math::nd4j_max<Nd4jLong>(1, COPY_GRAIN / rowLength), maxThreads);
+            return;
+        }
+
+        const auto &dimA = dims[a];
+        const auto &dimB = dims[b];
+        const auto tilesA = (dimA.length + TILE_SIZE - 1) / TILE_SIZE;
+        const auto tilesB = (dimB.length + TILE_SIZE - 1) / TILE_SIZE;
+        const auto tilesPerOuter = tilesA * tilesB;
+
+        auto func = [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong t = start; t < stop; t++) {
+                Nd4jLong xOffset, zOffset;
+                outerOffsets(t / tilesPerOuter, outer, xOffset, zOffset);
+
+                const auto startB = ((t % tilesPerOuter) / tilesA) * TILE_SIZE;
+                const auto startA = (t % tilesA) * TILE_SIZE;
+
+                xOffset += startA * dimA.xStride + startB * dimB.xStride;
+                zOffset += startA * dimA.zStride + startB * dimB.zStride;
+
+                copyTile<T>(x + xOffset, dimA.xStride, dimB.xStride, z + zOffset, dimA.zStride, dimB.zStride,
+                            nd4j::math::nd4j_min<Nd4jLong>(TILE_SIZE, dimA.length - startA), nd4j::math::nd4j_min<Nd4jLong>(TILE_SIZE, dimB.length - startB));
+            }
+        };
+
+        Executor::parallel_for(0, (length / (dimA.length * dimB.length)) * tilesPerOuter, func, nd4j::math::nd4j_max<Nd4jLong>(1, COPY_GRAIN / (TILE_SIZE * TILE_SIZE)), maxThreads);
+    }
+
+    bool TransposeHelper::copy(const void *x, const Nd4jLong *xShapeInfo, void *z, const Nd4jLong *zShapeInfo, bool allowParallelism) {
+        const auto dtype = ArrayOptions::dataType(xShapeInfo);
+        if (dtype != ArrayOptions::dataType(zShapeInfo) || DataTypeUtils::isS(dtype))
+            return false;
+
+        if (shape::isEmpty(xShapeInfo) || shape::isEmpty(zShapeInfo) || !shape::shapeEquals(xShapeInfo, zShapeInfo))
+            return false;
+
+        const auto length = shape::length(xShapeInfo);
+        const int rank = shape::rank(xShapeInfo);
+        auto shape = shape::shapeOf(const_cast<Nd4jLong*>(xShapeInfo));
+        auto xStrides = shape::stride(const_cast<Nd4jLong*>(xShapeInfo));
+        auto zStrides = shape::stride(const_cast<Nd4jLong*>(zShapeInfo));
+
+        std::vector<CopyDim> dims;
+        for (int e = 0; e < rank; e++)
+            if (shape[e] != 1)
+                dims.push_back({shape[e], xStrides[e], zStrides[e]});
+
+        // z layout defines iteration order
+        std::stable_sort(dims.begin(), dims.end(), [](const CopyDim &l, const CopyDim &r) {
+            return nd4j::math::nd4j_abs<Nd4jLong>(l.zStride) > nd4j::math::nd4j_abs<Nd4jLong>(r.zStride);
+        });
+
+        // merging dimensions contiguous in both arrays
+        std::vector<CopyDim> merged;
+        for (const auto &d: dims) {
+            if (!merged.empty()) {
+                auto &last = merged.back();
+                if (last.xStride == d.xStride * d.length && last.zStride == d.zStride * d.length) {
+                    last.length *= d.length;
+                    last.xStride = d.xStride;
+                    last.zStride = d.zStride;
+                    continue;
+                }
+            }
+
+            merged.emplace_back(d);
+        }
+
+        if (merged.empty())
+            merged.push_back({1, 1, 1});
+
+        switch (DataTypeUtils::sizeOfElement(dtype)) {
+            case 1:
+                copy_<uint8_t>(reinterpret_cast<const uint8_t*>(x), reinterpret_cast<uint8_t*>(z), merged, length, allowParallelism);
+                return true;
+            case 2:
+                copy_<uint16_t>(reinterpret_cast<const uint16_t*>(x), reinterpret_cast<uint16_t*>(z), merged, length, allowParallelism);
+                return true;
+            case 4:
+                copy_<uint32_t>(reinterpret_cast<const uint32_t*>(x), reinterpret_cast<uint32_t*>(z), merged, length, allowParallelism);
+                return true;
+            case 8:
+                copy_<uint64_t>(reinterpret_cast<const uint64_t*>(x), reinterpret_cast<uint64_t*>(z), merged, length, allowParallelism);
+                return true;
+            default:
+                return false;
+        }
+    }
+}
@@ -23,6 +23,12 @@
 #include <NDArrayFactory.h>
 #include <chrono>
 #include <helpers/ShapeUtils.h>
+#include <ops/declarable/CustomOperations.h>
+#include <loops/fused_chain.h>
+#include <helpers/SparseMmulHelper.h>
+#include <MmulHelper.h>
+#include <helpers/KnnHelper.h>
+#include <helpers/VPTree.h>
 
 namespace nd4j {
     BenchmarkHelper::BenchmarkHelper(unsigned int warmUpIterations, unsigned int runIterations) {
@@ -699,4 +705,210 @@ namespace nd4j {
 
         return output;
     }
-}
\ No newline at end of file
+
+    Nd4jLong BenchmarkHelper::medianTime(const std::function<void ()> &func) {
+        for (uint i = 0; i < _wIterations; i++)
+            func();
+
+        std::vector<Nd4jLong> timings(_rIterations);
+        for (uint i = 0; i < _rIterations; i++) {
+            auto timeStart = std::chrono::system_clock::now();
+
+            func();
+
+            auto timeEnd = std::chrono::system_clock::now();
+            timings[i] = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart)).count();
+        }
+
+        std::sort(timings.begin(), timings.end());
+        return timings[_rIterations / 2];
+    }
+
+    std::string BenchmarkHelper::runLambdaSuit(const std::vector<Nd4jLong> &lengths) {
+        std::string output("TestName\tLength\tstd::function median (us)\tinlined median (us)\tspeedup\n");
+
+#ifndef __CUDABLAS__
+
+        for (auto length: lengths) {
+            auto x = NDArrayFactory::create<float>('c', {length});
+            auto y = NDArrayFactory::create<float>('c', {length});
+            auto w = NDArrayFactory::create<float>('c', {length});
+            auto z = NDArrayFactory::create<float>('c', {length});
+            x.linspace(-1.0f, 2.0f / length);
+            y.assign(0.25f);
+            w.assign(0.75f);
+
+            // lstm/gru gate activation
+            auto sigmoid = [](float v) -> float { return 1.0f / (1.0f + nd4j::math::nd4j_exp<float, float>(-v)); };
+            // gru output: z * h + (1 - z) * c
+            auto blend = [](float g, float h, float c) -> float { return g * h + (1.0f - g) * c; };
+            // squared error from loss helpers
+            auto squared = [](float p, float l) -> float { return (p - l) * (p - l); };
+            // indexed masking, as in transforms helpers
+            auto mask = [](Nd4jLong e, float v) -> float { return e % 2 == 0 ? v : 0.0f; };
+
+            std::function<float(float)> sigmoidF = sigmoid;
+            std::function<float(float, float, float)> blendF = blend;
+            std::function<float(float, float)> squaredF = squared;
+            std::function<float(Nd4jLong, float)> maskF = mask;
+
+            std::vector<std::pair<std::string, std::pair<Nd4jLong, Nd4jLong>>> results;
+            results.emplace_back("applyLambda_sigmoid", std::make_pair(medianTime([&] () { x.applyLambda<float>(sigmoidF, &z); }),
+                                                                         medianTime([&] () { x.applyLambda<float>(sigmoid, &z); })));
+            results.emplace_back("applyTriplewiseLambda_gru", std::make_pair(medianTime([&] () { w.applyTriplewiseLambda<float>(&x, &y, blendF, &z); }),
+                                                                               medianTime([&] () { w.applyTriplewiseLambda<float>(&x, &y, blend, &z); })));
+            results.emplace_back("applyPairwiseLambda_mse", std::make_pair(medianTime([&] () { x.applyPairwiseLambda<float>(&y, squaredF, &z); }),
+                                                                             medianTime([&] () { x.applyPairwiseLambda<float>(&y, squared, &z); })));
+            results.emplace_back("applyIndexedLambda_mask", std::make_pair(medianTime([&] () { x.applyIndexedLambda<float>(maskF, &z); }),
+                                                                             medianTime([&] () { x.applyIndexedLambda<float>(mask, &z); })));
+
+            for (auto &r: results) {
+                auto speedup = r.second.second > 0 ? static_cast<double>(r.second.first) / r.second.second : 0.0;
+
+                std::string temp;
+                temp.resize(1024);
+                snprintf(const_cast<char *>(temp.data()), temp.length(), "%s\t%lld\t%lld\t%lld\t%.2f\n", r.first.c_str(), length, r.second.first, r.second.second, speedup);
+
+                output += temp.substr(0, temp.find('\n') + 1);
+            }
+        }
+#endif
+
+        return output;
+    }
+
+    std::string BenchmarkHelper::runFusedChainSuit(const std::vector<Nd4jLong> &lengths) {
+        std::string output("TestName\tLength\tseparate ops median (us)\tfused_elementwise median (us)\tFusedChain median (us)\tfused GB/s\tspeedup\n");
+
+#ifndef __CUDABLAS__
+        using namespace functions::fused;
+        typedef FusedChain<float, Scalar<simdOps::Multiply<float, float, float>>, Pairwise<simdOps::Add<float, float, float>>,
+                           Scalar<simdOps::RELU<float, float, float>>, Transform<simdOps::Sigmoid<float>>> Chain;
+
+        nd4j::ops::fused_elementwise op;
+        std::vector<Nd4jLong> program({SCALAR, scalar::Multiply, 0, 1, PAIRWISE, pairwise::Add, 1, 0, SCALAR, scalar::RELU, 0, 1, TRANSFORM_STRICT, transform::Sigmoid, 0, 0});
+        std::vector<double> tArgs({2.0, 0.0});
+        std::vector<bool> bArgs;
+
+        for (auto length: lengths) {
+            auto x = NDArrayFactory::create<float>('c', {length});
+            auto y = NDArrayFactory::create<float>('c', {length});
+            auto z = NDArrayFactory::create<float>('c', {length});
+            x.linspace(-1.0f, 2.0f / length);
+            y.assign(0.25f);
+
+            std::vector<NDArray*> in({&x, &y});
+            std::vector<NDArray*> out({&z});
+
+            float multiplier = 2.0f;
+            float threshold = 0.0f;
+            StepArgs<float> args[4];
+            args[0].params = &multiplier;
+            args[1].operand = y.bufferAsT<float>();
+            args[1].period = length;
+            args[2].params = &threshold;
+
+            auto separate = medianTime([&] () {
+                x.applyScalar(scalar::Multiply, 2.0f, &z);
+                z.applyPairwiseTransform(pairwise::Add, &y, &z);
+                z.applyScalar(scalar::RELU, 0.0f, &z);
+                z.applyTransform(transform::Sigmoid, &z);
+            });
+
+            auto fused = medianTime([&] () { op.execute(in, out, tArgs, program, bArgs); });
+            auto chain = medianTime([&] () { Chain::exec(x.bufferAsT<float>(), z.bufferAsT<float>(), length, args); });
+
+            // x and y are read once, z is written once
+            auto bandwidth = fused > 0 ? 3.0 * length * sizeof(float) / fused / 1000.0 : 0.0;
+            auto speedup = fused > 0 ? static_cast<double>(separate) / fused : 0.0;
+
+            std::string temp;
+            temp.resize(1024);
+            snprintf(const_cast<char *>(temp.data()), temp.length(), "fused_chain_4\t%lld\t%lld\t%lld\t%lld\t%.2f\t%.2f\n", length, separate, fused, chain, bandwidth, speedup);
+
+            output += temp.substr(0, temp.find('\n') + 1);
+        }
+#endif
+
+        return output;
+    }
+
+    std::string BenchmarkHelper::runSparseMmulSuit(Nd4jLong rows, Nd4jLong k, Nd4jLong m, const std::vector<double> &densities) {
+        std::string output("TestName\tShape\tDensity\tdense mmul median (us)\tCSR conversion median (us)\tSpMM median (us)\tmatmul op median (us)\tSpMM speedup\n");
+
+#ifndef __CUDABLAS__
+        nd4j::ops::matmul op;
+
+        for (auto density: densities) {
+            auto x = NDArrayFactory::create<float>('c', {rows, k});
+            auto y = NDArrayFactory::create<float>('c', {k, m});
+            auto z = NDArrayFactory::create<float>('c', {rows, m});
+            y.linspace(0.0f, 1.0f / y.lengthOf());
+
+            // deterministic pseudo-random pattern with given fraction of non-zeros
+            auto xBuffer = x.bufferAsT<float>();
+            uint32_t state = 119;
+            for (Nd4jLong e = 0; e < x.lengthOf(); e++) {
+                state = state * 1664525u + 1013904223u;
+                xBuffer[e] = (state >> 8) < static_cast<uint32_t>(density * 16777216.0) ? 1.0f : 0.0f;
+            }
+
+            auto sparse = SparseNDArray::fromDense(x);
+
+            auto dense = medianTime([&] () { MmulHelper::mmul(&x, &y, &z, 1.0, 0.0); });
+            auto conversion = medianTime([&] () { auto temp = SparseNDArray::fromDense(x); });
+            auto spmm = medianTime([&] () { SparseMmulHelper::mmul(sparse, y, z); });
+            auto matmul = medianTime([&] () { op.execute({&x, &y}, {&z}, {}, {}, {}); });
+
+            auto speedup = spmm > 0 ? static_cast<double>(dense) / spmm : 0.0;
+
+            std::string temp;
+            temp.resize(1024);
+            snprintf(const_cast<char *>(temp.data()), temp.length(), "sparse_mmul\t[%lld, %lld]x[%lld, %lld]\t%.4f\t%lld\t%lld\t%lld\t%lld\t%.2f\n",
+                     rows, k, k, m, sparse.density(), dense, conversion, spmm, matmul, speedup);
+
+            output += temp.substr(0, temp.find('\n') + 1);
+        }
+#endif
+
+        return output;
+    }
+
+    std::string BenchmarkHelper::runKnnSuit(Nd4jLong numPoints, Nd4jLong dim, Nd4jLong numQueries, int k) {
+        std::string output("TestName\tPoints\tQueries\tk\tbrute force median (us)\ttree build median (us)\ttree query median (us)\tquery speedup\n");
+
+        auto points = NDArrayFactory::create<float>('c', {numPoints, dim});
+        auto queries = NDArrayFactory::create<float>('c', {numQueries, dim});
+
+        // deterministic pseudo-random points within unit cube
+        uint32_t state = 119;
+        for (auto array: {&points, &queries}) {
+            auto buffer = array->bufferAsT<float>();
+            for (Nd4jLong e = 0; e < array->lengthOf(); e++) {
+                state = state * 1664525u + 1013904223u;
+                buffer[e] = static_cast<float>(state >> 8) / 16777216.0f;
+            }
+            array->tickWriteHost();
+        }
+
+        auto indices = NDArrayFactory::create<Nd4jLong>('c', {numQueries, (Nd4jLong) k});
+        auto distances = NDArrayFactory::create<float>('c', {numQueries, (Nd4jLong) k});
+        auto treeIndices = NDArrayFactory::create<Nd4jLong>('c', {numPoints});
+        auto radii = NDArrayFactory::create<float>('c', {numPoints});
+
+        auto brute = medianTime([&] () { KnnHelper::search(queries, points, k, KnnHelper::EUCLIDEAN, indices, distances); });
+        auto build = medianTime([&] () { VPTree::build(points, KnnHelper::EUCLIDEAN, treeIndices, radii); });
+        auto query = medianTime([&] () { VPTree::query(points, treeIndices, radii, queries, k, KnnHelper::EUCLIDEAN, indices, distances); });
+
+        auto speedup = query > 0 ? static_cast<double>(brute) / query : 0.0;
+
+        std::string temp;
+        temp.resize(1024);
+        snprintf(const_cast<char *>(temp.data()), temp.length(), "knn\t[%lld, %lld]\t%lld\t%i\t%lld\t%lld\t%lld\t%.2f\n",
+                 numPoints, dim, numQueries, k, brute, build, query, speedup);
+
+        output += temp.substr(0, temp.find('\n') + 1);
+
+        return output;
+    }
+}
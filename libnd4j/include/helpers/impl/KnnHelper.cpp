@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Exact k nearest neighbours search with blocked distance computation
+//
+
+#include <helpers/KnnHelper.h>
+#include <MmulHelper.h>
+#include <execution/Executor.h>
+#include <memory>
+
+namespace nd4j {
+
+    // returns array itself if it's contiguous, or c-ordered copy of it stored in holder
+    static const NDArray* contiguous(const NDArray &array, std::unique_ptr<NDArray> &holder) {
+        if (array.ordering() == 'c' && array.ews() == 1)
+            return &array;
+
+        holder.reset(array.dup('c'));
+        holder->syncToHost();
+        return holder.get();
+    }
+
+    template <typename T>
+    static void squaredNorms(const T *x, Nd4jLong rows, Nd4jLong length, std::vector<T> &norms) {
+        norms.resize(rows);
+        Executor::parallel_for(0, rows, [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong r = start; r < stop; r++) {
+                const auto row = x + r * length;
+                T sum = static_cast<T>(0.f);
+
+                PRAGMA_OMP_SIMD_SUM(sum)
+                for (Nd4jLong e = 0; e < length; e++)
+                    sum += row[e] * row[e];
+
+                norms[r] = sum;
+            }
+        });
+    }
+
+    template <typename T>
+    static void search_(const NDArray &query, const NDArray &reference, int k, int metric, Nd4jLong *indices, void *vdistances) {
+        auto distances = reinterpret_cast<T*>(vdistances);
+        const auto numQueries = query.sizeAt(0);
+        const auto numReferences = reference.sizeAt(0);
+        const auto length = query.sizeAt(1);
+        const auto q = query.bufferAsT<T>();
+        const auto r = reference.bufferAsT<T>();
+
+        std::vector<TopK<T>> heaps(numQueries, TopK<T>(k));
+
+        if (metric == KnnHelper::MANHATTAN) {
+            // every thread takes its queries over the same reference block, so block stays in cache
+            Executor::parallel_for(0, numQueries, [&](Nd4jLong start, Nd4jLong stop) {
+                for (Nd4jLong r0 = 0; r0 < numReferences; r0 += KnnHelper::REFERENCE_BLOCK) {
+                    const auto r1 = nd4j::math::nd4j_min<Nd4jLong>(r0 + KnnHelper::REFERENCE_BLOCK, numReferences);
+
+                    for (Nd4jLong i = start; i < stop; i++)
+                        for (Nd4jLong j = r0; j < r1; j++)
+                            heaps[i].push(KnnHelper::distance<T>(metric, q + i * length, r + j * length, length), j);
+                }
+            });
+        } else {
+            std::vector<T> queryNorms, referenceNorms;
+            squaredNorms(q, numQueries, length, queryNorms);
+            squaredNorms(r, numReferences, length, referenceNorms);
+
+            // only one block of dot products exists at any time
+            std::unique_ptr<NDArray> dots;
+
+            for (Nd4jLong q0 = 0; q0 < numQueries; q0 += KnnHelper::QUERY_BLOCK) {
+                const auto q1 = nd4j::math::nd4j_min<Nd4jLong>(q0 + KnnHelper::QUERY_BLOCK, numQueries);
+                auto queryBlock = query({q0, q1, 0, 0}, true);
+
+                for (Nd4jLong r0 = 0; r0 < numReferences; r0 += KnnHelper::REFERENCE_BLOCK) {
+                    const auto r1 = nd4j::math::nd4j_min<Nd4jLong>(r0 + KnnHelper::REFERENCE_BLOCK, numReferences);
+                    const auto blockLength = r1 - r0;
+                    auto referenceBlock = reference({r0, r1, 0, 0}, true).transpose();
+
+                    if (dots == nullptr || dots->sizeAt(0) != q1 - q0 || dots->sizeAt(1) != blockLength)
+                        dots.reset(new NDArray('c', {q1 - q0, blockLength}, query.dataType(), query.getContext()));
+
+                    MmulHelper::mmul(&queryBlock, &referenceBlock, dots.get(), 1.0, 0.0);
+                    dots->syncToHost();
+
+                    const auto d = dots->bufferAsT<T>();
+                    Executor::parallel_for(q0, q1, [&](Nd4jLong start, Nd4jLong stop) {
+                        for (Nd4jLong i = start; i < stop; i++) {
+                            auto &heap = heaps[i];
+                            const auto row = d + (i - q0) * blockLength;
+
+                            for (Nd4jLong j = 0; j < blockLength; j++) {
+                                // squared euclidean distance is enough for ordering, negative values are rounding errors
+                                T distance = metric == KnnHelper::COSINE ? KnnHelper::cosineDistance<T>(row[j], queryNorms[i], referenceNorms[r0 + j])
+                                                                         : nd4j::math::nd4j_max<T>(queryNorms[i] + referenceNorms[r0 + j] - static_cast<T>(2.f) * row[j], static_cast<T>(0.f));
+
+                                if (distance <= heap.worst())
+                                    heap.push(distance, r0 + j);
+                            }
+                        }
+                    });
+                }
+            }
+        }
+
+        Executor::parallel_for(0, numQueries, [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong i = start; i < stop; i++) {
+                auto &neighbours = heaps[i].sorted();
+
+                for (int j = 0; j < k; j++) {
+                    indices[i * k + j] = neighbours[j].second;
+                    distances[i * k + j] = metric == KnnHelper::EUCLIDEAN ? nd4j::math::nd4j_sqrt<T, T>(neighbours[j].first) : neighbours[j].first;
+                }
+            }
+        });
+    }
+
+    void KnnHelper::search(const NDArray &query, const NDArray &reference, int k, int metric, NDArray &indices, NDArray &distances) {
+        if (query.rankOf() != 2 || reference.rankOf() != 2 || query.sizeAt(1) != reference.sizeAt(1))
+            throw std::invalid_argument("KnnHelper::search: query and reference should be matrices with the same number of columns");
+
+        if (query.dataType() != reference.dataType() || distances.dataType() != query.dataType() || !query.isR())
+            throw std::invalid_argument("KnnHelper::search: query, reference and distances should have the same floating point type");
+
+        if (k < 1 || k > reference.sizeAt(0))
+            throw std::invalid_argument("KnnHelper::search: k should be within [1, number of reference rows]");
+
+        if (metric < (int) EUCLIDEAN || metric > (int) MANHATTAN)
+            throw std::invalid_argument("KnnHelper::search: unknown metric");
+
+        NDArray::preparePrimaryUse({&indices, &distances}, {&query, &reference});
+
+        std::unique_ptr<NDArray> queryHolder, referenceHolder;
+        auto q = contiguous(query, queryHolder);
+        auto r = contiguous(reference, referenceHolder);
+
+        // results are written as [M, k] c-ordered matrices
+        NDArray idx('c', {query.sizeAt(0), (Nd4jLong) k}, nd4j::DataType::INT64, query.getContext());
+        NDArray dist('c', {query.sizeAt(0), (Nd4jLong) k}, query.dataType(), query.getContext());
+        NDArray::preparePrimaryUse({&idx, &dist}, {});
+
+        BUILD_SINGLE_SELECTOR(query.dataType(), search_, (*q, *r, k, metric, idx.bufferAsT<Nd4jLong>(), dist.buffer()), FLOAT_TYPES);
+
+        NDArray::registerPrimaryUse({&idx, &dist}, {});
+        indices.assign(idx);
+        distances.assign(dist);
+
+        NDArray::registerPrimaryUse({&indices, &distances}, {&query, &reference});
+    }
+
+    BUILD_SINGLE_TEMPLATE(template void search_, (const NDArray &query, const NDArray &reference, int k, int metric, Nd4jLong *indices, void *vdistances), FLOAT_TYPES);
+}
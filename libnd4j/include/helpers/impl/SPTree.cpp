@@ -0,0 +1,277 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Barnes-Hut space partitioning tree for t-SNE repulsive forces
+//
+
+#include <helpers/SPTree.h>
+#include <execution/Executor.h>
+#include <templatemath.h>
+#include <memory>
+#include <vector>
+
+namespace nd4j {
+
+    template <typename T>
+    class SPTreeNodes {
+    private:
+        // points closer to each other than float precision allows to separate stay in one leaf
+        static const int MAX_DEPTH = 64;
+
+        const T *_data;
+        const int _dims;
+        const int _numChildren;
+
+        // geometry is used by build only, traversal touches center of mass, size, max half-width and links
+        std::vector<T> _centers;
+        std::vector<T> _halfWidths;
+        std::vector<T> _centersOfMass;
+        std::vector<T> _maxWidths;
+        std::vector<Nd4jLong> _cumSizes;
+        std::vector<Nd4jLong> _firstChildren;
+        std::vector<Nd4jLong> _points;
+
+        Nd4jLong addNode(const std::vector<T> &center, const std::vector<T> &halfWidth) {
+            T maxWidth = static_cast<T>(0.f);
+            for (int d = 0; d < _dims; d++)
+                maxWidth = nd4j::math::nd4j_max<T>(maxWidth, halfWidth[d]);
+
+            _centers.insert(_centers.end(), center.begin(), center.end());
+            _halfWidths.insert(_halfWidths.end(), halfWidth.begin(), halfWidth.end());
+            _centersOfMass.resize(_centersOfMass.size() + _dims, static_cast<T>(0.f));
+            _maxWidths.emplace_back(maxWidth);
+            _cumSizes.emplace_back(0);
+            _firstChildren.emplace_back(-1);
+            _points.emplace_back(-1);
+
+            return (Nd4jLong) _cumSizes.size() - 1;
+        }
+
+        // bit d of child index is set for lower half along dimension d, points on the border go to upper half
+        Nd4jLong childFor(Nd4jLong node, const T *point) const {
+            Nd4jLong child = 0;
+            for (int d = 0; d < _dims; d++)
+                if (point[d] < _centers[node * _dims + d])
+                    child |= (1LL << d);
+
+            return _firstChildren[node] + child;
+        }
+
+        void subdivide(Nd4jLong node) {
+            std::vector<T> center(_dims);
+            std::vector<T> halfWidth(_dims);
+
+            const auto first = (Nd4jLong) _cumSizes.size();
+            for (int c = 0; c < _numChildren; c++) {
+                for (int d = 0; d < _dims; d++) {
+                    halfWidth[d] = _halfWidths[node * _dims + d] / static_cast<T>(2.f);
+                    center[d] = _centers[node * _dims + d] + (((c >> d) & 1) ? -halfWidth[d] : halfWidth[d]);
+                }
+
+                addNode(center, halfWidth);
+            }
+
+            _firstChildren[node] = first;
+        }
+
+        void insert(Nd4jLong index) {
+            const auto point = _data + index * _dims;
+            Nd4jLong node = 0;
+
+            for (int depth = 0; ; depth++) {
+                const auto size = static_cast<T>(_cumSizes[node]);
+                for (int d = 0; d < _dims; d++) {
+                    auto &com = _centersOfMass[node * _dims + d];
+                    com = (com * size + point[d]) / (size + static_cast<T>(1.f));
+                }
+
+                _cumSizes[node]++;
+
+                if (_firstChildren[node] < 0) {
+                    if (_points[node] < 0) {
+                        _points[node] = index;
+                        return;
+                    }
+
+                    const auto existing = _points[node];
+                    const auto other = _data + existing * _dims;
+
+                    bool duplicate = true;
+                    for (int d = 0; d < _dims && duplicate; d++)
+                        duplicate = point[d] == other[d];
+
+                    if (duplicate || depth >= MAX_DEPTH)
+                        return;
+
+                    // point of the leaf moves one level down, together with its duplicates
+                    subdivide(node);
+                    auto child = childFor(node, other);
+                    _points[child] = existing;
+                    _cumSizes[child] = _cumSizes[node] - 1;
+                    std::copy(other, other + _dims, _centersOfMass.data() + child * _dims);
+                    _points[node] = -1;
+                }
+
+                node = childFor(node, point);
+            }
+        }
+
+    public:
+        SPTreeNodes(const T *data, Nd4jLong numPoints, int dims) : _data(data), _dims(dims), _numChildren(1 << dims) {
+            // root is centered at mean of data and covers all points
+            std::vector<T> mean(dims, static_cast<T>(0.f));
+            std::vector<T> minimum(dims, DataTypeUtils::max<T>());
+            std::vector<T> maximum(dims, -DataTypeUtils::max<T>());
+
+            for (Nd4jLong i = 0; i < numPoints; i++) {
+                for (int d = 0; d < dims; d++) {
+                    const auto v = data[i * dims + d];
+                    mean[d] += v;
+                    minimum[d] = nd4j::math::nd4j_min<T>(minimum[d], v);
+                    maximum[d] = nd4j::math::nd4j_max<T>(maximum[d], v);
+                }
+            }
+
+            std::vector<T> halfWidth(dims);
+            for (int d = 0; d < dims; d++) {
+                mean[d] /= static_cast<T>(numPoints);
+                halfWidth[d] = nd4j::math::nd4j_max<T>(maximum[d] - mean[d], mean[d] - minimum[d]) + static_cast<T>(1e-5f);
+            }
+
+            addNode(mean, halfWidth);
+
+            for (Nd4jLong i = 0; i < numPoints; i++)
+                insert(i);
+        }
+
+        Nd4jLong numberOfNodes() const {
+            return (Nd4jLong) _cumSizes.size();
+        }
+
+        /**
+         * Adds repulsive force on point index to negativeForce and returns its share of sumQ. stack and diff are scratch buffers of calling thread
+         */
+        T nonEdgeForces(Nd4jLong index, T theta, T *negativeForce, std::vector<Nd4jLong> &stack, std::vector<T> &diff) const {
+            const auto point = _data + index * _dims;
+            T sumQ = static_cast<T>(0.f);
+
+            stack.clear();
+            stack.emplace_back(0);
+
+            while (!stack.empty()) {
+                const auto node = stack.back();
+                stack.pop_back();
+
+                if (_cumSizes[node] == 0)
+                    continue;
+
+                const bool isLeaf = _firstChildren[node] < 0;
+
+                // leaf holding the point itself (and its duplicates): point doesn't interact with itself
+                bool own = isLeaf;
+                const auto stored = _data + _points[node] * _dims;
+                for (int d = 0; d < _dims && own; d++)
+                    own = point[d] == stored[d];
+
+                T distance = static_cast<T>(0.f);
+                for (int d = 0; d < _dims; d++) {
+                    diff[d] = own ? static_cast<T>(0.f) : point[d] - _centersOfMass[node * _dims + d];
+                    distance += diff[d] * diff[d];
+                }
+
+                if (isLeaf || _maxWidths[node] / nd4j::math::nd4j_sqrt<T, T>(distance) < theta) {
+                    const auto size = own ? _cumSizes[node] - 1 : _cumSizes[node];
+                    const auto q = static_cast<T>(1.f) / (static_cast<T>(1.f) + distance);
+                    auto mult = static_cast<T>(size) * q;
+                    sumQ += mult;
+                    mult *= q;
+
+                    for (int d = 0; d < _dims; d++)
+                        negativeForce[d] += mult * diff[d];
+                } else {
+                    // children are visited in order
+                    for (int c = _numChildren - 1; c >= 0; c--)
+                        stack.emplace_back(_firstChildren[node] + c);
+                }
+            }
+
+            return sumQ;
+        }
+    };
+
+    template <typename T>
+    static void repulsiveForces_(const NDArray &data, double theta, NDArray &negativeForces, NDArray &sumQ) {
+        const auto numPoints = data.sizeAt(0);
+        const int dims = (int) data.sizeAt(1);
+        auto forces = negativeForces.bufferAsT<T>();
+
+        SPTreeNodes<T> tree(data.bufferAsT<T>(), numPoints, dims);
+
+        // per point sums are added up in fixed order afterwards, so result doesn't depend on number of threads
+        std::vector<T> sums(numPoints);
+        Executor::parallel_for(0, numPoints, [&](Nd4jLong start, Nd4jLong stop) {
+            std::vector<Nd4jLong> stack;
+            std::vector<T> diff(dims);
+
+            for (Nd4jLong i = start; i < stop; i++) {
+                auto force = forces + i * dims;
+                std::fill(force, force + dims, static_cast<T>(0.f));
+                sums[i] = tree.nonEdgeForces(i, static_cast<T>(theta), force, stack, diff);
+            }
+        });
+
+        T total = static_cast<T>(0.f);
+        for (auto v: sums)
+            total += v;
+
+        sumQ.p(0, total);
+    }
+
+    void SPTree::repulsiveForces(const NDArray &data, double theta, NDArray &negativeForces, NDArray &sumQ) {
+        if (data.rankOf() != 2 || !data.isR() || data.sizeAt(0) < 1)
+            throw std::invalid_argument("SPTree::repulsiveForces: data should be non-empty floating point matrix");
+
+        if (data.sizeAt(1) < 1 || data.sizeAt(1) > MAX_DIMENSIONS)
+            throw std::invalid_argument("SPTree::repulsiveForces: number of dimensions should be within [1, 10]");
+
+        if (!negativeForces.isSameShape(&data) || negativeForces.dataType() != data.dataType() || sumQ.lengthOf() != 1 || sumQ.dataType() != data.dataType())
+            throw std::invalid_argument("SPTree::repulsiveForces: forces should have the same shape and type as data, sumQ should be scalar of data type");
+
+        NDArray::preparePrimaryUse({&negativeForces}, {&data});
+
+        std::unique_ptr<NDArray> dataHolder;
+        const NDArray *x = &data;
+        if (data.ordering() != 'c' || data.ews() != 1) {
+            dataHolder.reset(data.dup('c'));
+            dataHolder->syncToHost();
+            x = dataHolder.get();
+        }
+
+        NDArray forces('c', data.getShapeAsVector(), data.dataType(), data.getContext());
+        NDArray::preparePrimaryUse({&forces}, {});
+
+        BUILD_SINGLE_SELECTOR(data.dataType(), repulsiveForces_, (*x, theta, forces, sumQ), FLOAT_TYPES);
+
+        NDArray::registerPrimaryUse({&forces}, {});
+        negativeForces.assign(forces);
+
+        NDArray::registerPrimaryUse({&negativeForces}, {&data});
+    }
+
+    BUILD_SINGLE_TEMPLATE(template void repulsiveForces_, (const NDArray &data, double theta, NDArray &negativeForces, NDArray &sumQ), FLOAT_TYPES);
+}
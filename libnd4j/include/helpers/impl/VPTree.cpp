@@ -0,0 +1,254 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Vantage point tree over rows of a matrix, stored in two flat arrays
+//
+
+#include <helpers/VPTree.h>
+#include <execution/Executor.h>
+#include <memory>
+
+namespace nd4j {
+
+    // returns array itself if it's contiguous, or c-ordered copy of it stored in holder
+    static const NDArray* contiguous(const NDArray &array, std::unique_ptr<NDArray> &holder) {
+        if (array.ordering() == 'c' && array.ews() == 1)
+            return &array;
+
+        holder.reset(array.dup('c'));
+        holder->syncToHost();
+        return holder.get();
+    }
+
+    template <typename T>
+    static void build_(const NDArray &points, int metric, Nd4jLong *indices, void *vradii) {
+        auto radii = reinterpret_cast<T*>(vradii);
+        const auto numPoints = points.sizeAt(0);
+        const auto length = points.sizeAt(1);
+        const auto x = points.bufferAsT<T>();
+
+        // owners[p] is first position of the node p belongs to. Position equal to its owner holds vantage point of that node
+        std::vector<Nd4jLong> owners(numPoints, 0);
+        std::vector<std::pair<T, Nd4jLong>> scratch(numPoints);
+        std::vector<std::pair<Nd4jLong, Nd4jLong>> level, next;
+
+        for (Nd4jLong p = 0; p < numPoints; p++)
+            indices[p] = p;
+
+        if (numPoints > 0)
+            level.emplace_back(0, numPoints);
+
+        while (!level.empty()) {
+            // pseudo-random vantage point, so sorted input doesn't degrade the tree
+            Executor::parallel_for(0, (Nd4jLong) level.size(), [&](Nd4jLong start, Nd4jLong stop) {
+                for (Nd4jLong n = start; n < stop; n++) {
+                    const auto lo = level[n].first;
+                    const auto hi = level[n].second;
+                    const auto pick = lo + static_cast<Nd4jLong>((static_cast<uint64_t>(lo) * 2654435761ULL + static_cast<uint64_t>(hi)) % static_cast<uint64_t>(hi - lo));
+
+                    std::swap(indices[lo], indices[pick]);
+                    radii[lo] = static_cast<T>(0.f);
+                }
+            });
+
+            // distances of all points of this level to vantage points of their nodes, balanced over positions rather than nodes
+            Executor::parallel_for(0, numPoints, [&](Nd4jLong start, Nd4jLong stop) {
+                for (Nd4jLong p = start; p < stop; p++) {
+                    const auto owner = owners[p];
+                    if (owner == p)
+                        continue;
+
+                    scratch[p] = std::make_pair(KnnHelper::distance<T>(metric, x + indices[owner] * length, x + indices[p] * length, length), indices[p]);
+                }
+            }, 1024);
+
+            Executor::parallel_for(0, (Nd4jLong) level.size(), [&](Nd4jLong start, Nd4jLong stop) {
+                for (Nd4jLong n = start; n < stop; n++) {
+                    const auto lo = level[n].first;
+                    const auto hi = level[n].second;
+                    if (hi - lo < 2)
+                        continue;
+
+                    const auto mid = VPTree::middle(lo, hi);
+                    std::nth_element(scratch.data() + lo + 1, scratch.data() + mid, scratch.data() + hi);
+                    radii[lo] = scratch[mid].first;
+
+                    for (Nd4jLong p = lo + 1; p < hi; p++) {
+                        indices[p] = scratch[p].second;
+                        owners[p] = p < mid ? lo + 1 : mid;
+                    }
+                }
+            });
+
+            next.clear();
+            for (const auto &node: level) {
+                if (node.second - node.first < 2)
+                    continue;
+
+                const auto mid = VPTree::middle(node.first, node.second);
+                if (mid > node.first + 1)
+                    next.emplace_back(node.first + 1, mid);
+
+                next.emplace_back(mid, node.second);
+            }
+
+            std::swap(level, next);
+        }
+    }
+
+    template <typename T>
+    class VPTreeSearch {
+    private:
+        const T *_points;
+        const Nd4jLong *_indices;
+        const T *_radii;
+        const T *_query = nullptr;
+        Nd4jLong _length;
+        int _metric;
+
+    public:
+        VPTreeSearch(const T *points, const Nd4jLong *indices, const T *radii, Nd4jLong length, int metric) : _points(points), _indices(indices), _radii(radii), _length(length), _metric(metric) {
+            //
+        }
+
+        void search(const T *query, Nd4jLong lo, Nd4jLong hi, TopK<T> &heap) {
+            if (lo >= hi)
+                return;
+
+            const auto d = KnnHelper::distance<T>(_metric, query, _points + _indices[lo] * _length, _length);
+            heap.push(d, _indices[lo]);
+
+            if (hi - lo == 1)
+                return;
+
+            // subtree is skipped if triangle inequality says none of its points can beat current worst neighbour
+            const auto mid = VPTree::middle(lo, hi);
+            const auto radius = _radii[lo];
+
+            if (d < radius) {
+                if (d - heap.worst() <= radius)
+                    search(query, lo + 1, mid, heap);
+
+                if (d + heap.worst() >= radius)
+                    search(query, mid, hi, heap);
+            } else {
+                if (d + heap.worst() >= radius)
+                    search(query, mid, hi, heap);
+
+                if (d - heap.worst() <= radius)
+                    search(query, lo + 1, mid, heap);
+            }
+        }
+    };
+
+    template <typename T>
+    static void query_(const NDArray &points, const Nd4jLong *indices, const NDArray &radii, const NDArray &queries, int k, int metric, Nd4jLong *outIndices, void *voutDistances) {
+        auto outDistances = reinterpret_cast<T*>(voutDistances);
+        const auto length = points.sizeAt(1);
+        const auto q = queries.bufferAsT<T>();
+
+        VPTreeSearch<T> tree(points.bufferAsT<T>(), indices, radii.bufferAsT<T>(), length, metric);
+
+        Executor::parallel_for(0, queries.sizeAt(0), [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong i = start; i < stop; i++) {
+                TopK<T> heap(k);
+                tree.search(q + i * length, 0, points.sizeAt(0), heap);
+
+                auto &neighbours = heap.sorted();
+                for (int j = 0; j < k; j++) {
+                    outIndices[i * k + j] = neighbours[j].second;
+                    outDistances[i * k + j] = neighbours[j].first;
+                }
+            }
+        });
+    }
+
+    static void validate(const NDArray &points, int metric) {
+        if (points.rankOf() != 2 || !points.isR())
+            throw std::invalid_argument("VPTree: points should be floating point matrix");
+
+        if (metric != KnnHelper::EUCLIDEAN && metric != KnnHelper::MANHATTAN)
+            throw std::invalid_argument("VPTree: only euclidean and manhattan metrics are supported");
+    }
+
+    void VPTree::build(const NDArray &points, int metric, NDArray &indices, NDArray &radii) {
+        validate(points, metric);
+
+        if (indices.lengthOf() != points.sizeAt(0) || radii.lengthOf() != points.sizeAt(0) || radii.dataType() != points.dataType())
+            throw std::invalid_argument("VPTree::build: indices and radii should have one element per point, radii should have points type");
+
+        NDArray::preparePrimaryUse({&indices, &radii}, {&points});
+
+        std::unique_ptr<NDArray> pointsHolder;
+        auto p = contiguous(points, pointsHolder);
+
+        NDArray idx('c', {points.sizeAt(0)}, nd4j::DataType::INT64, points.getContext());
+        NDArray rad('c', {points.sizeAt(0)}, points.dataType(), points.getContext());
+        NDArray::preparePrimaryUse({&idx, &rad}, {});
+
+        BUILD_SINGLE_SELECTOR(points.dataType(), build_, (*p, metric, idx.bufferAsT<Nd4jLong>(), rad.buffer()), FLOAT_TYPES);
+
+        NDArray::registerPrimaryUse({&idx, &rad}, {});
+        indices.assign(idx.reshape(indices.ordering(), indices.getShapeAsVector()));
+        radii.assign(rad.reshape(radii.ordering(), radii.getShapeAsVector()));
+
+        NDArray::registerPrimaryUse({&indices, &radii}, {&points});
+    }
+
+    void VPTree::query(const NDArray &points, const NDArray &indices, const NDArray &radii, const NDArray &queries, int k, int metric, NDArray &outIndices, NDArray &outDistances) {
+        validate(points, metric);
+
+        if (indices.lengthOf() != points.sizeAt(0) || radii.lengthOf() != points.sizeAt(0) || radii.dataType() != points.dataType())
+            throw std::invalid_argument("VPTree::query: indices and radii don't match points");
+
+        if (queries.rankOf() != 2 || queries.sizeAt(1) != points.sizeAt(1) || queries.dataType() != points.dataType() || outDistances.dataType() != points.dataType())
+            throw std::invalid_argument("VPTree::query: queries should be matrix with the same number of columns and data type as points");
+
+        if (k < 1 || k > points.sizeAt(0))
+            throw std::invalid_argument("VPTree::query: k should be within [1, number of points]");
+
+        NDArray::preparePrimaryUse({&outIndices, &outDistances}, {&points, &indices, &radii, &queries});
+
+        std::unique_ptr<NDArray> pointsHolder, radiiHolder, queriesHolder;
+        auto p = contiguous(points, pointsHolder);
+        auto r = contiguous(radii, radiiHolder);
+        auto q = contiguous(queries, queriesHolder);
+
+        std::vector<Nd4jLong> order(indices.lengthOf());
+        for (Nd4jLong e = 0; e < indices.lengthOf(); e++) {
+            order[e] = indices.e<Nd4jLong>(e);
+            if (order[e] < 0 || order[e] >= points.sizeAt(0))
+                throw std::invalid_argument("VPTree::query: indices don't match points");
+        }
+
+        NDArray idx('c', {queries.sizeAt(0), (Nd4jLong) k}, nd4j::DataType::INT64, points.getContext());
+        NDArray dist('c', {queries.sizeAt(0), (Nd4jLong) k}, points.dataType(), points.getContext());
+        NDArray::preparePrimaryUse({&idx, &dist}, {});
+
+        BUILD_SINGLE_SELECTOR(points.dataType(), query_, (*p, order.data(), *r, *q, k, metric, idx.bufferAsT<Nd4jLong>(), dist.buffer()), FLOAT_TYPES);
+
+        NDArray::registerPrimaryUse({&idx, &dist}, {});
+        outIndices.assign(idx);
+        outDistances.assign(dist);
+
+        NDArray::registerPrimaryUse({&outIndices, &outDistances}, {&points, &indices, &radii, &queries});
+    }
+
+    BUILD_SINGLE_TEMPLATE(template void build_, (const NDArray &points, int metric, Nd4jLong *indices, void *vradii), FLOAT_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void query_, (const NDArray &points, const Nd4jLong *indices, const NDArray &radii, const NDArray &queries, int k, int metric, Nd4jLong *outIndices, void *voutDistances), FLOAT_TYPES);
+}
@@ -0,0 +1,344 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Fused chains of elementwise simdOps functors, executed in one pass over memory
+//
+
+#ifndef LIBND4J_FUSED_CHAIN_H
+#define LIBND4J_FUSED_CHAIN_H
+
+#include <op_boilerplate.h>
+#include <templatemath.h>
+#include <ops/ops.h>
+#include <execution/Executor.h>
+#include <Environment.h>
+
+// functors allowed in fused chains, numbering follows respective op families in legacy_ops.h
+#define FUSED_TRANSFORM_SAME_OPS \
+        (0, Abs), \
+        (1, Sign), \
+        (3, Neg), \
+        (4, Round), \
+        (5, TimesOneMinus), \
+        (6, Cube), \
+        (7, OneMinus), \
+        (11, Reciprocal), \
+        (12, Square), \
+        (15, Identity), \
+        (17, Ceiling), \
+        (18, Floor), \
+        (19, ClipByValue), \
+        (21, Copy)
+
+#define FUSED_TRANSFORM_STRICT_OPS \
+        (22, Cosine), \
+        (23, Exp), \
+        (24, Log), \
+        (26, Sigmoid), \
+        (27, Sin), \
+        (28, SoftPlus), \
+        (29, Tanh), \
+        (33, HardTanh), \
+        (34, SoftSign), \
+        (36, HardSigmoid), \
+        (37, RationalTanh), \
+        (38, RectifiedTanh), \
+        (39, Sinh), \
+        (40, Cosh), \
+        (42, SELU), \
+        (43, Swish), \
+        (44, Log1p), \
+        (45, Erf), \
+        (48, Rint), \
+        (49, LogSigmoid), \
+        (53, GELU)
+
+#define FUSED_SCALAR_OPS \
+        (0, Add), \
+        (1, Subtract), \
+        (2, Multiply), \
+        (3, Divide), \
+        (4, ReverseDivide), \
+        (5, ReverseSubtract), \
+        (6, MaxPairwise), \
+        (7, ELU), \
+        (13, MinPairwise), \
+        (22, SquaredSubtract), \
+        (23, SafeDivide), \
+        (31, Pow), \
+        (35, LeakyRELU), \
+        (39, RELU), \
+        (40, RELU6), \
+        (41, Step), \
+        (45, ReversePow)
+
+#define FUSED_PAIRWISE_OPS \
+        (0, Add), \
+        (2, Divide), \
+        (3, Multiply), \
+        (4, Pow), \
+        (5, ReverseSubtract), \
+        (6, Subtract), \
+        (7, MaxPairwise), \
+        (8, MinPairwise), \
+        (11, ReverseDivide), \
+        (20, SquaredSubtract), \
+        (22, SafeDivide)
+
+// same as DISPATCH_BY_OPNUM_T/TTT, but opNums missing in the list are skipped silently
+#define DISPATCH_FUSED_T(NAME, SIGNATURE, ...) switch(opNum) { EVAL(_EXEC_OPS(_EXPAND_PACKED_OP_CALL, NAME, (SIGNATURE), __VA_ARGS__)) default: break; }
+#define DISPATCH_FUSED_TTT(NAME, SIGNATURE, ...) switch(opNum) { EVAL(_EXEC_OPS(_EXPAND_PACKED_OP_CALL_TTT, NAME, (SIGNATURE), __VA_ARGS__)) default: break; }
+
+namespace functions {
+    namespace fused {
+
+        enum StepKind {
+            TRANSFORM_SAME = 0,
+            TRANSFORM_STRICT = 1,
+            SCALAR = 2,
+            PAIRWISE = 3,
+        };
+
+        /**
+         * Arguments of single chain step
+         */
+        template <typename X>
+        struct StepArgs {
+            // operand of pairwise step, repeated along input with given period: 1 for scalar, input length for same shape
+            const X *operand = nullptr;
+            Nd4jLong period = 0;
+
+            // extra params of the step, scalar steps keep scalar itself in params[0]
+            X *params = nullptr;
+        };
+
+        template <typename OpType>
+        class Transform {
+        public:
+            template <typename X>
+            static FORCEINLINE X op(X v, Nd4jLong e, const StepArgs<X> &args) {
+                return OpType::op(v, args.params);
+            }
+        };
+
+        template <typename OpType>
+        class Scalar {
+        public:
+            template <typename X>
+            static FORCEINLINE X op(X v, Nd4jLong e, const StepArgs<X> &args) {
+                return OpType::op(v, args.params[0], args.params + 1);
+            }
+        };
+
+        template <typename OpType>
+        class Pairwise {
+        public:
+            template <typename X>
+            static FORCEINLINE X op(X v, Nd4jLong e, const StepArgs<X> &args) {
+                auto y = args.period == 1 ? args.operand[0] : args.operand[e < args.period ? e : e % args.period];
+                return OpType::op(v, y, args.params);
+            }
+        };
+
+        /**
+         * Compile-time chain of Transform/Scalar/Pairwise steps, i.e.
+         * FusedChain<float, Scalar<simdOps::Multiply<float, float, float>>, Pairwise<simdOps::Add<float, float, float>>, Transform<simdOps::Sigmoid<float>>>
+         * All steps are inlined into single loop, so input is read and output is written once
+         */
+        template <typename X, typename... Steps>
+        class FusedChain;
+
+        template <typename X>
+        class FusedChain<X> {
+        public:
+            static FORCEINLINE X op(X v, Nd4jLong e, const StepArgs<X> *args) {
+                return v;
+            }
+        };
+
+        template <typename X, typename Step, typename... Rest>
+        class FusedChain<X, Step, Rest...> {
+        public:
+            static FORCEINLINE X op(X v, Nd4jLong e, const StepArgs<X> *args) {
+                return FusedChain<X, Rest...>::op(Step::op(v, e, args[0]), e, args + 1);
+            }
+
+            /**
+             * This method applies chain to contiguous x of given length, args holds one entry per step. x and z may be the same buffer
+             */
+            static void exec(const X *x, X *z, Nd4jLong length, const StepArgs<X> *args) {
+                auto func = [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto e = from; e < to; e++)
+                        z[e] = op(x[e], e, args);
+                };
+
+                nd4j::Executor::parallel_for(0, length, func, nd4j::Environment::getInstance()->elementwiseThreshold());
+            }
+        };
+
+        /**
+         * Chain of steps known at runtime only. Input is processed in blocks small enough to stay in L1,
+         * each block goes through all steps before next block is loaded, so there's still one pass over memory.
+         * Functor is resolved once per step per block, and inner loops are the same as in compile-time chains
+         */
+        template <typename X>
+        class FusedProgram {
+        private:
+            typedef X Y;
+            typedef X Z;
+
+            template <typename OpType>
+            static void mark(bool &found) {
+                found = true;
+            }
+
+            template <typename OpType>
+            static void applyTransform(const X *in, X *out, Nd4jLong offset, Nd4jLong length, const StepArgs<X> &args) {
+                auto params = args.params;
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < length; e++)
+                    out[e] = OpType::op(in[e], params);
+            }
+
+            template <typename OpType>
+            static void applyScalar(const X *in, X *out, Nd4jLong offset, Nd4jLong length, const StepArgs<X> &args) {
+                auto scalar = args.params[0];
+                auto params = args.params + 1;
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < length; e++)
+                    out[e] = OpType::op(in[e], scalar, params);
+            }
+
+            template <typename OpType>
+            static void applyPairwise(const X *in, X *out, Nd4jLong offset, Nd4jLong length, const StepArgs<X> &args) {
+                auto params = args.params;
+
+                if (args.period == 1) {
+                    auto y = args.operand[0];
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < length; e++)
+                        out[e] = OpType::op(in[e], y, params);
+
+                    return;
+                }
+
+                // block is split into spans, each of them covered by contiguous part of operand
+                auto position = offset % args.period;
+                for (Nd4jLong e = 0; e < length; ) {
+                    auto span = nd4j::math::nd4j_min<Nd4jLong>(length - e, args.period - position);
+                    auto y = args.operand + position;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong i = 0; i < span; i++)
+                        out[e + i] = OpType::op(in[e + i], y[i], params);
+
+                    e += span;
+                    position = 0;
+                }
+            }
+
+            static void applyStep(int kind, int opNum, const X *in, X *out, Nd4jLong offset, Nd4jLong length, const StepArgs<X> &args) {
+                using namespace simdOps;
+
+                switch (kind) {
+                    case TRANSFORM_SAME: {
+                            DISPATCH_FUSED_T(applyTransform, PARAMS(in, out, offset, length, args), FUSED_TRANSFORM_SAME_OPS);
+                        }
+                        break;
+                    case TRANSFORM_STRICT: {
+                            DISPATCH_FUSED_T(applyTransform, PARAMS(in, out, offset, length, args), FUSED_TRANSFORM_STRICT_OPS);
+                        }
+                        break;
+                    case SCALAR: {
+                            DISPATCH_FUSED_TTT(applyScalar, PARAMS(in, out, offset, length, args), FUSED_SCALAR_OPS);
+                        }
+                        break;
+                    case PAIRWISE: {
+                            DISPATCH_FUSED_TTT(applyPairwise, PARAMS(in, out, offset, length, args), FUSED_PAIRWISE_OPS);
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+        public:
+            static const Nd4jLong BLOCK = 1024;
+
+            /**
+             * This method returns TRUE if functor with given kind and opNum can be used in fused chain
+             */
+            static bool isSupported(int kind, int opNum) {
+                using namespace simdOps;
+                bool found = false;
+
+                switch (kind) {
+                    case TRANSFORM_SAME: {
+                            DISPATCH_FUSED_T(mark, PARAMS(found), FUSED_TRANSFORM_SAME_OPS);
+                        }
+                        break;
+                    case TRANSFORM_STRICT: {
+                            DISPATCH_FUSED_T(mark, PARAMS(found), FUSED_TRANSFORM_STRICT_OPS);
+                        }
+                        break;
+                    case SCALAR: {
+                            DISPATCH_FUSED_TTT(mark, PARAMS(found), FUSED_SCALAR_OPS);
+                        }
+                        break;
+                    case PAIRWISE: {
+                            DISPATCH_FUSED_TTT(mark, PARAMS(found), FUSED_PAIRWISE_OPS);
+                        }
+                        break;
+                    default:
+                        break;
+                }
+
+                return found;
+            }
+
+            /**
+             * This method applies numSteps steps to contiguous x of given length. x and z may be the same buffer
+             */
+            static void exec(const X *x, X *z, Nd4jLong length, int numSteps, const int *kinds, const int *opNums, const StepArgs<X> *args) {
+                auto func = [&](Nd4jLong from, Nd4jLong to) {
+                    for (auto b = from; b < to; b += BLOCK) {
+                        auto len = nd4j::math::nd4j_min<Nd4jLong>(BLOCK, to - b);
+
+                        // first step reads input, all others work within output block
+                        const X *in = x + b;
+                        for (int s = 0; s < numSteps; s++) {
+                            applyStep(kinds[s], opNums[s], in, z + b, b, len, args[s]);
+                            in = z + b;
+                        }
+
+                        if (numSteps == 0 && x != z)
+                            for (Nd4jLong e = 0; e < len; e++)
+                                z[b + e] = x[b + e];
+                    }
+                };
+
+                nd4j::Executor::parallel_for(0, length, func, nd4j::math::nd4j_max<Nd4jLong>(BLOCK, nd4j::Environment::getInstance()->elementwiseThreshold()));
+            }
+        };
+    }
+}
+
+#endif //LIBND4J_FUSED_CHAIN_H
@@ -1427,6 +1427,22 @@
                                                                                 REGISTER_C(NAME) \
                                                                                 Nd4jStatus nd4j::ops::NAME::validateAndExecute(nd4j::graph::Context& block)
 
+// custom op that can publish its outputs as views of its input, see DeclarableOp::viewOutput
+#define DECLARE_VIEW_CUSTOM_OP(NAME, NIN, NOUT, INPLACEABLE, TARGS, IARGS)      class ND4J_EXPORT NAME: public nd4j::ops::DeclarableCustomOp { \
+                                                                                protected: \
+                                                                                    void registerTypes(); \
+                                                                                    Nd4jStatus validateAndExecute(Context& block); \
+                                                                                    nd4j::NDArray* viewOutput(nd4j::graph::Context& block, int outputIdx, Nd4jLong *shapeInfo); \
+                                                                                public:\
+                                                                                    NAME(); \
+                                                                                    nd4j::ShapeList* calculateOutputShape(nd4j::ShapeList* inputShape, nd4j::graph::Context& block); \
+                                                                                    bool hasViewOutputs() { return true; } \
+                                                                                };\
+                                                                                REGISTER_H(NAME)
+
+// this declaration MUST follow DECLARE_VIEW_CUSTOM_OP
+#define DECLARE_VIEW_FN(NAME)                                                   nd4j::NDArray* nd4j::ops::NAME::viewOutput(nd4j::graph::Context& block, int outputIdx, Nd4jLong *shapeInfo)
+
 // this declaration MUST follow DECLARE_CUSTOM_OP
 #define DECLARE_SHAPE_FN(NAME)                                                  nd4j::ShapeList* nd4j::ops::NAME::calculateOutputShape(nd4j::ShapeList* inputShape, nd4j::graph::Context& block)
 
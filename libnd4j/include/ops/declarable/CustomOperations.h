@@ -40,6 +40,7 @@
 #include <ops/declarable/headers/third_party.h>
 #include <ops/declarable/headers/tests.h>
 #include <ops/declarable/headers/BarnesHutTsne.h>
+#include <ops/declarable/headers/quantization.h>
 #include <dll.h>
 #include <helpers/shape.h>
 #include <helpers/TAD.h>
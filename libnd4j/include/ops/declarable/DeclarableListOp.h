@@ -50,6 +50,9 @@ namespace nd4j {
             ResultSet* execute(NDArrayList* list, std::vector<NDArray*>& inputs, std::vector<double>& tArgs, std::vector<int>& iArgs);
 
             ShapeList* calculateOutputShape(ShapeList* inputShape, nd4j::graph::Context& block) override;
+
+            // arrays returned by list ops (i.e. stacked list) may share storage of NDArrayList, so their consumers can't be executed in place
+            bool hasViewOutputs() override;
         };
     }
 }
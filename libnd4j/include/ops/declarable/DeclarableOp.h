@@ -68,6 +68,8 @@ namespace nd4j {
             std::mutex _registrator;
             bool _registered = false;
 
+            void ensureTypesRegistered();
+
         protected:
             OpDescriptor *_descriptor;
             NDArray *_scalar = nullptr;
@@ -111,6 +113,23 @@ namespace nd4j {
             */
             int prepareOutputs(Context& block);
 
+            /**
+             * This method publishes outputs of view-capable op as views of its input(s), if Context allows that.
+             * Returns number of published outputs, 0 means regular execution is required
+             */
+            int prepareViews(Context& block);
+
+            /**
+             * This method returns view of op input with given output shape, or nullptr if view isn't possible, i.e. due to strides.
+             * Views share DataBuffer with input, so input buffer stays alive as long as view exists
+             */
+            virtual nd4j::NDArray* viewOutput(Context& block, int outputIdx, Nd4jLong *shapeInfo);
+
+            /**
+             * This method returns view of array reshaped (in c order of elements) to given shape, or nullptr if strides don't allow that
+             */
+            static nd4j::NDArray* reshapeView(const NDArray& array, const Nd4jLong *shapeInfo);
+
             //std::vector<int>* calculateOutputShape(std::vector<int>* inputShape, nd4j::graph::Block<T>& block);
         public:
             // for special cases, like BooleanOps
@@ -131,6 +150,12 @@ namespace nd4j {
             // this method returns OpDescriptor, describing this Op instance
             OpDescriptor *getOpDescriptor();
 
+            // this method returns TRUE if outputs of this op might be views of its inputs
+            virtual bool hasViewOutputs();
+
+            // this method returns TRUE if outputs of this op depend on its inputs and arguments only, so it can be executed ahead of time
+            bool isPure();
+
             Nd4jStatus validateDataTypes(Context& block);
 
             /**
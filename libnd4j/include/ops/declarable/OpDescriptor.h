@@ -91,6 +91,9 @@ namespace nd4j {
             // field for ops that allow data type override at runtime
             bool _dtypeOverride = false;
 
+            // flag for ops whose outputs depend on inputs and arguments only: no randomness, no state
+            bool _pure = true;
+
             bool checkDataTypesMatch(nd4j::DataType needle, std::vector<nd4j::DataType> &haystack) const;
         public:
             // default constructor
@@ -170,6 +173,7 @@ namespace nd4j {
             OpDescriptor* setAllowedOutputTypes(nd4j::DataType dtype);
             OpDescriptor* allowOverride(bool reallyAllow);
             OpDescriptor* setSameMode(bool reallySame);
+            OpDescriptor* setPure(bool reallyPure);
             OpDescriptor* setInputType(int idx, nd4j::DataType dtype);
             OpDescriptor* setOutputType(int idx, nd4j::DataType dtype);
 
@@ -178,6 +182,7 @@ namespace nd4j {
             bool checkInputMatch(int index, nd4j::DataType dataType);
             bool checkOutputMatch(int index, nd4j::DataType dataType);
             bool isSameMode();
+            bool isPure();
 
             bool isInherit(int index);
         };
@@ -25,6 +25,7 @@
 
 #include <ops/declarable/CustomOperations.h>
 #include <MmulHelper.h>
+#include <helpers/SparseMmulHelper.h>
 
 namespace nd4j {
     namespace ops {
@@ -92,6 +93,12 @@ namespace nd4j {
             }
             // ******* end of input validation ******* //
 
+#ifndef __CUDABLAS__
+            // very sparse x (i.e. bag-of-features input) is multiplied as CSR matrix
+            if (!transX && xRank == 2 && yRank == 2 && SparseMmulHelper::mmulIfSparse(x, y, z, transY))
+                return Status::OK();
+#endif
+
             MmulHelper::matmul(x, y, z, transX, transY);
 
             return Status::OK();
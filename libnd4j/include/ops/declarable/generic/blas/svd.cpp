@@ -36,6 +36,19 @@ CUSTOM_OP_IMPL(svd, 1, 1, false, 0, 3) {
     const bool fullUV = (bool)INT_ARG(0);
     const bool calcUV = (bool)INT_ARG(1);
     const int switchNum = INT_ARG(2);
+    const int topK = block.getIArguments()->size() > 3 ? INT_ARG(3) : 0;
+
+    if (topK > 0) {
+        const int diagSize = x->sizeAt(-1) < x->sizeAt(-2) ? x->sizeAt(-1) : x->sizeAt(-2);
+        REQUIRE_TRUE(topK <= diagSize, 0, "SVD OP: number of singular values to evaluate must not exceed %i, but got %i instead!", diagSize, topK);
+
+#ifndef __CUDABLAS__
+        helpers::svdRandomized(block.launchContext(), block.randomGenerator(), x, {OUTPUT_VARIABLE(0), calcUV ? OUTPUT_VARIABLE(1) : nullptr, calcUV ? OUTPUT_VARIABLE(2) : nullptr}, topK, calcUV);
+        return Status::OK();
+#else
+        REQUIRE_TRUE(false, 0, "SVD OP: truncated mode isn't supported on CUDA yet");
+#endif
+    }
 
     // #ifndef __CUDABLAS__
     helpers::svd(block.launchContext(), x, {OUTPUT_VARIABLE(0), calcUV ? OUTPUT_VARIABLE(1) : nullptr, calcUV ? OUTPUT_VARIABLE(2) : nullptr}, fullUV, calcUV, switchNum);
@@ -48,7 +61,9 @@ CUSTOM_OP_IMPL(svd, 1, 1, false, 0, 3) {
     DECLARE_TYPES(svd) {
         getOpDescriptor()
                 ->setAllowedInputTypes(0, {DataType::FLOAT32, DataType ::DOUBLE, DataType::HALF})
-                ->setSameMode(true);
+                ->setSameMode(true)
+                // randomized path draws test matrix from block's generator
+                ->setPure(false);
     }
 
 DECLARE_SHAPE_FN(svd) {
@@ -60,7 +75,15 @@ DECLARE_SHAPE_FN(svd) {
     const int rank = inShapeInfo[0];
     REQUIRE_TRUE(rank >= 2 , 0, "SVD OP: the rank of input array must be >=2, but got %i instead!", rank);
 
-    const int diagSize = inShapeInfo[rank] < inShapeInfo[rank-1] ? inShapeInfo[rank] : inShapeInfo[rank-1];
+    int diagSize = inShapeInfo[rank] < inShapeInfo[rank-1] ? inShapeInfo[rank] : inShapeInfo[rank-1];
+
+    // truncated mode: only top k singular values and vectors
+    const int topK = block.getIArguments()->size() > 3 ? INT_ARG(3) : 0;
+    if (topK > 0) {
+        REQUIRE_TRUE(topK <= diagSize, 0, "SVD OP: number of singular values to evaluate must not exceed %i, but got %i instead!", diagSize, topK);
+        diagSize = topK;
+        fullUV = false;
+    }
 
     Nd4jLong* sShapeInfo(nullptr);
     if(rank == 2) {
@@ -41,7 +41,7 @@ namespace nd4j {
                 expandable = true;
             }
 
-            auto list = new NDArrayList(height, expandable);
+            auto list = new NDArrayList(height, expandable, true);
 
             // we recieve input array for graph integrity purposes only
             auto input = INPUT_VARIABLE(0);
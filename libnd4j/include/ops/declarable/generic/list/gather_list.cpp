@@ -29,9 +29,6 @@ namespace nd4j {
             auto list = INPUT_LIST(0);
             auto indices = INPUT_VARIABLE(1);
 
-            indices->printShapeInfo("indices shape");
-            indices->printIndexedBuffer("indices");
-
             REQUIRE_TRUE(indices->isVector() || indices->rankOf() == 1, 0, "Indices for Gather operation should be a vector");
             REQUIRE_TRUE(list->height() > 0, 0, "Number of elements in list should be positive prior to Gather call");
             REQUIRE_TRUE(list->height() == indices->lengthOf(), 1, "Number of indicies should be equal to number of elements in list, but got [%i] indices instead", indices->lengthOf());
@@ -39,18 +36,12 @@ namespace nd4j {
             // first of all we need to get shapes
             std::vector<Nd4jLong> shape({0});
             shape[0] = indices->lengthOf();
-            for (int e = 0; e < list->height(); e++) {
-                auto array = list->readRaw(e);
-
-                // now we should fill other dimensions 
-                if (e == 0) {
-                    for (int d = 0; d < array->rankOf(); d++)
-                        shape.emplace_back(array->sizeAt(d));
-                }
-            }
+            auto first = list->readRaw(0);
+            for (int d = 0; d < first->rankOf(); d++)
+                shape.emplace_back(first->sizeAt(d));
 
             auto result = NDArrayFactory::create_('c', shape, list->dataType());
-            std::vector<Nd4jLong> indicesList((list->readRaw(0)->rankOf() + 1) * 2, 0);
+            std::vector<Nd4jLong> indicesList((first->rankOf() + 1) * 2, 0);
             int skipPosition = 0;
             for (int e = 0; e < indices->lengthOf(); e++) {
                 auto idx = indices->e<int>(e);
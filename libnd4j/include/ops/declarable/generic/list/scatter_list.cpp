@@ -42,7 +42,7 @@ namespace nd4j {
             } else {
                 array = INPUT_VARIABLE(1);
                 indices = INPUT_VARIABLE(2);
-                list = new NDArrayList(indices->lengthOf(), false);
+                list = new NDArrayList(indices->lengthOf(), false, true);
                 block.trackList(list);
             }
 
@@ -56,8 +56,7 @@ namespace nd4j {
                 if (idx >= tads->size())
                     return ND4J_STATUS_BAD_ARGUMENTS;
 
-                auto arr = tads->at(e)->dup(array->ordering());
-                auto res = list->write(idx, arr);
+                auto res = list->writeCopy(idx, tads->at(e));
                 if (res != ND4J_STATUS_OK)
                     return res;
             }
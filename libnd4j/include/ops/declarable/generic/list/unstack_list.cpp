@@ -30,7 +30,7 @@ namespace ops {
         auto input = INPUT_VARIABLE(int(outputList != nullptr) );
 
         if (outputList == nullptr) {
-            outputList = new NDArrayList(0, true);
+            outputList = new NDArrayList(0, true, true);
             //block.trackList(outputList);
             setupResultList(outputList, block);
         }
@@ -39,7 +39,7 @@ namespace nd4j {
                 //nd4j_printf("Writing [%i]:\n", idx->e<int>(0));
                 //input->printShapeInfo("input shape");
                 //input->printIndexedBuffer("input buffer");
-                Nd4jStatus result = list->write(idx->e<int>(0), input->dup());
+                Nd4jStatus result = list->writeCopy(idx->e<int>(0), input);
 
                 auto res = NDArrayFactory::create_(list->counter(), block.launchContext());
                 //res->printShapeInfo("Write_list 2 output shape");
@@ -52,7 +52,7 @@ namespace nd4j {
                 auto input = INPUT_VARIABLE(1);
                 auto idx = INT_ARG(0);
 
-                Nd4jStatus result = list->write(idx, input->dup());
+                Nd4jStatus result = list->writeCopy(idx, input);
 
                 auto res = NDArrayFactory::create_(list->counter(), block.launchContext());
                 //res->printShapeInfo("Write_list 1 output shape");
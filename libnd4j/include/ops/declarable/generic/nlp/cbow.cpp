@@ -52,6 +52,7 @@ namespace nd4j {
 
             auto numWorkers = block.numI() > 0 ? INT_ARG(0) : omp_get_max_threads();
             auto nsRounds = block.numI() > 1 ? INT_ARG(1) : 0;
+            auto minibatch = block.numI() > 2 ? INT_ARG(2) : 0;
 
             auto trainWords = block.numB() > 0 ? B_ARG(0) : true;
             auto isInference = block.numB() > 1 ? B_ARG(1) : false;
@@ -62,7 +63,11 @@ namespace nd4j {
             REQUIRE_TRUE(syn0->dataType() == expTable->dataType(), 0, "CBOW: expTable must have the same data type as syn0 table");
 
 
-            nd4j::ops::helpers::cbow(*syn0, *syn1, *syn1neg, *expTable, *negTable, *target, *ngStarter, nsRounds, *context, *lockedWords, *indices, *codes, *alpha, *randomValue, *numLabels, *inferenceVector, trainWords, numWorkers);
+            // minibatch mode shares negative samples between consecutive rows, so it's used for batched training only
+            if (minibatch > 0 && nsRounds > 0 && context->rankOf() == 2 && ngStarter->isVector() && inferenceVector->isEmpty())
+                nd4j::ops::helpers::cbowMinibatch(*syn0, *syn1, *syn1neg, *expTable, *negTable, *ngStarter, nsRounds, *context, *lockedWords, *indices, *codes, *alpha, *randomValue, *numLabels, trainWords, minibatch, numWorkers);
+            else
+                nd4j::ops::helpers::cbow(*syn0, *syn1, *syn1neg, *expTable, *negTable, *target, *ngStarter, nsRounds, *context, *lockedWords, *indices, *codes, *alpha, *randomValue, *numLabels, *inferenceVector, trainWords, numWorkers);
 
 
             return Status::OK();
@@ -50,6 +50,7 @@ namespace nd4j {
 
             auto numWorkers = block.numI() > 0 ? INT_ARG(0) : omp_get_max_threads();
             auto nsRounds = block.numI() > 1 ? INT_ARG(1) : 0;
+            auto minibatch = block.numI() > 2 ? INT_ARG(2) : 0;
 
             auto isInference = block.numB() > 0 ? B_ARG(0) : false;
             auto isPreciseMode = block.numB() > 1 ? B_ARG(1) : false;
@@ -59,8 +60,15 @@ namespace nd4j {
             REQUIRE_TRUE(syn0->dataType() == syn1->dataType() && syn0->dataType() == syn1neg->dataType(), 0, "SkipGram: all syn tables must have the same data type");
             REQUIRE_TRUE(syn0->dataType() == expTable->dataType(), 0, "SkipGram: expTable must have the same data type as syn0 table");
 
+            // minibatches are processed concurrently with shared negatives, so their updates can't be reproduced in precise mode
+            REQUIRE_TRUE(!(isPreciseMode && minibatch > 0), 0, "SkipGram: precise mode can't be used together with minibatch");
 
-            nd4j::ops::helpers::skipgram(*syn0, *syn1, *syn1neg, *expTable, *negTable, *target, *ngStarter, nsRounds, *indices, *codes, *alpha, *randomValue, *inferenceVector, isPreciseMode, numWorkers);
+
+            // minibatch mode shares negative samples between consecutive rows, so it's used for batched training only
+            if (minibatch > 0 && nsRounds > 0 && target->isVector() && ngStarter->isVector() && inferenceVector->isEmpty())
+                nd4j::ops::helpers::skipgramMinibatch(*syn0, *syn1, *syn1neg, *expTable, *negTable, *target, *ngStarter, nsRounds, *indices, *codes, *alpha, *randomValue, minibatch, numWorkers);
+            else
+                nd4j::ops::helpers::skipgram(*syn0, *syn1, *syn1neg, *expTable, *negTable, *target, *ngStarter, nsRounds, *indices, *codes, *alpha, *randomValue, *inferenceVector, isPreciseMode, numWorkers);
 
             return Status::OK();
         }
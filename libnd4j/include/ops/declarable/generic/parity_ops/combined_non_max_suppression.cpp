@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Batched per-class non max suppression, whole detection head in one op
+//
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/image_suppression.h>
+
+#if NOT_EXCLUDED(OP_combined_non_max_suppression)
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(combined_non_max_suppression, 2, 4, false, -2, -2) {
+            auto boxes = INPUT_VARIABLE(0);
+            auto scores = INPUT_VARIABLE(1);
+
+            auto outBoxes = OUTPUT_VARIABLE(0);
+            auto outScores = OUTPUT_VARIABLE(1);
+            auto outClasses = OUTPUT_VARIABLE(2);
+            auto validDetections = OUTPUT_VARIABLE(3);
+
+            int maxPerClass, maxTotal;
+            if (block.width() > 3) {
+                maxPerClass = INPUT_VARIABLE(2)->e<int>(0);
+                maxTotal = INPUT_VARIABLE(3)->e<int>(0);
+            } else if (block.getIArguments()->size() >= 2) {
+                maxPerClass = INT_ARG(0);
+                maxTotal = INT_ARG(1);
+            } else
+                REQUIRE_TRUE(false, 0, "combined_non_max_suppression: max output sizes per class and in total should be provided either as inputs or as int args");
+
+            const bool clip = block.getIArguments()->size() > 2 ? (bool) INT_ARG(2) : true;
+            const double threshold = block.getTArguments()->size() > 0 ? T_ARG(0) : 0.5;
+            const double scoreThreshold = block.getTArguments()->size() > 1 ? T_ARG(1) : -DataTypeUtils::infOrMax<double>();
+
+            REQUIRE_TRUE(boxes->rankOf() == 4 && boxes->sizeAt(3) == 4, 0, "combined_non_max_suppression: boxes should have shape [batch, numBoxes, q, 4], but got rank %i instead", boxes->rankOf());
+            REQUIRE_TRUE(scores->rankOf() == 3 && scores->sizeAt(0) == boxes->sizeAt(0) && scores->sizeAt(1) == boxes->sizeAt(1), 0, "combined_non_max_suppression: scores should have shape [batch, numBoxes, numClasses]");
+            REQUIRE_TRUE(boxes->sizeAt(2) == 1 || boxes->sizeAt(2) == scores->sizeAt(2), 0, "combined_non_max_suppression: third dimension of boxes should be either 1 or numClasses, but got %i instead", boxes->sizeAt(2));
+            REQUIRE_TRUE(boxes->dataType() == scores->dataType(), 0, "combined_non_max_suppression: boxes and scores should have the same data type");
+
+#ifndef __CUDABLAS__
+            helpers::combinedNonMaxSuppression(block.launchContext(), boxes, scores, maxPerClass, maxTotal, threshold, scoreThreshold, clip, outBoxes, outScores, outClasses, validDetections);
+#else
+            REQUIRE_TRUE(false, 0, "combined_non_max_suppression: op isn't supported on CUDA yet");
+#endif
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(combined_non_max_suppression) {
+            auto in = inputShape->at(0);
+
+            int maxTotal;
+            if (block.width() > 3)
+                maxTotal = INPUT_VARIABLE(3)->e<int>(0);
+            else if (block.getIArguments()->size() >= 2)
+                maxTotal = INT_ARG(1);
+            else
+                REQUIRE_TRUE(false, 0, "combined_non_max_suppression: max output sizes per class and in total should be provided either as inputs or as int args");
+
+            const Nd4jLong batchSize = shape::sizeAt(in, 0);
+            auto dtype = ArrayOptions::dataType(in);
+
+            auto boxesShape = ConstantShapeHelper::getInstance()->createShapeInfo(dtype, 'c', {batchSize, (Nd4jLong) maxTotal, 4});
+            auto scoresShape = ConstantShapeHelper::getInstance()->createShapeInfo(dtype, 'c', {batchSize, (Nd4jLong) maxTotal});
+            auto validShape = ConstantShapeHelper::getInstance()->vectorShapeInfo(batchSize, DataType::INT32);
+
+            return SHAPELIST(boxesShape, scoresShape, scoresShape, validShape);
+        }
+
+        DECLARE_TYPES(combined_non_max_suppression) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(nd4j::DataType::ANY)
+                    ->setAllowedOutputTypes(0, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(1, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(2, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(3, {ALL_INTS});
+        }
+    }
+}
+#endif
@@ -54,6 +54,7 @@ CONFIGURABLE_OP_IMPL(dropout, 1, 1, true, 1, 1) {
 
         DECLARE_TYPES(dropout) {
             getOpDescriptor()
+                    ->setPure(false)
                     ->setAllowedInputTypes(0, {ALL_FLOATS})
                     ->setAllowedInputTypes(1, {ALL_INTS})
                     ->setAllowedOutputTypes({ALL_FLOATS})
@@ -87,10 +88,42 @@ CONFIGURABLE_OP_IMPL(dropout_bp, 2, 1, false, 1, 1) {
 
 DECLARE_TYPES(dropout_bp) {
     getOpDescriptor()
+            ->setPure(false)
             ->setAllowedInputTypes({ALL_FLOATS, ALL_INTS})
             ->setAllowedOutputTypes({ALL_FLOATS});
 }
 
+//////////////////////////////////////////////////////////////////////////
+CONFIGURABLE_OP_IMPL(alpha_dropout, 1, 1, true, 4, 1) {
+    NDArray* input   = INPUT_VARIABLE(0);
+
+    NDArray* reduceShape = nullptr; // this param is optional
+    NDArray* output  = OUTPUT_VARIABLE(0);
+
+    if (block.width() > 1)
+        reduceShape = INPUT_VARIABLE(1);
+
+    int seed = INT_ARG(0);
+
+    double probValue   = T_ARG(0);
+    double alphaValue  = T_ARG(1);
+    double alpha1Value = T_ARG(2);
+    double betaValue   = T_ARG(3);
+
+    REQUIRE_TRUE(probValue > 0. && probValue <= 1., 0, "alpha_dropout: Probability should be with range 0 to 1.");
+
+    return helpers::alphaDropOutFunctor(block, input, output, reduceShape, seed, probValue, alphaValue, alpha1Value, betaValue);
+}
+
+DECLARE_TYPES(alpha_dropout) {
+    getOpDescriptor()
+            ->setPure(false)
+            ->setAllowedInputTypes(0, {ALL_FLOATS})
+            ->setAllowedInputTypes(1, {ALL_INTS})
+            ->setAllowedOutputTypes({ALL_FLOATS})
+            ->setSameMode(true);
+}
+
 //////////////////////////////////////////////////////////////////////////
 CONFIGURABLE_OP_IMPL(alpha_dropout_bp, 2, 1, false, 4, 1) {
     NDArray* input   = INPUT_VARIABLE(0); // lookup param
@@ -105,7 +138,7 @@ CONFIGURABLE_OP_IMPL(alpha_dropout_bp, 2, 1, false, 4, 1) {
     int seed = INT_ARG(0);
     
     double probValue   = T_ARG(0);
-    double alphaValue  = T_ARG(0);
+    double alphaValue  = T_ARG(1);
     double alpha1Value = T_ARG(2);
     double betaValue   = T_ARG(3);
 
@@ -119,6 +152,7 @@ CONFIGURABLE_OP_IMPL(alpha_dropout_bp, 2, 1, false, 4, 1) {
 }
         DECLARE_TYPES(alpha_dropout_bp) {
             getOpDescriptor()
+                    ->setPure(false)
                     ->setAllowedInputTypes({ALL_FLOATS})
                     ->setSameMode(true);
         }
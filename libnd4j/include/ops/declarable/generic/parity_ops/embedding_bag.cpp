@@ -0,0 +1,188 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Fused lookup and combine of embedding bags
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_embedding_bag)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/embedding_bag.h>
+
+namespace nd4j {
+namespace ops {
+
+    // bags are either rows of 2D ids, or given by offsets for 1D ids. Returns index of the first input after ids and offsets
+    static int bagBounds(Context &block, int numInputs, std::vector<Nd4jLong> &bounds) {
+        auto table = INPUT_VARIABLE(0);
+        auto ids = INPUT_VARIABLE(1);
+
+        REQUIRE_TRUE(table->rankOf() == 2, 0, "EMBEDDING_BAG op: table should be 2D array, but got rank %i instead !", table->rankOf());
+        REQUIRE_TRUE(ids->rankOf() == 1 || ids->rankOf() == 2, 0, "EMBEDDING_BAG op: ids should be either 1D or 2D array, but got rank %i instead !", ids->rankOf());
+
+        if (ids->lengthOf() > 0) {
+            auto minId = ids->reduceNumber(reduce::Min).e<Nd4jLong>(0);
+            auto maxId = ids->reduceNumber(reduce::Max).e<Nd4jLong>(0);
+            REQUIRE_TRUE(minId >= 0 && maxId < table->sizeAt(0), 0, "EMBEDDING_BAG op: ids should be within [0, %lld), but got [%lld, %lld] instead !", table->sizeAt(0), minId, maxId);
+        }
+
+        if (ids->rankOf() == 2) {
+            bounds.resize(ids->sizeAt(0) + 1);
+            for (Nd4jLong b = 0; b < (Nd4jLong) bounds.size(); b++)
+                bounds[b] = b * ids->sizeAt(1);
+
+            return 2;
+        }
+
+        REQUIRE_TRUE(numInputs > 2, 0, "EMBEDDING_BAG op: offsets are required for 1D ids !");
+        auto offsets = INPUT_VARIABLE(2);
+        REQUIRE_TRUE(offsets->rankOf() == 1, 0, "EMBEDDING_BAG op: offsets should be 1D array, but got rank %i instead !", offsets->rankOf());
+
+        bounds.resize(offsets->lengthOf() + 1);
+        bounds.back() = ids->lengthOf();
+        for (Nd4jLong b = 0; b < offsets->lengthOf(); b++) {
+            bounds[b] = offsets->e<Nd4jLong>(b);
+            REQUIRE_TRUE(bounds[b] >= (b > 0 ? bounds[b - 1] : 0) && bounds[b] <= ids->lengthOf(), 0, "EMBEDDING_BAG op: offsets should be non-decreasing and within [0, %lld], but offset %lld is %lld !", ids->lengthOf(), b, bounds[b]);
+        }
+
+        return 3;
+    }
+
+    static NDArray* bagWeights(Context &block, int numInputs, int next) {
+        if (numInputs <= next)
+            return nullptr;
+
+        auto weights = INPUT_VARIABLE(next);
+        REQUIRE_TRUE(weights->isSameShape(INPUT_VARIABLE(1)), 0, "EMBEDDING_BAG op: weights should have the same shape as ids, but got %s and %s instead !", ShapeUtils::shapeAsString(weights).c_str(), ShapeUtils::shapeAsString(INPUT_VARIABLE(1)).c_str());
+        REQUIRE_TRUE(weights->dataType() == INPUT_VARIABLE(0)->dataType(), 0, "EMBEDDING_BAG op: weights should have the same data type as table !");
+
+        return weights;
+    }
+
+    static int bagMode(Context &block) {
+        int mode = block.numI() > 0 ? (int) INT_ARG(0) : (int) helpers::EMBEDDING_BAG_SUM;
+        REQUIRE_TRUE(mode >= (int) helpers::EMBEDDING_BAG_SUM && mode <= (int) helpers::EMBEDDING_BAG_SQRTN, 0, "EMBEDDING_BAG op: mode should be 0 (sum), 1 (mean) or 2 (sqrtn), but got %i instead !", mode);
+
+        return mode;
+    }
+
+    CUSTOM_OP_IMPL(embedding_bag, 2, 1, false, 0, 0) {
+        auto table = INPUT_VARIABLE(0);
+        auto ids = INPUT_VARIABLE(1);
+        auto output = OUTPUT_VARIABLE(0);
+
+        std::vector<Nd4jLong> bounds;
+        auto next = bagBounds(block, block.width(), bounds);
+        auto weights = bagWeights(block, block.width(), next);
+        auto mode = bagMode(block);
+
+        REQUIRE_TRUE(output->dataType() == table->dataType(), 0, "EMBEDDING_BAG op: output should have the same data type as table !");
+
+        helpers::embeddingBag(block.launchContext(), *table, *ids, bounds, weights, mode, *output);
+
+        return Status::OK();
+    }
+
+    DECLARE_SHAPE_FN(embedding_bag) {
+        auto tableShape = inputShape->at(0);
+        auto idsShape = inputShape->at(1);
+
+        Nd4jLong numBags = shape::rank(idsShape) == 2 ? shape::sizeAt(idsShape, 0) : shape::length(inputShape->at(2));
+
+        return SHAPELIST(ConstantShapeHelper::getInstance()->createShapeInfo(ArrayOptions::dataType(tableShape), 'c', {numBags, shape::sizeAt(tableShape, 1)}));
+    }
+
+    DECLARE_TYPES(embedding_bag) {
+        getOpDescriptor()
+                ->setAllowedInputTypes(0, {ALL_FLOATS})
+                ->setAllowedInputTypes(1, {ALL_INTS})
+                ->setAllowedInputTypes(2, nd4j::DataType::ANY)
+                ->setAllowedInputTypes(3, {ALL_FLOATS})
+                ->setAllowedOutputTypes({ALL_FLOATS});
+    }
+
+    CUSTOM_OP_IMPL(embedding_bag_bp, 3, -1, false, 0, 0) {
+        auto table = INPUT_VARIABLE(0);
+        auto ids = INPUT_VARIABLE(1);
+        auto gradO = INPUT_VARIABLE(block.width() - 1);
+
+        // last input is gradient of output
+        const int numInputs = block.width() - 1;
+
+        std::vector<Nd4jLong> bounds;
+        auto next = bagBounds(block, numInputs, bounds);
+        auto weights = bagWeights(block, numInputs, next);
+        auto mode = bagMode(block);
+
+        const std::vector<Nd4jLong> expected = {(Nd4jLong) bounds.size() - 1, table->sizeAt(1)};
+        REQUIRE_TRUE(gradO->isSameShape(expected), 0, "EMBEDDING_BAG_BP op: wrong shape of output gradient, expected is %s, but got %s instead !", ShapeUtils::shapeAsString(expected).c_str(), ShapeUtils::shapeAsString(gradO).c_str());
+        REQUIRE_TRUE(gradO->dataType() == table->dataType(), 0, "EMBEDDING_BAG_BP op: output gradient should have the same data type as table !");
+
+        auto uniqueIds = OUTPUT_VARIABLE(0);
+        auto gradRows = OUTPUT_VARIABLE(1);
+        auto gradW = weights == nullptr ? nullptr : OUTPUT_VARIABLE(2);
+
+        // nothing was looked up, so all gradients are empty
+        if (ids->lengthOf() == 0)
+            return Status::OK();
+
+        helpers::embeddingBagBp(block.launchContext(), *table, *ids, bounds, weights, *gradO, mode, *uniqueIds, *gradRows, gradW);
+
+        return Status::OK();
+    }
+
+    DECLARE_SHAPE_FN(embedding_bag_bp) {
+        auto tableShape = inputShape->at(0);
+        auto idsShape = inputShape->at(1);
+        auto dtype = ArrayOptions::dataType(tableShape);
+
+        auto numUnique = helpers::embeddingBagUniqueCount(*INPUT_VARIABLE(1));
+
+        auto shapes = SHAPELIST();
+        if (numUnique == 0) {
+            shapes->push_back(ConstantShapeHelper::getInstance()->emptyShapeInfo(nd4j::DataType::INT64));
+            shapes->push_back(ConstantShapeHelper::getInstance()->emptyShapeInfo(dtype));
+        } else {
+            shapes->push_back(ConstantShapeHelper::getInstance()->vectorShapeInfo(numUnique, nd4j::DataType::INT64));
+            shapes->push_back(ConstantShapeHelper::getInstance()->createShapeInfo(dtype, 'c', {numUnique, shape::sizeAt(tableShape, 1)}));
+        }
+
+        // weights go right after ids or offsets, and are followed by gradient of output
+        int next = shape::rank(idsShape) == 2 ? 2 : 3;
+        if ((int) inputShape->size() - 1 > next)
+            shapes->push_back(ConstantShapeHelper::getInstance()->createShapeInfo(ShapeDescriptor(inputShape->at(next), dtype)));
+
+        return shapes;
+    }
+
+    DECLARE_TYPES(embedding_bag_bp) {
+        getOpDescriptor()
+                ->setAllowedInputTypes(0, {ALL_FLOATS})
+                ->setAllowedInputTypes(1, {ALL_INTS})
+                ->setAllowedInputTypes(2, nd4j::DataType::ANY)
+                ->setAllowedInputTypes(3, {ALL_FLOATS})
+                ->setAllowedInputTypes(4, {ALL_FLOATS})
+                ->setAllowedOutputTypes(0, {ALL_INTS})
+                ->setAllowedOutputTypes(1, {ALL_FLOATS})
+                ->setAllowedOutputTypes(2, {ALL_FLOATS});
+    }
+}
+}
+
+#endif
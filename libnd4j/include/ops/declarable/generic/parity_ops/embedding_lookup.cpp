@@ -23,6 +23,8 @@
 
 #include <ops/declarable/CustomOperations.h>
 #include <helpers/ShapeUtils.h>
+#include <array/TadSpan.h>
+#include <execution/Executor.h>
 #include <vector>
 #include <numeric>
 
@@ -45,16 +47,28 @@ CUSTOM_OP_IMPL(embedding_lookup, 2, 1, false, 0, 1) {
             v = i++;
         }
 
-        std::unique_ptr<ResultSet> outputView(output->allTensorsAlongDimension(dims));
         REQUIRE_TRUE(block.width() > output->sizeAt(0), 0, "embedding_lookup: input list should be greater then %i, but %i given.",
                     output->sizeAt(0), block.width()
                 );
+
+        NDArray::preparePrimaryUse({output}, {indeces});
+
+        TadSpan outputView(*output, dims);
         for (Nd4jLong e = 0; e < indeces->lengthOf(); ++e) {
             Nd4jLong thisIndex = (*indeces).e<Nd4jLong>(e);
             input   = INPUT_VARIABLE(thisIndex); // lookup param
 
-            outputView->at(e)->assign(input);
+            if (input->dataType() == output->dataType()) {
+                outputView.assign(e, *input);
+            }
+            else {
+                // span copies raw elements, so param of other type goes through casting assign()
+                std::unique_ptr<NDArray> tad(output->tensorAlongDimension(e, dims));
+                tad->assign(input);
+            }
         }
+
+        NDArray::registerPrimaryUse({output}, {indeces});
     }
     else {
         int indexRank = indeces->rankOf();
@@ -64,6 +78,31 @@ CUSTOM_OP_IMPL(embedding_lookup, 2, 1, false, 0, 1) {
         int lastIndDim = indeces->lengthOf();
         int partition_mode = INT_ARG(0); // partition_mode == 0 - i.e. 'mod' , 1 - 'div'
 
+        // rows are copied straight from params into output, without intermediate gather result
+        if (inputRank > 1 && input->dataType() == output->dataType() && output->sizeAt(0) == lastIndDim) {
+            std::vector<int> dims(inputRank - 1);
+            std::iota(dims.begin(), dims.end(), 1);
+
+            NDArray::preparePrimaryUse({output}, {input, indeces});
+
+            TadSpan inputRows(*input, dims);
+            TadSpan outputRows(*output, dims);
+
+            std::vector<Nd4jLong> rows(lastIndDim);
+            for (Nd4jLong e = 0; e < lastIndDim; e++) {
+                rows[e] = indeces->e<Nd4jLong>(e);
+                REQUIRE_TRUE(rows[e] >= 0 && rows[e] < inputRows.size(), 0, "embedding_lookup: index %lld is out of range [0, %lld) !", rows[e], inputRows.size());
+            }
+
+            Executor::parallel_for(0, lastIndDim, [&](Nd4jLong start, Nd4jLong stop) {
+                for (Nd4jLong e = start; e < stop; e++)
+                    outputRows.assign(e, inputRows, rows[e]);
+            });
+
+            NDArray::registerPrimaryUse({output}, {input, indeces});
+            return Status::OK();
+        }
+
         nd4j::ops::gather op;
 
         std::unique_ptr<ResultSet> result(op.execute({input, indeces}, {}, {0}, {}));
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Exact k nearest neighbours search
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_knn)
+
+#include <ops/declarable/CustomOperations.h>
+#include <helpers/KnnHelper.h>
+
+namespace nd4j {
+namespace ops {
+
+    CUSTOM_OP_IMPL(knn, 2, 2, false, 0, 1) {
+        auto query = INPUT_VARIABLE(0);
+        auto reference = INPUT_VARIABLE(1);
+        auto indices = OUTPUT_VARIABLE(0);
+        auto distances = OUTPUT_VARIABLE(1);
+
+        const int k = INT_ARG(0);
+        const int metric = block.numI() > 1 ? INT_ARG(1) : (int) KnnHelper::EUCLIDEAN;
+
+        REQUIRE_TRUE(query->rankOf() == 2 && reference->rankOf() == 2, 0, "KNN op: query and reference should be 2D arrays, but got ranks %i and %i instead !", query->rankOf(), reference->rankOf());
+        REQUIRE_TRUE(query->sizeAt(1) == reference->sizeAt(1), 0, "KNN op: query and reference should have the same number of columns, but got %lld and %lld instead !", query->sizeAt(1), reference->sizeAt(1));
+        REQUIRE_TRUE(query->dataType() == reference->dataType(), 0, "KNN op: query and reference should have the same data type !");
+        REQUIRE_TRUE(k >= 1 && k <= reference->sizeAt(0), 0, "KNN op: k should be within [1, %lld], but got %i instead !", reference->sizeAt(0), k);
+        REQUIRE_TRUE(metric >= (int) KnnHelper::EUCLIDEAN && metric <= (int) KnnHelper::MANHATTAN, 0, "KNN op: metric should be 0 (euclidean), 1 (cosine) or 2 (manhattan), but got %i instead !", metric);
+
+        KnnHelper::search(*query, *reference, k, metric, *indices, *distances);
+
+        return Status::OK();
+    }
+
+    DECLARE_SHAPE_FN(knn) {
+        auto queryShape = inputShape->at(0);
+        Nd4jLong k = INT_ARG(0);
+
+        auto indicesShape = ConstantShapeHelper::getInstance()->createShapeInfo(nd4j::DataType::INT64, 'c', {shape::sizeAt(queryShape, 0), k});
+        auto distancesShape = ConstantShapeHelper::getInstance()->createShapeInfo(ArrayOptions::dataType(queryShape), 'c', {shape::sizeAt(queryShape, 0), k});
+
+        return SHAPELIST(indicesShape, distancesShape);
+    }
+
+    DECLARE_TYPES(knn) {
+        getOpDescriptor()
+                ->setAllowedInputTypes({ALL_FLOATS})
+                ->setAllowedOutputTypes(0, {ALL_INTS})
+                ->setAllowedOutputTypes(1, {ALL_FLOATS});
+    }
+}
+}
+
+#endif
@@ -88,6 +88,43 @@ namespace nd4j {
             return Status::OK();
         }
 
+        DECLARE_VIEW_FN(slice) {
+            auto input = INPUT_VARIABLE(0);
+            const int x_rank = input->rankOf();
+
+            if (x_rank == 0 || input->isEmpty() || shape::isEmpty(shapeInfo))
+                return nullptr;
+
+            std::vector<int> begin;
+            std::vector<int> sz;
+
+            if (block.width() == 3) {
+                begin = INPUT_VARIABLE(1)->template asVectorT<int>();
+                sz = INPUT_VARIABLE(2)->template asVectorT<int>();
+            } else {
+                ShapeUtils::copyVectorPart(begin, *(block.getIArguments()), x_rank, 0);
+                ShapeUtils::copyVectorPart(sz, *(block.getIArguments()), x_rank, x_rank);
+            }
+
+            if ((int) begin.size() != x_rank || (int) sz.size() != x_rank)
+                return nullptr;
+
+            // anything invalid is left for op itself, to be reported properly
+            std::vector<Nd4jLong> indices(2 * x_rank);
+            for (int e = 0; e < x_rank; e++) {
+                int start = begin[e];
+                int size = sz[e] == -1 ? input->sizeAt(e) - start : sz[e];
+
+                if (start < 0 || size <= 0 || start + size > input->sizeAt(e))
+                    return nullptr;
+
+                indices[2*e]   = start;
+                indices[2*e+1] = start + size;
+            }
+
+            return new NDArray((*input)(indices, true));
+        }
+
         DECLARE_TYPES(slice) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
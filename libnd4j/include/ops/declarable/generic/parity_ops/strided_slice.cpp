@@ -299,13 +299,8 @@ namespace nd4j {
         }
 
 
-        CUSTOM_OP_IMPL(strided_slice, 1, 1, false, 0, 5) {
-            auto x = INPUT_VARIABLE(0);
-            auto z = OUTPUT_VARIABLE(0);
-            if (z->isEmpty()) {
-                return ND4J_STATUS_OK;
-            }
-
+        // evaluates sub-array indices {first, last, stride} per input dimension, shared by op and its view
+        static void stridedSliceIndices(Context& block, NDArray* x, std::vector<Nd4jLong>& indices) {
             int begin_mask = INT_ARG(0);
             int ellipsis_mask = INT_ARG(1);
             int end_mask = INT_ARG(2);
@@ -395,9 +390,8 @@ namespace nd4j {
                 ++e;
             }
 
-            
-            std::vector<Nd4jLong> indices;
-            auto input_shape = x->getShapeAsVector();            
+
+            auto input_shape = x->getShapeAsVector();
             std::vector<Nd4jLong> final_shape;
             bool is_identity;
             bool is_simple_slice;
@@ -406,6 +400,18 @@ namespace nd4j {
             // FIXME: remove this method once we get 1D vectors supported
             //vectorize(input_shape);
             REQUIRE_TRUE(_preprocess_strided_slice(&indices, &final_shape, input_shape, begin, end, strides, begin_mask, ellipsis_mask, end_mask, new_axis_mask, shrink_axis_mask, &is_identity, &is_simple_slice, &is_dim0), 0, "StridedSlice: shape calculation failed");
+        }
+
+        CUSTOM_OP_IMPL(strided_slice, 1, 1, false, 0, 5) {
+            auto x = INPUT_VARIABLE(0);
+            auto z = OUTPUT_VARIABLE(0);
+            if (z->isEmpty()) {
+                return ND4J_STATUS_OK;
+            }
+
+            std::vector<Nd4jLong> indices;
+            stridedSliceIndices(block, x, indices);
+
 //            if(z->lengthOf() == 1 && !z->isEmpty() && (input_shape.size() == 2 && input_shape[0] == 1)) { //(indices.size() == 6) && (indices[2] - indices[0] == 1)) {
 //                z->assign(x->e<float>(indices[0]));
 //            }
@@ -421,6 +427,27 @@ namespace nd4j {
         }
         DECLARE_SYN(stridedslice, strided_slice);
 
+        DECLARE_VIEW_FN(strided_slice) {
+            auto x = INPUT_VARIABLE(0);
+            if (x->isEmpty() || shape::isEmpty(shapeInfo))
+                return nullptr;
+
+            std::vector<Nd4jLong> indices;
+            stridedSliceIndices(block, x, indices);
+
+            if (indices.empty())
+                return nullptr;
+
+            // negative strides aren't supported by sub-array views
+            for (int e = 2; e < (int) indices.size(); e += 3)
+                if (indices[e] <= 0)
+                    return nullptr;
+
+            // shrunk and new axes are unities, so reshape of sub-array is always a view
+            auto sub = (*x)(indices, true, true);
+            return reshapeView(sub, shapeInfo);
+        }
+
         DECLARE_SHAPE_FN(strided_slice) {
             auto inShape = inputShape->at(0);
 
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Vantage point tree build and query
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_vptree)
+
+#include <ops/declarable/CustomOperations.h>
+#include <helpers/VPTree.h>
+
+namespace nd4j {
+namespace ops {
+
+    CUSTOM_OP_IMPL(vptree_build, 1, 2, false, 0, 0) {
+        auto points = INPUT_VARIABLE(0);
+        auto indices = OUTPUT_VARIABLE(0);
+        auto radii = OUTPUT_VARIABLE(1);
+
+        const int metric = block.numI() > 0 ? INT_ARG(0) : (int) KnnHelper::EUCLIDEAN;
+
+        REQUIRE_TRUE(points->rankOf() == 2, 0, "VPTREE_BUILD op: points should be 2D array, but got rank %i instead !", points->rankOf());
+        REQUIRE_TRUE(metric == KnnHelper::EUCLIDEAN || metric == KnnHelper::MANHATTAN, 0, "VPTREE_BUILD op: metric should be 0 (euclidean) or 2 (manhattan), but got %i instead !", metric);
+
+        VPTree::build(*points, metric, *indices, *radii);
+
+        return Status::OK();
+    }
+
+    DECLARE_SHAPE_FN(vptree_build) {
+        auto pointsShape = inputShape->at(0);
+
+        auto indicesShape = ConstantShapeHelper::getInstance()->vectorShapeInfo(shape::sizeAt(pointsShape, 0), nd4j::DataType::INT64);
+        auto radiiShape = ConstantShapeHelper::getInstance()->vectorShapeInfo(shape::sizeAt(pointsShape, 0), ArrayOptions::dataType(pointsShape));
+
+        return SHAPELIST(indicesShape, radiiShape);
+    }
+
+    DECLARE_TYPES(vptree_build) {
+        getOpDescriptor()
+                ->setAllowedInputTypes({ALL_FLOATS})
+                ->setAllowedOutputTypes(0, {ALL_INTS})
+                ->setAllowedOutputTypes(1, {ALL_FLOATS});
+    }
+
+    CUSTOM_OP_IMPL(vptree_query, 4, 2, false, 0, 1) {
+        auto points = INPUT_VARIABLE(0);
+        auto indices = INPUT_VARIABLE(1);
+        auto radii = INPUT_VARIABLE(2);
+        auto queries = INPUT_VARIABLE(3);
+        auto outIndices = OUTPUT_VARIABLE(0);
+        auto outDistances = OUTPUT_VARIABLE(1);
+
+        const int k = INT_ARG(0);
+        const int metric = block.numI() > 1 ? INT_ARG(1) : (int) KnnHelper::EUCLIDEAN;
+
+        REQUIRE_TRUE(points->rankOf() == 2 && queries->rankOf() == 2, 0, "VPTREE_QUERY op: points and queries should be 2D arrays, but got ranks %i and %i instead !", points->rankOf(), queries->rankOf());
+        REQUIRE_TRUE(points->sizeAt(1) == queries->sizeAt(1), 0, "VPTREE_QUERY op: points and queries should have the same number of columns, but got %lld and %lld instead !", points->sizeAt(1), queries->sizeAt(1));
+        REQUIRE_TRUE(points->dataType() == queries->dataType() && points->dataType() == radii->dataType(), 0, "VPTREE_QUERY op: points, radii and queries should have the same data type !");
+        REQUIRE_TRUE(indices->lengthOf() == points->sizeAt(0) && radii->lengthOf() == points->sizeAt(0), 0, "VPTREE_QUERY op: tree was built for %lld points, but got %lld !", indices->lengthOf(), points->sizeAt(0));
+        REQUIRE_TRUE(k >= 1 && k <= points->sizeAt(0), 0, "VPTREE_QUERY op: k should be within [1, %lld], but got %i instead !", points->sizeAt(0), k);
+        REQUIRE_TRUE(metric == KnnHelper::EUCLIDEAN || metric == KnnHelper::MANHATTAN, 0, "VPTREE_QUERY op: metric should be 0 (euclidean) or 2 (manhattan), but got %i instead !", metric);
+
+        VPTree::query(*points, *indices, *radii, *queries, k, metric, *outIndices, *outDistances);
+
+        return Status::OK();
+    }
+
+    DECLARE_SHAPE_FN(vptree_query) {
+        auto queriesShape = inputShape->at(3);
+        Nd4jLong k = INT_ARG(0);
+
+        auto indicesShape = ConstantShapeHelper::getInstance()->createShapeInfo(nd4j::DataType::INT64, 'c', {shape::sizeAt(queriesShape, 0), k});
+        auto distancesShape = ConstantShapeHelper::getInstance()->createShapeInfo(ArrayOptions::dataType(queriesShape), 'c', {shape::sizeAt(queriesShape, 0), k});
+
+        return SHAPELIST(indicesShape, distancesShape);
+    }
+
+    DECLARE_TYPES(vptree_query) {
+        getOpDescriptor()
+                ->setAllowedInputTypes(0, {ALL_FLOATS})
+                ->setAllowedInputTypes(1, {ALL_INTS})
+                ->setAllowedInputTypes(2, {ALL_FLOATS})
+                ->setAllowedInputTypes(3, {ALL_FLOATS})
+                ->setAllowedOutputTypes(0, {ALL_INTS})
+                ->setAllowedOutputTypes(1, {ALL_FLOATS});
+    }
+}
+}
+
+#endif
@@ -25,6 +25,7 @@
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/matmul.h>
 #include <MmulHelper.h>
+#include <helpers/SparseMmulHelper.h>
 
 namespace nd4j {
     namespace ops {
@@ -37,8 +38,13 @@ namespace nd4j {
             REQUIRE_TRUE(x->rankOf() <= 2 && y->rankOf() <= 2 && z->rankOf() <= 2, 0, "xw_plus_b: Input and Output NDArrays should have rank less or equal to 2");
             REQUIRE_TRUE(b->isVector() && b->lengthOf() == z->sizeAt(-1), 0, "xw_plus_b: Input vector should have proper dimension 1x%i. "
                 "But %i != %i.", z->sizeAt(-1), b->lengthOf(), z->sizeAt(-1));
-            // multiply x to y
-            MmulHelper::mmul(x, y, z, 1.0, 0.0);
+            // multiply x to y, very sparse x is multiplied as CSR matrix
+            bool isSparse = false;
+#ifndef __CUDABLAS__
+            isSparse = SparseMmulHelper::mmulIfSparse(x, y, z);
+#endif
+            if (!isSparse)
+                MmulHelper::mmul(x, y, z, 1.0, 0.0);
 
             // adding b vector
             z->addiRowVector(b);
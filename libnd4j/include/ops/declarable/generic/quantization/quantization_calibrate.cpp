@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_quantization_calibrate)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/quantization.h>
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(quantization_calibrate, 3, 4, false, 0, 0) {
+            auto input = INPUT_VARIABLE(0);
+            auto runningMin = INPUT_VARIABLE(1);
+            auto runningMax = INPUT_VARIABLE(2);
+
+            auto min = OUTPUT_VARIABLE(0);
+            auto max = OUTPUT_VARIABLE(1);
+            auto scale = OUTPUT_VARIABLE(2);
+            auto zeroPoint = OUTPUT_VARIABLE(3);
+
+            const int axis = block.getIArguments()->size() > 0 ? INT_ARG(0) : -1;
+            const double momentum = block.getTArguments()->size() > 0 ? T_ARG(0) : 0.;
+
+            REQUIRE_TRUE(runningMin->lengthOf() == runningMax->lengthOf(), 0, "QUANTIZATION_CALIBRATE OP: running min and max must have the same length, but got %i and %i instead !", runningMin->lengthOf(), runningMax->lengthOf());
+            if (runningMin->lengthOf() != 1)
+                REQUIRE_TRUE(input->sizeAt(axis) == runningMin->lengthOf(), 0, "QUANTIZATION_CALIBRATE OP: per-channel ranges length should be equal to %i, but got %i instead !", input->sizeAt(axis), runningMin->lengthOf());
+            REQUIRE_TRUE(momentum >= 0. && momentum < 1., 0, "QUANTIZATION_CALIBRATE OP: momentum must be in range [0, 1), but got %f instead !", momentum);
+
+            if (min != runningMin)
+                min->assign(runningMin);
+            if (max != runningMax)
+                max->assign(runningMax);
+
+            helpers::calibrateRange(block.launchContext(), *input, axis, momentum, *min, *max);
+            helpers::chooseQuantizationParams(block.launchContext(), *min, *max, zeroPoint->dataType(), *scale, *zeroPoint);
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(quantization_calibrate) {
+            auto rangeShapeInfo = inputShape->at(1);
+            auto qType = block.getIArguments()->size() > 1 ? static_cast<nd4j::DataType>(INT_ARG(1)) : nd4j::DataType::UINT8;
+
+            REQUIRE_TRUE(qType == nd4j::DataType::INT8 || qType == nd4j::DataType::UINT8, 0, "QUANTIZATION_CALIBRATE OP: target data type must be INT8 or UINT8 !");
+
+            auto minShape = ConstantShapeHelper::getInstance()->createShapeInfo(ShapeDescriptor(rangeShapeInfo));
+            auto scaleShape = ConstantShapeHelper::getInstance()->createShapeInfo(ShapeDescriptor(rangeShapeInfo, nd4j::DataType::FLOAT32));
+            auto zeroPointShape = ConstantShapeHelper::getInstance()->createShapeInfo(ShapeDescriptor(rangeShapeInfo, qType));
+
+            return SHAPELIST(minShape, minShape, scaleShape, zeroPointShape);
+        }
+
+        DECLARE_TYPES(quantization_calibrate) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(0, {ALL_FLOATS})
+                    ->setAllowedInputTypes(1, {ALL_FLOATS})
+                    ->setAllowedInputTypes(2, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(0, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(1, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(2, {nd4j::DataType::FLOAT32})
+                    ->setAllowedOutputTypes(3, {ALL_QUANTIZED});
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,57 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_quantize_linear)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/quantization.h>
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(quantize_linear, 3, 1, false, 0, 0) {
+            auto input = INPUT_VARIABLE(0);
+            auto scale = INPUT_VARIABLE(1);
+            auto zeroPoint = INPUT_VARIABLE(2);
+            auto output = OUTPUT_VARIABLE(0);
+
+            const int axis = block.getIArguments()->size() > 0 ? INT_ARG(0) : -1;
+
+            REQUIRE_TRUE(scale->lengthOf() == zeroPoint->lengthOf(), 0, "QUANTIZE_LINEAR OP: scale and zero point must have the same length, but got %i and %i instead !", scale->lengthOf(), zeroPoint->lengthOf());
+            if (scale->lengthOf() != 1)
+                REQUIRE_TRUE(input->sizeAt(axis) == scale->lengthOf(), 0, "QUANTIZE_LINEAR OP: per-channel params length should be equal to %i, but got %i instead !", input->sizeAt(axis), scale->lengthOf());
+
+            helpers::quantizeLinear(block.launchContext(), *input, *scale, *zeroPoint, axis, *output);
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(quantize_linear) {
+            auto qType = ArrayOptions::dataType(inputShape->at(2));
+            return SHAPELIST(ConstantShapeHelper::getInstance()->createShapeInfo(ShapeDescriptor(inputShape->at(0), qType)));
+        }
+
+        DECLARE_TYPES(quantize_linear) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(0, {ALL_FLOATS})
+                    ->setAllowedInputTypes(1, {ALL_FLOATS})
+                    ->setAllowedInputTypes(2, {ALL_QUANTIZED})
+                    ->setAllowedOutputTypes(0, {ALL_QUANTIZED});
+        }
+    }
+}
+
+#endif
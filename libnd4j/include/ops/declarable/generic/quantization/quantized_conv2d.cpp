@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_quantized_conv2d)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/convolutions.h>
+#include <ops/declarable/helpers/quantization.h>
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(quantized_conv2d, 6, 1, false, 0, 9) {
+            auto input   = INPUT_VARIABLE(0);                                    // [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
+            auto weights = INPUT_VARIABLE(1);                                    // [kH, kW, iC, oC] always
+            auto inScale = INPUT_VARIABLE(2);
+            auto inZero  = INPUT_VARIABLE(3);
+            auto wScale  = INPUT_VARIABLE(4);
+            auto wZero   = INPUT_VARIABLE(5);
+
+            // bias and output params are optional, so width is 6, 7 (bias), 8 (output params) or 9 (both)
+            auto bias     = block.width() == 7 || block.width() == 9 ? INPUT_VARIABLE(6) : nullptr;     // [oC]
+            auto outScale = block.width() >= 8 ? INPUT_VARIABLE(block.width() - 2) : nullptr;
+            auto outZero  = block.width() >= 8 ? INPUT_VARIABLE(block.width() - 1) : nullptr;
+
+            auto output  = OUTPUT_VARIABLE(0);                                   // [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW)
+
+            int sH = INT_ARG(2);                                                        // strides height
+            int sW = INT_ARG(3);                                                        // strides width
+            int pH = INT_ARG(4);                                                        // paddings height
+            int pW = INT_ARG(5);                                                        // paddings width
+            int dH = INT_ARG(6);                                                        // dilations height
+            int dW = INT_ARG(7);                                                        // dilations width
+            int isSameMode = INT_ARG(8);                                                // 0-VALID, 1-SAME
+            bool isNCHW    = block.getIArguments()->size() > 9 ? !INT_ARG(9) : 1;       // INT_ARG(9): 0-NCHW,  1-NHWC
+            int activation = block.getIArguments()->size() > 10 ? INT_ARG(10) : 0;      // 0-none, 1-relu, 2-relu6
+
+            int kH = INT_ARG(0) > 0 ? INT_ARG(0) : static_cast<int>(weights->sizeAt(0)); // filter(kernel) height
+            int kW = INT_ARG(1) > 0 ? INT_ARG(1) : static_cast<int>(weights->sizeAt(1)); // filter(kernel) width
+
+            int bS, iC, iH, iW, oC, oH, oW;                             // batch size, input channels, input height/width, output channels, output height/width;
+            int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;       // corresponding indexes
+            ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWoC, indWkH, indOoH);
+
+            std::string expectedWeightsShape = ShapeUtils::shapeAsString({kH, kW, iC, oC});
+            REQUIRE_TRUE(expectedWeightsShape == ShapeUtils::shapeAsString(weights), 0, "QUANTIZED_CONV2D OP: wrong shape of weights array, expected is %s, but got %s instead !", expectedWeightsShape.c_str(), ShapeUtils::shapeAsString(weights).c_str());
+            REQUIRE_TRUE(inScale->lengthOf() == 1 && inZero->lengthOf() == 1, 0, "QUANTIZED_CONV2D OP: only per-tensor quantization params are supported for input !");
+            REQUIRE_TRUE((wScale->lengthOf() == 1 || wScale->lengthOf() == oC) && wScale->lengthOf() == wZero->lengthOf(), 0, "QUANTIZED_CONV2D OP: weights quantization params must be scalars or vectors of length %i !", oC);
+            REQUIRE_TRUE(activation >= (int) helpers::QUANTIZED_ACT_NONE && activation <= (int) helpers::QUANTIZED_ACT_RELU6, 0, "QUANTIZED_CONV2D OP: unknown activation %i !", activation);
+            if (bias)
+                REQUIRE_TRUE(bias->rankOf() <= 2 && oC == bias->lengthOf(), 0, "QUANTIZED_CONV2D OP: wrong shape of array with biases, expected rank, length: <=2, %i, but got %i, %i instead !", oC, bias->rankOf(), bias->lengthOf());
+
+            helpers::quantizedConv2d(block.launchContext(), *input, *weights, *inScale, *inZero, *wScale, *wZero, bias, outScale, outZero, *output, kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW, activation);
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(quantized_conv2d) {
+            auto inputShapeInfo   = inputShape->at(0);                                  // [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
+            auto weightsShapeInfo = inputShape->at(1);                                  // [kH, kW, iC, oC] always
+
+            int sH = INT_ARG(2);                                                        // strides height
+            int sW = INT_ARG(3);                                                        // strides width
+            int pH = INT_ARG(4);                                                        // paddings height
+            int pW = INT_ARG(5);                                                        // paddings width
+            int dH = INT_ARG(6);                                                        // dilations height
+            int dW = INT_ARG(7);                                                        // dilations width
+            int isSameMode = INT_ARG(8);                                                // 0-VALID, 1-SAME
+            int isNCHW  = block.getIArguments()->size() > 9 ? !INT_ARG(9) : 1;          // INT_ARG(9): 0-NCHW, 1-NHWC
+
+            int kH = INT_ARG(0) > 0 ? INT_ARG(0) : static_cast<int>(shape::sizeAt(weightsShapeInfo, 0)); // filter(kernel) height
+            int kW = INT_ARG(1) > 0 ? INT_ARG(1) : static_cast<int>(shape::sizeAt(weightsShapeInfo, 1)); // filter(kernel) width
+
+            const int rank = 4;
+            REQUIRE_TRUE(inputShapeInfo[0]   == rank, 0, "QUANTIZED_CONV2D OP: rank of input array must be equal to %i, but got %i instead !", rank, inputShapeInfo[0]);
+            REQUIRE_TRUE(weightsShapeInfo[0] == rank, 0, "QUANTIZED_CONV2D OP: rank of weights array must be equal to %i, but got %i instead !", rank, weightsShapeInfo[0]);
+
+            const int indIiH = isNCHW ? 2 : 1;
+            const Nd4jLong bS = inputShapeInfo[1];                      // batch size
+            const int iH = inputShapeInfo[indIiH+1];                    // input height
+            const int iW = inputShapeInfo[indIiH+2];                    // input width
+            const Nd4jLong oC = weightsShapeInfo[4];                    // output channels
+
+            int oH, oW;                                                 // output height, width
+            ConvolutionUtils::calcOutSizePool2D(oH, oW, kH, kW, sH, sW, pH, pW, dH, dW, iH, iW, isSameMode);
+
+            auto dtype = block.width() >= 8 ? ArrayOptions::dataType(inputShape->at(block.width() - 1)) : nd4j::DataType::FLOAT32;
+            std::vector<Nd4jLong> outShape = isNCHW ? std::vector<Nd4jLong>({bS, oC, oH, oW}) : std::vector<Nd4jLong>({bS, oH, oW, oC});
+
+            return SHAPELIST(ConstantShapeHelper::getInstance()->createShapeInfo(dtype, 'c', outShape));
+        }
+
+        DECLARE_TYPES(quantized_conv2d) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(0, {ALL_QUANTIZED})
+                    ->setAllowedInputTypes(1, {ALL_QUANTIZED})
+                    ->setAllowedInputTypes(nd4j::DataType::ANY)
+                    ->setAllowedOutputTypes(0, {nd4j::DataType::FLOAT32, ALL_QUANTIZED});
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_quantized_matmul)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/quantization.h>
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(quantized_matmul, 6, 1, false, 0, 0) {
+            auto x = INPUT_VARIABLE(0);                                                 // [..., K]
+            auto y = INPUT_VARIABLE(1);                                                 // [K, N]
+            auto xScale = INPUT_VARIABLE(2);
+            auto xZero = INPUT_VARIABLE(3);
+            auto yScale = INPUT_VARIABLE(4);
+            auto yZero = INPUT_VARIABLE(5);
+
+            // bias and output params are optional, so width is 6, 7 (bias), 8 (output params) or 9 (both)
+            auto bias = block.width() == 7 || block.width() == 9 ? INPUT_VARIABLE(6) : nullptr;
+            auto zScale = block.width() >= 8 ? INPUT_VARIABLE(block.width() - 2) : nullptr;
+            auto zZero = block.width() >= 8 ? INPUT_VARIABLE(block.width() - 1) : nullptr;
+
+            auto z = OUTPUT_VARIABLE(0);
+
+            const int activation = block.getIArguments()->size() > 0 ? INT_ARG(0) : 0;
+
+            REQUIRE_TRUE(x->rankOf() >= 2 && y->rankOf() == 2, 0, "QUANTIZED_MATMUL OP: x must have rank >= 2 and y must be matrix, but got x rank = %i, y rank = %i instead !", x->rankOf(), y->rankOf());
+            REQUIRE_TRUE(x->sizeAt(-1) == y->sizeAt(0), 0, "QUANTIZED_MATMUL OP: inconsistent shapes for matrix product: x %s, y %s !", ShapeUtils::shapeAsString(x).c_str(), ShapeUtils::shapeAsString(y).c_str());
+            REQUIRE_TRUE(xScale->lengthOf() == 1 && xZero->lengthOf() == 1, 0, "QUANTIZED_MATMUL OP: only per-tensor quantization params are supported for x !");
+            REQUIRE_TRUE((yScale->lengthOf() == 1 || yScale->lengthOf() == y->sizeAt(1)) && yScale->lengthOf() == yZero->lengthOf(), 0, "QUANTIZED_MATMUL OP: y quantization params must be scalars or vectors of length %i !", y->sizeAt(1));
+            REQUIRE_TRUE(activation >= (int) helpers::QUANTIZED_ACT_NONE && activation <= (int) helpers::QUANTIZED_ACT_RELU6, 0, "QUANTIZED_MATMUL OP: unknown activation %i !", activation);
+            if (bias != nullptr)
+                REQUIRE_TRUE(bias->lengthOf() == y->sizeAt(1), 0, "QUANTIZED_MATMUL OP: bias length should be equal to %i, but got %i instead !", y->sizeAt(1), bias->lengthOf());
+
+            helpers::quantizedMatmul(block.launchContext(), *x, *y, *xScale, *xZero, *yScale, *yZero, bias, zScale, zZero, activation, *z);
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(quantized_matmul) {
+            auto xShapeInfo = inputShape->at(0);
+            auto yShapeInfo = inputShape->at(1);
+
+            auto zShape = ShapeUtils::pullShapeFromShapeInfo(xShapeInfo);
+            zShape.back() = shape::sizeAt(yShapeInfo, 1);
+
+            auto dtype = block.width() >= 8 ? ArrayOptions::dataType(inputShape->at(block.width() - 1)) : nd4j::DataType::FLOAT32;
+
+            return SHAPELIST(ConstantShapeHelper::getInstance()->createShapeInfo(dtype, 'c', zShape));
+        }
+
+        DECLARE_TYPES(quantized_matmul) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(0, {ALL_QUANTIZED})
+                    ->setAllowedInputTypes(1, {ALL_QUANTIZED})
+                    ->setAllowedInputTypes(nd4j::DataType::ANY)
+                    ->setAllowedOutputTypes(0, {nd4j::DataType::FLOAT32, ALL_QUANTIZED});
+        }
+    }
+}
+
+#endif
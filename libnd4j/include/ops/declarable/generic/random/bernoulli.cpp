@@ -60,6 +60,7 @@ namespace nd4j {
 
         DECLARE_TYPES(random_bernoulli) {
             getOpDescriptor()
+                    ->setPure(false)
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
                     ->setAllowedOutputTypes({ALL_FLOATS});
         }
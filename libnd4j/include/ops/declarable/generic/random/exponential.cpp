@@ -69,6 +69,7 @@ namespace nd4j {
 
         DECLARE_TYPES(random_exponential) {
             getOpDescriptor()
+                    ->setPure(false)
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
                     ->setAllowedOutputTypes({ALL_FLOATS});
         }
@@ -42,6 +42,7 @@ namespace nd4j {
 
         DECLARE_TYPES(get_seed) {
             getOpDescriptor()
+                    ->setPure(false)
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
                     ->setAllowedOutputTypes(DataType::INT64);
         }
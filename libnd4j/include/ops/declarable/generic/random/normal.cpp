@@ -56,6 +56,7 @@ namespace nd4j {
 
         DECLARE_TYPES(random_normal) {
             getOpDescriptor()
+                    ->setPure(false)
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
                     ->setAllowedOutputTypes({ALL_FLOATS});
         }
@@ -65,6 +65,7 @@ DECLARE_SHAPE_FN(random_crop) {
 
         DECLARE_TYPES(random_crop) {
             getOpDescriptor()
+                    ->setPure(false)
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
                     ->setAllowedOutputTypes({ALL_FLOATS});
         }
@@ -45,6 +45,7 @@ OP_IMPL(random_shuffle, 1, 1, true) {
 
     DECLARE_TYPES(random_shuffle) {
         getOpDescriptor()
+                ->setPure(false)
                 ->setAllowedInputTypes(nd4j::DataType::ANY)
                 ->setSameMode(true);
     }
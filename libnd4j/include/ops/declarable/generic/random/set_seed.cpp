@@ -54,6 +54,7 @@ namespace nd4j {
 
         DECLARE_TYPES(set_seed) {
             getOpDescriptor()
+                    ->setPure(false)
                     ->setAllowedInputTypes({ALL_INTS})
                     ->setAllowedOutputTypes({ALL_FLOATS});
         }
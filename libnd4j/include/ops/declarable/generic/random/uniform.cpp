@@ -68,6 +68,7 @@ namespace nd4j {
 
         DECLARE_TYPES(randomuniform) {
             getOpDescriptor()
+                    ->setPure(false)
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
                     ->setAllowedOutputTypes({ALL_FLOATS});
         }
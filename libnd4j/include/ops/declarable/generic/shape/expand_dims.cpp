@@ -55,6 +55,11 @@ namespace nd4j {
             return Status::OK();
         }
 
+        DECLARE_VIEW_FN(expand_dims) {
+            // inserting unity never requires copy
+            return reshapeView(*INPUT_VARIABLE(0), shapeInfo);
+        }
+
         DECLARE_TYPES(expand_dims) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
@@ -74,6 +74,24 @@ namespace nd4j {
             return Status::OK();
         }
 
+        DECLARE_VIEW_FN(permute) {
+            auto x = INPUT_VARIABLE(0);
+            if (x->rankOf() == 0 || x->isEmpty())
+                return nullptr;
+
+            auto arguments = block.width() > 1 ? INPUT_VARIABLE(1)->asVectorT<int>() : *block.getIArguments();
+            if (arguments.empty()) {
+                for (int e = x->rankOf() - 1; e >= 0; e--)
+                    arguments.emplace_back(e);
+            }
+
+            for (auto &ax: arguments)
+                if (ax < 0)
+                    ax += x->rankOf();
+
+            return new NDArray(x->permute(arguments));
+        }
+
         DECLARE_TYPES(permute) {
             getOpDescriptor()
                     ->setAllowedInputTypes(0, nd4j::DataType::ANY)
@@ -152,6 +152,17 @@ namespace nd4j {
         }
 
 
+        DECLARE_VIEW_FN(reshape) {
+            auto x = INPUT_VARIABLE(0);
+
+            // only c order of elements can be expressed by strides of input
+            if (block.numI() > 0 && -INT_ARG(0) == 'f')
+                return nullptr;
+
+            return reshapeView(*x, shapeInfo);
+        }
+
+
         DECLARE_TYPES(reshape) {
             getOpDescriptor()
                     ->setAllowedInputTypes(0, nd4j::DataType::ANY)
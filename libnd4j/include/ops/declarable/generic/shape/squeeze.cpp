@@ -80,6 +80,11 @@ namespace nd4j {
             return Status::OK();
         }
 
+        DECLARE_VIEW_FN(squeeze) {
+            // dropping unities never requires copy
+            return reshapeView(*INPUT_VARIABLE(0), shapeInfo);
+        }
+
         DECLARE_TYPES(squeeze) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
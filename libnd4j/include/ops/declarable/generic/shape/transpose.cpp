@@ -87,6 +87,30 @@ namespace ops {
         return Status::OK();
     }
 
+    DECLARE_VIEW_FN(transpose) {
+        auto x = INPUT_VARIABLE(0);
+        if (x->rankOf() == 0 || x->isEmpty())
+            return nullptr;
+
+        if (block.width() == 1)
+            return new NDArray(x->transpose());
+
+        std::vector<int> arguments(*block.getIArguments());
+        if (arguments.empty() && block.width() == 2)
+            arguments = INPUT_VARIABLE(1)->asVectorT<int>();
+
+        if (arguments.empty()) {
+            for (int e = x->rankOf() - 1; e >= 0; e--)
+                arguments.emplace_back(e);
+        }
+
+        for (auto &ax: arguments)
+            if (ax < 0)
+                ax += x->rankOf();
+
+        return new NDArray(x->permute(arguments));
+    }
+
     DECLARE_TYPES(transpose) {
         getOpDescriptor()
                 ->setAllowedInputTypes(nd4j::DataType::ANY)
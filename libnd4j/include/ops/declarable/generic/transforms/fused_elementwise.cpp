@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Chain of elementwise steps executed in one pass over memory
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_fused_elementwise)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/LegacyTransformSameOp.h>
+#include <ops/declarable/LegacyTransformStrictOp.h>
+#include <ops/declarable/LegacyScalarOp.h>
+#include <ops/declarable/LegacyPairwiseTransformOp.h>
+#include <ops/declarable/helpers/fused_elementwise.h>
+#include <loops/fused_chain.h>
+#include <algorithm>
+#include <memory>
+
+namespace nd4j {
+    namespace ops {
+        // operand is repeated along input, so its shape has to match trailing dimensions of input. Leading unit dimensions are ignored
+        static bool isRepeatable(NDArray *input, NDArray *operand) {
+            if (operand->lengthOf() == 1)
+                return true;
+
+            auto shape = operand->getShapeAsVector();
+            auto first = std::find_if(shape.begin(), shape.end(), [](Nd4jLong v) { return v != 1; });
+            auto rank = shape.end() - first;
+            if (rank > input->rankOf())
+                return false;
+
+            auto inputShape = input->getShapeAsVector();
+            return std::equal(first, shape.end(), inputShape.end() - rank);
+        }
+
+        // executes steps one by one with legacy ops, for arrays fused kernel can't handle
+        static Nd4jStatus executeSteps(const std::vector<NDArray*> &inputs, const std::vector<int> &program, const std::vector<double> &tArgs, NDArray *output) {
+            std::vector<Nd4jLong> iArgs;
+            std::vector<bool> bArgs;
+
+            auto source = inputs[0];
+            int offset = 0;
+
+            for (size_t s = 0; s < program.size(); s += 4) {
+                std::vector<double> params(tArgs.begin() + offset, tArgs.begin() + offset + program[s + 3]);
+                offset += program[s + 3];
+
+                std::vector<NDArray*> in({source});
+                std::vector<NDArray*> out({output});
+                std::unique_ptr<DeclarableOp> op;
+                NDArray tiled;
+
+                switch (program[s]) {
+                    case functions::fused::TRANSFORM_SAME:
+                        op.reset(new LegacyTransformSameOp(program[s + 1]));
+                        break;
+                    case functions::fused::TRANSFORM_STRICT:
+                        op.reset(new LegacyTransformStrictOp(program[s + 1]));
+                        break;
+                    case functions::fused::SCALAR:
+                        op.reset(new LegacyScalarOp(program[s + 1]));
+                        break;
+                    default: {
+                            auto operand = inputs[program[s + 2]];
+                            if (!operand->isSameShape(source)) {
+                                tiled = operand->tileToShape(source->getShapeInfo());
+                                operand = &tiled;
+                            }
+
+                            in.emplace_back(operand);
+                            op.reset(new LegacyPairwiseTransformOp(program[s + 1]));
+                        }
+                        break;
+                }
+
+                auto status = op->execute(in, out, params, iArgs, bArgs, source == output);
+                if (status != Status::OK())
+                    return status;
+
+                source = output;
+            }
+
+            if (source != output)
+                output->assign(source);
+
+            return Status::OK();
+        }
+
+        CUSTOM_OP_IMPL(fused_elementwise, -1, 1, true, -2, -1) {
+            auto input = INPUT_VARIABLE(0);
+            auto output = OUTPUT_VARIABLE(0);
+
+            auto program = *block.getIArguments();
+            auto tArgs = *block.getTArguments();
+
+            REQUIRE_TRUE(program.size() % 4 == 0, 0, "FUSED_ELEMENTWISE op: number of integer arguments should be multiple of 4, but got %i instead !", (int) program.size());
+
+            std::vector<NDArray*> inputs(block.width());
+            for (int e = 0; e < (int) block.width(); e++)
+                inputs[e] = INPUT_VARIABLE(e);
+
+            int numT = 0;
+            for (size_t s = 0; s < program.size(); s += 4) {
+                const int step = (int) s / 4;
+                const int kind = program[s];
+                const int stepT = program[s + 3];
+
+                REQUIRE_TRUE(functions::fused::FusedProgram<float>::isSupported(kind, program[s + 1]), 0, "FUSED_ELEMENTWISE op: step %i has unsupported kind %i and opNum %i !", step, kind, program[s + 1]);
+                REQUIRE_TRUE(stepT >= 0 && numT + stepT <= (int) tArgs.size(), 0, "FUSED_ELEMENTWISE op: step %i requires %i T arguments, but only %i left !", step, stepT, (int) tArgs.size() - numT);
+                REQUIRE_TRUE(kind != functions::fused::SCALAR || stepT > 0, 0, "FUSED_ELEMENTWISE op: scalar step %i requires scalar value as T argument !", step);
+
+                if (kind == functions::fused::PAIRWISE) {
+                    const int operand = program[s + 2];
+                    REQUIRE_TRUE(operand > 0 && operand < (int) block.width(), 0, "FUSED_ELEMENTWISE op: operand index of step %i should be within [1, %i), but got %i instead !", step, (int) block.width(), operand);
+                    REQUIRE_TRUE(isRepeatable(input, inputs[operand]), 0, "FUSED_ELEMENTWISE op: operand %s of step %i doesn't match trailing dimensions of input %s !", ShapeUtils::shapeAsString(inputs[operand]).c_str(), step, ShapeUtils::shapeAsString(input).c_str());
+                }
+
+                numT += stepT;
+            }
+
+            bool fused = false;
+#ifndef __CUDABLAS__
+            fused = helpers::fusedElementwise(block.launchContext(), inputs, program, tArgs, *output);
+#endif
+
+            if (!fused)
+                return executeSteps(inputs, program, tArgs, output);
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(fused_elementwise) {
+            auto in = inputShape->at(0);
+
+            return SHAPELIST(ConstantShapeHelper::getInstance()->createShapeInfo(ShapeDescriptor(in, ArrayOptions::dataType(in))));
+        }
+
+        DECLARE_TYPES(fused_elementwise) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(nd4j::DataType::ANY)
+                    ->setSameMode(true);
+        }
+    }
+}
+
+#endif
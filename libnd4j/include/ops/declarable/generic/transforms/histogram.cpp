@@ -24,14 +24,38 @@
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/transforms.h>
 #include <ops/declarable/helpers/histogram.h>
+#include <helpers/ShapeUtils.h>
+#include <algorithm>
 
 namespace nd4j {
     namespace ops {
+        // dimensions of batched histogram, empty for histogram of whole input
+        static std::vector<int> histogramDimensions(Context &block, int rank) {
+            std::vector<int> dimensions;
+            for (int e = 1; e < (int) block.getIArguments()->size(); e++) {
+                auto d = INT_ARG(e);
+                REQUIRE_TRUE(d >= -rank && d < rank, 0, "Histogram: dimension %i is out of range for input of rank %i", d, rank);
+                dimensions.emplace_back(d < 0 ? d + rank : d);
+            }
+
+            std::sort(dimensions.begin(), dimensions.end());
+            dimensions.erase(std::unique(dimensions.begin(), dimensions.end()), dimensions.end());
+            return dimensions;
+        }
+
         CUSTOM_OP_IMPL(histogram, 1, 1, false, 0, 1) {
             auto input = INPUT_VARIABLE(0);
             auto numBins = INT_ARG(0);
             auto output = OUTPUT_VARIABLE(0);
 
+            auto dimensions = histogramDimensions(block, input->rankOf());
+            if (!dimensions.empty()) {
+                REQUIRE_TRUE(numBins == output->sizeAt(-1), 0, "Histogram: numBins must match last dimension of output");
+
+                helpers::histogramHelper(block.launchContext(), *input, *output, dimensions);
+                return Status::OK();
+            }
+
             REQUIRE_TRUE(numBins == output->lengthOf(), 0, "Histogram: numBins must match output length")
 
             output->nullify();
@@ -42,6 +66,17 @@ namespace nd4j {
 
         DECLARE_SHAPE_FN(histogram) {
             auto numBins = INT_ARG(0);
+            auto inShapeInfo = inputShape->at(0);
+
+            auto dimensions = histogramDimensions(block, shape::rank(inShapeInfo));
+            if (!dimensions.empty()) {
+                std::vector<Nd4jLong> shapeOf;
+                for (auto d: ShapeUtils::evalDimsToExclude(shape::rank(inShapeInfo), dimensions))
+                    shapeOf.emplace_back(shape::sizeAt(inShapeInfo, d));
+                shapeOf.emplace_back(numBins);
+
+                return SHAPELIST(ConstantShapeHelper::getInstance()->createShapeInfo(nd4j::DataType::INT64, 'c', shapeOf));
+            }
 
             return SHAPELIST(ConstantShapeHelper::getInstance()->vectorShapeInfo(numBins, nd4j::DataType::INT64));
         }
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Barnes-Hut repulsive forces of t-SNE gradient
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_barnes_repulsive_forces)
+
+#include <ops/declarable/CustomOperations.h>
+#include <helpers/SPTree.h>
+
+namespace nd4j {
+namespace ops  {
+
+    CUSTOM_OP_IMPL(barnes_repulsive_forces, 1, 2, false, -1, 0) {
+        auto data = INPUT_VARIABLE(0);
+        auto forces = OUTPUT_VARIABLE(0);
+        auto sumQ = OUTPUT_VARIABLE(1);
+
+        const double theta = block.numT() > 0 ? T_ARG(0) : 0.5;
+
+        REQUIRE_TRUE(data->rankOf() == 2, 0, "barnes_repulsive_forces: data must be a matrix, but its rank is %i instead !", data->rankOf());
+        REQUIRE_TRUE(data->sizeAt(0) > 0, 0, "barnes_repulsive_forces: data can't be empty !");
+        REQUIRE_TRUE(data->sizeAt(1) >= 1 && data->sizeAt(1) <= SPTree::MAX_DIMENSIONS, 0, "barnes_repulsive_forces: number of columns must be within [1, %i], but got %lld instead !", SPTree::MAX_DIMENSIONS, data->sizeAt(1));
+        REQUIRE_TRUE(theta >= 0.0, 0, "barnes_repulsive_forces: theta can't be negative, but got %f instead !", theta);
+
+        SPTree::repulsiveForces(*data, theta, *forces, *sumQ);
+
+        return Status::OK();
+    }
+
+    DECLARE_TYPES(barnes_repulsive_forces) {
+        getOpDescriptor()
+        ->setAllowedInputTypes(0, {ALL_FLOATS})
+        ->setAllowedOutputTypes(0, {ALL_FLOATS})
+        ->setAllowedOutputTypes(1, {ALL_FLOATS})
+        ->setSameMode(true);
+    }
+
+    DECLARE_SHAPE_FN(barnes_repulsive_forces) {
+        auto in = inputShape->at(0);
+
+        auto forcesShape = ConstantShapeHelper::getInstance()->createShapeInfo(ShapeDescriptor(in, ArrayOptions::dataType(in)));
+        auto sumShape = ConstantShapeHelper::getInstance()->scalarShapeInfo(ArrayOptions::dataType(in));
+
+        return SHAPELIST(forcesShape, sumShape);
+    }
+
+}
+}
+
+#endif
@@ -45,6 +45,24 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(barnes_edge_forces, 4, 1, false, 0, 1);
         #endif
 
+        /**
+         * This operation used as helper with BarnesHutTsne class
+         * to compute repulsive (non-edge) forces with space partitioning tree
+         *
+         * Expected input:
+         * 0: 2D float-point matrix with current embedding, up to 10 columns
+         *
+         * T args:
+         * 0: theta - Barnes-Hut accuracy/speed trade-off, 0 means exact forces. Optional, 0.5 by default
+         *
+         * Output:
+         * 0: 2D matrix with the same shape and type as input, unnormalized negative forces
+         * 1: scalar of the same type, sum of Q used for normalization
+         */
+        #if NOT_EXCLUDED(OP_barnes_repulsive_forces)
+        DECLARE_CUSTOM_OP(barnes_repulsive_forces, 1, 2, false, -1, 0);
+        #endif
+
         /**
          * This operation used as helper with BarnesHutTsne class
          * to Symmetrize the value matrix
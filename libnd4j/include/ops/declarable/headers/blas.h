@@ -101,8 +101,10 @@ namespace nd4j {
          * IArgs[0] - bool, whether to calculate u and v, s is calculated in any case
          * IArgs[1] - bool, whether to calculate full-sized u and v
          * IArgs[2] - the number of cols or rows which determines what algorithm to use. More precisely:
-         *            if diagSize < IArgs[2] then Jacobi algorithm is used, in opposite case the Divide-And-Conquer is applied
+         *            if diagSize < IArgs[2] then two-sided Jacobi algorithm is used, in opposite case Householder QR followed by parallel one-sided Jacobi is applied
          *            Recommended value is 16. 
+         * IArgs[3] - optional, k > 0 enables truncated mode: only top k singular values are evaluated (randomized range finder),
+         *            so s[..., k], u[..., Rows, k], v[..., Cols, k], and IArgs[1] is ignored
          */
         #if NOT_EXCLUDED(OP_svd)
         DECLARE_CUSTOM_OP(svd, 1, 1, false, 0, 3);   
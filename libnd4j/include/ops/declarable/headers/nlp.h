@@ -25,10 +25,19 @@
 namespace nd4j {
     namespace ops {
 
+        /**
+         * Int args:
+         * 0: number of workers. Default: max number of OpenMP threads
+         * 1: number of negative sampling rounds. Default: 0
+         * 2: minibatch size for batched negative sampling: consecutive rows share negative samples. Default: 0, which means disabled
+         */
         #if NOT_EXCLUDED(OP_skipgram)
         DECLARE_CONFIGURABLE_OP(skipgram, 12, 12, true, 0, 0);
         #endif
 
+        /**
+         * Int args: same as skipgram
+         */
         #if NOT_EXCLUDED(OP_cbow)
         DECLARE_CONFIGURABLE_OP(cbow, 15, 15, true, 0, 0);
         #endif
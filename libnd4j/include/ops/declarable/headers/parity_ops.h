@@ -359,18 +359,19 @@ namespace nd4j {
 
         /**
          * This operation extracts a strided (optionally) slice from a tensor,
+         * in graph execution slice with positive strides is a view of input
          */
         #if NOT_EXCLUDED(OP_strided_slice)
-        DECLARE_CUSTOM_OP(strided_slice, 1, 1, false, 0, 5); // TODO: new op type needed. that returns VIEW
+        DECLARE_VIEW_CUSTOM_OP(strided_slice, 1, 1, false, 0, 5);
         DECLARE_CUSTOM_OP(strided_slice_bp, 2, 1, false, 0, 5);
         #endif
 
         /**
          * This operation extracts a slice from a tensor.
-         *
+         * in graph execution slice is a view of input
          */
         #if NOT_EXCLUDED(OP_slice)
-        DECLARE_CUSTOM_OP(slice, 1, 1, false, 0, -2);
+        DECLARE_VIEW_CUSTOM_OP(slice, 1, 1, false, 0, -2);
         DECLARE_CUSTOM_OP(slice_bp, 2, 1, false, 0, -2);
         #endif
 
@@ -751,6 +752,86 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(embedding_lookup, 2, 1, false, 0, 1);
         #endif
 
+        /**
+         * embedding_bag - looks up rows of table and combines rows of every bag into one row,
+         * without materializing looked up rows.
+         *
+         * input params:
+         *    0 - table, 2D float array [V, D]
+         *    1 - ids, either 2D [B, L] with one bag per row, or 1D [N] together with offsets
+         *    2 - offsets, 1D [B] start position of every bag within ids, only for 1D ids
+         *    next (optional) - per-id weights, of the same shape as ids
+         *
+         * int params:
+         *    0 - combine mode: 0 - sum (default), 1 - mean, 2 - sqrtn. Mean and sqrtn divide by sum of weights and
+         *        sqrt of sum of squared weights respectively, empty bags give zero rows
+         *
+         * output:
+         *    0 - 2D array [B, D]
+         *
+         * embedding_bag_bp takes the same inputs followed by gradient of output, and returns sparse gradient of table,
+         * with repeated ids merged:
+         *    0 - unique ids, INT64 vector [U] in order of first appearance
+         *    1 - summed gradient rows [U, D]
+         *    2 - gradient of weights, only if weights were given
+         */
+        #if NOT_EXCLUDED(OP_embedding_bag)
+        DECLARE_CUSTOM_OP(embedding_bag, 2, 1, false, 0, 0);
+        DECLARE_CUSTOM_OP(embedding_bag_bp, 3, -1, false, 0, 0);
+        #endif
+
+        /**
+         * knn - exact k nearest neighbours search. Distances are computed block by block and merged into
+         * per-query heaps, so full [M, N] distance matrix is never stored.
+         *
+         * input params:
+         *    0 - query, 2D float array [M, D]
+         *    1 - reference, 2D float array [N, D]
+         *
+         * int params:
+         *    0 - k, number of neighbours, within [1, N]
+         *    1 - metric (optional): 0 - euclidean (default), 1 - cosine distance, 2 - manhattan
+         *
+         * output:
+         *    0 - INT64 [M, k] indices of neighbours within reference, nearest first
+         *    1 - [M, k] distances
+         */
+        #if NOT_EXCLUDED(OP_knn)
+        DECLARE_CUSTOM_OP(knn, 2, 2, false, 0, 1);
+        #endif
+
+        /**
+         * vptree_build - builds vantage point tree over rows of points, for repeated knn queries over the same points.
+         *
+         * input params:
+         *    0 - points, 2D float array [N, D]
+         *
+         * int params:
+         *    0 - metric (optional): 0 - euclidean (default), 2 - manhattan
+         *
+         * output:
+         *    0 - INT64 [N] tree order of points
+         *    1 - [N] radii of tree nodes
+         *
+         * vptree_query - finds k nearest points for every query using tree built by vptree_build.
+         *
+         * input params:
+         *    0 - points, the same as given to vptree_build
+         *    1 - indices returned by vptree_build
+         *    2 - radii returned by vptree_build
+         *    3 - queries, 2D float array [M, D]
+         *
+         * int params:
+         *    0 - k, number of neighbours, within [1, N]
+         *    1 - metric (optional), should be the same as used by vptree_build
+         *
+         * output: the same as for knn op
+         */
+        #if NOT_EXCLUDED(OP_vptree)
+        DECLARE_CUSTOM_OP(vptree_build, 1, 2, false, 0, 0);
+        DECLARE_CUSTOM_OP(vptree_query, 4, 2, false, 0, 1);
+        #endif
+
         /**
          * dynamic_partition - partition a input tensor onto num_partitions
          * accordingly to index array given.
@@ -891,12 +972,20 @@ namespace nd4j {
         #endif
 
         /*  Calculates alpha weighted dropout
+            Input arguments:
+                0 - input tensor
+                1 - gradient, alpha_dropout_bp only
+                last - noise_shape, optional
             T params:
                 0 - drop probability
                 1 - alpha value
                 2 - alpha' value
                 3 - beta value
+            int param - seed, decisions of forward and backward passes with the same seed are the same
          */
+        #if NOT_EXCLUDED(OP_alpha_dropout)
+        DECLARE_CONFIGURABLE_OP(alpha_dropout, 1, 1, true, 4, 1);
+        #endif
         #if NOT_EXCLUDED(OP_alpha_dropout_bp)
         DECLARE_CONFIGURABLE_OP(alpha_dropout_bp, 2, 1, false, 4, 1);
         #endif
@@ -1667,6 +1756,31 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(non_max_suppression, 2, 1, false, 0, 0);
         #endif
 
+        /*
+         * batched per-class non max suppression (combined_non_max_suppression in TF)
+         * input:
+         *     0 - boxes - 4D-tensor with shape (batch, num_boxes, q, 4), q is either 1 (boxes shared by all classes) or num_classes
+         *     1 - scores - 3D-tensor with shape (batch, num_boxes, num_classes), the same float type as boxes
+         *     2 - max_output_size_per_class - 0D-tensor by int type (optional)
+         *     3 - max_total_size - 0D-tensor by int type (optional)
+         * float args:
+         *     0 - iou_threshold - threshold value for overlap checks (optional, by default 0.5)
+         *     1 - score_threshold - boxes with lower scores are ignored (optional, by default -inf)
+         * int args:
+         *     0 - max_output_size_per_class - as arg 2. Either this or args 2 and 3 should be provided.
+         *     1 - max_total_size - as arg 3
+         *     2 - clip_boxes - clip output boxes to [0, 1] (optional, by default 1)
+         *
+         * output:
+         *     0 - nmsed_boxes - (batch, max_total_size, 4)
+         *     1 - nmsed_scores - (batch, max_total_size)
+         *     2 - nmsed_classes - (batch, max_total_size)
+         *     3 - valid_detections - (batch) by int type, number of valid detections per image, the rest is zero-padded
+         * */
+        #if NOT_EXCLUDED(OP_combined_non_max_suppression)
+        DECLARE_CUSTOM_OP(combined_non_max_suppression, 2, 4, false, -2, -2);
+        #endif
+
         /*
          * cholesky op - decomposite positive square symetric matrix (or matricies when rank > 2).
          * input:
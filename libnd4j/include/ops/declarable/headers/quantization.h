@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// int8/uint8 quantized inference ops, real = (q - zeroPoint) * scale
+//
+
+#ifndef LIBND4J_HEADERS_QUANTIZATION_H
+#define LIBND4J_HEADERS_QUANTIZATION_H
+
+#include <ops/declarable/headers/common.h>
+
+namespace nd4j {
+    namespace ops {
+
+        /**
+         * This operation quantizes floating point input: q = saturate(round(x / scale) + zeroPoint)
+         * Output data type is the data type of zero point (INT8 or UINT8)
+         *
+         * Expected input:
+         * 0: floating point input
+         * 1: scale, scalar (per-tensor) or vector (per-channel)
+         * 2: zero point, scalar (per-tensor) or vector (per-channel)
+         *
+         * Int args:
+         * 0: channel axis, used for per-channel params only. Default: -1
+         */
+        #if NOT_EXCLUDED(OP_quantize_linear)
+        DECLARE_CUSTOM_OP(quantize_linear, 3, 1, false, 0, 0);
+        #endif
+
+        /**
+         * This operation restores floating point values from quantized input: x = (q - zeroPoint) * scale
+         * Output data type is the data type of scale
+         *
+         * Expected input:
+         * 0: INT8 or UINT8 input
+         * 1: scale, scalar (per-tensor) or vector (per-channel)
+         * 2: zero point, scalar (per-tensor) or vector (per-channel)
+         *
+         * Int args:
+         * 0: channel axis, used for per-channel params only. Default: -1
+         */
+        #if NOT_EXCLUDED(OP_dequantize_linear)
+        DECLARE_CUSTOM_OP(dequantize_linear, 3, 1, false, 0, 0);
+        #endif
+
+        /**
+         * This operation is matrix multiplication of quantized operands with int32 accumulation,
+         * and fused bias + activation + requantization epilogue
+         *
+         * Expected input:
+         * 0: x [..., K], INT8 or UINT8
+         * 1: y [K, N], INT8 or UINT8
+         * 2: x scale, scalar
+         * 3: x zero point, scalar
+         * 4: y scale, scalar or vector [N]
+         * 5: y zero point, scalar or vector [N]
+         * 6: optional bias [N], floating point
+         * 7, 8: optional output scale & zero point. If given, output is requantized to zero point data type, otherwise output is FLOAT32
+         *
+         * Int args:
+         * 0: fused activation: 0 - none, 1 - relu, 2 - relu6. Default: 0
+         */
+        #if NOT_EXCLUDED(OP_quantized_matmul)
+        DECLARE_CUSTOM_OP(quantized_matmul, 6, 1, false, 0, 0);
+        #endif
+
+        /**
+         * This operation is 2D convolution of quantized input with quantized weights,
+         * and fused bias + activation + requantization epilogue
+         *
+         * Expected input:
+         * 0: input [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW), INT8 or UINT8
+         * 1: weights [kH, kW, iC, oC], INT8 or UINT8
+         * 2: input scale, scalar
+         * 3: input zero point, scalar
+         * 4: weights scale, scalar or vector [oC]
+         * 5: weights zero point, scalar or vector [oC]
+         * 6: optional bias [oC], floating point
+         * 7, 8: optional output scale & zero point. If given, output is requantized to zero point data type, otherwise output is FLOAT32
+         *
+         * Int args: same as conv2d
+         * 0..8: kH, kW, sH, sW, pH, pW, dH, dW, isSameMode
+         * 9: data format: 0 - NCHW, 1 - NHWC. Default: 0
+         * 10: fused activation: 0 - none, 1 - relu, 2 - relu6. Default: 0
+         */
+        #if NOT_EXCLUDED(OP_quantized_conv2d)
+        DECLARE_CUSTOM_OP(quantized_conv2d, 6, 1, false, 0, 9);
+        #endif
+
+        /**
+         * This operation collects value ranges for post-training quantization.
+         * It's meant to be called for every calibration batch, with outputs 0 and 1 fed back as inputs 1 and 2
+         *
+         * Expected input:
+         * 0: floating point input (i.e. activations of calibrated layer)
+         * 1: running min, scalar (per-tensor) or vector (per-channel). min > max stands for empty range
+         * 2: running max, same shape as running min
+         *
+         * Int args:
+         * 0: channel axis, used for per-channel ranges only. Default: -1
+         * 1: target quantized data type: INT8 or UINT8. Default: UINT8
+         *
+         * T args:
+         * 0: momentum of moving average. Default: 0, which means absolute min/max
+         *
+         * Output:
+         * 0: updated min
+         * 1: updated max
+         * 2: scale (FLOAT32)
+         * 3: zero point (target quantized data type)
+         */
+        #if NOT_EXCLUDED(OP_quantization_calibrate)
+        DECLARE_CUSTOM_OP(quantization_calibrate, 3, 4, false, 0, 0);
+        #endif
+    }
+}
+
+#endif
@@ -25,8 +25,9 @@
 
 namespace nd4j {
     namespace ops {
+        // ops declared with DECLARE_VIEW_CUSTOM_OP publish outputs as views of input during graph execution, whenever strides allow that
         #if NOT_EXCLUDED(OP_permute)
-        DECLARE_CUSTOM_OP(permute, 1, 1, true, 0, -2);   
+        DECLARE_VIEW_CUSTOM_OP(permute, 1, 1, true, 0, -2);
         #endif
 
         #if NOT_EXCLUDED(OP_reshapeas)
@@ -34,7 +35,7 @@ namespace nd4j {
         #endif
 
         #if NOT_EXCLUDED(OP_transpose)
-        DECLARE_CUSTOM_OP(transpose, 1, 1, true, 0, 0);
+        DECLARE_VIEW_CUSTOM_OP(transpose, 1, 1, true, 0, 0);
         #endif
 
         #if NOT_EXCLUDED(OP_shape_of)
@@ -46,15 +47,15 @@ namespace nd4j {
         #endif
 
         #if NOT_EXCLUDED(OP_squeeze)
-        DECLARE_CUSTOM_OP(squeeze, 1, 1, true, 0, -2);
+        DECLARE_VIEW_CUSTOM_OP(squeeze, 1, 1, true, 0, -2);
         #endif
 
         #if NOT_EXCLUDED(OP_expand_dims)
-        DECLARE_CUSTOM_OP(expand_dims, 1, 1, false, 0, -2);
+        DECLARE_VIEW_CUSTOM_OP(expand_dims, 1, 1, false, 0, -2);
         #endif
 
         #if NOT_EXCLUDED(OP_reshape)
-        DECLARE_CUSTOM_OP(reshape, 1, 1, true, 0, -2);
+        DECLARE_VIEW_CUSTOM_OP(reshape, 1, 1, true, 0, -2);
         #endif
 
         #if NOT_EXCLUDED(OP_size_at)
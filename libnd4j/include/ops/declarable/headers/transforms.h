@@ -217,11 +217,38 @@ namespace nd4j {
         #endif
 
         /**
-         * This operation calculates number of entries per bin
+         * This operation calculates number of entries per bin, bins are spread evenly between min and max of input
+         *
+         * Integer arguments:
+         * 0 - number of bins
+         * 1... - optional dimensions. If given, every TAD along them gets its own histogram with its own min and max,
+         *        output has shape of input without these dimensions plus trailing numBins dimension
          */
         #if NOT_EXCLUDED(OP_histogram)
         DECLARE_CUSTOM_OP(histogram, 1, 1, false, 0, 1);
         #endif
+
+        /**
+         * This operation applies chain of elementwise steps to the input in one pass over memory.
+         * Each step is one of simdOps functors listed in loops/fused_chain.h: same/strict transform, scalar op or pairwise op.
+         * Usually it's created by graph optimizer out of chains of legacy transform/scalar/pairwise nodes and relu/sigmoid/tanh/biasadd.
+         *
+         * Input arrays:
+         * 0 - input array
+         * 1... - optional operands of pairwise steps: arrays of input shape, single element arrays, or arrays matching trailing dimensions of input
+         *
+         * Integer arguments, 4 per step:
+         * - step kind: 0 - transform same, 1 - transform strict, 2 - scalar, 3 - pairwise
+         * - opNum within respective op family
+         * - index of operand array for pairwise step, ignored for other steps
+         * - number of T arguments consumed by this step: extra params of the step, scalar steps take scalar value first
+         *
+         * Output array has shape and data type of input. Float contiguous arrays are processed by fused kernel,
+         * everything else is executed step by step with legacy ops
+         */
+        #if NOT_EXCLUDED(OP_fused_elementwise)
+        DECLARE_CUSTOM_OP(fused_elementwise, -1, 1, true, -2, -1);
+        #endif
     }
 }
 
@@ -19,6 +19,9 @@
 //
 
 #include <ops/declarable/helpers/BarnesHutTsne.h>
+#include <execution/Executor.h>
+#include <algorithm>
+#include <vector>
 
 namespace nd4j {
 namespace ops {
@@ -62,73 +65,85 @@ namespace helpers {
 
     template <typename T>
     static void barnes_symmetrize_(const NDArray* rowP, const NDArray* colP, const NDArray* valP, Nd4jLong N, NDArray* outputRows, NDArray* outputCols, NDArray* outputVals, NDArray* rowCounts) {
-        //auto N = rowP->lengthOf() - 1; /// 2 + rowP->lengthOf() % 2;
-        //auto numElements = output->lengthOf();
-        //std::vector<int> symRowP = rowCounts->asVectorT<int>();//NDArrayFactory::create<int>('c', {numElements});
-        //NDArray symValP = NDArrayFactory::create<double>('c', {numElements});
-        //symRowP.insert(symRowP.begin(),0);
-        //symRowP(1, {0}) = *rowCounts;
         int const* pRows = reinterpret_cast<int const*>(rowP->getBuffer());
+        int const* pCols = reinterpret_cast<int const*>(colP->getBuffer());
+        T const* pVals = reinterpret_cast<T const*>(valP->getBuffer());
         int* symRowP = reinterpret_cast<int*>(outputRows->buffer());
+        int* symColP = reinterpret_cast<int*>(outputCols->buffer());
+        T* pOutput = reinterpret_cast<T*>(outputVals->buffer());
+
         symRowP[0] = 0;
         for (int n = 0; n < N; n++)
             symRowP[n + 1] = symRowP[n] + rowCounts->e<int>(n);
-//        outputRows->printBuffer("output rows");
 
-        int* symColP = reinterpret_cast<int*>(outputCols->buffer());
-//            symRowP.p(n + 1, symRowP.e(n) + rowCounts.e(n))
-//        outputRows->printBuffer("SymRows are");
-        int const* pCols = reinterpret_cast<int const*>(colP->getBuffer());
-        T const* pVals = reinterpret_cast<T const*>(valP->getBuffer());
-        T* pOutput = reinterpret_cast<T*>(outputVals->buffer());
-        //std::vector<int> rowCountsV = rowCounts->getBufferAsVector<int>();
-        std::vector<int> offset(N);// = NDArrayFactory::create<int>('c', {N});
+        // transposed structure: for every column n, rows having entry (r, n) in ascending order, together with position of that entry
+        const int numEntries = pRows[N];
+        std::vector<int> tRows(N + 1, 0);
+        for (int i = 0; i < numEntries; i++)
+            ++tRows[pCols[i] + 1];
 
-//PRAGMA_OMP_PARALLEL_FOR_SIMD_ARGS(schedule(guided) shared(offset))
-        for (int n = 0; n < N; n++) {
-            int begin = pRows[n];
-            int bound = pRows[n + 1];
+        for (int n = 0; n < N; n++)
+            tRows[n + 1] += tRows[n];
 
-            for (int i = begin; i < bound; i++) {
-                bool present = false;
-                int colPI = pCols[i];
-                int start = pRows[colPI];
-                int end = pRows[colPI + 1];
+        std::vector<int> tCols(numEntries);
+        std::vector<int> tPos(numEntries);
+        std::vector<int> fill(tRows.begin(), tRows.end() - 1);
+        for (int n = 0; n < N; n++)
+            for (int i = pRows[n]; i < pRows[n + 1]; i++) {
+                tCols[fill[pCols[i]]] = n;
+                tPos[fill[pCols[i]]++] = i;
+            }
 
-                //PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided) firstprivate(offset))
-                for (int m = start; m < end; m++) {
-                    if (pCols[m] == n) {
-                        present = true;
-                        if (n <= colPI) {
-                            symColP[symRowP[n] + offset[n]]        = colPI;
-                            symColP[symRowP[colPI] + offset[colPI]] = n;
-                            pOutput[symRowP[n] + offset[n]] = pVals[i] + pVals[m];
-                            pOutput[symRowP[colPI] + offset[colPI]] = pVals[i] + pVals[m];
-                        }
-                    }
+        // every output row is merged from row n and column n of input independently. Order of entries within row is the same
+        // as sequential pass over rows gives: (r, n) entries of rows r < n, then own entries, then (r, n) entries of rows r > n
+        auto func = [&](Nd4jLong start, Nd4jLong stop) {
+            for (int n = start; n < stop; n++) {
+                const int begin = pRows[n];
+                const int bound = pRows[n + 1];
+                const int tBegin = tRows[n];
+                const int tBound = tRows[n + 1];
+                int offset = symRowP[n];
+
+                // position of entry (n, c) within row n, or -1
+                auto ownEntry = [&](int c) -> int {
+                    for (int i = begin; i < bound; i++)
+                        if (pCols[i] == c)
+                            return i;
+                    return -1;
+                };
+
+                for (int t = tBegin; t < tBound && tCols[t] < n; t++) {
+                    const int i = ownEntry(tCols[t]);
+                    symColP[offset] = tCols[t];
+                    pOutput[offset++] = i < 0 ? pVals[tPos[t]] : pVals[tPos[t]] + pVals[i];
                 }
 
-                // If (colP[i], n) is not present, there is no addition involved
-                if (!present) {
-                    //int colPI = pCols[i];
-                    //if (n <= colPI) {
-                        symColP[symRowP[n] + offset[n]] = colPI;
-                        symColP[symRowP[pCols[i]] + offset[colPI]] = n;
-                        pOutput[symRowP[n] + offset[n]] = pVals[i];
-                        pOutput[symRowP[colPI] + offset[colPI]] = pVals[i];
-                    //}
-
+                for (int i = begin; i < bound; i++) {
+                    const int colPI = pCols[i];
+                    auto t = std::lower_bound(tCols.begin() + tBegin, tCols.begin() + tBound, colPI);
+                    const bool present = t != tCols.begin() + tBound && *t == colPI;
+
+                    // present entries with smaller column were merged above
+                    if (!present) {
+                        symColP[offset] = colPI;
+                        pOutput[offset++] = pVals[i];
+                    } else if (n <= colPI) {
+                        symColP[offset] = colPI;
+                        pOutput[offset++] = pVals[i] + pVals[tPos[t - tCols.begin()]];
+                    }
                 }
-                // Update offsets
-                if (!present || (present && n <= colPI)) {
-                    ++offset[n];
 
-                    if (colPI != n)
-                        ++offset[colPI];
+                for (int t = tBegin; t < tBound; t++) {
+                    if (tCols[t] <= n || ownEntry(tCols[t]) >= 0)
+                        continue;
+
+                    symColP[offset] = tCols[t];
+                    pOutput[offset++] = pVals[tPos[t]];
                 }
-//                printVector(offset);
             }
-        }
+        };
+
+        Executor::parallel_for(0, N, func);
     }
     void barnes_symmetrize(const NDArray* rowP, const NDArray* colP, const NDArray* valP, Nd4jLong N, NDArray* outputRows, NDArray* outputCols, NDArray* outputVals, NDArray* rowCounts) {
 
@@ -20,72 +20,139 @@
 
 #include <ops/declarable/helpers/dropout.h>
 #include <NativeOps.h>
+#include <helpers/PhiloxRandom.h>
+#include <execution/Executor.h>
 #include <vector>
-#include <memory>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    template <typename T>
-    static void dropoutSimple(NDArray const* input, NDArray* output, double probValue, int seed) {
+    /**
+     * Keep decisions of dropout, regenerated from seed on every call instead of being stored.
+     * Element is kept if Philox value of its index (or of its noise shape position) is below probValue * 2^32,
+     * so forward and backward passes with the same seed make the same decisions
+     */
+    class DropoutMask {
+    private:
+        nd4j::graph::RandomGenerator _rng;
+        nd4j::random::PhiloxRandom _philox;
+        uint64_t _threshold;
+
+        // noise shape is aligned to trailing dimensions of input, every input coordinate is taken modulo noise dimension
+        std::vector<Nd4jLong> _inputShape;
+        std::vector<Nd4jLong> _noiseShape;
+        std::vector<Nd4jLong> _noiseStrides;
+
+        // decisions for noise shape positions, only used when noise shape is smaller than input
+        std::vector<uint8_t> _noiseKeep;
+
+    public:
+        DropoutMask(const NDArray* input, const NDArray* reduceShape, int seed, double probValue) : _rng(3019L, seed), _philox(_rng) {
+            _threshold = static_cast<uint64_t>(probValue * 4294967296.0);
+
+            if (reduceShape == nullptr)
+                return;
+
+            const int rank = input->rankOf();
+            const int noiseRank = (int) reduceShape->lengthOf();
+            REQUIRE_TRUE(noiseRank <= rank, 0, "dropout: Noise shape should be fittable to input");
+
+            _inputShape.resize(rank);
+            _noiseShape.assign(rank, 1);
+            _noiseStrides.resize(rank);
+
+            Nd4jLong noiseLength = 1;
+            for (int e = rank - 1; e >= 0; e--) {
+                _inputShape[e] = input->sizeAt(e);
+
+                auto n = e - (rank - noiseRank);
+                if (n >= 0)
+                    _noiseShape[e] = reduceShape->e<Nd4jLong>(n);
 
-        nd4j::graph::RandomGenerator nodeRng(3019L, seed);
-        int inLen = input->lengthOf();
+                REQUIRE_TRUE(_noiseShape[e] > 0 && _inputShape[e] % _noiseShape[e] == 0, 0, "dropout: Noise shape should fit to input rank.");
 
-        PRAGMA_OMP_PARALLEL_FOR_IF(inLen > Environment::getInstance()->elementwiseThreshold())
-        for (Nd4jLong e = 0; e < inLen; ++e) {
-            float val = nodeRng.relativeT(e, T(0.f), T(1.f));
+                _noiseStrides[e] = noiseLength;
+                noiseLength *= _noiseShape[e];
+            }
+
+            if (noiseLength == input->lengthOf()) {
+                _noiseShape.clear();
+                return;
+            }
 
-            if (val < probValue)
-                output->p<T>(e, input->e<T>(e) / probValue);
+            _noiseKeep.resize(noiseLength);
+            for (Nd4jLong e = 0; e < noiseLength; e++)
+                _noiseKeep[e] = keep(_philox.value(e)) ? 1 : 0;
         }
-    }
-    BUILD_SINGLE_TEMPLATE(template void dropoutSimple, (NDArray const* input, NDArray* output, double probValue, int seed), FLOAT_TYPES);
 
-    template <typename T>
-    int dropOutFunctor_(graph::Context& context, NDArray* input, NDArray* output, NDArray* reduceShape, int seed, double probValue) {
-        //NativeOps native;
-        //nd4j::graph::RandomGenerator nodeRng(seed);   //static int dropOutFunctor_(nd4j::random::RandomBuffer* rng, NDArray* input, NDArray* output, NDArray* reduceShape, int seed, double probValue) {
-        //NativeOps native;
-        //native.reSeedBuffer(nullptr, (long)seed, rng);
-        //if (newRng )
-        if (reduceShape == nullptr){
-            dropoutSimple<T>(input, output, probValue, seed);
+        FORCEINLINE bool keep(uint32_t value) const {
+            return value < _threshold;
+        }
+
+        FORCEINLINE bool noisy() const {
+            return !_noiseShape.empty();
         }
-        else {
-            REQUIRE_TRUE(reduceShape->lengthOf() <= input->rankOf(), 0, "dropout: Noise shape should be fittable to input");
-
-            std::vector<Nd4jLong> dims(reduceShape->lengthOf());
-
-            bool fit = true;
-            PRAGMA_OMP_PARALLEL_FOR_ARGS(firstprivate(fit))
-            for( int i = 0; i < dims.size(); i++ ) {
-                if (fit) {
-                    dims[i] = reduceShape->e<Nd4jLong>(i);
-                    for (int e = 0; e < input->rankOf(); ++e)
-                        if (fit)
-                        if (input->sizeAt(e) % dims[i]) {
-                            fit = false;
-                        }
-                }
-            }
 
-            // check dims to fit input
-            REQUIRE_TRUE(fit, 0, "dropout: Noise shape should fit to input rank.");
-            std::unique_ptr<NDArray> chunk(new NDArray('c', dims, output->dataType(), output->getContext()));
-            chunk->assign(1.f);
-            //chunk->applyRandom<randomOps::DropOutInverted<T>>(rng, nullptr, chunk.get(), &probValue);
-            //NativeOpExecutioner::execRandom(random::DropOutInverted, rng, chunk->buffer(), chunk->shapeInfo(), chunk->buffer(), chunk->shapeInfo(), &prob);
-            dropoutSimple<T>(chunk.get(), chunk.get(), probValue, seed);
-            // broadcast chunk to full matrix
-            std::unique_ptr<NDArray> dropOutMultiplier(new NDArray(*input));
-            dropOutMultiplier->assign(1.f);
+        const nd4j::random::PhiloxRandom& philox() const {
+            return _philox;
+        }
 
-            *dropOutMultiplier += *chunk;
+        // decision of input element with given c-order index
+        FORCEINLINE bool keepAt(Nd4jLong index) const {
+            Nd4jLong position = 0;
+            for (int e = (int) _inputShape.size() - 1; e >= 0; e--) {
+                position += (index % _inputShape[e]) % _noiseShape[e] * _noiseStrides[e];
+                index /= _inputShape[e];
+            }
 
-             output->assign(*input * *dropOutMultiplier); //input->applyPairwiseTransform(pairwise::Multiply, dropOutMultiplier.get(), output, nullptr);
+            return _noiseKeep[position] != 0;
         }
+    };
+
+    /**
+     * Fused dropout kernel: decisions are made on the fly, and output = func(source, kept) is written in the same pass
+     */
+    template <typename T, typename F>
+    static void applyMask(const DropoutMask& mask, const NDArray* source, NDArray* output, const F& func) {
+        const Nd4jLong length = output->lengthOf();
+        const Nd4jLong batch = nd4j::random::PhiloxRandom::LENGTH;
+        const Nd4jLong numBatches = length / batch + (length % batch != 0 ? 1 : 0);
+
+        const bool direct = source->dataType() == output->dataType() && source->ordering() == 'c' && source->ews() == 1 && output->ordering() == 'c' && output->ews() == 1;
+        auto x = direct ? source->bufferAsT<T>() : nullptr;
+        auto z = direct ? output->bufferAsT<T>() : nullptr;
+
+        Executor::parallel_for(0, numBatches, [&](Nd4jLong start, Nd4jLong stop) {
+            uint32_t values[nd4j::random::PhiloxRandom::LENGTH];
+
+            for (Nd4jLong b = start; b < stop; b++) {
+                auto first = b * batch;
+                auto last = nd4j::math::nd4j_min<Nd4jLong>(length, first + batch);
+
+                if (!mask.noisy())
+                    mask.philox().blocks(static_cast<uint64_t>(first) / 4, values);
+
+                for (auto e = first; e < last; e++) {
+                    bool kept = mask.noisy() ? mask.keepAt(e) : mask.keep(values[e - first]);
+
+                    if (direct)
+                        z[e] = func(x[e], kept);
+                    else
+                        output->p<T>(e, func(source->e<T>(e), kept));
+                }
+            }
+        }, 16);
+    }
+
+    template <typename T>
+    int dropOutFunctor_(graph::Context& context, NDArray* input, NDArray* output, NDArray* reduceShape, int seed, double probValue) {
+        DropoutMask mask(input, reduceShape, seed, probValue);
+        const T scale = static_cast<T>(1. / probValue);
+
+        applyMask<T>(mask, input, output, [&](T x, bool kept) -> T {
+            return kept ? x * scale : static_cast<T>(0.f);
+        });
 
         return Status::OK();
     }
@@ -101,37 +168,28 @@ namespace helpers {
 /////////////////////////////////// backrpopagations ///////////////////////////////////////////////
     template <typename T>
     static int dropOutFunctorBP_(graph::Context& context, NDArray* input, NDArray* gradOut, NDArray* output, NDArray* reduceShape, int seed, double probValue) {
+        // mask is regenerated from the same seed, gradient passes where forward value passed
+        DropoutMask mask(input, reduceShape, seed, probValue);
+        const T scale = static_cast<T>(1. / probValue);
 
-        int res = dropOutFunctor(context, input, output, reduceShape, seed, probValue);
-
-        if (ND4J_STATUS_OK == res)
-            for (Nd4jLong e = 0; e < output->lengthOf(); e++) {
-                if (output->e<float>(e) != 0.f) output->p<T>(e, gradOut->e<double>(e) / probValue);
-//            else (*output)(e) = T(0.f);
-            }
+        applyMask<T>(mask, gradOut, output, [&](T grad, bool kept) -> T {
+            return kept ? grad * scale : static_cast<T>(0.f);
+        });
 
-        return res;
+        return Status::OK();
     }
 
     template <typename T>
     static int alphaDropOutFunctor_(graph::Context& context, NDArray* input, NDArray* output,
                             NDArray* reduceShape, int seed, double probValue, double alpha, double alpha1, double beta) {
+        DropoutMask mask(input, reduceShape, seed, probValue);
+        const T a = static_cast<T>(alpha);
+        const T b = static_cast<T>(alpha1);
+        const T dropped = static_cast<T>(alpha * beta + alpha1);
 
-        //NativeOps native;
-        //auto rng = context.getRNG();
-        //native.reSeedBuffer(nullptr, (long)seed, rng);
-        //if (rng == nullptr)
-        //    return ND4J_STATUS_BAD_RNG;
-        //T probValueArr[] = {probValue, alpha, alpha1, beta};
-        //input->template applyRandom<randomOps::AlphaDropOut<T>>(rng, nullptr, output, probValueArr);
-        nd4j::graph::RandomGenerator nodeRng(3019L, seed);
-
-        PRAGMA_OMP_PARALLEL_FOR_IF(input->lengthOf() > Environment::getInstance()->elementwiseThreshold())
-        for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
-            float randVal = nodeRng.relativeT(e, T(0.f), T(1.f));
-            float xVal = input->e<float>(e);
-            output->p<float>(e, randVal >= probValue ? alpha * beta + alpha1 : alpha * xVal + alpha1);
-        }
+        applyMask<T>(mask, input, output, [&](T x, bool kept) -> T {
+            return kept ? a * x + b : dropped;
+        });
 
         return ND4J_STATUS_OK;
     }
@@ -139,13 +197,15 @@ namespace helpers {
     template <typename T>
     int alphaDropOutFunctorBP_(graph::Context& context, NDArray* input, NDArray* gradOut, NDArray* output,
                               NDArray* reduceShape, int seed, double probValue, double alpha, double alpha1, double beta) {
+        // dropped elements are constant, kept ones are alpha * x + alpha'
+        DropoutMask mask(input, reduceShape, seed, probValue);
+        const T a = static_cast<T>(alpha);
 
-        int res = alphaDropOutFunctor(context, input, output, reduceShape, seed, probValue, alpha, alpha1, beta);
-        if (res == ND4J_STATUS_OK) {
-            (*output) *= alpha;
-            (*output) *= (*gradOut); //->applyPairwiseTransform<transform::Multiply>(gradOut, output, nullptr);
-        }
-        return res;
+        applyMask<T>(mask, gradOut, output, [&](T grad, bool kept) -> T {
+            return kept ? a * grad : static_cast<T>(0.f);
+        });
+
+        return ND4J_STATUS_OK;
     }
 
     int dropOutFunctorBP(graph::Context& context, NDArray* input, NDArray* gradOut, NDArray* output, NDArray* reduceShape, int seed, double probValue) {
@@ -165,4 +225,4 @@ namespace helpers {
 
 }
 }
-}
\ No newline at end of file
+}
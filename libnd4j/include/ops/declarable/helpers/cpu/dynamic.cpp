@@ -18,6 +18,10 @@
 // Created by george on 05.04.18.
 //
 #include <ops/declarable/helpers/dynamic.h>
+#include <array/TadSpan.h>
+#include <helpers/RadixPartition.h>
+#include <execution/Executor.h>
+#include <algorithm>
 
 namespace nd4j {
     namespace ops {
@@ -25,7 +29,22 @@ namespace nd4j {
 
             template <typename T>
             static void _dynamicPartitionFunctor(NDArray const* input, NDArray const* indices, std::vector<NDArray*>& outputList) {
-                std::vector<std::pair<NDArray *, int>> outputs(outputList.size());
+                const int outSize = (int) outputList.size();
+                const auto length = indices->lengthOf();
+
+                std::vector<Nd4jLong> ids(length);
+                for (Nd4jLong e = 0; e < length; ++e)
+                    ids[e] = indices->e<Nd4jLong>(e);
+
+                // stable grouping by partition: order within every output matches order of indices
+                std::vector<Nd4jLong> order;
+                std::vector<Nd4jLong> offsets;
+                RadixPartition::partition(length, outSize, [&](Nd4jLong e) { return ids[e] >= 0 && ids[e] < outSize ? (int) ids[e] : -1; }, order, offsets);
+
+                auto partitionOf = [&](Nd4jLong pos) -> int {
+                    return (int) (std::upper_bound(offsets.begin(), offsets.end(), pos) - offsets.begin()) - 1;
+                };
+
                 int sourceDimsLen = input->rankOf() - indices->rankOf();
                 if (sourceDimsLen) {
                     std::vector<int> sourceDims(sourceDimsLen);
@@ -33,42 +52,41 @@ namespace nd4j {
                     for (int i = sourceDimsLen; i > 0; i--)
                         sourceDims[sourceDimsLen - i] = input->rankOf() - i;
 
-                    std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(sourceDims));
+                    TadSpan inputTads(*input, sourceDims);
 
-                    unsigned int outSize = outputList.size();
+                    std::vector<TadSpan> outputTads;
+                    outputTads.reserve(outSize);
 
-                    //PRAGMA_OMP_PARALLEL_FOR_IF(outSize > Environment::getInstance()->tadThreshold())
-                    for (unsigned int i = 0; i < outSize; i++) {
-                        outputs[i].first = outputList[i];
-                        std::vector<int> outDims(outputs[i].first->rankOf() - 1);
+                    for (int i = 0; i < outSize; i++) {
+                        std::vector<int> outDims(outputList[i]->rankOf() - 1);
 
-                        int r = outputs[i].first->rankOf();
+                        int r = outputList[i]->rankOf();
 
                         for (int k = 1; k < r; k++)
                             outDims[k - 1] = k;
 
-                        std::unique_ptr<ResultSet> listOutForCurrent(
-                                outputs[i].first->allTensorsAlongDimension(outDims));
-
-                        outputs[i].second = 0;
-
-                        //PRAGMA_OMP_PARALLEL_FOR_IF(indices->lengthOf() > Environment::getInstance()->elementwiseThreshold())
-                        for (int e = 0; e < indices->lengthOf(); ++e)
-                            if ((*indices).e<Nd4jLong>(e) == i)
-                                listOutForCurrent->at(outputs[i].second++)->assign(listOfTensors->at(e));
+                        outputTads.emplace_back(*outputList[i], outDims);
                     }
 
+                    Executor::parallel_for(0, (Nd4jLong) order.size(), [&](Nd4jLong start, Nd4jLong stop) {
+                        auto i = partitionOf(start);
+                        for (Nd4jLong pos = start; pos < stop; pos++) {
+                            while (pos >= offsets[i + 1])
+                                i++;
+
+                            outputTads[i].assign(pos - offsets[i], inputTads, order[pos]);
+                        }
+                    });
                 } else {
-                    unsigned int outSize = outputList.size();
+                    Executor::parallel_for(0, (Nd4jLong) order.size(), [&](Nd4jLong start, Nd4jLong stop) {
+                        auto i = partitionOf(start);
+                        for (Nd4jLong pos = start; pos < stop; pos++) {
+                            while (pos >= offsets[i + 1])
+                                i++;
 
-                    PRAGMA_OMP_PARALLEL_FOR_IF(outSize > Environment::getInstance()->tadThreshold())
-                    for (unsigned int i = 0; i < outSize; i++) {
-                        outputs[i].first = outputList[i];
-                        outputs[i].second = 0;
-                        for (int e = 0; e < indices->lengthOf(); ++e)
-                            if (indices->e<Nd4jLong>(e) == i)
-                                outputs[i].first->p(outputs[i].second++, input->e<T>(e));
-                    }
+                            outputList[i]->p(pos - offsets[i], input->e<T>(order[pos]));
+                        }
+                    }, RadixPartition::GRAIN);
                 }
             }
             template <typename T>
@@ -100,7 +118,7 @@ namespace nd4j {
                     for (int i = restDims.size(); i > 0;  i--)
                         restDims[restDims.size() - i] = output->rankOf() - i;
 
-                    std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+                    TadSpan outputTads(*output, restDims);
 
                     for (int e = 0; e < numOfData; e++) {
                         auto data = inputs[e];
@@ -109,7 +127,7 @@ namespace nd4j {
                         for (int i = sourceDims.size(); i > 0;  i--)
                             sourceDims[sourceDims.size() - i] = data->rankOf() - i;
 
-                        std::unique_ptr<ResultSet> listOfTensors(data->allTensorsAlongDimension(sourceDims));
+                        TadSpan inputTads(*data, sourceDims);
 
                         for (int i = 0; i < index->lengthOf(); i++) {
                             auto pos = index->e<Nd4jLong>(i);
@@ -117,13 +135,13 @@ namespace nd4j {
                                 nd4j_printf("dynamic_stitch: Index value should be non-negative. But %i was given", pos);
                                 return ND4J_STATUS_VALIDATION;
                             }
-                            if (pos >= output->lengthOf()) {
+                            if (pos >= outputTads.size()) {
                                 nd4j_printf("dynamic_stitch: Index should be less than %i. But %i was given",
-                                         output->lengthOf(), pos);
+                                         outputTads.size(), pos);
                                 return ND4J_STATUS_VALIDATION;
                             }
 
-                            listOfOutTensors->at(pos)->assign(listOfTensors->at(i));
+                            outputTads.assign(pos, inputTads, i);
                         }
                     }
                 }
@@ -141,24 +159,26 @@ namespace nd4j {
                     for (int i = sourceDimsLen; i > 0; i--)
                         sourceDims[sourceDimsLen - i] = input->rankOf() - i;
 
-                    std::unique_ptr<ResultSet> listOfTensors(outputList[0]->allTensorsAlongDimension(sourceDims));
+                    TadSpan outputTads(*outputList[0], sourceDims);
 
-                    for (unsigned int i = 0; i < inputGradientList.size(); i++) {
-                        outputs[i].first = inputGradientList[i];
-                        if (outputs[i].first->rankOf() < 1) continue; // skip empty gradient outs
-                        std::vector<int> outDims(outputs[i].first->rankOf() - 1);
+                    unsigned int gradsSize = inputGradientList.size();
+                    std::vector<std::unique_ptr<TadSpan>> gradTads(gradsSize);
 
-                        for (int k = 1; k < outputs[i].first->rankOf(); k++)
-                            outDims[k - 1] = k;
+                    for (unsigned int i = 0; i < gradsSize; i++) {
+                        if (inputGradientList[i]->rankOf() < 1) continue; // skip empty gradient outs
+                        std::vector<int> outDims(inputGradientList[i]->rankOf() - 1);
 
-                        std::unique_ptr<ResultSet> listOutForCurrent(
-                                outputs[i].first->allTensorsAlongDimension(outDims));
+                        for (int k = 1; k < inputGradientList[i]->rankOf(); k++)
+                            outDims[k - 1] = k;
 
-                        outputs[i].second = 0;
+                        gradTads[i].reset(new TadSpan(*inputGradientList[i], outDims));
+                    }
 
-                        for (int e = 0; e < indices->lengthOf(); ++e)
-                            if (indices->e<Nd4jLong>(e) == i)
-                                listOfTensors->at(e)->assign(listOutForCurrent->at(outputs[i].second++));
+                    std::vector<Nd4jLong> counters(gradsSize, 0);
+                    for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
+                        auto i = indices->e<Nd4jLong>(e);
+                        if (i >= 0 && i < (Nd4jLong) gradsSize && gradTads[i])
+                            outputTads.assign(e, *gradTads[i], counters[i]++);
                     }
                 }
                 else { // one-dimensional case
@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Fused kernel behind fused_elementwise op
+//
+
+#include <ops/declarable/helpers/fused_elementwise.h>
+#include <loops/fused_chain.h>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    template <typename X>
+    static void fusedElementwise_(const std::vector<NDArray*> &inputs, const std::vector<int> &program, const std::vector<double> &tArgs, NDArray &output) {
+        const int numSteps = (int) program.size() / 4;
+
+        std::vector<X> params(tArgs.size());
+        for (size_t e = 0; e < tArgs.size(); e++)
+            params[e] = static_cast<X>(tArgs[e]);
+
+        std::vector<int> kinds(numSteps);
+        std::vector<int> opNums(numSteps);
+        std::vector<functions::fused::StepArgs<X>> args(numSteps);
+
+        int offset = 0;
+        for (int s = 0; s < numSteps; s++) {
+            kinds[s] = program[4 * s];
+            opNums[s] = program[4 * s + 1];
+
+            if (program[4 * s + 3] > 0)
+                args[s].params = params.data() + offset;
+
+            offset += program[4 * s + 3];
+
+            if (kinds[s] == functions::fused::PAIRWISE) {
+                // operand matches trailing dimensions of input, so it repeats with period of its own length
+                auto operand = inputs[program[4 * s + 2]];
+                args[s].operand = operand->bufferAsT<X>();
+                args[s].period = operand->lengthOf();
+            }
+        }
+
+        auto x = inputs[0];
+        functions::fused::FusedProgram<X>::exec(x->bufferAsT<X>(), output.bufferAsT<X>(), x->lengthOf(), numSteps, kinds.data(), opNums.data(), args.data());
+    }
+
+    bool fusedElementwise(nd4j::LaunchContext *context, const std::vector<NDArray*> &inputs, const std::vector<int> &program, const std::vector<double> &tArgs, NDArray &output) {
+        auto x = inputs[0];
+        if (!x->isR() || output.dataType() != x->dataType() || output.ordering() != 'c' || output.ews() != 1)
+            return false;
+
+        for (auto array: inputs)
+            if (array->dataType() != x->dataType() || array->ordering() != 'c' || array->ews() != 1)
+                return false;
+
+        BUILD_SINGLE_SELECTOR(x->dataType(), fusedElementwise_, (inputs, program, tArgs, output), FLOAT_TYPES);
+        return true;
+    }
+
+    BUILD_SINGLE_TEMPLATE(template void fusedElementwise_, (const std::vector<NDArray*> &inputs, const std::vector<int> &program, const std::vector<double> &tArgs, NDArray &output), FLOAT_TYPES);
+
+}
+}
+}
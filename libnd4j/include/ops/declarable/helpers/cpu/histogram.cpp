@@ -19,65 +19,69 @@
 //
 
 #include <ops/declarable/helpers/histogram.h>
+#include <helpers/BinCounter.h>
+#include <helpers/ShapeUtils.h>
+#include <array/TadSpan.h>
 
 namespace nd4j {
     namespace ops {
         namespace helpers {
-            template <typename X, typename Z>
-            static void histogram_(void *xBuffer, Nd4jLong *xShapeInfo, void *zBuffer, Nd4jLong *zShapeInfo, Nd4jLong numBins, double min_val, double max_val) {
-                auto dx = reinterpret_cast<X*>(xBuffer);
-                auto result = reinterpret_cast<Z*>(zBuffer);
-
-                int length = shape::length(xShapeInfo);
-                // FIXME: 2???
-                int _threads = 2;
-
-                int span = (length / _threads) + 8;
-
-                X binSize = (max_val - min_val) / (numBins);
-
-                PRAGMA_OMP_PARALLEL_THREADS(_threads)
-                {
-                    int tid, start, end;
-
-                    int *bins = new int[numBins];
-                    std::memset(bins, 0, sizeof(int) * numBins);
-                    tid = omp_get_thread_num();
-                    start = span * tid;
-                    end = span * (tid + 1);
-                    if (end > length) end = length;
-
-                    PRAGMA_OMP_SIMD
-                    for (int x = start; x < end; x++) {
-                        int idx = (int) ((dx[x] - min_val) / binSize);
-                        if (idx < 0)
-                            idx = 0;
-                        else if (idx >= numBins)
-                            idx = numBins - 1;
-
-                        bins[idx]++;
-                    }
-
-                    PRAGMA_OMP_CRITICAL
-                    {
-                        PRAGMA_OMP_SIMD
-                        for (int x = 0; x < numBins; x++) {
-                            result[x] += bins[x];
-                        }
-
-                    }
-
-                    delete[] bins;
+            template <typename X>
+            static void histogram_(const NDArray &input, NDArray &output, double minValue, double maxValue) {
+                UniformBins<BinCounter::compute_type<X>> bins(minValue, maxValue, output.lengthOf());
+
+                BinCounter::histogram<X>(input, bins, output);
+            }
+
+            template <typename X>
+            static void histogramTads_(const NDArray &input, NDArray &output, const std::vector<int> &dimensions, const NDArray &minValues, const NDArray &maxValues) {
+                typedef BinCounter::compute_type<X> C;
+                const int numBins = (int) output.sizeAt(-1);
+
+                std::unique_ptr<NDArray> holder;
+                std::unique_ptr<TadSpan> span(new TadSpan(input, dimensions));
+
+                // TADs without single stride become rows of contiguous copy, TAD order stays the same
+                if (span->ews() < 1) {
+                    auto permutation = ShapeUtils::evalDimsToExclude(input.rankOf(), dimensions);
+                    permutation.insert(permutation.end(), dimensions.begin(), dimensions.end());
+                    holder.reset(input.permute(permutation).dup('c'));
+
+                    std::vector<int> rows(dimensions.size());
+                    for (int e = 0; e < (int) rows.size(); e++)
+                        rows[e] = input.rankOf() - (int) rows.size() + e;
+
+                    span.reset(new TadSpan(*holder, rows));
                 }
+
+                const auto numTads = span->size();
+                const auto stride = span->ews();
+
+                std::vector<UniformBins<C>> bins;
+                bins.reserve(numTads);
+                for (Nd4jLong t = 0; t < numTads; t++)
+                    bins.emplace_back(minValues.e<double>(t), maxValues.e<double>(t), numBins);
+
+                BinCounter::store(output, [&](Nd4jLong *result) {
+                    BinCounter::histograms(numTads, span->tadLength(), numBins, [&](Nd4jLong tad, Nd4jLong start, Nd4jLong stop, Nd4jLong *lanes, int numLanes) {
+                        BinCounter::count(span->at<X>(tad) + start * stride, stride, stop - start, bins[tad], numBins, numLanes, lanes);
+                    }, result);
+                });
             }
 
             void histogramHelper(nd4j::LaunchContext *context, NDArray &input, NDArray &output) {
-                Nd4jLong numBins = output.lengthOf();
                 double min_val = input.reduceNumber(reduce::SameOps::Min).e<double>(0);
                 double max_val = input.reduceNumber(reduce::SameOps::Max).e<double>(0);
 
-                BUILD_DOUBLE_SELECTOR(input.dataType(), output.dataType(), histogram_, (input.buffer(), input.shapeInfo(), output.getBuffer(), output.getShapeInfo(), numBins, min_val, max_val), LIBND4J_TYPES, INDEXING_TYPES);
+                BUILD_SINGLE_SELECTOR(input.dataType(), histogram_, (input, output, min_val, max_val), LIBND4J_TYPES);
+            }
+
+            void histogramHelper(nd4j::LaunchContext *context, NDArray &input, NDArray &output, const std::vector<int> &dimensions) {
+                auto minValues = input.reduceAlongDims(reduce::SameOps::Min, dimensions);
+                auto maxValues = input.reduceAlongDims(reduce::SameOps::Max, dimensions);
+
+                BUILD_SINGLE_SELECTOR(input.dataType(), histogramTads_, (input, output, dimensions, minValues, maxValues), LIBND4J_TYPES);
             }
         }
     }
-}
\ No newline at end of file
+}
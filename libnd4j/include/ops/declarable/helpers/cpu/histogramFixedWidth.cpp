@@ -19,6 +19,7 @@
 //
 
 #include <ops/declarable/helpers/histogramFixedWidth.h>
+#include <helpers/BinCounter.h>
 
 namespace nd4j {
 namespace ops {
@@ -26,53 +27,16 @@ namespace helpers {
 
 
 template <typename T>
-void histogramFixedWidth_(const NDArray& input, const NDArray& range, NDArray& output) {
+static void histogramFixedWidth_(const NDArray& input, const NDArray& range, NDArray& output) {
 
-    const int nbins = output.lengthOf();
+    FixedWidthBins<BinCounter::compute_type<T>> bins(range.e<double>(0), range.e<double>(1), output.lengthOf());
 
-    // firstly initialize output with zeros
-    output.nullify();
-
-    const T leftEdge  = range.e<double>(0);
-    const T rightEdge = range.e<double>(1);
-
-    const T binWidth       = (rightEdge - leftEdge ) / nbins;
-    const T secondEdge     = leftEdge + binWidth;
-    const T lastButOneEdge = rightEdge - binWidth;
-
-    Nd4jLong inputLength = input.lengthOf();
-
-    PRAGMA_OMP_PARALLEL_FOR
-    for(Nd4jLong i = 0; i < inputLength; ++i) {
-
-        const T value = input.e<T>(i);
-
-        if(value < secondEdge) {
-
-            PRAGMA_OMP_CRITICAL
-            {
-                output.p<Nd4jLong>(0, output.e<Nd4jLong>(0) + 1);
-            }
-        } else if(value >= lastButOneEdge) {
-            PRAGMA_OMP_CRITICAL
-            {
-                output.p<Nd4jLong>(nbins - 1, output.e<Nd4jLong>(nbins - 1) + 1);
-            }
-        } else {
-            Nd4jLong currInd = static_cast<Nd4jLong>((value - leftEdge) / binWidth);
-
-            PRAGMA_OMP_CRITICAL
-            {
-                output.p<Nd4jLong>(currInd, output.e<Nd4jLong>(currInd) + 1);
-            }
-        }
-    }
+    BinCounter::histogram<T>(input, bins, output);
 }
 
 void histogramFixedWidth(nd4j::LaunchContext * context, const NDArray& input, const NDArray& range, NDArray& output) {
     BUILD_SINGLE_SELECTOR(input.dataType(), histogramFixedWidth_, (input, range, output), LIBND4J_TYPES);
 }
-BUILD_SINGLE_TEMPLATE(template void histogramFixedWidth_, (const NDArray& input, const NDArray& range, NDArray& output), LIBND4J_TYPES);
 
 
 }
@@ -20,65 +20,218 @@
 
 #include <ops/declarable/helpers/image_suppression.h>
 //#include <blas/NDArray.h>
+#include <execution/Executor.h>
 #include <algorithm>
 #include <numeric>
+#include <vector>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    // number of sorted boxes, which suppression masks are evaluated for at once
+    static const int NMS_BLOCK = 256;
+
+    // minimal number of IoU evaluations per thread
+    static const Nd4jLong NMS_GRAIN = 8192;
+
+    static FORCEINLINE bool isBitSet(const std::vector<uint64_t>& bits, Nd4jLong i) {
+        return (bits[i >> 6] >> (i & 63)) & 1ULL;
+    }
+
+    /**
+     * This method selects up to maxSize boxes in score order, so that no two selected boxes overlap with IoU > threshold.
+     * Boxes are sorted once, and suppression bitmask of every sorted box against all boxes with lower scores is
+     * evaluated in parallel, block by block, right before linear sweep reaches that block.
+     * So sweep itself is just bitwise OR, and no work is spent on blocks beyond last selected box
+     *
+     * @param coords - [numBoxes, 4] contiguous box corners, as y1, x1, y2, x2 in any order of corners
+     * @param scores - [numBoxes] contiguous scores
+     * @param selected - indices of selected boxes, in score order
+     */
+    template <typename T>
+    static void nonMaxSuppressionBitmask_(const T* coords, const T* scores, Nd4jLong numBoxes, int maxSize, double threshold, double scoreThreshold, std::vector<Nd4jLong>& selected) {
+        selected.clear();
+        if (maxSize <= 0)
+            return;
+
+        std::vector<Nd4jLong> order;
+        order.reserve(numBoxes);
+        for (Nd4jLong e = 0; e < numBoxes; e++)
+            if (static_cast<double>(scores[e]) > scoreThreshold)
+                order.emplace_back(e);
+
+        // stable sort keeps lower index first for equal scores
+        std::stable_sort(order.begin(), order.end(), [scores](Nd4jLong i, Nd4jLong j) {return scores[i] > scores[j];});
+
+        const Nd4jLong n = static_cast<Nd4jLong>(order.size());
+        if (n == 0)
+            return;
+
+        // normalized corners and areas, in sorted order
+        std::vector<double> minY(n), minX(n), maxY(n), maxX(n), area(n);
+        for (Nd4jLong e = 0; e < n; e++) {
+            auto box = coords + order[e] * 4;
+            minY[e] = nd4j::math::nd4j_min<double>(box[0], box[2]);
+            minX[e] = nd4j::math::nd4j_min<double>(box[1], box[3]);
+            maxY[e] = nd4j::math::nd4j_max<double>(box[0], box[2]);
+            maxX[e] = nd4j::math::nd4j_max<double>(box[1], box[3]);
+            area[e] = (maxY[e] - minY[e]) * (maxX[e] - minX[e]);
+        }
+
+        const Nd4jLong numWords = (n + 63) / 64;
+        const Nd4jLong blockSize = nd4j::math::nd4j_min<Nd4jLong>(NMS_BLOCK, n);
+        std::vector<uint64_t> removed(numWords, 0ULL);
+        std::vector<uint64_t> mask(blockSize * numWords);
+
+        const Nd4jLong grain = nd4j::math::nd4j_max<Nd4jLong>(1, NMS_GRAIN / n);
+
+        for (Nd4jLong blockStart = 0; blockStart < n; blockStart += blockSize) {
+            const Nd4jLong blockEnd = nd4j::math::nd4j_min<Nd4jLong>(blockStart + blockSize, n);
+
+            // bit j of row i is set if box j has to be suppressed by box i. Only boxes with lower scores are checked
+            auto func = [&](Nd4jLong start, Nd4jLong stop) {
+                for (Nd4jLong i = start; i < stop; i++) {
+                    auto row = mask.data() + (i - blockStart) * numWords;
+
+                    // rows of boxes suppressed by previous blocks aren't used
+                    if (isBitSet(removed, i))
+                        continue;
+
+                    for (Nd4jLong w = i >> 6; w < numWords; w++)
+                        row[w] = 0ULL;
+
+                    if (area[i] <= 0.)
+                        continue;
+
+                    for (Nd4jLong j = i + 1; j < n; j++) {
+                        if (area[j] <= 0.)
+                            continue;
+
+                        auto intersectionY = nd4j::math::nd4j_min<double>(maxY[i], maxY[j]) - nd4j::math::nd4j_max<double>(minY[i], minY[j]);
+                        auto intersectionX = nd4j::math::nd4j_min<double>(maxX[i], maxX[j]) - nd4j::math::nd4j_max<double>(minX[i], minX[j]);
+                        if (intersectionY <= 0. || intersectionX <= 0.)
+                            continue;
+
+                        auto intersectionArea = intersectionY * intersectionX;
+                        if (intersectionArea / (area[i] + area[j] - intersectionArea) > threshold)
+                            row[j >> 6] |= 1ULL << (j & 63);
+                    }
+                }
+            };
+
+            Executor::parallel_for(blockStart, blockEnd, func, grain);
+
+            for (Nd4jLong i = blockStart; i < blockEnd; i++) {
+                if (isBitSet(removed, i))
+                    continue;
+
+                selected.emplace_back(order[i]);
+                if (static_cast<int>(selected.size()) >= maxSize)
+                    return;
+
+                auto row = mask.data() + (i - blockStart) * numWords;
+                for (Nd4jLong w = i >> 6; w < numWords; w++)
+                    removed[w] |= row[w];
+            }
+        }
+    }
+
     template <typename T>
     static void nonMaxSuppressionV2_(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output) {
-        std::vector<Nd4jLong> indices(scales->lengthOf());
-        std::iota(indices.begin(), indices.end(), 0);
-
-        std::sort(indices.begin(), indices.end(), [scales](int i, int j) {return scales->e<T>(i) > scales->e<T>(j);});
-
-//        std::vector<int> selected(output->lengthOf());
-        std::vector<int> selectedIndices(output->lengthOf(), 0);
-        auto needToSuppressWithThreshold = [] (NDArray& boxes, int previousIndex, int nextIndex, T threshold) -> bool {
-            T minYPrev = nd4j::math::nd4j_min(boxes.e<T>(previousIndex, 0), boxes.e<T>(previousIndex, 2));
-            T minXPrev = nd4j::math::nd4j_min(boxes.e<T>(previousIndex, 1), boxes.e<T>(previousIndex, 3));
-            T maxYPrev = nd4j::math::nd4j_max(boxes.e<T>(previousIndex, 0), boxes.e<T>(previousIndex, 2));
-            T maxXPrev = nd4j::math::nd4j_max(boxes.e<T>(previousIndex, 1), boxes.e<T>(previousIndex, 3));
-            T minYNext = nd4j::math::nd4j_min(boxes.e<T>(nextIndex, 0), boxes.e<T>(nextIndex, 2));
-            T minXNext = nd4j::math::nd4j_min(boxes.e<T>(nextIndex, 1), boxes.e<T>(nextIndex, 3));
-            T maxYNext = nd4j::math::nd4j_max(boxes.e<T>(nextIndex, 0), boxes.e<T>(nextIndex, 2));
-            T maxXNext = nd4j::math::nd4j_max(boxes.e<T>(nextIndex, 1), boxes.e<T>(nextIndex, 3));
-            T areaPrev = (maxYPrev - minYPrev) * (maxXPrev - minXPrev);
-            T areaNext = (maxYNext - minYNext) * (maxXNext - minXNext);
-
-            if (areaNext <= T(0.f) || areaPrev <= T(0.f)) return false;
-
-            T minIntersectionY = nd4j::math::nd4j_max(minYPrev, minYNext);
-            T minIntersectionX = nd4j::math::nd4j_max(minXPrev, minXNext);
-            T maxIntersectionY = nd4j::math::nd4j_min(maxYPrev, maxYNext);
-            T maxIntersectionX = nd4j::math::nd4j_min(maxXPrev, maxXNext);
-            T intersectionArea =
-                    nd4j::math::nd4j_max(T(maxIntersectionY - minIntersectionY), T(0.0f)) *
-                            nd4j::math::nd4j_max(T(maxIntersectionX - minIntersectionX), T(0.0f));
-            T intersectionValue = intersectionArea / (areaPrev + areaNext - intersectionArea);
-            return intersectionValue > threshold;
+        const Nd4jLong numBoxes = boxes->sizeAt(0);
 
-        };
-//        int numSelected = 0;
-        int numBoxes = boxes->sizeAt(0);
-        int numSelected = 0;
-
-        for (int i = 0; i < numBoxes; ++i) {
-            bool shouldSelect = numSelected < output->lengthOf();
-            PRAGMA_OMP_PARALLEL_FOR //_ARGS(firstprivate(numSelected))
-            for (int j = numSelected - 1; j >= 0; --j) {
-                if (shouldSelect)
-                if (needToSuppressWithThreshold(*boxes, indices[i], indices[selectedIndices[j]], T(threshold))) {
-                    shouldSelect = false;
+        std::vector<T> coords(numBoxes * 4);
+        std::vector<T> scores(numBoxes);
+        for (Nd4jLong e = 0; e < numBoxes; e++) {
+            for (int c = 0; c < 4; c++)
+                coords[e * 4 + c] = boxes->e<T>(e, c);
+
+            scores[e] = scales->e<T>(e);
+        }
+
+        std::vector<Nd4jLong> selected;
+        nonMaxSuppressionBitmask_<T>(coords.data(), scores.data(), numBoxes, nd4j::math::nd4j_min<int>(maxSize, output->lengthOf()), threshold, -DataTypeUtils::infOrMax<double>(), selected);
+
+        for (int e = 0; e < static_cast<int>(selected.size()); e++)
+            output->p(e, selected[e]);
+    }
+
+    template <typename T>
+    static void combinedNonMaxSuppression_(NDArray* boxes, NDArray* scores, int maxPerClass, int maxTotal, double threshold, double scoreThreshold, bool clip,
+                                           NDArray* outBoxes, NDArray* outScores, NDArray* outClasses, NDArray* validDetections) {
+        const Nd4jLong batchSize = boxes->sizeAt(0);
+        const Nd4jLong numBoxes = boxes->sizeAt(1);
+        const Nd4jLong q = boxes->sizeAt(2);
+        const Nd4jLong numClasses = scores->sizeAt(2);
+
+        auto boxesC = boxes->ordering() == 'c' && boxes->ews() == 1 ? boxes : boxes->dup('c');
+        auto scoresC = scores->ordering() == 'c' && scores->ews() == 1 ? scores : scores->dup('c');
+        auto boxesBuffer = boxesC->bufferAsT<T>();
+        auto scoresBuffer = scoresC->bufferAsT<T>();
+
+        // every (image, class) pair is independent
+        std::vector<std::vector<Nd4jLong>> selected(batchSize * numClasses);
+        auto func = [&](Nd4jLong start, Nd4jLong stop) {
+            std::vector<T> coords(numBoxes * 4);
+            std::vector<T> classScores(numBoxes);
+
+            for (Nd4jLong t = start; t < stop; t++) {
+                const Nd4jLong b = t / numClasses;
+                const Nd4jLong c = t % numClasses;
+                const Nd4jLong boxClass = q == 1 ? 0 : c;
+
+                for (Nd4jLong e = 0; e < numBoxes; e++) {
+                    auto box = boxesBuffer + ((b * numBoxes + e) * q + boxClass) * 4;
+                    for (int k = 0; k < 4; k++)
+                        coords[e * 4 + k] = box[k];
+
+                    classScores[e] = scoresBuffer[(b * numBoxes + e) * numClasses + c];
                 }
+
+                nonMaxSuppressionBitmask_<T>(coords.data(), classScores.data(), numBoxes, maxPerClass, threshold, scoreThreshold, selected[t]);
             }
-            if (shouldSelect) {
-                output->p(numSelected, indices[i]);
-                selectedIndices[numSelected++] = i;
+        };
+
+        Executor::parallel_for(0, batchSize * numClasses, func);
+
+        outBoxes->assign(0.f);
+        outScores->assign(0.f);
+        outClasses->assign(0.f);
+
+        // per image: detections of all classes are merged by score
+        auto merge = [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong b = start; b < stop; b++) {
+                std::vector<std::pair<Nd4jLong, Nd4jLong>> detections;
+                for (Nd4jLong c = 0; c < numClasses; c++)
+                    for (auto e: selected[b * numClasses + c])
+                        detections.emplace_back(c, e);
+
+                auto score = [&](const std::pair<Nd4jLong, Nd4jLong>& d) -> T {return scoresBuffer[(b * numBoxes + d.second) * numClasses + d.first];};
+                std::stable_sort(detections.begin(), detections.end(), [&](const std::pair<Nd4jLong, Nd4jLong>& x, const std::pair<Nd4jLong, Nd4jLong>& y) {return score(x) > score(y);});
+
+                const int numValid = nd4j::math::nd4j_min<int>(maxTotal, static_cast<int>(detections.size()));
+                for (int e = 0; e < numValid; e++) {
+                    auto c = detections[e].first;
+                    auto box = boxesBuffer + ((b * numBoxes + detections[e].second) * q + (q == 1 ? 0 : c)) * 4;
+                    for (int k = 0; k < 4; k++)
+                        outBoxes->p(b, e, k, clip ? nd4j::math::nd4j_min<T>(nd4j::math::nd4j_max<T>(box[k], T(0.f)), T(1.f)) : box[k]);
+
+                    outScores->p(b, e, score(detections[e]));
+                    outClasses->p(b, e, c);
+                }
+
+                validDetections->p(b, numValid);
             }
-        }
+        };
+
+        Executor::parallel_for(0, batchSize, merge);
+
+        if (boxesC != boxes)
+            delete boxesC;
+
+        if (scoresC != scores)
+            delete scoresC;
     }
 
     void nonMaxSuppressionV2(nd4j::LaunchContext * context, NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output) {
@@ -86,6 +239,12 @@ namespace helpers {
     }
     BUILD_SINGLE_TEMPLATE(template void nonMaxSuppressionV2_, (NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output), NUMERIC_TYPES);
 
+    void combinedNonMaxSuppression(nd4j::LaunchContext * context, NDArray* boxes, NDArray* scores, int maxPerClass, int maxTotal, double threshold, double scoreThreshold, bool clip,
+                                   NDArray* outBoxes, NDArray* outScores, NDArray* outClasses, NDArray* validDetections) {
+        BUILD_SINGLE_SELECTOR(boxes->dataType(), combinedNonMaxSuppression_, (boxes, scores, maxPerClass, maxTotal, threshold, scoreThreshold, clip, outBoxes, outScores, outClasses, validDetections), FLOAT_TYPES);
+    }
+    BUILD_SINGLE_TEMPLATE(template void combinedNonMaxSuppression_, (NDArray* boxes, NDArray* scores, int maxPerClass, int maxTotal, double threshold, double scoreThreshold, bool clip, NDArray* outBoxes, NDArray* outScores, NDArray* outClasses, NDArray* validDetections), FLOAT_TYPES);
+
+}
 }
 }
-}
\ No newline at end of file
@@ -18,165 +18,369 @@
 //  @author raver119@gmail.com
 //
 
-#include <ops/declarable/helpers/top_k.h>
-#include <MmulHelper.h>
+#include <ops/declarable/helpers/lup.h>
+#include <helpers/BlasHelper.h>
+#include <execution/Executor.h>
 #include <NDArrayFactory.h>
 #include <Status.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    // panel width of blocked factorizations. Matrices up to this size are processed by unblocked kernels only
+    static const Nd4jLong BLOCK_SIZE = 64;
+
+    // pivots below this value are considered zero
+    static const double PIVOT_THRESHOLD = 0.00001;
+
+    /**
+     * c = c - a * b (or c - a * b^T if transB is set), all matrices are row-major with given leading dimensions
+     * c is m x n, a is m x k
+     */
     template <typename T>
-    static void swapRows_(NDArray* matrix, int theFirst, int theSecond) {
+    static void gemmUpdate_(T* c, Nd4jLong ldc, T* a, Nd4jLong lda, T* b, Nd4jLong ldb, Nd4jLong m, Nd4jLong n, Nd4jLong k, bool transB) {
+        if (m <= 0 || n <= 0 || k <= 0)
+            return;
+
+        if (std::is_same<T, float>::value && BlasHelper::getInstance()->hasGEMM<float>()) {
+            BlasHelper::getInstance()->sgemm()(CblasRowMajor, CblasNoTrans, transB ? CblasTrans : CblasNoTrans, (int) m, (int) n, (int) k, -1.0f, reinterpret_cast<float *>(a), (int) lda, reinterpret_cast<float *>(b), (int) ldb, 1.0f, reinterpret_cast<float *>(c), (int) ldc);
+            return;
+        }
+
+        if (std::is_same<T, double>::value && BlasHelper::getInstance()->hasGEMM<double>()) {
+            BlasHelper::getInstance()->dgemm()(CblasRowMajor, CblasNoTrans, transB ? CblasTrans : CblasNoTrans, (int) m, (int) n, (int) k, -1.0, reinterpret_cast<double *>(a), (int) lda, reinterpret_cast<double *>(b), (int) ldb, 1.0, reinterpret_cast<double *>(c), (int) ldc);
+            return;
+        }
 
-        if (theFirst != theSecond)
-            for (int i = 0; i < matrix->columns(); i++) {
-                T e0 = matrix->e<T>(theFirst, i);
-                T e1 = matrix->e<T>(theSecond, i);
+        auto func = [&](Nd4jLong from, Nd4jLong to) {
+            for (Nd4jLong i = from; i < to; i++) {
+                auto cRow = c + i * ldc;
+                auto aRow = a + i * lda;
 
-                matrix->p<T>(theFirst, i, e1);
-                matrix->p<T>(theSecond, i, e0);
+                if (transB) {
+                    for (Nd4jLong j = 0; j < n; j++) {
+                        auto bRow = b + j * ldb;
+                        T sum = static_cast<T>(0.f);
+                        for (Nd4jLong p = 0; p < k; p++)
+                            sum += aRow[p] * bRow[p];
+
+                        cRow[j] -= sum;
+                    }
+                } else {
+                    for (Nd4jLong p = 0; p < k; p++) {
+                        auto v = aRow[p];
+                        auto bRow = b + p * ldb;
+
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong j = 0; j < n; j++)
+                            cRow[j] -= v * bRow[j];
+                    }
+                }
             }
-    }
-    BUILD_SINGLE_TEMPLATE(template void swapRows_, (NDArray* matrix, int theFirst, int theSecond), FLOAT_TYPES);
+        };
 
-    void swapRows(NDArray* matrix, int theFirst, int theSecond) {
-        BUILD_SINGLE_SELECTOR(matrix->dataType(), swapRows_, (matrix, theFirst, theSecond), FLOAT_TYPES);
+        // rows are independent. In batched mode this call is nested, and executed inline
+        auto grain = nd4j::math::nd4j_max<Nd4jLong>(1, Environment::getInstance()->elementwiseThreshold() / (n * k));
+        Executor::parallel_for(0, m, func, grain);
     }
 
+    /**
+     * In-place LU decomposition with partial pivoting of n x n row-major matrix, so P * A = L * U.
+     * Right-looking: panel of BLOCK_SIZE columns is factorized with unblocked kernel, then U12 is solved and trailing matrix is updated with single GEMM.
+     *
+     * permutation[i] holds original index of row i, number of row swaps is returned
+     */
     template <typename T>
-    static void invertLowerMatrix_(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        int n = inputMatrix->rows();
-        invertedMatrix->assign(0.f);
+    static int luBlocked_(T* a, Nd4jLong n, Nd4jLong* permutation) {
+        int swapCount = 0;
+
+        for (Nd4jLong i = 0; i < n; i++)
+            permutation[i] = i;
+
+        for (Nd4jLong k = 0; k < n; k += BLOCK_SIZE) {
+            const auto panelEnd = nd4j::math::nd4j_min<Nd4jLong>(k + BLOCK_SIZE, n);
+
+            // panel factorization. Rows are swapped entirely, so L on the left and A12 on the right stay consistent
+            for (Nd4jLong j = k; j < panelEnd; j++) {
+                T pivotValue = static_cast<T>(0.f);
+                Nd4jLong pivot = -1;
+
+                for (Nd4jLong r = j; r < n; r++) {
+                    auto v = nd4j::math::nd4j_abs<T>(a[r * n + j]);
+                    if (v > pivotValue) {
+                        pivotValue = v;
+                        pivot = r;
+                    }
+                }
 
-       // PRAGMA_OMP_PARALLEL_FOR_IF(n > Environment::getInstance()->elementwiseThreshold())
-        for (int i = 0; i < n; i++)
-            invertedMatrix->p(i, i, 1.0f);
+                if (pivotValue > static_cast<T>(PIVOT_THRESHOLD)) {
+                    if (pivot != j) {
+                        std::swap_ranges(a + j * n, a + (j + 1) * n, a + pivot * n);
+                        std::swap(permutation[j], permutation[pivot]);
+                        swapCount++;
+                    }
+
+                    auto pivotRow = a + j * n;
+                    for (Nd4jLong r = j + 1; r < n; r++) {
+                        auto row = a + r * n;
+                        row[j] /= pivotRow[j];
+                        auto v = row[j];
+
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong c = j + 1; c < panelEnd; c++)
+                            row[c] -= v * pivotRow[c];
+                    }
+                } else {
+                    // nothing to eliminate with, zero multipliers keep the trailing update consistent
+                    for (Nd4jLong r = j + 1; r < n; r++)
+                        a[r * n + j] = static_cast<T>(0.f);
+                }
+            }
 
-        if (inputMatrix->isIdentityMatrix()) return;
+            if (panelEnd == n)
+                break;
 
-        //PRAGMA_OMP_PARALLEL_FOR_IF(n > Environment::getInstance()->elementwiseThreshold())
-        for (int i = 1; i < n; i++)
-            invertedMatrix->t<T>(i, i - 1) = -inputMatrix->t<T>(i, i - 1);
+            const auto rest = n - panelEnd;
 
-        //PRAGMA_OMP_PARALLEL_FOR_SIMD
-        for (int i = 2; i < n; i++) {
-            for (int j = i - 2; j > -1; --j)
-                for (int k = 0; k < i; k++)
-                    invertedMatrix->t<T>(i, j) -= (invertedMatrix->t<T>(k, j) * inputMatrix->t<T>(i, k));
+            // U12 = L11^-1 * A12
+            for (Nd4jLong j = k + 1; j < panelEnd; j++) {
+                auto row = a + j * n + panelEnd;
+                for (Nd4jLong p = k; p < j; p++) {
+                    auto v = a[j * n + p];
+                    auto pRow = a + p * n + panelEnd;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong c = 0; c < rest; c++)
+                        row[c] -= v * pRow[c];
+                }
+            }
+
+            // A22 = A22 - L21 * U12
+            gemmUpdate_<T>(a + panelEnd * n + panelEnd, n, a + panelEnd * n + k, n, a + k * n + panelEnd, n, rest, rest, panelEnd - k, false);
         }
+
+        return swapCount;
     }
 
-    BUILD_SINGLE_TEMPLATE(template void invertLowerMatrix_, (NDArray* inputMatrix, NDArray* invertedMatrix);, FLOAT_TYPES);
+    /**
+     * Solves A * X = B in place of B. A is n x n triangular, B is n x m, both row-major.
+     * Diagonal blocks are solved by substitution, the remaining rows of B are updated with GEMM
+     */
+    template <typename T>
+    static void triangularSolve_(T* a, Nd4jLong lda, T* b, Nd4jLong ldb, Nd4jLong n, Nd4jLong m, bool lower, bool unitDiagonal) {
+        if (lower) {
+            for (Nd4jLong k = 0; k < n; k += BLOCK_SIZE) {
+                const auto end = nd4j::math::nd4j_min<Nd4jLong>(k + BLOCK_SIZE, n);
+
+                for (Nd4jLong i = k; i < end; i++) {
+                    auto row = b + i * ldb;
+                    for (Nd4jLong p = k; p < i; p++) {
+                        auto v = a[i * lda + p];
+                        auto pRow = b + p * ldb;
+
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong c = 0; c < m; c++)
+                            row[c] -= v * pRow[c];
+                    }
+
+                    if (!unitDiagonal) {
+                        auto d = a[i * lda + i];
+                        for (Nd4jLong c = 0; c < m; c++)
+                            row[c] /= d;
+                    }
+                }
+
+                // rows below current block
+                gemmUpdate_<T>(b + end * ldb, ldb, a + end * lda + k, lda, b + k * ldb, ldb, n - end, m, end - k, false);
+            }
+        } else {
+            for (Nd4jLong end = n; end > 0; end -= BLOCK_SIZE) {
+                const auto k = nd4j::math::nd4j_max<Nd4jLong>(end - BLOCK_SIZE, 0);
+
+                for (Nd4jLong i = end - 1; i >= k; i--) {
+                    auto row = b + i * ldb;
+                    for (Nd4jLong p = i + 1; p < end; p++) {
+                        auto v = a[i * lda + p];
+                        auto pRow = b + p * ldb;
+
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong c = 0; c < m; c++)
+                            row[c] -= v * pRow[c];
+                    }
+
+                    if (!unitDiagonal) {
+                        auto d = a[i * lda + i];
+                        for (Nd4jLong c = 0; c < m; c++)
+                            row[c] /= d;
+                    }
+                }
 
-    void invertLowerMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        BUILD_SINGLE_SELECTOR(inputMatrix->dataType(), invertLowerMatrix_, (inputMatrix, invertedMatrix), FLOAT_TYPES);
+                // rows above current block
+                gemmUpdate_<T>(b, ldb, a + k, lda, b + k * ldb, ldb, k, m, end - k, false);
+            }
+        }
     }
 
+    /**
+     * In-place Cholesky decomposition A = L * L^T of n x n row-major symmetric matrix, only lower triangle is read.
+     * Right-looking blocked, trailing matrix is updated with GEMM. Upper triangle is zeroed on exit
+     *
+     * Returns false if matrix isn't positive definite
+     */
     template <typename T>
-    static void _invertUpperMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        int n = inputMatrix->rows();
-        invertedMatrix->setIdentity();
+    static bool choleskyBlocked_(T* a, Nd4jLong n) {
+        bool positive = true;
 
-        if (inputMatrix->isIdentityMatrix()) { // the inverse for I is I
-            return;
-        }
+        for (Nd4jLong k = 0; k < n; k += BLOCK_SIZE) {
+            const auto end = nd4j::math::nd4j_min<Nd4jLong>(k + BLOCK_SIZE, n);
 
-        //PRAGMA_OMP_PARALLEL_FOR_IF(n > Environment::getInstance()->elementwiseThreshold())
-        for (int i = 0; i < n; i++)
-            invertedMatrix->t<T>(i, i) /= inputMatrix->t<T>(i, i);
+            // A11 = L11 * L11^T
+            for (Nd4jLong j = k; j < end; j++) {
+                auto rowJ = a + j * n;
+                T diagonal = rowJ[j];
+                for (Nd4jLong p = k; p < j; p++)
+                    diagonal -= rowJ[p] * rowJ[p];
+
+                if (!(diagonal > static_cast<T>(0.f)))
+                    positive = false;
+
+                rowJ[j] = nd4j::math::nd4j_sqrt<T, T>(diagonal);
+
+                for (Nd4jLong i = j + 1; i < end; i++) {
+                    auto rowI = a + i * n;
+                    T sum = rowI[j];
+                    for (Nd4jLong p = k; p < j; p++)
+                        sum -= rowI[p] * rowJ[p];
+
+                    rowI[j] = sum / rowJ[j];
+                }
+            }
 
-        //PRAGMA_OMP_PARALLEL_FOR_IF(n > Environment::getInstance()->elementwiseThreshold())
-        for (int i = 0; i < n - 1; i++)
-            invertedMatrix->t<T>(i, i + 1) -= (inputMatrix->t<T>(i, i + 1) * invertedMatrix->t<T>(i + 1, i + 1) / inputMatrix->t<T>(i, i));
+            if (end == n)
+                break;
 
-//        PRAGMA_OMP_PARALLEL_FOR_SIMD
-        for (int i = n - 2; i > - 1; i--) {
-            for (int j = i + 2; j < n; j++)
-                for (int k = i; k < n; k++)
-                    invertedMatrix->t<T>(i, j) -= ((invertedMatrix->t<T>(k, j) * inputMatrix->t<T>(i, k) / inputMatrix->t<T>(i, i)));
+            // L21 = A21 * L11^-T
+            for (Nd4jLong i = end; i < n; i++) {
+                auto rowI = a + i * n;
+                for (Nd4jLong j = k; j < end; j++) {
+                    auto rowJ = a + j * n;
+                    T sum = rowI[j];
+                    for (Nd4jLong p = k; p < j; p++)
+                        sum -= rowI[p] * rowJ[p];
+
+                    rowI[j] = sum / rowJ[j];
+                }
+            }
+
+            // A22 = A22 - L21 * L21^T
+            gemmUpdate_<T>(a + end * n + end, n, a + end * n + k, n, a + end * n + k, n, n - end, n - end, end - k, true);
         }
+
+        for (Nd4jLong i = 0; i < n; i++)
+            for (Nd4jLong j = i + 1; j < n; j++)
+                a[i * n + j] = static_cast<T>(0.f);
+
+        return positive;
     }
 
-    BUILD_SINGLE_TEMPLATE(template void _invertUpperMatrix, (NDArray* inputMatrix, NDArray* invertedMatrix);, FLOAT_TYPES);
+    /**
+     * This method returns c-ordered contiguous version of given array, copy is made only if it's necessary
+     */
+    static NDArray* contiguous(NDArray* array, std::unique_ptr<NDArray>& holder) {
+        if (array->ordering() == 'c' && array->ews() == 1)
+            return array;
 
-    void invertUpperMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        BUILD_SINGLE_SELECTOR(inputMatrix->dataType(), _invertUpperMatrix, (inputMatrix, invertedMatrix), FLOAT_TYPES);
+        holder.reset(array->dup('c'));
+        return holder.get();
     }
 
+    /**
+     * This method executes func(matrixIndex, scratch) for all n x n matrices of the batch. Matrices are processed in parallel,
+     * each thread gets own scratch space of n * n elements
+     */
+    template <typename T>
+    static void forEachMatrix_(Nd4jLong numMatrices, Nd4jLong n, const std::function<void(Nd4jLong, T*)>& func) {
+        Executor::parallel_for(0, numMatrices, [&](Nd4jLong from, Nd4jLong to) {
+            std::vector<T> scratch(n * n);
+            for (Nd4jLong e = from; e < to; e++)
+                func(e, scratch.data());
+        });
+    }
 
     template <typename T>
     static NDArray lup_(LaunchContext *context, NDArray* input, NDArray* compound, NDArray* permutation) {
+        const auto n = input->rows();
 
-        const int rowNum = input->rows();
-        const int columnNum = input->columns();
+        std::unique_ptr<NDArray> holder;
+        auto in = contiguous(input, holder);
 
-        NDArray determinant = NDArrayFactory::create<T>(1.f);
-        NDArray compoundMatrix = *input; // copy
-        NDArray permutationMatrix(input, false, context); // has same shape as input and contiguous strides
-        permutationMatrix.setIdentity();
+        std::vector<T> lu(in->bufferAsT<T>(), in->bufferAsT<T>() + n * n);
+        std::vector<Nd4jLong> rows(n);
+        auto swapCount = luBlocked_<T>(lu.data(), n, rows.data());
 
-        T pivotValue; // = T(0.0);
-        int pivot; // = -1;
-        int swapCount = 0;
+        T det = static_cast<T>(1.f);
+        for (Nd4jLong e = 0; e < n; e++)
+            det *= lu[e * n + e];
 
-        for(int i = 0; i < rowNum; i++ ) {
-            pivotValue = T(0.0);
-            pivot = -1;
-            //PRAGMA_OMP_PARALLEL_FOR //_ARGS(firstprivate(pivot,pivotValue))
-            for(int rowCounter = i; rowCounter < rowNum; rowCounter++ ) {
-                if (nd4j::math::nd4j_abs(compoundMatrix.t<T>(rowCounter, i)) > pivotValue) {
-                    pivotValue = nd4j::math::nd4j_abs(compoundMatrix.t<T>(rowCounter, i));
-                    pivot = rowCounter;
-                }
-            }
+        if (swapCount % 2)
+            det = -det;
 
-            if( pivotValue > T(0.00001)) {
-                swapRows(&compoundMatrix, pivot, i);
-                swapRows(&permutationMatrix, pivot, i);
-                if (pivot != i)
-                    swapCount++;
-
-                for( int j = i + 1; j < rowNum; j++ ) {
-                    compoundMatrix.t<T>(j, i) /= compoundMatrix.t<T>(i, i);
-                    //PRAGMA_OMP_PARALLEL_FOR
-                    for( int k = i + 1; k < rowNum; k++ ) {
-                        compoundMatrix.t<T>(j, k) -= compoundMatrix.t<T>(j, i) * compoundMatrix.t<T>(i, k);
-                    }
-                }
-            }
+        if (compound != nullptr) {
+            NDArray compoundMatrix(lu.data(), 'c', {n, n}, input->dataType(), context);
+            compound->assign(compoundMatrix);
         }
 
-        for (int e = 0; e < rowNum; e++) {
-            // nd4j_printf("Compound matrix diag %i %f.\n", e, (*compoundMatrix)(e, e));
-            determinant *= compoundMatrix.e<T>(e, e);
-        }
-        if (swapCount % 2) determinant = -determinant;
-        if (compound != nullptr)
-            compound->assign(compoundMatrix);
-        if (permutation != nullptr)
+        if (permutation != nullptr) {
+            auto permutationMatrix = NDArrayFactory::create(input->ordering(), {n, n}, input->dataType(), context);
+            permutationMatrix.assign(0.f);
+            for (Nd4jLong e = 0; e < n; e++)
+                permutationMatrix.p(e, rows[e], 1.f);
+
             permutation->assign(permutationMatrix);
-        return determinant;
+        }
+
+        return NDArrayFactory::create<T>(det, context);
     }
 
     BUILD_SINGLE_TEMPLATE(template NDArray lup_, (LaunchContext *context, NDArray* input, NDArray* output, NDArray* permutation), FLOAT_TYPES);
 
+    /**
+     * This method returns determinants of all matrices of the batch
+     */
+    template <typename T>
+    static std::vector<T> batchedDeterminant_(NDArray* input) {
+        const auto n = input->sizeAt(-1);
+        const auto numMatrices = input->lengthOf() / (n * n);
 
+        std::unique_ptr<NDArray> holder;
+        auto in = contiguous(input, holder)->bufferAsT<T>();
+        std::vector<T> result(numMatrices);
 
-    template <typename T>
-    static int determinant_(LaunchContext *context, NDArray* input, NDArray* output) {
+        forEachMatrix_<T>(numMatrices, n, [&](Nd4jLong e, T* lu) {
+            std::vector<Nd4jLong> rows(n);
+            std::copy(in + e * n * n, in + (e + 1) * n * n, lu);
+            auto swapCount = luBlocked_<T>(lu, n, rows.data());
 
-        Nd4jLong n = input->sizeAt(-1);
-        Nd4jLong n2 = n * n;
+            T det = static_cast<T>(1.f);
+            for (Nd4jLong i = 0; i < n; i++)
+                det *= lu[i * n + i];
 
-        auto matrix = NDArrayFactory::create(input->ordering(), {n, n}, input->dataType(), context); //, block.getWorkspace());
+            result[e] = swapCount % 2 ? -det : det;
+        });
 
-        for (int e = 0; e < output->lengthOf(); e++) {
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; ++k, ++row)
-                matrix.p(row, input->e<T>(k));
-            output->p(e, lup_<T>(context, &matrix, (NDArray*)nullptr, (NDArray*)nullptr));
-        }
+        return result;
+    }
+
+    template <typename T>
+    static int determinant_(LaunchContext *context, NDArray* input, NDArray* output) {
+        auto dets = batchedDeterminant_<T>(input);
+        for (Nd4jLong e = 0; e < output->lengthOf(); e++)
+            output->p(e, dets[e]);
 
         return Status::OK();
     }
@@ -187,19 +391,10 @@ namespace helpers {
 
 template <typename T>
     int logAbsDeterminant_(LaunchContext *context, NDArray* input, NDArray* output) {
-
-        Nd4jLong n = input->sizeAt(-1);
-        Nd4jLong n2 = n * n;
-
-        NDArray matrix = NDArrayFactory::create(input->ordering(), {n, n}, input->dataType(), context); //, block.getWorkspace());
-        for (int e = 0; e < output->lengthOf(); e++) {
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; ++k, ++row) {
-                matrix.p(row, input->e<T>(k));
-            }
-	    NDArray det = lup_<T>(context, &matrix, (NDArray*)nullptr, (NDArray*)nullptr);
-	    if (det.e<T>(0) != 0.f)
-             	output->p(e, nd4j::math::nd4j_log<T,T>(nd4j::math::nd4j_abs(det.t<T>(0))));
-        }
+        auto dets = batchedDeterminant_<T>(input);
+        for (Nd4jLong e = 0; e < output->lengthOf(); e++)
+            if (dets[e] != static_cast<T>(0.f))
+                output->p(e, nd4j::math::nd4j_log<T,T>(nd4j::math::nd4j_abs(dets[e])));
 
         return ND4J_STATUS_OK;
     }
@@ -210,53 +405,50 @@ template <typename T>
 
     template <typename T>
     static int inverse_(LaunchContext *context, NDArray* input, NDArray* output) {
+        const auto n = input->sizeAt(-1);
+        const auto n2 = n * n;
+        const auto totalCount = output->lengthOf() / n2;
 
-        auto n = input->sizeAt(-1);
-        auto n2 = n * n;
-        auto totalCount = output->lengthOf() / n2;
+        std::unique_ptr<NDArray> inHolder;
+        auto in = contiguous(input, inHolder)->bufferAsT<T>();
 
-        output->assign(0.f); // fill up output tensor with zeros
-        auto matrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context); //, block.getWorkspace());
-        auto compound = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context); //, block.getWorkspace());
-        auto permutation = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);
-        auto lowerMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);
-        auto upperMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);
+        std::unique_ptr<NDArray> outHolder;
+        auto out = contiguous(output, outHolder);
+        auto z = out->bufferAsT<T>();
 
-        for (int e = 0; e < totalCount; e++) {
-            if (e)
-                matrix.assign(0.f);
+        std::atomic<bool> singular(false);
 
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; k++) {
-                matrix.p(row++, input->e<T>(k));
-            }
-            T det = lup_<T>(context, &matrix, &compound, &permutation).template e<T>(0);
+        // A^-1 = U^-1 * L^-1 * P, i.e. two triangular solves against permuted identity
+        forEachMatrix_<T>(totalCount, n, [&](Nd4jLong e, T* lu) {
+            std::vector<Nd4jLong> rows(n);
+            std::copy(in + e * n2, in + (e + 1) * n2, lu);
+            auto swapCount = luBlocked_<T>(lu, n, rows.data());
+
+            T det = swapCount % 2 ? static_cast<T>(-1.f) : static_cast<T>(1.f);
+            for (Nd4jLong i = 0; i < n; i++)
+                det *= lu[i * n + i];
 
             // FIXME: and how this is going to work on float16?
             if (nd4j::math::nd4j_abs<T>(det) < T(0.000001)) {
-                nd4j_printf("matrix_inverse: The matrix %i has no inverse due determinant is %lf. Quiting...\n", e, det);
-                matrix.printIndexedBuffer("Wrong matrix");
-                return ND4J_STATUS_VALIDATION;
-            }
-            lowerMatrix.setIdentity(); // set up U to identity matrix
-            for (int k = 1; k < n; k++) {  // and then put all values under main diagonal on to it
-                for (int j = 0; j < k; j++)
-                    lowerMatrix.template t<T>(k, j) = compound.template t<T>(k, j);
-            }
-            upperMatrix.setIdentity(); // set up U to identity matrix
-            for (int k = 0; k < n; k++) {  // and then put all values under main diagonal on to it
-                for (int j = k; j < n; j++)
-                    upperMatrix.template t<T>(k, j) = compound.template e<T>(k, j);
+                nd4j_printf("matrix_inverse: The matrix %i has no inverse due determinant is %lf. Quiting...\n", (int) e, (double) det);
+                singular = true;
+                return;
             }
-            invertUpperMatrix(&upperMatrix, &matrix);
 
-            invertLowerMatrix(&lowerMatrix, &upperMatrix);
+            auto x = z + e * n2;
+            std::fill(x, x + n2, static_cast<T>(0.f));
+            for (Nd4jLong i = 0; i < n; i++)
+                x[i * n + rows[i]] = static_cast<T>(1.f);
 
-            nd4j::MmulHelper::mmul(&matrix, &upperMatrix, &compound, 1.0, 0.0);
-            nd4j::MmulHelper::mmul(&compound, &permutation, &matrix, 1.0, 0.0);
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; k++) {
-                output->t<T>(k) = matrix.template t<T>(row++);
-            }
-        }
+            triangularSolve_<T>(lu, n, x, n, n, n, true, true);
+            triangularSolve_<T>(lu, n, x, n, n, n, false, false);
+        });
+
+        if (singular)
+            return ND4J_STATUS_VALIDATION;
+
+        if (out != output)
+            output->assign(out);
 
         return Status::OK();
     }
@@ -267,27 +459,31 @@ template <typename T>
 
     template <typename T>
     static bool checkCholeskyInput_(nd4j::LaunchContext * context, NDArray const* input) {
-        //std::unique_ptr<NDArray> matrix(NDArrayFactory::create_('c', {n, n}, input->dataType())); //, block.getWorkspace());
-        std::unique_ptr<ResultSet> lastMatrixList(input->allTensorsAlongDimension({input->rankOf() - 2, input->rankOf()-1}));
-        for (size_t i = 0; i < lastMatrixList->size(); i++) {
-            auto thisMatrix = lastMatrixList->at(i);
-            // check for symmetric
-            for (Nd4jLong r = 0; r < thisMatrix->rows(); r++)
-                for (Nd4jLong c = 0; c < thisMatrix->columns(); c++)
-                    if (nd4j::math::nd4j_abs(thisMatrix->e<T>(r, c) - lastMatrixList->at(i)->e<T>(c,r)) > T(1.e-6f)) return false;
-
-            NDArray output = NDArrayFactory::create<T>(0., context);
-            if (ND4J_STATUS_OK != determinant(context, thisMatrix, &output)) return false;
-            if (output.e<T>(0) <= T(0)) return 0;
-            NDArray reversedMatrix(*thisMatrix);
-            if (ND4J_STATUS_OK != inverse(context, thisMatrix, &reversedMatrix)) return false;
-            if (ND4J_STATUS_OK != determinant(context, &reversedMatrix, &output)) return false;
-            if (output.e<T>(0) <= T(0)) return 0;
-
-        }
+        const auto n = input->sizeAt(-1);
+        const auto n2 = n * n;
+        const auto totalCount = input->lengthOf() / n2;
+
+        std::unique_ptr<NDArray> holder;
+        auto in = contiguous(const_cast<NDArray*>(input), holder)->bufferAsT<T>();
+
+        std::atomic<bool> valid(true);
+
+        // symmetric, and positive definite, i.e. cholesky decomposition exists
+        forEachMatrix_<T>(totalCount, n, [&](Nd4jLong e, T* matrix) {
+            auto x = in + e * n2;
+            for (Nd4jLong r = 0; r < n; r++)
+                for (Nd4jLong c = r + 1; c < n; c++)
+                    if (nd4j::math::nd4j_abs(x[r * n + c] - x[c * n + r]) > T(1.e-6f)) {
+                        valid = false;
+                        return;
+                    }
 
+            std::copy(x, x + n2, matrix);
+            if (!choleskyBlocked_<T>(matrix, n))
+                valid = false;
+        });
 
-        return true;
+        return valid;
     }
 
     bool checkCholeskyInput(nd4j::LaunchContext * context, NDArray const* input) {
@@ -296,43 +492,26 @@ template <typename T>
 
     template <typename T>
     int cholesky_(LaunchContext *context, NDArray* input, NDArray* output, bool inplace) {
+        const auto n = input->sizeAt(-1);
+        const auto n2 = n * n;
+        const auto totalCount = output->lengthOf() / n2;
 
-        auto n = input->sizeAt(-1);
-        auto n2 = n * n;
-        auto totalCount = output->lengthOf() / n2;
-        if (!inplace)
-             output->assign(0.f); // fill up output tensor with zeros only inplace=false
+        std::unique_ptr<NDArray> inHolder;
+        auto in = contiguous(input, inHolder)->bufferAsT<T>();
 
-        std::unique_ptr<NDArray> matrix(NDArrayFactory::create_('c', {n, n}, input->dataType(), context)); //, block.getWorkspace());
-        std::unique_ptr<NDArray> lowerMatrix(NDArrayFactory::create_('c',{n, n}, input->dataType(), context));
+        std::unique_ptr<NDArray> outHolder;
+        auto out = contiguous(output, outHolder);
+        auto z = out->bufferAsT<T>();
 
-        for (int e = 0; e < totalCount; e++) {
+        forEachMatrix_<T>(totalCount, n, [&](Nd4jLong e, T* matrix) {
+            // input and output might be the same array
+            std::copy(in + e * n2, in + (e + 1) * n2, matrix);
+            choleskyBlocked_<T>(matrix, n);
+            std::copy(matrix, matrix + n2, z + e * n2);
+        });
 
-            // fill up matrix
-            for (int k = e * n2, l = 0; k < (e + 1) * n2; k++) {
-                matrix->p(l++, input->e<T>(k));
-            }
-            //if (e) // from the second loop need to zero matrix
-            lowerMatrix->assign(0.f);
-
-            for (Nd4jLong col = 0; col < n; col++) {
-                for (Nd4jLong row = 0; row < col; row++) {
-                    T rowSum = 0;
-                    for (Nd4jLong k = 0; k < row; ++k)
-                        rowSum += (lowerMatrix->e<T>(col, k) * lowerMatrix->e<T>(row, k));
-                    lowerMatrix->p(col, row, (matrix->e<T>(row, col) - rowSum) / lowerMatrix->e<double>(row, row));
-                }
-                T diagonalSum = 0;
-                for (Nd4jLong k = 0; k < col;  ++k)
-                    diagonalSum += lowerMatrix->e<T>(col, k) * lowerMatrix->e<T>(col, k);
-                lowerMatrix->p(col, col, nd4j::math::nd4j_sqrt<T, T>(matrix->e<T>(col, col) - diagonalSum));
-                //nd4j_printf("%i: ", col);
-                //lowerMatrix->printIndexedBuffer("Lower matrix");
-            }
-            for (int k = e * n2, l = 0; k < (e + 1) * n2; k++) {
-                output->p(k, lowerMatrix->e<T>(l++));
-            }
-        }
+        if (out != output)
+            output->assign(out);
 
         return ND4J_STATUS_OK;
     }
@@ -343,22 +522,25 @@ template <typename T>
 
     template <typename T>
     int logdetFunctor_(LaunchContext *context, NDArray* input, NDArray* output) {
-        std::unique_ptr<NDArray> tempOutput(input->dup());
+        std::unique_ptr<NDArray> tempOutput(NDArrayFactory::create_('c', input->getShapeAsVector(), input->dataType(), context));
         int res = cholesky_<T>(context, input, tempOutput.get(), false);
         if (res != ND4J_STATUS_OK)
             return res;
-        auto n = input->sizeAt(-1);
-        auto totalCount = output->lengthOf();
-        std::vector<T> d(n);
-        std::unique_ptr<ResultSet> matricies(tempOutput->allTensorsAlongDimension({input->rankOf()-2, input->rankOf() - 1}));
-        std::unique_ptr<ResultSet> inputMatricies(input->allTensorsAlongDimension({input->rankOf()-2, input->rankOf() - 1}));
+
+        const auto n = input->sizeAt(-1);
+        const auto totalCount = output->lengthOf();
+        auto l = tempOutput->bufferAsT<T>();
+
+        // log(det) = sum of log(L_ii^2)
         for (Nd4jLong e = 0; e < totalCount; e++) {
+            auto matrix = l + e * n * n;
+            T sum = static_cast<T>(0.f);
+            for (Nd4jLong i = 0; i < n; ++i)
+                sum += nd4j::math::nd4j_log<T,T>(matrix[i * n + i] * matrix[i * n + i]);
 
-            //d[0] = inputMatricies->at(e)->t<T>(0, 0);
-            for (size_t i = 0; i < n; ++i) {
-                output->t<T>(e) += nd4j::math::nd4j_log<T,T>(nd4j::math::nd4j_pow<T,T,T>(matricies->at(e)->t<T>(i, i), T(2)));
-            }
+            output->p(e, sum);
         }
+
         return ND4J_STATUS_OK;
     }
 
@@ -20,10 +20,80 @@
 
 #include <ops/declarable/helpers/segment.h>
 #include <ShapeUtils.h>
+#include <array/TadSpan.h>
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    // forward functors are instantiated for output type, so input is cast to it once if types differ
+    static NDArray* sameTypeAs(NDArray* input, NDArray* output, std::unique_ptr<NDArray>& holder) {
+        if (input->dataType() == output->dataType())
+            return input;
+
+        holder.reset(input->cast(output->dataType()));
+        return holder.get();
+    }
+
+    // z = op(z, x), elementwise over TAD zTad of zTads and TAD xTad of xTads
+    template <typename T, typename OpFunc>
+    static FORCEINLINE void combineTads(const TadSpan& zTads, Nd4jLong zTad, const TadSpan& xTads, Nd4jLong xTad, OpFunc op) {
+        auto z = zTads.at<T>(zTad);
+        auto x = xTads.at<T>(xTad);
+        auto tadLength = zTads.tadLength();
+
+        for (Nd4jLong e = 0; e < tadLength; e++) {
+            auto zOffset = zTads.elementOffset(e);
+            z[zOffset] = op(z[zOffset], x[xTads.elementOffset(e)]);
+        }
+    }
+
+    template <typename T>
+    static FORCEINLINE void divideTad(const TadSpan& zTads, Nd4jLong zTad, double divisor) {
+        auto z = zTads.at<T>(zTad);
+        auto tadLength = zTads.tadLength();
+
+        for (Nd4jLong e = 0; e < tadLength; e++) {
+            auto zOffset = zTads.elementOffset(e);
+            z[zOffset] = static_cast<T>(static_cast<double>(z[zOffset]) / divisor);
+        }
+    }
+
+    // sorted segments: each run of equal indices is folded into output TAD with that index
+    template <typename T, typename OpFunc>
+    static void segmentTadsReduce_(NDArray* input, NDArray* indices, NDArray* output, OpFunc op) {
+        auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
+        TadSpan inputTads(*input, restDims);
+        TadSpan outputTads(*output, restDims);
+
+        auto idx = indices->e<Nd4jLong>(0);
+        outputTads.assign(idx, inputTads, 0);
+
+        for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
+            auto next = indices->e<Nd4jLong>(i);
+            if (next == idx) {
+                combineTads<T>(outputTads, idx, inputTads, i, op);
+            }
+            else {
+                idx = next;
+                outputTads.assign(idx, inputTads, i);
+            }
+        }
+    }
+
+    // unsorted segments: TADs listed for each class are folded into output TAD of that class
+    template <typename T, typename OpFunc>
+    static void unsortedSegmentTadsReduce_(NDArray* input, std::map<Nd4jLong, std::vector<Nd4jLong>>& idxs, NDArray* output, OpFunc op) {
+        auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
+        TadSpan inputTads(*input, restDims);
+        TadSpan outputTads(*output, restDims);
+
+        for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
+            outputTads.assign(fi->first, inputTads, fi->second.at(0));
+            for (size_t idx = 1; idx < fi->second.size(); ++idx)
+                combineTads<T>(outputTads, fi->first, inputTads, fi->second.at(idx), op);
+        }
+    }
+
     // segment max
     template <typename T>
     static void segmentMaxFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
@@ -46,33 +116,7 @@ namespace helpers {
             }
         }
         else {
-            std::vector<int> restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            auto numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto maxT = listOfOutTensors->at(idx);
-
-            //int pos = 0;
-            maxT->assign(listOfTensors->at(0));
-
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-
-                    for (Nd4jLong e = 0; e < maxT->lengthOf(); e++) {
-                       maxT->t<T>(e) = nd4j::math::nd4j_max(maxT->t<T>(e), listOfTensors->at(i)->t<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<Nd4jLong>(i);
-                    maxT = listOfOutTensors->at(idx);
-                    maxT->assign(listOfTensors->at(i));
-                }
-
-            }
-            delete listOfTensors;
-            delete listOfOutTensors;
+            segmentTadsReduce_<T>(input, indices, output, [](T a, T b) -> T { return nd4j::math::nd4j_max<T>(a, b); });
         }
     }
 
@@ -98,31 +142,7 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            std::unique_ptr<ResultSet> listOfTensors( input->allTensorsAlongDimension(restDims) );
-            std::unique_ptr<ResultSet> listOfOutTensors( output->allTensorsAlongDimension(restDims) );
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto minT = listOfOutTensors->at(idx);
-
-            int pos = 0;
-            minT->assign(listOfTensors->at(0));
-
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<T>(i) == idx) {
-
-                    for (int e = 0; e < minT->lengthOf(); e++) {
-                       minT->p(e, nd4j::math::nd4j_min(minT->e<T>(e), listOfTensors->at(i)->e<T>(e)));
-                    }
-                }
-                else {
-                    idx = indices->e<T>(i);
-                    minT = listOfOutTensors->at(idx);
-                    minT->assign(listOfTensors->at(i));
-                }
-            }
+            segmentTadsReduce_<T>(input, indices, output, [](T a, T b) -> T { return nd4j::math::nd4j_min<T>(a, b); });
         }
     }
 
@@ -153,38 +173,27 @@ namespace helpers {
         }
         else {
             auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
+            TadSpan inputTads(*input, restDims);
+            TadSpan outputTads(*output, restDims);
+
+            auto sum = [](T a, T b) -> T { return a + b; };
+            Nd4jLong count = 1;
+            outputTads.assign(idx, inputTads, 0);
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto meanT = listOfOutTensors->at(idx);
-            int count = 1;
-            auto meanV = meanT->dup();
-            meanV->assign(listOfTensors->at(0));
-
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < meanT->lengthOf(); e++) {
-                       meanV->p<T>(e, meanV->e<T>(e) + listOfTensors->at(i)->e<T>(e));
-                    }
+            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
+                auto next = indices->e<Nd4jLong>(i);
+                if (next == idx) {
+                    combineTads<T>(outputTads, idx, inputTads, i, sum);
                     count++;
                 }
                 else {
-                    //meanT->assign(meanV);
-                    meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
-                    idx = indices->e<int>(i);
-                    meanT = listOfOutTensors->at(idx);
-                    meanV->assign(listOfTensors->at(i));
+                    divideTad<T>(outputTads, idx, count);
+                    idx = next;
+                    outputTads.assign(idx, inputTads, i);
                     count = 1;
                 }
-                meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
             }
-            delete meanV;
-            delete listOfTensors;
-            delete listOfOutTensors;
+            divideTad<T>(outputTads, idx, count);
         }
     }
 
@@ -209,30 +218,7 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto sumT = listOfOutTensors->at(idx);
-
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) + listOfTensors->at(i)->e<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
-                }
-            }
-            delete listOfTensors;
-            delete listOfOutTensors;
+            segmentTadsReduce_<T>(input, indices, output, [](T a, T b) -> T { return a + b; });
         }
     }
 
@@ -259,29 +245,7 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            auto sumT = listOfOutTensors->at(idx);
-            sumT->assign(listOfTensors->at(0));
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i)  == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) * listOfTensors->at(i)->e<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
-                }
-            }
-            delete listOfTensors;
-            delete listOfOutTensors;
+            segmentTadsReduce_<T>(input, indices, output, [](T a, T b) -> T { return a * b; });
         }
     }
 
@@ -290,23 +254,33 @@ namespace helpers {
 //      }
 
     void segmentMaxFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentMaxFunctor_, (input, indices, output), LIBND4J_TYPES);
+        std::unique_ptr<NDArray> holder;
+        input = sameTypeAs(input, output, holder);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentMaxFunctor_, (input, indices, output), LIBND4J_TYPES);
     }
 
     void segmentMinFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentMinFunctor_, (input, indices, output), LIBND4J_TYPES);
+        std::unique_ptr<NDArray> holder;
+        input = sameTypeAs(input, output, holder);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentMinFunctor_, (input, indices, output), LIBND4J_TYPES);
     }
 
     void segmentMeanFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentMeanFunctor_, (input, indices, output), LIBND4J_TYPES);
+        std::unique_ptr<NDArray> holder;
+        input = sameTypeAs(input, output, holder);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentMeanFunctor_, (input, indices, output), LIBND4J_TYPES);
     }
 
     void segmentSumFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentSumFunctor_, (input, indices, output), LIBND4J_TYPES);
+        std::unique_ptr<NDArray> holder;
+        input = sameTypeAs(input, output, holder);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentSumFunctor_, (input, indices, output), LIBND4J_TYPES);
     }
 
     void segmentProdFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentProdFunctor_, (input, indices, output), LIBND4J_TYPES);
+        std::unique_ptr<NDArray> holder;
+        input = sameTypeAs(input, output, holder);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentProdFunctor_, (input, indices, output), LIBND4J_TYPES);
     }
 
     bool segmentIndicesValidate(nd4j::LaunchContext * context, NDArray* indices, NDArray& expected, NDArray& output) {
@@ -367,31 +341,16 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
             T maxVal = DataTypeUtils::max<T>();
             output->assign(-maxVal);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto maxT = listOfTensors->at(fi->second.at(idx));
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        T val = nd4j::math::nd4j_max(maxT->e<T>(e), outputT->e<T>(e));
-
-                        outputT->p(e, val);
-                    }
-                }
-                //outputT->assign(maxT);
-            }
+            unsortedSegmentTadsReduce_<T>(input, idxs, output, [](T a, T b) -> T { return nd4j::math::nd4j_max<T>(a, b); });
         }
     }
     void unsortedSegmentMaxFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+        std::unique_ptr<NDArray> holder;
+        input = sameTypeAs(input, output, holder);
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
     BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMaxFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
@@ -420,37 +379,23 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
             T maxVal = DataTypeUtils::max<T>();
             output->assign(maxVal);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto minT = listOfTensors->at(fi->second.at(idx));
-
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        outputT->t<T>(e) = nd4j::math::nd4j_min(minT->t<T>(e), outputT->t<T>(e));
-                    }
-                }
-                //outputT->assign(maxT);
-            }
+            unsortedSegmentTadsReduce_<T>(input, idxs, output, [](T a, T b) -> T { return nd4j::math::nd4j_min<T>(a, b); });
         }
-
     }
     void unsortedSegmentMinFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output),
+        std::unique_ptr<NDArray> holder;
+        input = sameTypeAs(input, output, holder);
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output),
                               NUMERIC_TYPES);
     }
 
     BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
-    void unsortedSegmentMeanFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+    template <typename T>
+    static void unsortedSegmentMeanFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
         std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
         for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
             idxs[indices->e<Nd4jLong>(e)].push_back(e);
@@ -471,26 +416,23 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
+            unsortedSegmentTadsReduce_<T>(input, idxs, output, [](T a, T b) -> T { return a + b; });
 
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                Nd4jLong loopSize = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR
-                for (Nd4jLong idx = 1; idx < loopSize; ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
-                }
-                (*outputT) /= double(fi->second.size());
-            }
+            TadSpan outputTads(*output, ShapeUtils::evalDimsToExclude(output->rankOf(), {0}));
+            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi)
+                divideTad<T>(outputTads, fi->first, fi->second.size());
         }
     }
 
-    void unsortedSegmentSumFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+    void unsortedSegmentMeanFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        std::unique_ptr<NDArray> holder;
+        input = sameTypeAs(input, output, holder);
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentMeanFunctor_, (input, indices, numOfClasses, output), FLOAT_TYPES);
+    }
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMeanFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), FLOAT_TYPES);
+
+    template <typename T>
+    static void unsortedSegmentSumFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
         std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
         for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
             idxs[indices->e<Nd4jLong>(e)].push_back(e);
@@ -508,25 +450,17 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                Nd4jLong loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *(outputT) += *current;
-                }
-                //outputT->assign(maxT);
-            }
+            unsortedSegmentTadsReduce_<T>(input, idxs, output, [](T a, T b) -> T { return a + b; });
         }
     }
 
+    void unsortedSegmentSumFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        std::unique_ptr<NDArray> holder;
+        input = sameTypeAs(input, output, holder);
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentSumFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    }
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentSumFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+
     template <typename T>
     void unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
         std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
@@ -547,29 +481,19 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-
-                    *outputT *= *current;
-                }
-            }
+            unsortedSegmentTadsReduce_<T>(input, idxs, output, [](T a, T b) -> T { return a * b; });
         }
     }
 
     void unsortedSegmentProdFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentProdFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+        std::unique_ptr<NDArray> holder;
+        input = sameTypeAs(input, output, holder);
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentProdFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
     BUILD_SINGLE_TEMPLATE(template void unsortedSegmentProdFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
-    void unsortedSegmentSqrtNFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+    template <typename T>
+    static void unsortedSegmentSqrtNFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
         std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
         for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
             idxs[indices->e<Nd4jLong>(e)].push_back(e);
@@ -586,24 +510,21 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            unsortedSegmentTadsReduce_<T>(input, idxs, output, [](T a, T b) -> T { return a + b; });
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
-                }
-                //outputT->assign(maxT);
-                (*outputT) /= nd4j::math::nd4j_sqrt<size_t, double>(fi->second.size());
-            }
+            TadSpan outputTads(*output, ShapeUtils::evalDimsToExclude(output->rankOf(), {0}));
+            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi)
+                divideTad<T>(outputTads, fi->first, nd4j::math::nd4j_sqrt<size_t, double>(fi->second.size()));
         }
     }
 
+    void unsortedSegmentSqrtNFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        std::unique_ptr<NDArray> holder;
+        input = sameTypeAs(input, output, holder);
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentSqrtNFunctor_, (input, indices, numOfClasses, output), FLOAT_TYPES);
+    }
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentSqrtNFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), FLOAT_TYPES);
+
     // -------------------------------------------------------------------------------------------------------------- //
     // Backpropagate ops helpers
     // -------------------------------------------------------------------------------------------------------------- //
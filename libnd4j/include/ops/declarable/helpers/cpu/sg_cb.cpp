@@ -20,6 +20,7 @@
 
 #include <ops/declarable/helpers/sg_cb.h>
 #include <specials.h>
+#include <algorithm>
 
 #define HS_MAX_EXP 6.0f
 
@@ -569,6 +570,300 @@ namespace nd4j {
             }
             BUILD_SINGLE_TEMPLATE(template void cbowBatchExec_, (NDArray &s0, NDArray &s1, NDArray &s1n, void *vexpTable, void *vnegTable, void *vinfVector, NDArray &context, NDArray &lockedWords, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, NDArray &nLabels, const int nsRounds, const int vocabSize, const int vectorLength, const int expLength, const int negLength,  const bool trainWords, const int numThreads), FLOAT_TYPES);
 
+            /**
+             * Negative sampling gradient for given dot product, with saturation beyond HS_MAX_EXP instead of early exit,
+             * so it can be evaluated for whole rows of dot products without branching on exp table bounds
+             */
+            template <typename T>
+            static FORCEINLINE T nsGradient(const T dot, const T label, const T *expTable, const int expLength, const T alpha) {
+                const T maxExp = static_cast<T>(HS_MAX_EXP);
+                const T clamped = nd4j::math::nd4j_min<T>(nd4j::math::nd4j_max<T>(dot, -maxExp), maxExp);
+                const int idx = nd4j::math::nd4j_min<int>(static_cast<int>((clamped + maxExp) * static_cast<T>(expLength / HS_MAX_EXP / 2.0)), expLength - 1);
+                const T f = dot > maxExp ? static_cast<T>(1.0f) : dot < -maxExp ? static_cast<T>(0.0f) : expTable[idx];
+
+                return (label - f) * alpha;
+            }
+
+            template <typename T>
+            static void drawNegatives(int *negatives, unsigned long long randomValue, const T *negTable, const int nsRounds, const int vocabSize, const int negLength) {
+                for (int r = 0; r < nsRounds; r++) {
+                    randomValue = randomValue * (unsigned long long) 25214903917 + 11;
+                    auto idx = nd4j::math::nd4j_abs<Nd4jLong>((randomValue >> 16) % negLength);
+                    int irow = idx >= negLength ? -1 : static_cast<int>(negTable[idx]);
+
+                    if (irow < 0 || irow >= vocabSize)
+                        irow = randomValue % (vocabSize - 1) + 1;
+
+                    negatives[r] = irow;
+                }
+            }
+
+            /**
+             * This method trains one minibatch of [numRows] input rows against their own positive syn1Neg rows and [nsRounds] negative rows
+             * shared by the whole minibatch. Negative part is done as two small dense GEMMs:
+             * scores = input x negatives^T, then error += grads x negatives and negatives += grads^T x input
+             *
+             * input and error are [numRows, vectorLength] thread-local buffers, negatives gradient is accumulated locally and applied once
+             */
+            template <typename T>
+            static void nsMinibatch_(T *input, T *error, T *syn1Neg, const T *expTable, const int *positives, const int *negatives, const double *alphas, T *scores, T *outRows, T *outGrads, const int numRows, const int nsRounds, const int vectorLength, const int expLength) {
+                // positive samples are unique per row
+                for (int i = 0; i < numRows; i++) {
+                    auto in = input + i * vectorLength;
+                    auto err = error + i * vectorLength;
+                    auto pos = syn1Neg + positives[i] * vectorLength;
+
+                    T dot = (T) 0.0f;
+                    for (int e = 0; e < vectorLength; e++)
+                        dot += in[e] * pos[e];
+
+                    const T g = nsGradient<T>(dot, (T) 1.0f, expTable, expLength, (T) alphas[i]);
+
+                    PRAGMA_OMP_SIMD
+                    for (int e = 0; e < vectorLength; e++) {
+                        err[e] += g * pos[e];
+                        pos[e] += g * in[e];
+                    }
+                }
+
+                // gathering shared negatives
+                for (int k = 0; k < nsRounds; k++)
+                    memcpy(outRows + k * vectorLength, syn1Neg + negatives[k] * vectorLength, vectorLength * sizeof(T));
+
+                std::fill(outGrads, outGrads + nsRounds * vectorLength, (T) 0.0f);
+
+                // scores = input x negatives^T, converted to gradients in place
+                for (int i = 0; i < numRows; i++) {
+                    auto in = input + i * vectorLength;
+
+                    for (int k = 0; k < nsRounds; k++) {
+                        auto out = outRows + k * vectorLength;
+
+                        T dot = (T) 0.0f;
+                        for (int e = 0; e < vectorLength; e++)
+                            dot += in[e] * out[e];
+
+                        scores[i * nsRounds + k] = dot;
+                    }
+
+                    const T alpha = (T) alphas[i];
+                    PRAGMA_OMP_SIMD
+                    for (int k = 0; k < nsRounds; k++)
+                        scores[i * nsRounds + k] = negatives[k] == positives[i] ? (T) 0.0f : nsGradient<T>(scores[i * nsRounds + k], (T) 0.0f, expTable, expLength, alpha);
+                }
+
+                // error += grads x negatives, negatives gradient += grads^T x input
+                for (int i = 0; i < numRows; i++) {
+                    auto in = input + i * vectorLength;
+                    auto err = error + i * vectorLength;
+
+                    for (int k = 0; k < nsRounds; k++) {
+                        const T g = scores[i * nsRounds + k];
+                        if (g == (T) 0.0f)
+                            continue;
+
+                        auto out = outRows + k * vectorLength;
+                        auto grad = outGrads + k * vectorLength;
+
+                        PRAGMA_OMP_SIMD
+                        for (int e = 0; e < vectorLength; e++) {
+                            err[e] += g * out[e];
+                            grad[e] += g * in[e];
+                        }
+                    }
+                }
+
+                for (int k = 0; k < nsRounds; k++) {
+                    auto row = syn1Neg + negatives[k] * vectorLength;
+                    auto grad = outGrads + k * vectorLength;
+
+                    PRAGMA_OMP_SIMD
+                    for (int e = 0; e < vectorLength; e++)
+                        row[e] += grad[e];
+                }
+            }
+
+            template <typename T>
+            void skipgramMinibatch_(NDArray &s0, NDArray &s1, NDArray &s1n, NDArray &expTable, NDArray &negTable, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, const int nsRounds, const int minibatch, const int numThreads) {
+                const auto syn0 = s0.bufferAsT<T>();
+                const auto syn1 = s1.isEmpty() ? nullptr : s1.bufferAsT<T>();
+                const auto syn1Neg = s1n.bufferAsT<T>();
+                const auto bExpTable = expTable.bufferAsT<T>();
+                const auto bNegTable = negTable.bufferAsT<T>();
+
+                const int vocabSize = s0.sizeAt(0);
+                const int vectorLength = s0.sizeAt(1);
+                const int expLength = expTable.lengthOf();
+                const int negLength = negTable.lengthOf();
+
+                const auto numTargets = targets.lengthOf();
+                const auto bTarget = targets.bufferAsT<int>();
+                const auto bStarters = negStarters.bufferAsT<int>();
+                const auto bIndices = indices.isEmpty() ? nullptr : indices.bufferAsT<int>();
+                const auto bCodes = codes.isEmpty() ? nullptr : codes.bufferAsT<int8_t>();
+                const auto hsRounds = codes.isEmpty() ? 0 : codes.sizeAt(1);
+
+                const auto numChunks = (numTargets + minibatch - 1) / minibatch;
+
+                PRAGMA_OMP_PARALLEL_FOR_ARGS(num_threads(numThreads) schedule(dynamic))
+                for (Nd4jLong c = 0; c < numChunks; c++) {
+                    const int first = c * minibatch;
+                    const int numRows = nd4j::math::nd4j_min<Nd4jLong>(minibatch, numTargets - first);
+
+                    std::vector<T> input(numRows * vectorLength);
+                    std::vector<T> error(numRows * vectorLength, (T) 0.0f);
+                    std::vector<T> scores(numRows * nsRounds);
+                    std::vector<T> outRows(nsRounds * vectorLength);
+                    std::vector<T> outGrads(nsRounds * vectorLength);
+                    std::vector<double> alphas(numRows);
+                    std::vector<int> negatives(nsRounds);
+
+                    for (int i = 0; i < numRows; i++) {
+                        auto target = bTarget[first + i];
+                        if (target < 0 || target >= vocabSize)
+                            throw std::runtime_error("SkipGram: target can't be >= vocab size");
+
+                        memcpy(input.data() + i * vectorLength, syn0 + target * vectorLength, vectorLength * sizeof(T));
+                        alphas[i] = lr.e<double>(first + i);
+                    }
+
+                    // hierarchic softmax isn't shared between rows
+                    for (int i = 0; i < numRows && hsRounds > 0; i++) {
+                        for (int e = 0; e < hsRounds; e++) {
+                            auto irow = bIndices[(first + i) * hsRounds + e];
+                            if (irow < 0 || irow >= vocabSize)
+                                continue;
+
+                            hSoftmax_<T>(input.data() + i * vectorLength, syn1 + irow * vectorLength, bExpTable, error.data() + i * vectorLength, alphas[i], vectorLength, bCodes[(first + i) * hsRounds + e], expLength, false);
+                        }
+                    }
+
+                    drawNegatives<T>(negatives.data(), nextRandom.e<Nd4jLong>(first), bNegTable, nsRounds, vocabSize, negLength);
+                    nsMinibatch_<T>(input.data(), error.data(), syn1Neg, bExpTable, bStarters + first, negatives.data(), alphas.data(), scores.data(), outRows.data(), outGrads.data(), numRows, nsRounds, vectorLength, expLength);
+
+                    for (int i = 0; i < numRows; i++) {
+                        auto syn0row = syn0 + bTarget[first + i] * vectorLength;
+                        auto err = error.data() + i * vectorLength;
+
+                        PRAGMA_OMP_SIMD
+                        for (int e = 0; e < vectorLength; e++)
+                            syn0row[e] += err[e];
+                    }
+                }
+            }
+            BUILD_SINGLE_TEMPLATE(template void skipgramMinibatch_, (NDArray &s0, NDArray &s1, NDArray &s1n, NDArray &expTable, NDArray &negTable, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, const int nsRounds, const int minibatch, const int numThreads), FLOAT_TYPES);
+
+            template <typename T>
+            void cbowMinibatch_(NDArray &s0, NDArray &s1, NDArray &s1n, NDArray &expTable, NDArray &negTable, NDArray &context, NDArray &lockedWords, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, NDArray &nLabels, const int nsRounds, const bool trainWords, const int minibatch, const int numThreads) {
+                const auto syn0 = s0.bufferAsT<T>();
+                const auto syn1 = s1.isEmpty() ? nullptr : s1.bufferAsT<T>();
+                const auto syn1Neg = s1n.bufferAsT<T>();
+                const auto bExpTable = expTable.bufferAsT<T>();
+                const auto bNegTable = negTable.bufferAsT<T>();
+
+                const int vocabSize = s0.sizeAt(0);
+                const int vectorLength = s0.sizeAt(1);
+                const int expLength = expTable.lengthOf();
+                const int negLength = negTable.lengthOf();
+
+                const auto numTargets = context.sizeAt(0);
+                const int contextWidth = context.sizeAt(1);
+                const auto bContext = context.bufferAsT<int>();
+                const auto bLocker = lockedWords.bufferAsT<int>();
+                const auto bStarters = negStarters.bufferAsT<int>();
+                const auto bIndices = indices.isEmpty() ? nullptr : indices.bufferAsT<int>();
+                const auto bCodes = codes.isEmpty() ? nullptr : codes.bufferAsT<int8_t>();
+                const auto numIndices = indices.isEmpty() ? 0 : indices.sizeAt(1);
+
+                const auto numChunks = (numTargets + minibatch - 1) / minibatch;
+
+                PRAGMA_OMP_PARALLEL_FOR_ARGS(num_threads(numThreads) schedule(dynamic))
+                for (Nd4jLong c = 0; c < numChunks; c++) {
+                    const int first = c * minibatch;
+                    const int numRows = nd4j::math::nd4j_min<Nd4jLong>(minibatch, numTargets - first);
+
+                    std::vector<T> input(numRows * vectorLength, (T) 0.0f);
+                    std::vector<T> error(numRows * vectorLength, (T) 0.0f);
+                    std::vector<T> scores(numRows * nsRounds);
+                    std::vector<T> outRows(nsRounds * vectorLength);
+                    std::vector<T> outGrads(nsRounds * vectorLength);
+                    std::vector<double> alphas(numRows);
+                    std::vector<int> negatives(nsRounds);
+
+                    // building averaged context rows
+                    for (int i = 0; i < numRows; i++) {
+                        auto neu1 = input.data() + i * vectorLength;
+                        int actualContext = 0;
+
+                        for (int w = 0; w < contextWidth; w++) {
+                            auto cContext = bContext[w + (first + i) * contextWidth];
+
+                            // skipping padded values
+                            if (cContext < 0)
+                                continue;
+
+                            if (cContext >= vocabSize)
+                                throw std::runtime_error("ContextID can't be >= vocab size");
+
+                            auto syn0word = syn0 + cContext * vectorLength;
+
+                            PRAGMA_OMP_SIMD
+                            for (int e = 0; e < vectorLength; e++)
+                                neu1[e] += syn0word[e];
+
+                            actualContext++;
+                        }
+
+                        if (actualContext > 1) {
+                            for (int e = 0; e < vectorLength; e++)
+                                neu1[e] /= actualContext;
+                        }
+
+                        alphas[i] = lr.e<double>(first + i);
+                    }
+
+                    for (int i = 0; i < numRows && numIndices > 0; i++) {
+                        for (int e = 0; e < numIndices; e++) {
+                            auto cIndex = bIndices[(first + i) * numIndices + e];
+
+                            // we're skipping padded values
+                            if (cIndex < 0)
+                                continue;
+
+                            if (cIndex >= vocabSize)
+                                throw std::runtime_error("Index can't be > vocab size");
+
+                            hSoftmax_<T>(input.data() + i * vectorLength, syn1 + cIndex * vectorLength, bExpTable, error.data() + i * vectorLength, alphas[i], vectorLength, bCodes[(first + i) * numIndices + e], expLength, false);
+                        }
+                    }
+
+                    drawNegatives<T>(negatives.data(), nextRandom.e<Nd4jLong>(first), bNegTable, nsRounds, vocabSize, negLength);
+                    nsMinibatch_<T>(input.data(), error.data(), syn1Neg, bExpTable, bStarters + first, negatives.data(), alphas.data(), scores.data(), outRows.data(), outGrads.data(), numRows, nsRounds, vectorLength, expLength);
+
+                    // applying errors to context words
+                    for (int i = 0; i < numRows; i++) {
+                        auto numLabels = nLabels.isEmpty() ? 0 : nLabels.e<int>(first + i);
+                        int starter = trainWords == 1 ? 0 : contextWidth - numLabels;
+                        auto err = error.data() + i * vectorLength;
+
+                        for (int w = starter; w < contextWidth; w++) {
+                            auto cContext = bContext[w + (first + i) * contextWidth];
+                            auto cLock = bLocker[w + (first + i) * contextWidth];
+
+                            if (cContext < 0 || cLock == 1)
+                                continue;
+
+                            auto syn0word = syn0 + cContext * vectorLength;
+
+                            PRAGMA_OMP_SIMD
+                            for (int e = 0; e < vectorLength; e++)
+                                syn0word[e] += err[e];
+                        }
+                    }
+                }
+            }
+            BUILD_SINGLE_TEMPLATE(template void cbowMinibatch_, (NDArray &s0, NDArray &s1, NDArray &s1n, NDArray &expTable, NDArray &negTable, NDArray &context, NDArray &lockedWords, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, NDArray &nLabels, const int nsRounds, const bool trainWords, const int minibatch, const int numThreads), FLOAT_TYPES);
+
             void skipgram(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &target, NDArray &ngStarter, int nsRounds, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, NDArray &inferenceVector, const bool preciseMode, const int numWorkers) {
                 auto xType = syn0.dataType();
 
@@ -609,6 +904,20 @@ namespace nd4j {
                 } else
                     throw std::runtime_error("CBOW: context must have rank 0/1 or 2");
             }
+
+            void skipgramMinibatch(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &target, NDArray &ngStarter, int nsRounds, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, const int minibatch, const int numWorkers) {
+                if (!target.isVector() || !ngStarter.isVector() || nsRounds < 1 || minibatch < 1)
+                    throw std::runtime_error("SkipGram: minibatch mode requires batch of targets and negative sampling");
+
+                BUILD_SINGLE_SELECTOR(syn0.dataType(), skipgramMinibatch_, (syn0, syn1, syn1Neg, expTable, negTable, target, ngStarter, indices, codes, alpha, randomValue, nsRounds, minibatch, numWorkers), FLOAT_TYPES);
+            }
+
+            void cbowMinibatch(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &ngStarter, int nsRounds, NDArray &context, NDArray &lockedWords, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, NDArray &numLabels, const bool trainWords, const int minibatch, const int numWorkers) {
+                if (context.rankOf() != 2 || !ngStarter.isVector() || nsRounds < 1 || minibatch < 1)
+                    throw std::runtime_error("CBOW: minibatch mode requires batch of contexts and negative sampling");
+
+                BUILD_SINGLE_SELECTOR(syn0.dataType(), cbowMinibatch_, (syn0, syn1, syn1Neg, expTable, negTable, context, lockedWords, ngStarter, indices, codes, alpha, randomValue, numLabels, nsRounds, trainWords, minibatch, numWorkers), FLOAT_TYPES);
+            }
         }
     }
-}
\ No newline at end of file
+}
@@ -22,6 +22,11 @@
 #include <NDArrayFactory.h>
 #include <helpers/jacobiSVD.h>
 #include <helpers/biDiagonalUp.h>
+#include <ops/declarable/helpers/svd.h>
+#include <execution/Executor.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 
 namespace nd4j {
 namespace ops {
@@ -945,6 +950,469 @@ void SVD<T>::evalData(const NDArray& matrix) {
 BUILD_SINGLE_TEMPLATE(template class ND4J_EXPORT SVD,,FLOAT_TYPES);
 
 
+//////////////////////////////////////////////////////////////////////////
+// Kernels below work on raw buffers, tall matrices are stored column by column (i.e. each row of buffer holds one column)
+
+// width of Householder panel, trailing columns are updated once per panel
+static const Nd4jLong SVD_PANEL = 32;
+
+// one-sided Jacobi gives up after this number of sweeps, normally it converges within 6-10 sweeps
+static const int SVD_MAX_SWEEPS = 60;
+
+// randomized svd: extra columns of range sketch and number of power iterations
+static const Nd4jLong SVD_OVERSAMPLING = 10;
+static const int SVD_POWER_ITERATIONS = 2;
+
+template <typename T>
+static FORCEINLINE double svdEpsilon() {
+    return std::is_same<T, double>::value ? 2.2e-16 : std::is_same<T, float>::value ? 1.2e-7 : 1e-3;
+}
+
+template <typename T>
+static FORCEINLINE double dot_(const T* x, const T* y, Nd4jLong length) {
+    double sum = 0.;
+    for (Nd4jLong e = 0; e < length; e++)
+        sum += static_cast<double>(x[e]) * static_cast<double>(y[e]);
+
+    return sum;
+}
+
+template <typename T>
+static FORCEINLINE void axpy_(T* y, const T* x, T alpha, Nd4jLong length) {
+    PRAGMA_OMP_SIMD
+    for (Nd4jLong e = 0; e < length; e++)
+        y[e] += alpha * x[e];
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Householder QR of m x n matrix (m >= n), columns-wise storage.
+// On exit R is stored at and above diagonal, reflectors (with implicit unit first element) are stored below diagonal.
+// Panel columns are factorized one by one, then all trailing columns are updated in parallel while panel stays in cache
+template <typename T>
+static void householderQR_(T* at, Nd4jLong m, Nd4jLong n, T* tau) {
+
+    // applies reflectors [from, to) to column c
+    auto reflect = [&](T* c, Nd4jLong from, Nd4jLong to) {
+        for (Nd4jLong j = from; j < to; j++) {
+            if (tau[j] == static_cast<T>(0.f))
+                continue;
+
+            auto v = at + j * m;
+            auto w = static_cast<double>(c[j]) + dot_<T>(v + j + 1, c + j + 1, m - j - 1);
+            auto alpha = static_cast<T>(-static_cast<double>(tau[j]) * w);
+            c[j] += alpha;
+            axpy_<T>(c + j + 1, v + j + 1, alpha, m - j - 1);
+        }
+    };
+
+    for (Nd4jLong k = 0; k < n; k += SVD_PANEL) {
+        const auto panelEnd = nd4j::math::nd4j_min<Nd4jLong>(k + SVD_PANEL, n);
+
+        for (Nd4jLong j = k; j < panelEnd; j++) {
+            auto x = at + j * m;
+
+            // reflector of column j, H = I - tau * v * v^T, v[0] = 1
+            auto tail = dot_<T>(x + j + 1, x + j + 1, m - j - 1);
+            if (tail == 0.) {
+                tau[j] = static_cast<T>(0.f);
+            } else {
+                auto x0 = static_cast<double>(x[j]);
+                auto beta = -nd4j::math::nd4j_sign<double, double>(x0 == 0. ? 1. : x0) * nd4j::math::nd4j_sqrt<double, double>(x0 * x0 + tail);
+                auto scale = static_cast<T>(1. / (x0 - beta));
+
+                tau[j] = static_cast<T>((beta - x0) / beta);
+                x[j] = static_cast<T>(beta);
+                for (Nd4jLong i = j + 1; i < m; i++)
+                    x[i] *= scale;
+            }
+
+            for (Nd4jLong c = j + 1; c < panelEnd; c++)
+                reflect(at + c * m, j, j + 1);
+        }
+
+        Executor::parallel_for(panelEnd, n, [&](Nd4jLong from, Nd4jLong to) {
+            for (Nd4jLong c = from; c < to; c++)
+                reflect(at + c * m, k, panelEnd);
+        });
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// c = Q * c for numCols columns of length m, Q = H_0 * H_1 * ... * H_{n-1} as produced by householderQR_
+template <typename T>
+static void applyHouseholderQ_(const T* at, Nd4jLong m, Nd4jLong n, const T* tau, T* ct, Nd4jLong numCols) {
+    Executor::parallel_for(0, numCols, [&](Nd4jLong from, Nd4jLong to) {
+        for (Nd4jLong col = from; col < to; col++) {
+            auto c = ct + col * m;
+            for (Nd4jLong j = n - 1; j >= 0; j--) {
+                if (tau[j] == static_cast<T>(0.f))
+                    continue;
+
+                auto v = at + j * m;
+                auto w = static_cast<double>(c[j]) + dot_<T>(v + j + 1, c + j + 1, m - j - 1);
+                auto alpha = static_cast<T>(-static_cast<double>(tau[j]) * w);
+                c[j] += alpha;
+                axpy_<T>(c + j + 1, v + j + 1, alpha, m - j - 1);
+            }
+        }
+    });
+}
+
+//////////////////////////////////////////////////////////////////////////
+// One-sided (Hestenes) Jacobi: rotates pairs of columns of g (n columns of length len) until they are mutually orthogonal.
+// Rotations are accumulated in v (n columns of length n, identity on entry) if it's not null.
+// Pairs are visited in round-robin order, so all pairs of one round are disjoint and are processed in parallel
+template <typename T>
+static void oneSidedJacobi_(T* gt, Nd4jLong len, Nd4jLong n, T* vt) {
+    if (n < 2)
+        return;
+
+    const auto players = n + (n % 2);
+    const auto numPairs = players / 2;
+    const auto tolerance = svdEpsilon<T>() * nd4j::math::nd4j_max<double>(1., nd4j::math::nd4j_sqrt<double, double>((double) len));
+    const auto grain = nd4j::math::nd4j_max<Nd4jLong>(1, Environment::getInstance()->elementwiseThreshold() / (4 * len + 1));
+
+    std::vector<Nd4jLong> order(players);
+    for (Nd4jLong e = 0; e < players; e++)
+        order[e] = e;
+
+    for (int sweep = 0; sweep < SVD_MAX_SWEEPS; sweep++) {
+        std::atomic<bool> rotated(false);
+
+        for (Nd4jLong round = 0; round < players - 1; round++) {
+            Executor::parallel_for(0, numPairs, [&](Nd4jLong from, Nd4jLong to) {
+                bool local = false;
+                for (Nd4jLong k = from; k < to; k++) {
+                    auto p = order[k];
+                    auto q = order[players - 1 - k];
+
+                    // odd number of columns: one of players is dummy
+                    if (p >= n || q >= n)
+                        continue;
+
+                    auto gp = gt + p * len;
+                    auto gq = gt + q * len;
+                    auto alpha = dot_<T>(gp, gp, len);
+                    auto beta = dot_<T>(gq, gq, len);
+                    auto gamma = dot_<T>(gp, gq, len);
+
+                    if (nd4j::math::nd4j_abs<double>(gamma) <= tolerance * nd4j::math::nd4j_sqrt<double, double>(alpha * beta))
+                        continue;
+
+                    local = true;
+                    auto zeta = (beta - alpha) / (2. * gamma);
+                    auto t = nd4j::math::nd4j_sign<double, double>(zeta == 0. ? 1. : zeta) / (nd4j::math::nd4j_abs<double>(zeta) + nd4j::math::nd4j_sqrt<double, double>(1. + zeta * zeta));
+                    auto c = 1. / nd4j::math::nd4j_sqrt<double, double>(1. + t * t);
+                    auto s = static_cast<T>(c * t);
+                    auto cs = static_cast<T>(c);
+
+                    for (Nd4jLong e = 0; e < len; e++) {
+                        auto x = gp[e];
+                        auto y = gq[e];
+                        gp[e] = cs * x - s * y;
+                        gq[e] = s * x + cs * y;
+                    }
+
+                    if (vt != nullptr) {
+                        auto vp = vt + p * n;
+                        auto vq = vt + q * n;
+                        for (Nd4jLong e = 0; e < n; e++) {
+                            auto x = vp[e];
+                            auto y = vq[e];
+                            vp[e] = cs * x - s * y;
+                            vq[e] = s * x + cs * y;
+                        }
+                    }
+                }
+
+                if (local)
+                    rotated = true;
+            }, grain);
+
+            // first player stays, others move by one position
+            std::rotate(order.begin() + 1, order.end() - 1, order.end());
+        }
+
+        if (!rotated)
+            break;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// replaces columns u[e] with !valid[e] by unit vectors orthogonal to all other columns.
+// Columns are len long and stride apart, completed columns count as valid for the following ones
+template <typename T>
+static void completeBasis_(T* ut, Nd4jLong len, Nd4jLong stride, Nd4jLong numCols, std::vector<bool>& valid) {
+    for (Nd4jLong e = 0; e < numCols; e++) {
+        if (valid[e])
+            continue;
+
+        // unit vector e_c with largest residual after projection, squared residual of e_c is 1 - sum of u[c]^2 over valid columns
+        Nd4jLong best = 0;
+        double bestResidual = -1.;
+        for (Nd4jLong c = 0; c < len; c++) {
+            double residual = 1.;
+            for (Nd4jLong o = 0; o < numCols; o++)
+                if (valid[o]) {
+                    auto value = static_cast<double>(ut[o * stride + c]);
+                    residual -= value * value;
+                }
+
+            if (residual > bestResidual) {
+                bestResidual = residual;
+                best = c;
+            }
+        }
+
+        auto u = ut + e * stride;
+        std::fill(u, u + len, static_cast<T>(0.f));
+        u[best] = static_cast<T>(1.f);
+
+        // two passes of Gram-Schmidt
+        for (int pass = 0; pass < 2; pass++)
+            for (Nd4jLong o = 0; o < numCols; o++)
+                if (valid[o])
+                    axpy_<T>(u, ut + o * stride, static_cast<T>(-dot_<T>(ut + o * stride, u, len)), len);
+
+        // at most len - 1 columns are valid here, so the best residual is at least 1 / len
+        auto norm = nd4j::math::nd4j_sqrt<double, double>(dot_<T>(u, u, len));
+        for (Nd4jLong i = 0; i < len; i++)
+            u[i] = static_cast<T>(u[i] / norm);
+
+        valid[e] = true;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SVD of m x n matrix b (m >= n), columns-wise storage, b is destroyed.
+// s gets n singular values in decreasing order. If not null, ut gets (fullU ? m : n) left singular vectors and vt gets n right singular vectors,
+// both columns-wise
+template <typename T>
+static void svdTall_(T* bt, Nd4jLong m, Nd4jLong n, T* s, T* ut, bool fullU, T* vt) {
+    std::vector<T> tau;
+    std::vector<T> rt;
+
+    // tall matrices are reduced to square R first, so Jacobi rotations are n long instead of m long
+    if (m > n) {
+        tau.resize(n);
+        householderQR_<T>(bt, m, n, tau.data());
+
+        rt.resize(n * n, static_cast<T>(0.f));
+        for (Nd4jLong j = 0; j < n; j++)
+            std::copy(bt + j * m, bt + j * m + j + 1, rt.data() + j * n);
+    } else {
+        rt.assign(bt, bt + n * n);
+    }
+
+    std::vector<T> rotations;
+    if (vt != nullptr) {
+        rotations.resize(n * n, static_cast<T>(0.f));
+        for (Nd4jLong j = 0; j < n; j++)
+            rotations[j * n + j] = static_cast<T>(1.f);
+    }
+
+    oneSidedJacobi_<T>(rt.data(), n, n, vt != nullptr ? rotations.data() : nullptr);
+
+    std::vector<double> sigma(n);
+    std::vector<Nd4jLong> order(n);
+    for (Nd4jLong j = 0; j < n; j++) {
+        sigma[j] = nd4j::math::nd4j_sqrt<double, double>(dot_<T>(rt.data() + j * n, rt.data() + j * n, n));
+        order[j] = j;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](Nd4jLong a, Nd4jLong b) { return sigma[a] > sigma[b]; });
+
+    for (Nd4jLong j = 0; j < n; j++)
+        s[j] = static_cast<T>(sigma[order[j]]);
+
+    if (vt != nullptr)
+        for (Nd4jLong j = 0; j < n; j++)
+            std::copy(rotations.data() + order[j] * n, rotations.data() + (order[j] + 1) * n, vt + j * n);
+
+    if (ut == nullptr)
+        return;
+
+    // columns of R rotated by V are U * S
+    const auto numU = fullU ? m : n;
+    const auto threshold = sigma[order[0]] * svdEpsilon<T>() * n;
+    std::vector<bool> valid(numU, true);
+    std::fill(ut, ut + numU * m, static_cast<T>(0.f));
+
+    for (Nd4jLong j = 0; j < n; j++) {
+        auto u = ut + j * m;
+        auto r = rt.data() + order[j] * n;
+
+        if (sigma[order[j]] > threshold && sigma[order[j]] > 0.) {
+            for (Nd4jLong i = 0; i < n; i++)
+                u[i] = static_cast<T>(r[i] / sigma[order[j]]);
+        } else
+            valid[j] = false;
+    }
+
+    // rank deficient matrix: null space of R is filled with any orthonormal vectors of R space, columns past n are completed by Q below
+    completeBasis_<T>(ut, n, m, n, valid);
+
+    if (m > n) {
+        for (Nd4jLong j = n; j < numU; j++)
+            ut[j * m + j] = static_cast<T>(1.f);
+
+        applyHouseholderQ_<T>(bt, m, n, tau.data(), ut, numU);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// c-ordered contiguous version of given array, copy is made only if it's necessary
+static NDArray* contiguousSvdArray(NDArray* array, std::unique_ptr<NDArray>& holder) {
+    if (array->ordering() == 'c' && array->ews() == 1)
+        return array;
+
+    holder.reset(array->dup('c'));
+    return holder.get();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SVD of rows x cols matrix x (row-major) with one-sided Jacobi. s gets diagSize values,
+// u is rows x (fullUV ? rows : diagSize) and v is cols x (fullUV ? cols : diagSize), both row-major
+template <typename T>
+static void svdJacobi_(const T* x, Nd4jLong rows, Nd4jLong cols, T* s, T* u, T* v, bool fullUV) {
+    // tall matrix b with columns stored as rows: b = x if rows >= cols, otherwise b = x^T
+    const bool transposed = cols > rows;
+    const auto m = transposed ? cols : rows;
+    const auto n = transposed ? rows : cols;
+
+    std::vector<T> bt(m * n);
+    if (transposed)
+        std::copy(x, x + m * n, bt.data());
+    else
+        for (Nd4jLong i = 0; i < rows; i++)
+            for (Nd4jLong j = 0; j < cols; j++)
+                bt[j * m + i] = x[i * cols + j];
+
+    const bool calcUV = u != nullptr;
+    const auto numU = fullUV ? m : n;
+    std::vector<T> ut(calcUV ? numU * m : 0);
+    std::vector<T> vt(calcUV ? n * n : 0);
+
+    svdTall_<T>(bt.data(), m, n, s, calcUV ? ut.data() : nullptr, fullUV, calcUV ? vt.data() : nullptr);
+
+    if (!calcUV)
+        return;
+
+    // x = b^T = V_b * S * U_b^T if transposed
+    auto& left = transposed ? vt : ut;
+    auto& right = transposed ? ut : vt;
+    const auto numLeft = transposed ? n : numU;
+    const auto numRight = transposed ? numU : n;
+
+    for (Nd4jLong j = 0; j < numLeft; j++)
+        for (Nd4jLong i = 0; i < rows; i++)
+            u[i * numLeft + j] = left[j * rows + i];
+
+    for (Nd4jLong j = 0; j < numRight; j++)
+        for (Nd4jLong i = 0; i < cols; i++)
+            v[i * numRight + j] = right[j * cols + i];
+}
+
+//////////////////////////////////////////////////////////////////////////
+// top k singular triplets of rows x cols matrix x (row-major) with randomized range finder: x ~ Q * Q^T * x, Q has k + oversampling orthonormal columns.
+// u is rows x k, v is cols x k, both row-major
+template <typename T>
+static void svdRandomized_(const T* x, Nd4jLong rows, Nd4jLong cols, Nd4jLong k, T* s, T* u, T* v, nd4j::graph::RandomGenerator& rng, Nd4jLong seedOffset) {
+    const auto diagSize = nd4j::math::nd4j_min<Nd4jLong>(rows, cols);
+    const auto l = nd4j::math::nd4j_min<Nd4jLong>(k + SVD_OVERSAMPLING, diagSize);
+
+    // sketch is as large as matrix itself, so exact decomposition is cheaper
+    if (l == diagSize) {
+        std::vector<T> fullS(diagSize), fullU(u != nullptr ? rows * diagSize : 0), fullV(u != nullptr ? cols * diagSize : 0);
+        svdJacobi_<T>(x, rows, cols, fullS.data(), u != nullptr ? fullU.data() : nullptr, u != nullptr ? fullV.data() : nullptr, false);
+
+        std::copy(fullS.data(), fullS.data() + k, s);
+        if (u != nullptr) {
+            for (Nd4jLong i = 0; i < rows; i++)
+                std::copy(fullU.data() + i * diagSize, fullU.data() + i * diagSize + k, u + i * k);
+            for (Nd4jLong i = 0; i < cols; i++)
+                std::copy(fullV.data() + i * diagSize, fullV.data() + i * diagSize + k, v + i * k);
+        }
+        return;
+    }
+
+    // y = x * omega, omega is cols x l gaussian. All tall matrices below are stored columns-wise
+    std::vector<T> yt(l * rows), zt(l * cols), tauY(l), tauZ(l);
+    std::vector<T> omega(l * cols);
+    for (Nd4jLong e = 0; e < l * cols; e++) {
+        auto u1 = rng.relativeT<double>(seedOffset + 2 * e, DataTypeUtils::min<double>(), 1.);
+        auto u2 = rng.relativeT<double>(seedOffset + 2 * e + 1, 0., 1.);
+        omega[e] = static_cast<T>(nd4j::math::nd4j_sqrt<double, double>(-2. * nd4j::math::nd4j_log<double, double>(u1)) * nd4j::math::nd4j_cos<double, double>(2. * 3.14159265358979323846 * u2));
+    }
+
+    // x * b for b given columns-wise (cols long), result is columns-wise (rows long)
+    auto multiply = [&](const T* bt, T* ct) {
+        Executor::parallel_for(0, l, [&](Nd4jLong from, Nd4jLong to) {
+            for (Nd4jLong j = from; j < to; j++)
+                for (Nd4jLong i = 0; i < rows; i++)
+                    ct[j * rows + i] = static_cast<T>(dot_<T>(x + i * cols, bt + j * cols, cols));
+        });
+    };
+
+    // x^T * b for b given columns-wise (rows long), result is columns-wise (cols long)
+    auto multiplyTransposed = [&](const T* bt, T* ct) {
+        Executor::parallel_for(0, l, [&](Nd4jLong from, Nd4jLong to) {
+            for (Nd4jLong j = from; j < to; j++) {
+                auto c = ct + j * cols;
+                std::fill(c, c + cols, static_cast<T>(0.f));
+                for (Nd4jLong i = 0; i < rows; i++)
+                    axpy_<T>(c, x + i * cols, bt[j * rows + i], cols);
+            }
+        });
+    };
+
+    // explicit thin Q of columns-wise matrix with l columns of length len, in place
+    auto orthonormalize = [&](std::vector<T>& at, std::vector<T>& tau, Nd4jLong len) {
+        householderQR_<T>(at.data(), len, l, tau.data());
+        std::vector<T> qt(l * len, static_cast<T>(0.f));
+        for (Nd4jLong j = 0; j < l; j++)
+            qt[j * len + j] = static_cast<T>(1.f);
+
+        applyHouseholderQ_<T>(at.data(), len, l, tau.data(), qt.data(), l);
+        at.swap(qt);
+    };
+
+    multiply(omega.data(), yt.data());
+    orthonormalize(yt, tauY, rows);
+
+    // power iterations sharpen decay of spectrum, re-orthonormalization keeps small singular values from vanishing
+    for (int e = 0; e < SVD_POWER_ITERATIONS; e++) {
+        multiplyTransposed(yt.data(), zt.data());
+        orthonormalize(zt, tauZ, cols);
+        multiply(zt.data(), yt.data());
+        orthonormalize(yt, tauY, rows);
+    }
+
+    // c = x^T * q is cols x l, and x ~ q * c^T = (q * V_c) * S * U_c^T
+    multiplyTransposed(yt.data(), zt.data());
+
+    std::vector<T> sketchS(l), sketchU(u != nullptr ? l * cols : 0), sketchV(u != nullptr ? l * l : 0);
+    svdTall_<T>(zt.data(), cols, l, sketchS.data(), u != nullptr ? sketchU.data() : nullptr, false, u != nullptr ? sketchV.data() : nullptr);
+
+    std::copy(sketchS.data(), sketchS.data() + k, s);
+
+    if (u == nullptr)
+        return;
+
+    for (Nd4jLong j = 0; j < k; j++) {
+        // u[:, j] = q * V_c[:, j]
+        std::vector<T> column(rows, static_cast<T>(0.f));
+        for (Nd4jLong r = 0; r < l; r++)
+            axpy_<T>(column.data(), yt.data() + r * rows, sketchV[j * l + r], rows);
+
+        for (Nd4jLong i = 0; i < rows; i++)
+            u[i * k + j] = column[i];
+
+        for (Nd4jLong i = 0; i < cols; i++)
+            v[i * k + j] = sketchU[j * cols + i];
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 // svd operation, this function is not method of SVD class, it is standalone function
 template <typename T>
@@ -954,44 +1422,117 @@ static void svd_(const NDArray* x, const std::vector<NDArray*>& outArrs, const b
     auto u = outArrs[1];
     auto v = outArrs[2];
 
-    const int rank =  x->rankOf();    
-    const int sRank = rank - 1; 
+    const int rank =  x->rankOf();
+    const int sRank = rank - 1;
+    const Nd4jLong rows = x->sizeAt(-2);
+    const Nd4jLong cols = x->sizeAt(-1);
+    const Nd4jLong numMatrices = x->lengthOf() / (rows * cols);
 
-    auto listX = x->allTensorsAlongDimension({rank-2, rank-1});
-    auto listS = s->allTensorsAlongDimension({sRank-1});
-    ResultSet* listU(nullptr), *listV(nullptr);
-    
-    if(calcUV) {                
-        listU = u->allTensorsAlongDimension({rank-2, rank-1});
-        listV = v->allTensorsAlongDimension({rank-2, rank-1});
-    }
+    // small matrices are handled by two-sided Jacobi, matrices are processed in parallel
+    if (nd4j::math::nd4j_min<Nd4jLong>(rows, cols) < switchNum) {
+        auto listX = x->allTensorsAlongDimension({rank-2, rank-1});
+        auto listS = s->allTensorsAlongDimension({sRank-1});
+        ResultSet* listU(nullptr), *listV(nullptr);
 
-    for(int i = 0; i < listX->size(); ++i) {
-        
-        // NDArray<T> matrix(x->ordering(), {listX->at(i)->sizeAt(0), listX->at(i)->sizeAt(1)}, block.getContext());
-        // matrix.assign(listX->at(i));
-        helpers::SVD<T> svdObj(*(listX->at(i)), switchNum, calcUV, calcUV, fullUV);
-        listS->at(i)->assign(svdObj._s);
+        if(calcUV) {
+            listU = u->allTensorsAlongDimension({rank-2, rank-1});
+            listV = v->allTensorsAlongDimension({rank-2, rank-1});
+        }
+
+        Executor::parallel_for(0, listX->size(), [&](Nd4jLong from, Nd4jLong to) {
+            for (Nd4jLong i = from; i < to; ++i) {
+                helpers::SVD<T> svdObj(*(listX->at(i)), switchNum, calcUV, calcUV, fullUV);
+                listS->at(i)->assign(svdObj._s);
+
+                if(calcUV) {
+                    listU->at(i)->assign(svdObj._u);
+                    listV->at(i)->assign(svdObj._v);
+                }
+            }
+        });
+
+        delete listX;
+        delete listS;
 
         if(calcUV) {
-            listU->at(i)->assign(svdObj._u);
-            listV->at(i)->assign(svdObj._v);
-        }        
-    }
+            delete listU;
+            delete listV;
+        }
 
-    delete listX;
-    delete listS;
-    
-    if(calcUV) {
-        delete listU;
-        delete listV;
+        return;
     }
+
+    // large matrices: Householder QR + parallel one-sided Jacobi on raw buffers
+    const auto diagSize = nd4j::math::nd4j_min<Nd4jLong>(rows, cols);
+    const auto uCols = fullUV ? rows : diagSize;
+    const auto vCols = fullUV ? cols : diagSize;
+
+    std::unique_ptr<NDArray> xHolder, sHolder, uHolder, vHolder;
+    auto xBuffer = contiguousSvdArray(const_cast<NDArray*>(x), xHolder)->bufferAsT<T>();
+    auto sArray = contiguousSvdArray(s, sHolder);
+    auto uArray = calcUV ? contiguousSvdArray(u, uHolder) : nullptr;
+    auto vArray = calcUV ? contiguousSvdArray(v, vHolder) : nullptr;
+
+    auto sBuffer = sArray->bufferAsT<T>();
+    auto uBuffer = calcUV ? uArray->bufferAsT<T>() : nullptr;
+    auto vBuffer = calcUV ? vArray->bufferAsT<T>() : nullptr;
+
+    Executor::parallel_for(0, numMatrices, [&](Nd4jLong from, Nd4jLong to) {
+        for (Nd4jLong e = from; e < to; e++)
+            svdJacobi_<T>(xBuffer + e * rows * cols, rows, cols, sBuffer + e * diagSize, calcUV ? uBuffer + e * rows * uCols : nullptr, calcUV ? vBuffer + e * cols * vCols : nullptr, fullUV);
+    });
+
+    if (sArray != s)
+        s->assign(sArray);
+
+    if (calcUV && uArray != u)
+        u->assign(uArray);
+
+    if (calcUV && vArray != v)
+        v->assign(vArray);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void svdRandomized_(nd4j::graph::RandomGenerator& rng, const NDArray* x, const std::vector<NDArray*>& outArrs, const int k, const bool calcUV) {
+
+    const Nd4jLong rows = x->sizeAt(-2);
+    const Nd4jLong cols = x->sizeAt(-1);
+    const Nd4jLong numMatrices = x->lengthOf() / (rows * cols);
+
+    std::unique_ptr<NDArray> xHolder, sHolder, uHolder, vHolder;
+    auto xBuffer = contiguousSvdArray(const_cast<NDArray*>(x), xHolder)->bufferAsT<T>();
+    auto sArray = contiguousSvdArray(outArrs[0], sHolder);
+    auto uArray = calcUV ? contiguousSvdArray(outArrs[1], uHolder) : nullptr;
+    auto vArray = calcUV ? contiguousSvdArray(outArrs[2], vHolder) : nullptr;
+
+    auto sBuffer = sArray->bufferAsT<T>();
+    auto uBuffer = calcUV ? uArray->bufferAsT<T>() : nullptr;
+    auto vBuffer = calcUV ? vArray->bufferAsT<T>() : nullptr;
+
+    Executor::parallel_for(0, numMatrices, [&](Nd4jLong from, Nd4jLong to) {
+        for (Nd4jLong e = from; e < to; e++)
+            svdRandomized_<T>(xBuffer + e * rows * cols, rows, cols, k, sBuffer + e * k, calcUV ? uBuffer + e * rows * k : nullptr, calcUV ? vBuffer + e * cols * k : nullptr, rng, e * 2 * cols * (k + SVD_OVERSAMPLING));
+    });
+
+    if (sArray != outArrs[0])
+        outArrs[0]->assign(sArray);
+
+    if (calcUV && uArray != outArrs[1])
+        outArrs[1]->assign(uArray);
+
+    if (calcUV && vArray != outArrs[2])
+        outArrs[2]->assign(vArray);
 }
 
     void svd(nd4j::LaunchContext * context, const NDArray* x, const std::vector<NDArray*>& outArrs, const bool fullUV, const bool calcUV, const int switchNum) {
         BUILD_SINGLE_SELECTOR(x->dataType(), svd_, (x, outArrs, fullUV, calcUV, switchNum), FLOAT_TYPES);
     }
 
+    void svdRandomized(nd4j::LaunchContext * context, nd4j::graph::RandomGenerator& rng, const NDArray* x, const std::vector<NDArray*>& outArrs, const int k, const bool calcUV) {
+        BUILD_SINGLE_SELECTOR(x->dataType(), svdRandomized_, (rng, x, outArrs, k, calcUV), FLOAT_TYPES);
+    }
+
 
 }
 }
@@ -28,6 +28,10 @@
 #include <helpers/ConstantTadHelper.h>
 #include <Loops.h>
 #include <graph/RandomGenerator.h>
+#include <execution/Executor.h>
+#include <algorithm>
+#include <cstring>
+#include <set>
 
 namespace nd4j 	  {
 namespace ops 	  {
@@ -169,10 +173,90 @@ void randomShuffle_(NDArray& input, NDArray& output, nd4j::graph::RandomGenerato
     }
 
 
+//////////////////////////////////////////////////////////////////////////
+// row-wise padding of c-ordered contiguous arrays: interior of every output row is a contiguous copy of input row, borders are filled separately
+// mode: 0 - CONSTANT, 1 - REFLECT, 2 - SYMMETRIC
+template<typename T>
+static void padRows_(const int mode, const NDArray& input, const NDArray& paddings, NDArray& output, const T padVal) {
+
+    const T* x = input.bufferAsT<T>();
+          T* z = output.bufferAsT<T>();
+
+    const int rank = input.rankOf();
+    const int rankMinusOne = rank - 1;
+
+    std::vector<Nd4jLong> xShape(rank), zShape(rank), left(rank), xStrides(rank);
+    for(int j = 0; j < rank; ++j) {
+        xShape[j] = input.sizeAt(j);
+        zShape[j] = output.sizeAt(j);
+        left[j]   = xShape[j] == zShape[j] ? 0 : (paddings.rankOf() == 1 ? paddings.e<Nd4jLong>(2 * j) : paddings.e<Nd4jLong>(j, 0));
+    }
+    xStrides[rankMinusOne] = 1;
+    for(int j = rankMinusOne - 1; j >= 0; --j)
+        xStrides[j] = xStrides[j + 1] * xShape[j + 1];
+
+    const Nd4jLong shift1 = mode == 1 ? 0 : 1;         // REFLECT : SYMMETRIC
+    const Nd4jLong shift2 = mode == 1 ? 2 : 1;         // REFLECT : SYMMETRIC
+
+    const Nd4jLong xRowLen  = xShape[rankMinusOne];
+    const Nd4jLong zRowLen  = zShape[rankMinusOne];
+    const Nd4jLong rowLeft  = left[rankMinusOne];
+    const Nd4jLong rowRight = zRowLen - rowLeft - xRowLen;
+    const Nd4jLong numRows  = output.lengthOf() / zRowLen;
+
+    auto func = [&](Nd4jLong start, Nd4jLong stop) {
+        for(Nd4jLong r = start; r < stop; ++r) {
+
+            T* zRow = z + r * zRowLen;
+
+            // input row for this output row, or nothing if row lies in constant border
+            bool within = true;
+            Nd4jLong xOffset = 0;
+            for(Nd4jLong j = rankMinusOne - 1, idx = r; j >= 0; --j) {
+                Nd4jLong coord = idx % zShape[j] - left[j];
+                idx /= zShape[j];
+
+                if(coord < 0 || coord >= xShape[j]) {
+                    if(mode == 0) {within = false; break;}
+                    coord = coord < 0 ? -coord - shift1 : 2 * xShape[j] - coord - shift2;
+                }
+                xOffset += coord * xStrides[j];
+            }
+
+            if(!within) {
+                std::fill(zRow, zRow + zRowLen, padVal);
+                continue;
+            }
+
+            const T* xRow = x + xOffset;
+            memcpy(zRow + rowLeft, xRow, xRowLen * sizeof(T));
+
+            if(mode == 0) {
+                std::fill(zRow, zRow + rowLeft, padVal);
+                std::fill(zRow + rowLeft + xRowLen, zRow + zRowLen, padVal);
+            }
+            else {
+                for(Nd4jLong k = 0; k < rowLeft; ++k)                   // left side
+                    zRow[k] = xRow[rowLeft - k - shift1];
+
+                for(Nd4jLong k = 0; k < rowRight; ++k)                  // right side
+                    zRow[rowLeft + xRowLen + k] = xRow[xRowLen - k - shift2];
+            }
+        }
+    };
+
+    Executor::parallel_for(0, numRows, func, nd4j::math::nd4j_max<Nd4jLong>(1, 32768 / zRowLen));
+}
+
 //////////////////////////////////////////////////////////////////////////
 template<typename T>
 void pad_(const int mode, const NDArray& input, const NDArray& paddings, NDArray& output, const NDArray& padValue) {
 
+    if(input.rankOf() > 0 && input.ordering() == 'c' && output.ordering() == 'c' && input.ews() == 1 && output.ews() == 1 && !input.isEmpty() && output.lengthOf() > 0) {
+        padRows_<T>(mode, input, paddings, output, mode == 0 ? padValue.e<T>(0) : T(0));
+        return;
+    }
+
     const T* x = input.bufferAsT<T>();
           T* z = output.bufferAsT<T>();
 
@@ -1140,6 +1224,11 @@ template<typename T>
 static void mirrorPad_(const NDArray& input, const NDArray& paddings, NDArray& output, const int mode) {
 
     // mode:  0 - REFLECT, else - SYMMETRIC
+    if(input.rankOf() > 0 && input.ordering() == 'c' && output.ordering() == 'c' && input.ews() == 1 && output.ews() == 1 && !input.isEmpty() && output.lengthOf() > 0) {
+        padRows_<T>(mode == 0 ? 1 : 2, input, paddings, output, T(0));
+        return;
+    }
+
     const int reflBorder = (bool)mode ? 1 : 0;
     const int rank        = input.rankOf();
     const Nd4jLong outLen = output.lengthOf();
@@ -28,219 +28,128 @@ namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    /**
+     * Noise shape is aligned to trailing dimensions of input, every input coordinate is taken modulo noise dimension.
+     * Zero rank means that every input element makes its own decision
+     */
+    struct NoiseMap {
+        int rank = 0;
+        Nd4jLong inputShape[MAX_RANK];
+        Nd4jLong noiseShape[MAX_RANK];
+        Nd4jLong noiseStrides[MAX_RANK];
+    };
+
+    static NoiseMap noiseMap(NDArray* input, NDArray* reduceShape) {
+        NoiseMap map;
+        if (reduceShape == nullptr)
+            return map;
+
+        reduceShape->syncToHost(); // to ensure that follows are actual
+
+        const int rank = input->rankOf();
+        const int noiseRank = (int) reduceShape->lengthOf();
+        REQUIRE_TRUE(noiseRank <= rank, 0, "dropout: Noise shape should be fittable to input");
+
+        Nd4jLong noiseLength = 1;
+        for (int e = rank - 1; e >= 0; e--) {
+            map.inputShape[e] = input->sizeAt(e);
+
+            auto n = e - (rank - noiseRank);
+            map.noiseShape[e] = n >= 0 ? reduceShape->e<Nd4jLong>(n) : 1;
+
+            REQUIRE_TRUE(map.noiseShape[e] > 0 && map.inputShape[e] % map.noiseShape[e] == 0, 0, "dropout: Noise shape should fit to input rank.");
+
+            map.noiseStrides[e] = noiseLength;
+            noiseLength *= map.noiseShape[e];
+        }
+
+        if (noiseLength != input->lengthOf())
+            map.rank = rank;
+
+        return map;
+    }
+
+    /**
+     * Element is kept if random value of its index (or of its noise shape position) is below probValue * 2^32,
+     * so forward and backward passes with the same seed make the same decisions.
+     * z = kept ? multiplier * x + addend : dropped
+     */
     template <typename T>
-    static __global__ void dropoutSimpleKernel(void const* inputBuf, Nd4jLong const* inputShape, void* outputBuf, Nd4jLong* outputShape, double probVal, int inLen, nd4j::graph::RandomGenerator* nodeRng) {
+    static __global__ void dropoutKernel(void const* xBuf, Nd4jLong const* xShapeInfo, void* zBuf, Nd4jLong* zShapeInfo, Nd4jLong len, NoiseMap map, uint64_t threshold, double multiplier, double addend, double dropped, nd4j::graph::RandomGenerator* nodeRng) {
+        auto x = reinterpret_cast<T const*>(xBuf);
+        auto z = reinterpret_cast<T*>(zBuf);
+
         auto tid = blockIdx.x * blockDim.x + threadIdx.x;
         auto step = blockDim.x * gridDim.x;
-        T const* input = reinterpret_cast<T const*>(inputBuf);
-        T* output = reinterpret_cast<T*>(outputBuf);
 
-        // trivial idea: loop through all elements, get independent probability for each element to be nullified
-        for (Nd4jLong e = 0; e < inLen; ++e) {
-            T val = nodeRng->relativeT(e, T(0.f), T(1.f));
+        for (Nd4jLong e = tid; e < len; e += step) {
+            Nd4jLong position = e;
+            if (map.rank > 0) {
+                position = 0;
+                auto index = e;
+                for (int d = map.rank - 1; d >= 0; d--) {
+                    position += (index % map.inputShape[d]) % map.noiseShape[d] * map.noiseStrides[d];
+                    index /= map.inputShape[d];
+                }
+            }
 
-            // if probability is ok - we're saving scaled value
-            if (double(val) < probVal)
-                output[shape::getIndexOffset(e, outputShape)] = T(input[shape::getIndexOffset(e, inputShape)] / probVal);
+            const bool kept = nodeRng->relativeT<uint32_t>(position) < threshold;
+            const auto xVal = x[shape::getIndexOffset(e, xShapeInfo)];
+            z[shape::getIndexOffset(e, zShapeInfo)] = kept ? T(multiplier * (double) xVal + addend) : T(dropped);
         }
     }
 
     template <typename T>
-    static void dropoutSimple(nd4j::LaunchContext* context, NDArray const* input, NDArray* output, double probValue, int seed) {
-        nd4j::graph::RandomGenerator nodeRng(3019L, seed);
-        int inLen = input->lengthOf();
-        nd4j::graph::RandomGenerator* dRandom;
+    static void applyMask(nd4j::LaunchContext* context, const NoiseMap& map, NDArray* source, NDArray* output, int seed, double probValue, double multiplier, double addend, double dropped) {
+        nd4j::graph::RandomGenerator nodeRng(3019L, seed), *dRandom;
         auto stream = context->getCudaStream();
-        NDArray::prepareSpecialUse({output}, {input});
+        NDArray::prepareSpecialUse({output}, {source});
 
         auto err = cudaMalloc(&dRandom, sizeof(nd4j::graph::RandomGenerator));
         if (err) {
-            throw cuda_exception::build("helpers::dropoutSimple: Cannot allocate device memory for random generator.", err);
+            throw cuda_exception::build("helpers::dropout: Cannot allocate device memory for random generator.", err);
         }
         err = cudaMemcpy(dRandom, &nodeRng, sizeof(nd4j::graph::RandomGenerator), cudaMemcpyHostToDevice);
         if (err) {
-            throw cuda_exception::build("helpers::dropoutSimple: Cannot set up device memory for random generator.", err);
+            throw cuda_exception::build("helpers::dropout: Cannot set up device memory for random generator.", err);
         }
 
-        dropoutSimpleKernel<T><<<128, 256, 1024, *stream>>>(input->getSpecialBuffer(), input->getSpecialShapeInfo(), output->specialBuffer(), output->specialShapeInfo(), probValue, inLen, dRandom);
+        const auto threshold = static_cast<uint64_t>(probValue * 4294967296.0);
+        dropoutKernel<T><<<128, 256, 1024, *stream>>>(source->getSpecialBuffer(), source->getSpecialShapeInfo(), output->specialBuffer(), output->specialShapeInfo(), output->lengthOf(), map, threshold, multiplier, addend, dropped, dRandom);
+
         err = cudaFree(dRandom);
         if (err) {
-            throw cuda_exception::build("helpers::dropoutSimple: Cannot deallocate device memory for random generator.", err);
+            throw cuda_exception::build("helpers::dropout: Cannot deallocate device memory for random generator.", err);
         }
-        NDArray::registerSpecialUse({output}, {input});
+        NDArray::registerSpecialUse({output}, {source});
     }
 
     template <typename T>
-    int _dropOutFunctor(graph::Context& context, NDArray* input, NDArray* output, NDArray* reduceShape, int seed, double probValue) {
-
-        if (reduceShape == nullptr){
-            dropoutSimple<T>(context.launchContext(), input, output, probValue, seed);
-        }
-        else {
-            REQUIRE_TRUE(reduceShape->lengthOf() <= input->rankOf(), 0, "dropout: Noise shape should be fittable to input");
-
-            std::vector<Nd4jLong> dims(reduceShape->lengthOf());
-            reduceShape->syncToHost(); // to ensure that follows are actual
-            bool fit = true;
-
-            for( int i = 0; i < dims.size(); i++ ) {
-                if (fit) {
-                    dims[i] = reduceShape->e<Nd4jLong>(i);
-                    for (int e = 0; e < input->rankOf(); ++e)
-                        if (fit)
-                            if (input->sizeAt(e) % dims[i]) {
-                                fit = false;
-                            }
-                }
-            }
-
-            // check dims to fit input
-            REQUIRE_TRUE(fit, 0, "dropout: Noise shape should fit to input rank.");
-            std::unique_ptr<NDArray> chunk(new NDArray('c', dims, output->dataType(), context.launchContext()));
-            chunk->assign(1.f);
-
-            dropoutSimple<T>(context.launchContext(), chunk.get(), chunk.get(), probValue, seed);
-            // broadcast chunk to full matrix
-            std::unique_ptr<NDArray> dropOutMultiplier(new NDArray(*input));
-            dropOutMultiplier->assign(1.f);
-
-            *dropOutMultiplier += *chunk;
-
-            // FIXME: we could do this in one step, aren't we?
-            output->assign(*input * *dropOutMultiplier); //input->applyPairwiseTransform(pairwise::Multiply, dropOutMultiplier.get(), output, nullptr);
-        }
+    static int dropOutFunctor_(graph::Context& context, NDArray* input, NDArray* output, NDArray* reduceShape, int seed, double probValue) {
+        applyMask<T>(context.launchContext(), noiseMap(input, reduceShape), input, output, seed, probValue, 1. / probValue, 0., 0.);
 
         return Status::OK();
     }
 
     int dropOutFunctor(graph::Context& context, NDArray* input, NDArray* output, NDArray* reduceShape, int seed, double probValue) {
         auto xType = input->dataType();
-        NDArray::prepareSpecialUse({output}, {input});
-
-        BUILD_SINGLE_SELECTOR(xType, return _dropOutFunctor, (context, input, output, reduceShape, seed, probValue), FLOAT_TYPES);
 
-        NDArray::registerSpecialUse({output}, {input});
+        BUILD_SINGLE_SELECTOR(xType, return dropOutFunctor_, (context, input, output, reduceShape, seed, probValue), FLOAT_TYPES);
     }
 
 /////////////////////////////////// backrpopagations ///////////////////////////////////////////////
-    template <typename T>
-    static __global__ void dropoutBPKernel(void* outputBuf, Nd4jLong* outputShape, void* gradOutBuf, Nd4jLong* gradOutShape, double probValue) {
-        __shared__ T* output;
-        __shared__ T* input;
-        __shared__ int len;
-
-        if (threadIdx.x == 0) {
-            len = shape::length(outputShape);
-            output = reinterpret_cast<T*>(outputBuf);
-            input = reinterpret_cast<T*>(gradOutBuf);
-        }
-        __syncthreads();
-
-        auto tid = blockIdx.x * blockDim.x + threadIdx.x;
-        auto step = blockDim.x * gridDim.x;
-
-        for (int e = tid; e < len; e += step) {
-            const auto zOffset = shape::getIndexOffset(e, outputShape);
-
-            // if probability was non-zero on FF step, we'll scale grads back
-            if (output[zOffset] != T(0.))
-                output[zOffset] = T(input[shape::getIndexOffset(e, gradOutShape)] / probValue);
-
-        }
-    }
     template <typename T>
     static int dropOutFunctorBP_(graph::Context& context, NDArray* input, NDArray* gradOut, NDArray* output, NDArray* reduceShape, int seed, double probValue) {
-        // we're making additional FF run to see how probabilities played out with given seeds
-        int res = dropOutFunctor(context, input, output, reduceShape, seed, probValue);
-        auto stream = context.launchContext()->getCudaStream();
-
-        NDArray::prepareSpecialUse({output}, {input, gradOut});
-
-        if (ND4J_STATUS_OK == res)
-            dropoutBPKernel<T><<<128, 256, 1024, *stream>>>(output->specialBuffer(), output->specialShapeInfo(), gradOut->specialBuffer(), gradOut->specialShapeInfo(), probValue);
-
-        NDArray::registerSpecialUse({output}, {input, gradOut});
-
-        return res;
-    }
+        // mask is regenerated from the same seed, gradient passes where forward value passed
+        applyMask<T>(context.launchContext(), noiseMap(input, reduceShape), gradOut, output, seed, probValue, 1. / probValue, 0., 0.);
 
-    template <typename T>
-    static __global__ void alphaDropoutSimpleKernel(void const* inputBuf, Nd4jLong const* inputShape, void* outputBuf, Nd4jLong* outputShape, double probValue, double alpha, double alpha1, double beta, int inLen, nd4j::graph::RandomGenerator* nodeRng) {
-        auto tid = blockIdx.x * blockDim.x + threadIdx.x;
-        auto step = blockDim.x * gridDim.x;
-        T const* input = reinterpret_cast<T const*>(inputBuf);
-        T* output = reinterpret_cast<T*>(outputBuf);
-
-        for (auto e = tid; e < inLen; e += step) {
-            T val = nodeRng->relativeT(e, T(0.f), T(1.f));
-            T xVal = input[shape::getIndexOffset(e, inputShape)];
-            output[shape::getIndexOffset(e, outputShape)] = (val >= T(probValue) ? T(alpha * beta + alpha1) : T(alpha * (double)xVal + alpha1));
-        }
-    }
-    template <typename T>
-    static void alphaDropoutSimple(nd4j::LaunchContext* context, NDArray const* input, NDArray* output, int seed, double probValue, double alpha, double alpha1, double beta) {
-        nd4j::graph::RandomGenerator nodeRng(3019L, seed), *dRandom;
-        auto stream = context->getCudaStream();
-        auto err = cudaMalloc(&dRandom, sizeof(nd4j::graph::RandomGenerator));
-        NDArray::prepareSpecialUse({output}, {input});
-        if (err) {
-            throw cuda_exception::build("helpers::alphaDropoutSimple: Cannot allocate device memory for random generator.", err);
-        }
-        err = cudaMemcpy(dRandom, &nodeRng, sizeof(nd4j::graph::RandomGenerator), cudaMemcpyHostToDevice);
-        if (err) {
-            throw cuda_exception::build("helpers::alphaDropoutSimple: Cannot set up device memory for random generator.", err);
-        }
-
-        alphaDropoutSimpleKernel<T><<<128, 256, 1024, *stream>>>(input->getSpecialBuffer(), input->getSpecialShapeInfo(), output->specialBuffer(), output->specialShapeInfo(), probValue, alpha, alpha1, beta, output->lengthOf(), dRandom);
-
-        err = cudaFree(dRandom);
-        if (err) {
-            throw cuda_exception::build("helpers::alphaDropoutSimple: Cannot deallocate device memory for random generator.", err);
-        }
-        NDArray::registerSpecialUse({output}, {input});
+        return Status::OK();
     }
 
     template <typename T>
     static int alphaDropOutFunctor_(graph::Context& context, NDArray* input, NDArray* output,
                             NDArray* reduceShape, int seed, double probValue, double alpha, double alpha1, double beta) {
-
-        if (reduceShape == nullptr){
-            alphaDropoutSimple<T>(context.launchContext(), input, output, seed, probValue, alpha, alpha1, beta);
-        }
-        else {
-            REQUIRE_TRUE(reduceShape->lengthOf() <= input->rankOf(), 0, "dropout: Noise shape should be fittable to input");
-
-            std::vector<Nd4jLong> dims(reduceShape->lengthOf());
-            reduceShape->syncToHost(); // to ensure that follows are actual
-            bool fit = true;
-
-            for( int i = 0; i < dims.size(); i++ ) {
-                if (fit) {
-                    dims[i] = reduceShape->e<Nd4jLong>(i);
-                    for (int e = 0; e < input->rankOf(); ++e)
-                        if (fit)
-                            if (input->sizeAt(e) % dims[i]) {
-                                fit = false;
-                            }
-                }
-            }
-
-            // check dims to fit input
-            REQUIRE_TRUE(fit, 0, "alpha_dropout: Noise shape should fit to input rank.");
-            std::unique_ptr<NDArray> chunk(new NDArray('c', dims, output->dataType(), context.launchContext()));
-            chunk->assign(1.f);
-
-            alphaDropoutSimple<T>(context.launchContext(), chunk.get(), chunk.get(), seed, probValue, alpha, alpha1, beta);
-
-            // broadcast chunk to full matrix
-            std::unique_ptr<NDArray> dropOutMultiplier(new NDArray(*input));
-            dropOutMultiplier->assign(1.f);
-
-            *dropOutMultiplier += *chunk;
-
-            output->assign(*input * *dropOutMultiplier); //input->applyPairwiseTransform(pairwise::Multiply, dropOutMultiplier.get(), output, nullptr);
-        }
-
+        applyMask<T>(context.launchContext(), noiseMap(input, reduceShape), input, output, seed, probValue, alpha, alpha1, alpha * beta + alpha1);
 
         return Status::OK();
     }
@@ -248,14 +157,10 @@ namespace helpers {
     template <typename T>
     int alphaDropOutFunctorBP_(graph::Context& context, NDArray* input, NDArray* gradOut, NDArray* output,
                               NDArray* reduceShape, int seed, double probValue, double alpha, double alpha1, double beta) {
+        // dropped elements are constant, kept ones are alpha * x + alpha'
+        applyMask<T>(context.launchContext(), noiseMap(input, reduceShape), gradOut, output, seed, probValue, alpha, 0., 0.);
 
-        int res = alphaDropOutFunctor(context, input, output, reduceShape, seed, probValue, alpha, alpha1, beta);
-        if (res == ND4J_STATUS_OK) {
-            // FIXME: can we make it single-loop?
-            (*output) *= alpha;
-            (*output) *= (*gradOut); //->applyPairwiseTransform<transform::Multiply>(gradOut, output, nullptr);
-        }
-        return res;
+        return Status::OK();
     }
 
     int dropOutFunctorBP(graph::Context& context, NDArray* input, NDArray* gradOut, NDArray* output, NDArray* reduceShape, int seed, double probValue) {
@@ -272,4 +177,4 @@ namespace helpers {
 
 }
 }
-}
\ No newline at end of file
+}
@@ -20,6 +20,7 @@
 
 #include <ops/declarable/helpers/histogram.h>
 #include <NDArrayFactory.h>
+#include <memory>
 
 namespace nd4j {
     namespace ops {
@@ -121,7 +122,7 @@ namespace nd4j {
 
             void histogramHelper(nd4j::LaunchContext *context, NDArray &input, NDArray &output) {
                 Nd4jLong numBins = output.lengthOf();
-                NDArray::registerSpecialUse({&output}, {&input});
+                NDArray::prepareSpecialUse({&output}, {&input});
 
                 auto min_val = input.reduceNumber(reduce::SameOps::Min);
                 auto max_val = input.reduceNumber(reduce::SameOps::Max);
@@ -130,6 +131,22 @@ namespace nd4j {
                 BUILD_DOUBLE_SELECTOR(input.dataType(), output.dataType(), histogram_, (context, input.specialBuffer(), input.shapeInfo(), input.specialShapeInfo(), output.getSpecialBuffer(), output.getSpecialShapeInfo(), numBins, min_val.specialBuffer(), max_val.specialBuffer()), LIBND4J_TYPES, INTEGER_TYPES);
                 NDArray::registerSpecialUse({&output}, {&input});
             }
+
+            void histogramHelper(nd4j::LaunchContext *context, NDArray &input, NDArray &output, const std::vector<int> &dimensions) {
+                std::unique_ptr<ResultSet> inputTads(input.allTensorsAlongDimension(dimensions));
+                std::unique_ptr<ResultSet> outputRows(output.allTensorsAlongDimension({output.rankOf() - 1}));
+
+                // kernel reads input and writes bins linearly, while TADs and output rows are strided views in general
+                NDArray row('c', {output.sizeAt(-1)}, output.dataType(), context);
+
+                for (int e = 0; e < inputTads->size(); e++) {
+                    std::unique_ptr<NDArray> tad(inputTads->at(e)->dup('c'));
+
+                    row.nullify();
+                    histogramHelper(context, *tad, row);
+                    outputRows->at(e)->assign(row);
+                }
+            }
         }
     }
 }
\ No newline at end of file
@@ -730,6 +730,18 @@ namespace nd4j {
                 NDArray::registerSpecialUse({&syn0, &syn1, &syn1Neg, &expTable, &negTable, &target, &ngStarter}, {&context, &lockedWords, &indices, &codes, &alpha, &randomValue, &numLabels, &inferenceVector});
             }
 
+
+            // minibatch mode is cpu-only optimization, here we fall back to regular batched execution
+            void skipgramMinibatch(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &target, NDArray &ngStarter, int nsRounds, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, const int minibatch, const int numWorkers) {
+                auto inferenceVector = NDArrayFactory::empty(syn0.dataType(), syn0.getContext());
+                skipgram(syn0, syn1, syn1Neg, expTable, negTable, target, ngStarter, nsRounds, indices, codes, alpha, randomValue, inferenceVector, false, numWorkers);
+            }
+
+            void cbowMinibatch(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &ngStarter, int nsRounds, NDArray &context, NDArray &lockedWords, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, NDArray &numLabels, const bool trainWords, const int minibatch, const int numWorkers) {
+                auto target = NDArrayFactory::empty(nd4j::DataType::INT32, syn0.getContext());
+                auto inferenceVector = NDArrayFactory::empty(syn0.dataType(), syn0.getContext());
+                cbow(syn0, syn1, syn1Neg, expTable, negTable, target, ngStarter, nsRounds, context, lockedWords, indices, codes, alpha, randomValue, numLabels, inferenceVector, trainWords, numWorkers);
+            }
         }
     }
-}
\ No newline at end of file
+}
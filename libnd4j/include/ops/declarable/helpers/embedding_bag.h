@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Fused embedding bag: lookup and per-bag combine in one pass over table rows
+//
+
+#ifndef LIBND4J_EMBEDDING_BAG_H
+#define LIBND4J_EMBEDDING_BAG_H
+
+#include <op_boilerplate.h>
+#include <NDArray.h>
+#include <vector>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    // combine modes of embedding_bag, passed as integer argument
+    enum EmbeddingBagMode {
+        EMBEDDING_BAG_SUM = 0,
+        EMBEDDING_BAG_MEAN = 1,
+        EMBEDDING_BAG_SQRTN = 2,
+    };
+
+    /**
+     * This method computes output[b] = sum(w[p] * table[ids[p]]) / norm(b) for all p within [bounds[b], bounds[b + 1]).
+     * norm(b) is 1 for SUM, sum of weights for MEAN and sqrt of sum of squared weights for SQRTN. Bags with zero norm give zeros
+     *
+     * @param table - [V, D] matrix
+     * @param ids - ids of any shape, addressed as flat array
+     * @param bounds - B + 1 positions within ids, each bag occupies [bounds[b], bounds[b + 1])
+     * @param weights - optional per-id weights of the same shape as ids and data type as table, nullptr means all ones
+     * @param output - [B, D] matrix
+     */
+    void embeddingBag(nd4j::LaunchContext *context, const NDArray &table, const NDArray &ids, const std::vector<Nd4jLong> &bounds, const NDArray *weights, int mode, NDArray &output);
+
+    /**
+     * This method returns number of distinct ids
+     */
+    Nd4jLong embeddingBagUniqueCount(const NDArray &ids);
+
+    /**
+     * Backprop of embeddingBag. Gradient of table is sparse: repeated ids are merged,
+     * so uniqueIds gets each id once in order of first appearance and gradRows gets summed gradient row for it.
+     *
+     * @param gradO - [B, D] gradient of output
+     * @param uniqueIds - INT64 vector of embeddingBagUniqueCount(ids) elements
+     * @param gradRows - [U, D] matrix
+     * @param gradW - gradient of weights, required only if weights are given
+     */
+    void embeddingBagBp(nd4j::LaunchContext *context, const NDArray &table, const NDArray &ids, const std::vector<Nd4jLong> &bounds, const NDArray *weights, const NDArray &gradO, int mode, NDArray &uniqueIds, NDArray &gradRows, NDArray *gradW);
+
+}
+}
+}
+
+#endif //LIBND4J_EMBEDDING_BAG_H
@@ -0,0 +1,43 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Fused kernel behind fused_elementwise op
+//
+
+#ifndef LIBND4J_FUSED_ELEMENTWISE_H
+#define LIBND4J_FUSED_ELEMENTWISE_H
+
+#include <op_boilerplate.h>
+#include <NDArray.h>
+#include <vector>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    /**
+     * This method applies fused_elementwise program (4 integers per step) to inputs[0] in one pass over memory.
+     * Returns FALSE without touching output if arrays can't be handled by fused kernel: non-float or mixed data types, or non-contiguous layout
+     */
+    bool fusedElementwise(nd4j::LaunchContext *context, const std::vector<NDArray*> &inputs, const std::vector<int> &program, const std::vector<double> &tArgs, NDArray &output);
+
+}
+}
+}
+
+#endif //LIBND4J_FUSED_ELEMENTWISE_H
@@ -22,11 +22,18 @@
 #define LIBND4J_HISTOGRAM_H
 
 #include <NDArray.h>
+#include <vector>
 
 namespace nd4j {
     namespace ops {
         namespace helpers {
             void histogramHelper(nd4j::LaunchContext *context, NDArray &input, NDArray &output);
+
+            /**
+             * This method computes histogram of every TAD along dimensions, with bins between min and max of that TAD.
+             * Output has shape of input without dimensions, plus trailing numBins dimension
+             */
+            void histogramHelper(nd4j::LaunchContext *context, NDArray &input, NDArray &output, const std::vector<int> &dimensions);
         }
     }
 }
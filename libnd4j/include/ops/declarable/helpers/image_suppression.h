@@ -28,6 +28,13 @@ namespace helpers {
 
     void nonMaxSuppressionV2(nd4j::LaunchContext * context, NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output);
 
+    /**
+     * Batched per-class non max suppression: boxes [batch, numBoxes, q, 4] with q == 1 (boxes shared by classes) or q == numClasses,
+     * scores [batch, numBoxes, numClasses]. Up to maxPerClass boxes are selected per class, then top maxTotal detections per image are returned
+     */
+    void combinedNonMaxSuppression(nd4j::LaunchContext * context, NDArray* boxes, NDArray* scores, int maxPerClass, int maxTotal, double threshold, double scoreThreshold, bool clip,
+                                   NDArray* outBoxes, NDArray* outScores, NDArray* outClasses, NDArray* validDetections);
+
 }
 }
 }
@@ -0,0 +1,316 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Fused embedding bag: lookup and per-bag combine in one pass over table rows
+//
+
+#include <ops/declarable/helpers/embedding_bag.h>
+#include <execution/Executor.h>
+#include <templatemath.h>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    // rows are read in random order, so next row is requested from memory while current one is accumulated
+    template <typename T>
+    static inline void prefetchRow(const T *row, Nd4jLong length) {
+#if defined(__GNUC__) || defined(__clang__)
+        auto bytes = reinterpret_cast<const char*>(row);
+        const auto size = length * (Nd4jLong) sizeof(T);
+        for (Nd4jLong b = 0; b < size; b += 64)
+            __builtin_prefetch(bytes + b);
+#endif
+    }
+
+    // returns array itself if it's contiguous, or c-ordered copy of it stored in holder
+    static const NDArray* contiguous(const NDArray &array, std::unique_ptr<NDArray> &holder) {
+        if (array.ordering() == 'c' && array.ews() == 1)
+            return &array;
+
+        holder.reset(array.dup('c'));
+        holder->syncToHost();
+        return holder.get();
+    }
+
+    static std::vector<Nd4jLong> flatIds(const NDArray &ids) {
+        std::vector<Nd4jLong> result(ids.lengthOf());
+
+        if (ids.dataType() == nd4j::DataType::INT64 && ids.ordering() == 'c' && ids.ews() == 1) {
+            auto buffer = ids.bufferAsT<Nd4jLong>();
+            std::copy(buffer, buffer + result.size(), result.begin());
+        } else {
+            for (Nd4jLong e = 0; e < ids.lengthOf(); e++)
+                result[e] = ids.e<Nd4jLong>(e);
+        }
+
+        return result;
+    }
+
+    // sum of weights for MEAN, sqrt of sum of squared weights for SQRTN
+    template <typename T>
+    static T bagNorm(const T *weights, Nd4jLong first, Nd4jLong last, int mode) {
+        if (mode == EMBEDDING_BAG_SUM)
+            return static_cast<T>(1.f);
+
+        if (weights == nullptr)
+            return mode == EMBEDDING_BAG_MEAN ? static_cast<T>(last - first) : nd4j::math::nd4j_sqrt<T, T>(static_cast<T>(last - first));
+
+        T norm = static_cast<T>(0.f);
+        for (Nd4jLong p = first; p < last; p++)
+            norm += mode == EMBEDDING_BAG_MEAN ? weights[p] : weights[p] * weights[p];
+
+        return mode == EMBEDDING_BAG_MEAN ? norm : nd4j::math::nd4j_sqrt<T, T>(norm);
+    }
+
+    template <typename T>
+    static void embeddingBag_(const NDArray &table, const std::vector<Nd4jLong> &ids, const std::vector<Nd4jLong> &bounds, const NDArray *weights, int mode, NDArray &output) {
+        const auto rowLength = table.sizeAt(1);
+        const auto t = table.bufferAsT<T>();
+        const auto w = weights == nullptr ? nullptr : weights->bufferAsT<T>();
+        auto z = output.bufferAsT<T>();
+
+        auto func = [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong b = start; b < stop; b++) {
+                auto row = z + b * rowLength;
+                std::fill(row, row + rowLength, static_cast<T>(0.f));
+
+                const auto first = bounds[b];
+                const auto last = bounds[b + 1];
+
+                for (Nd4jLong p = first; p < last; p++) {
+                    if (p + 1 < last)
+                        prefetchRow(t + ids[p + 1] * rowLength, rowLength);
+
+                    const auto source = t + ids[p] * rowLength;
+                    const auto weight = w == nullptr ? static_cast<T>(1.f) : w[p];
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < rowLength; e++)
+                        row[e] += weight * source[e];
+                }
+
+                if (mode == EMBEDDING_BAG_SUM)
+                    continue;
+
+                const auto norm = bagNorm(w, first, last, mode);
+                const auto factor = norm == static_cast<T>(0.f) ? static_cast<T>(0.f) : static_cast<T>(1.f) / norm;
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < rowLength; e++)
+                    row[e] *= factor;
+            }
+        };
+
+        Executor::parallel_for(0, (Nd4jLong) bounds.size() - 1, func);
+    }
+
+    void embeddingBag(nd4j::LaunchContext *context, const NDArray &table, const NDArray &ids, const std::vector<Nd4jLong> &bounds, const NDArray *weights, int mode, NDArray &output) {
+        NDArray::preparePrimaryUse({&output}, {&table, &ids, weights});
+
+        std::unique_ptr<NDArray> tableHolder, weightsHolder;
+        auto t = contiguous(table, tableHolder);
+        auto w = weights == nullptr ? nullptr : contiguous(*weights, weightsHolder);
+        auto flat = flatIds(ids);
+
+        if (output.ordering() == 'c' && output.ews() == 1) {
+            BUILD_SINGLE_SELECTOR(output.dataType(), embeddingBag_, (*t, flat, bounds, w, mode, output), FLOAT_TYPES);
+        } else {
+            NDArray result('c', output.getShapeAsVector(), output.dataType(), context);
+            NDArray::preparePrimaryUse({&result}, {});
+            BUILD_SINGLE_SELECTOR(output.dataType(), embeddingBag_, (*t, flat, bounds, w, mode, result), FLOAT_TYPES);
+            NDArray::registerPrimaryUse({&result}, {});
+            output.assign(result);
+        }
+
+        NDArray::registerPrimaryUse({&output}, {&table, &ids, weights});
+    }
+
+    // maps every position of ids to index of its id within unique ids, unique ids go in order of first appearance
+    static std::vector<Nd4jLong> uniqueSlots(const std::vector<Nd4jLong> &ids, std::vector<Nd4jLong> &unique) {
+        std::unordered_map<Nd4jLong, Nd4jLong> slots;
+        slots.reserve(ids.size());
+
+        std::vector<Nd4jLong> result(ids.size());
+        for (size_t p = 0; p < ids.size(); p++) {
+            auto it = slots.emplace(ids[p], (Nd4jLong) unique.size());
+            if (it.second)
+                unique.emplace_back(ids[p]);
+
+            result[p] = it.first->second;
+        }
+
+        return result;
+    }
+
+    Nd4jLong embeddingBagUniqueCount(const NDArray &ids) {
+        NDArray::preparePrimaryUse({}, {&ids});
+
+        std::vector<Nd4jLong> unique;
+        uniqueSlots(flatIds(ids), unique);
+        return (Nd4jLong) unique.size();
+    }
+
+    template <typename T>
+    static void embeddingBagBp_(const NDArray &table, const std::vector<Nd4jLong> &ids, const std::vector<Nd4jLong> &bounds, const NDArray *weights, const NDArray &gradO, int mode, NDArray &gradRows, void *vgradW) {
+        const auto rowLength = table.sizeAt(1);
+        const auto numBags = (Nd4jLong) bounds.size() - 1;
+        const auto numIds = (Nd4jLong) ids.size();
+        const auto t = table.bufferAsT<T>();
+        const auto w = weights == nullptr ? nullptr : weights->bufferAsT<T>();
+        const auto g = gradO.bufferAsT<T>();
+        auto z = gradRows.bufferAsT<T>();
+        auto gradW = reinterpret_cast<T*>(vgradW);
+
+        std::vector<Nd4jLong> unique;
+        auto slots = uniqueSlots(ids, unique);
+        const auto numUnique = (Nd4jLong) unique.size();
+
+        // bag of every position and inverse norm of every bag
+        std::vector<Nd4jLong> bagOf(numIds);
+        std::vector<T> factors(numBags);
+        auto funcBags = [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong b = start; b < stop; b++) {
+                std::fill(bagOf.begin() + bounds[b], bagOf.begin() + bounds[b + 1], b);
+                const auto norm = bagNorm(w, bounds[b], bounds[b + 1], mode);
+                factors[b] = norm == static_cast<T>(0.f) ? static_cast<T>(0.f) : static_cast<T>(1.f) / norm;
+            }
+        };
+        Executor::parallel_for(0, numBags, funcBags);
+
+        // positions grouped by unique id, so every gradient row is owned by one thread and summed in fixed order
+        std::vector<Nd4jLong> starts(numUnique + 1, 0);
+        for (Nd4jLong p = 0; p < numIds; p++)
+            starts[slots[p] + 1]++;
+
+        for (Nd4jLong u = 0; u < numUnique; u++)
+            starts[u + 1] += starts[u];
+
+        std::vector<Nd4jLong> positions(numIds);
+        std::vector<Nd4jLong> fill(starts.begin(), starts.end() - 1);
+        for (Nd4jLong p = 0; p < numIds; p++)
+            positions[fill[slots[p]]++] = p;
+
+        auto funcRows = [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong u = start; u < stop; u++) {
+                auto row = z + u * rowLength;
+                std::fill(row, row + rowLength, static_cast<T>(0.f));
+
+                for (Nd4jLong i = starts[u]; i < starts[u + 1]; i++) {
+                    const auto p = positions[i];
+                    if (i + 1 < starts[u + 1])
+                        prefetchRow(g + bagOf[positions[i + 1]] * rowLength, rowLength);
+
+                    const auto source = g + bagOf[p] * rowLength;
+                    const auto factor = factors[bagOf[p]] * (w == nullptr ? static_cast<T>(1.f) : w[p]);
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < rowLength; e++)
+                        row[e] += factor * source[e];
+                }
+            }
+        };
+        Executor::parallel_for(0, numUnique, funcRows);
+
+        if (gradW == nullptr)
+            return;
+
+        // d(out)/d(w[p]) is table row of p minus its share of normalization, which is the same dot product for whole bag
+        auto funcWeights = [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong b = start; b < stop; b++) {
+                const auto first = bounds[b];
+                const auto last = bounds[b + 1];
+                const auto gradient = g + b * rowLength;
+
+                T total = static_cast<T>(0.f);
+                for (Nd4jLong p = first; p < last; p++) {
+                    if (p + 1 < last)
+                        prefetchRow(t + ids[p + 1] * rowLength, rowLength);
+
+                    const auto source = t + ids[p] * rowLength;
+                    T dot = static_cast<T>(0.f);
+
+                    PRAGMA_OMP_SIMD_SUM(dot)
+                    for (Nd4jLong e = 0; e < rowLength; e++)
+                        dot += gradient[e] * source[e];
+
+                    gradW[p] = dot;
+                    total += w[p] * dot;
+                }
+
+                const auto factor = factors[b];
+                for (Nd4jLong p = first; p < last; p++) {
+                    if (mode == EMBEDDING_BAG_MEAN)
+                        gradW[p] = (gradW[p] - total * factor) * factor;
+                    else if (mode == EMBEDDING_BAG_SQRTN)
+                        gradW[p] = (gradW[p] - total * w[p] * factor * factor) * factor;
+                }
+            }
+        };
+        Executor::parallel_for(0, numBags, funcWeights);
+    }
+
+    void embeddingBagBp(nd4j::LaunchContext *context, const NDArray &table, const NDArray &ids, const std::vector<Nd4jLong> &bounds, const NDArray *weights, const NDArray &gradO, int mode, NDArray &uniqueIds, NDArray &gradRows, NDArray *gradW) {
+        NDArray::preparePrimaryUse({&uniqueIds, &gradRows, gradW}, {&table, &ids, weights, &gradO});
+
+        std::unique_ptr<NDArray> tableHolder, weightsHolder, gradOHolder;
+        auto t = contiguous(table, tableHolder);
+        auto w = weights == nullptr ? nullptr : contiguous(*weights, weightsHolder);
+        auto g = contiguous(gradO, gradOHolder);
+        auto flat = flatIds(ids);
+
+        std::vector<Nd4jLong> unique;
+        uniqueSlots(flat, unique);
+        for (size_t u = 0; u < unique.size(); u++)
+            uniqueIds.p<Nd4jLong>(u, unique[u]);
+
+        // gradient of weights is flat as ids are, so it's computed into contiguous buffer first
+        std::unique_ptr<NDArray> gradWBuffer;
+        if (gradW != nullptr) {
+            gradWBuffer.reset(new NDArray('c', {(Nd4jLong) flat.size()}, gradW->dataType(), context));
+            NDArray::preparePrimaryUse({gradWBuffer.get()}, {});
+        }
+
+        NDArray rows('c', gradRows.getShapeAsVector(), gradRows.dataType(), context);
+        auto r = gradRows.ordering() == 'c' && gradRows.ews() == 1 ? &gradRows : &rows;
+        NDArray::preparePrimaryUse({r}, {});
+
+        BUILD_SINGLE_SELECTOR(gradRows.dataType(), embeddingBagBp_, (*t, flat, bounds, w, *g, mode, *r, gradWBuffer == nullptr ? nullptr : gradWBuffer->buffer()), FLOAT_TYPES);
+
+        if (r != &gradRows) {
+            NDArray::registerPrimaryUse({r}, {});
+            gradRows.assign(rows);
+        }
+
+        if (gradW != nullptr) {
+            NDArray::registerPrimaryUse({gradWBuffer.get()}, {});
+            gradW->assign(gradWBuffer->reshape('c', gradW->getShapeAsVector()));
+        }
+
+        NDArray::registerPrimaryUse({&uniqueIds, &gradRows, gradW}, {&table, &ids, weights, &gradO});
+    }
+
+    BUILD_SINGLE_TEMPLATE(template void embeddingBag_, (const NDArray &table, const std::vector<Nd4jLong> &ids, const std::vector<Nd4jLong> &bounds, const NDArray *weights, int mode, NDArray &output), FLOAT_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void embeddingBagBp_, (const NDArray &table, const std::vector<Nd4jLong> &ids, const std::vector<Nd4jLong> &bounds, const NDArray *weights, const NDArray &gradO, int mode, NDArray &gradRows, void *vgradW), FLOAT_TYPES);
+
+}
+}
+}
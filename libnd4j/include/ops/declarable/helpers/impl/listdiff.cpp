@@ -19,24 +19,90 @@
 //
 
 #include <ops/declarable/helpers/listdiff.h>
+#include <helpers/RadixPartition.h>
+#include <execution/Executor.h>
+#include <memory>
 #include <vector>
-//#include <memory>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
+
+    // returns array itself if it's contiguous, or c-ordered copy of it stored in holder
+    static const NDArray* contiguous(const NDArray &array, std::unique_ptr<NDArray> &holder) {
+        if (array.ordering() == 'c' && array.ews() == 1)
+            return &array;
+
+        holder.reset(array.dup('c'));
+        holder->syncToHost();
+        return holder.get();
+    }
+
+    /**
+     * Set of keep values: big sets are radix-partitioned by top bits of hash and every partition gets its own table,
+     * so tables are built in parallel and stay cache-friendly
+     */
     template <typename T>
-    static Nd4jLong listDiffCount_(NDArray* values, NDArray* keep) {
-        Nd4jLong saved = 0L;
-        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
-            auto v = values->e<double>(e);
-            ExtraArguments extras({v, 0.0, 10.0});
-            auto idx = keep->indexReduceNumber(indexreduce::FirstIndex, &extras);
-            auto index = idx.e<Nd4jLong>(0);
-            if (index < 0)
-                saved++;
+    class KeepSet {
+    private:
+        int _numPartitions;
+        std::vector<std::unique_ptr<OpenHashTable<T>>> _tables;
+
+    public:
+        KeepSet(const T *keep, Nd4jLong length) {
+            _numPartitions = length > 65536 ? 256 : 1;
+            _tables.resize(_numPartitions);
+
+            std::vector<uint64_t> hashes(length);
+            Executor::parallel_for(0, length, [&](Nd4jLong start, Nd4jLong stop) {
+                for (Nd4jLong e = start; e < stop; e++)
+                    hashes[e] = ValueHash::hash<T>(keep[e]);
+            }, RadixPartition::GRAIN);
+
+            std::vector<Nd4jLong> order;
+            std::vector<Nd4jLong> offsets;
+            RadixPartition::partition(length, _numPartitions, [&](Nd4jLong e) { return partitionOf(hashes[e]); }, order, offsets);
+
+            Executor::parallel_tasks(_numPartitions, [&](int p) {
+                _tables[p].reset(new OpenHashTable<T>(offsets[p + 1] - offsets[p]));
+
+                for (auto i = offsets[p]; i < offsets[p + 1]; i++)
+                    _tables[p]->insert(keep[order[i]], hashes[order[i]], order[i]);
+            });
+        }
+
+        FORCEINLINE int partitionOf(uint64_t hash) const {
+            return _numPartitions > 1 ? (int) (hash >> 56) : 0;
         }
-        return saved;
+
+        FORCEINLINE bool contains(const T &value) const {
+            auto hash = ValueHash::hash<T>(value);
+            return _tables[partitionOf(hash)]->find(value, hash) >= 0;
+        }
+    };
+
+    // flags[e] is replaced with position of values[e] in output, returns number of values not present in keep
+    template <typename T>
+    static Nd4jLong missingPositions(const T *values, Nd4jLong length, const KeepSet<T> &keep, std::vector<Nd4jLong> &flags) {
+        flags.resize(length);
+        Executor::parallel_for(0, length, [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong e = start; e < stop; e++)
+                flags[e] = keep.contains(values[e]) ? 0 : 1;
+        }, RadixPartition::GRAIN);
+
+        return RadixPartition::exclusivePrefix(flags);
+    }
+
+    template <typename T>
+    static Nd4jLong listDiffCount_(NDArray* values, NDArray* keep) {
+        std::unique_ptr<NDArray> valuesHolder, keepHolder;
+        auto x = contiguous(*values, valuesHolder);
+        auto y = contiguous(*keep, keepHolder);
+
+        KeepSet<T> set(y->bufferAsT<T>(), y->lengthOf());
+
+        std::vector<Nd4jLong> flags;
+        return missingPositions<T>(x->bufferAsT<T>(), x->lengthOf(), set, flags);
     }
 
     Nd4jLong listDiffCount(nd4j::LaunchContext * context, NDArray* values, NDArray* keep) {
@@ -44,54 +110,68 @@ namespace helpers {
 
         NDArray::preparePrimaryUse({},{values, keep});
 
-        BUILD_SINGLE_SELECTOR(xType, return listDiffCount_, (values, keep), LIBND4J_TYPES);
+        Nd4jLong result;
+        BUILD_SINGLE_SELECTOR(xType, result = listDiffCount_, (values, keep), LIBND4J_TYPES);
 
         NDArray::registerPrimaryUse({},{values, keep});
+
+        return result;
     }
 
     BUILD_SINGLE_TEMPLATE(template Nd4jLong listDiffCount_, (NDArray* values, NDArray* keep);, LIBND4J_TYPES);
 
     template <typename T>
     static int listDiffFunctor_(NDArray* values, NDArray* keep, NDArray* output1, NDArray* output2) {
+        std::unique_ptr<NDArray> valuesHolder, keepHolder;
+        auto x = contiguous(*values, valuesHolder);
+        auto y = contiguous(*keep, keepHolder);
+        auto v = x->bufferAsT<T>();
+        const auto length = x->lengthOf();
 
-        std::vector<T> saved;
-        std::vector<Nd4jLong> indices;
+        KeepSet<T> set(y->bufferAsT<T>(), y->lengthOf());
 
-        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
-            auto v = values->e<double>(e);
-            ExtraArguments extras({v, 0.0, 10.0});
-            NDArray idxScalar = keep->indexReduceNumber(indexreduce::FirstIndex, &extras);
-            Nd4jLong idx = idxScalar.e<Nd4jLong>(0);
+        std::vector<Nd4jLong> positions;
+        auto saved = missingPositions<T>(v, length, set, positions);
 
-            if (idx < 0) {
-                saved.emplace_back(v);
-                indices.emplace_back(e);
-            }
+        if (saved == 0) {
+            nd4j_printf("ListDiff: search returned no results", "");
+            throw std::invalid_argument("Op validation failed");
         }
 
+        if (output1->lengthOf() != saved) {
+            nd4j_printf("ListDiff: output/actual size mismatch", "");
+            throw std::invalid_argument("Op validation failed");
+        }
 
-        if (saved.size() == 0) {
-//            if (nd4j::ops::conditionHelper(__FILE__, __LINE__, false, 0, "ListDiff: search returned no results") != 0)
-            nd4j_printf("ListDiff: search returned no results", "");
-                throw std::invalid_argument("Op validation failed");
-        } else {
-            auto z0 = output1;//OUTPUT_VARIABLE(0); //new NDArray<T>('c', {(int) saved.size()});
-            auto z1 = output2; //OUTPUT_VARIABLE(1); //new NDArray<T>('c', {(int) saved.size()});
+        if (output2->lengthOf() != saved) {
+            nd4j_printf("ListDiff: output/actual indices size mismatch", "");
+            throw std::invalid_argument("Op validation failed");
+        }
 
-            if (z0->lengthOf() != saved.size()) {
-                nd4j_printf("ListDiff: output/actual size mismatch", "");
-                throw std::invalid_argument("Op validation failed");
+        const bool directValues = output1->ordering() == 'c' && output1->ews() == 1;
+        const bool directIndices = output2->dataType() == nd4j::DataType::INT64 && output2->ordering() == 'c' && output2->ews() == 1;
+        auto z0 = directValues ? output1->bufferAsT<T>() : nullptr;
+        auto z1 = directIndices ? output2->bufferAsT<Nd4jLong>() : nullptr;
+
+        // element is saved if its position differs from position of next element, or it's the last one and it's missing
+        Executor::parallel_for(0, length, [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong e = start; e < stop; e++) {
+                auto next = e < length - 1 ? positions[e + 1] : saved;
+                if (next == positions[e])
+                    continue;
+
+                if (directValues)
+                    z0[positions[e]] = v[e];
+                else
+                    output1->p(positions[e], v[e]);
+
+                if (directIndices)
+                    z1[positions[e]] = e;
+                else
+                    output2->p(positions[e], e);
             }
+        }, RadixPartition::GRAIN);
 
-            if (z1->lengthOf() != saved.size()) {
-                nd4j_printf("ListDiff: output/actual indices size mismatch", "");
-                throw std::invalid_argument("Op validation failed");
-            }
-            memcpy(z0->buffer(), saved.data(), saved.size() * sizeof(T));
-            for (int e = 0; e < indices.size(); e++) {
-                z1->p(e, indices[e]);
-            }
-        }
         return Status::OK();
     }
 
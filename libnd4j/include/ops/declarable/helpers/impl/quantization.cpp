@@ -0,0 +1,588 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Linear (affine) int8/uint8 quantization helpers
+//
+
+#include <ops/declarable/helpers/quantization.h>
+#include <ops/declarable/helpers/convolutions.h>
+#include <limits>
+#include <vector>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+//////////////////////////////////////////////////////////////////////////
+// real -> quantized value with rounding and saturation, float output is passed through as is
+template <typename Z>
+static FORCEINLINE Z storeQuantized(const float real, const float invScale, const int zeroPoint) {
+    auto q = static_cast<int>(nd4j::math::nd4j_round<float, float>(real * invScale)) + zeroPoint;
+    q = nd4j::math::nd4j_max<int>(q, static_cast<int>(std::numeric_limits<Z>::min()));
+    q = nd4j::math::nd4j_min<int>(q, static_cast<int>(std::numeric_limits<Z>::max()));
+    return static_cast<Z>(q);
+}
+
+template <>
+FORCEINLINE float storeQuantized<float>(const float real, const float invScale, const int zeroPoint) {
+    return real;
+}
+
+template <>
+FORCEINLINE double storeQuantized<double>(const float real, const float invScale, const int zeroPoint) {
+    return real;
+}
+
+static FORCEINLINE float applyActivation(const float real, const int activation) {
+    switch (activation) {
+        case QUANTIZED_ACT_RELU:
+            return real > 0.f ? real : 0.f;
+        case QUANTIZED_ACT_RELU6:
+            return real > 0.f ? (real < 6.f ? real : 6.f) : 0.f;
+        default:
+            return real;
+    }
+}
+
+static void quantizedRange(const nd4j::DataType qType, int& qMin, int& qMax) {
+    if (qType == nd4j::DataType::INT8) {
+        qMin = std::numeric_limits<int8_t>::min();
+        qMax = std::numeric_limits<int8_t>::max();
+    }
+    else if (qType == nd4j::DataType::UINT8) {
+        qMin = std::numeric_limits<uint8_t>::min();
+        qMax = std::numeric_limits<uint8_t>::max();
+    }
+    else
+        throw std::invalid_argument("quantization: only INT8 and UINT8 quantized types are supported");
+}
+
+//////////////////////////////////////////////////////////////////////////
+// scalar params are broadcasted to length
+static std::vector<float> floatParams(const NDArray& params, const Nd4jLong length) {
+    if (params.lengthOf() != 1 && params.lengthOf() != length)
+        throw std::invalid_argument("quantization: quantization params must be either scalars or vectors with length equal to number of channels");
+
+    std::vector<float> result(length);
+    for (Nd4jLong e = 0; e < length; e++)
+        result[e] = params.e<float>(params.lengthOf() == 1 ? 0 : e);
+
+    return result;
+}
+
+static std::vector<int> intParams(const NDArray& params, const Nd4jLong length) {
+    if (params.lengthOf() != 1 && params.lengthOf() != length)
+        throw std::invalid_argument("quantization: quantization params must be either scalars or vectors with length equal to number of channels");
+
+    std::vector<int> result(length);
+    for (Nd4jLong e = 0; e < length; e++)
+        result[e] = params.e<int>(params.lengthOf() == 1 ? 0 : e);
+
+    return result;
+}
+
+// for per-channel params, element i belongs to channel (i / innerSize) % numChannels of c-ordered array
+static void channelSizes(const NDArray& input, const NDArray& params, int axis, Nd4jLong& numChannels, Nd4jLong& innerSize) {
+    numChannels = 1;
+    innerSize = 1;
+
+    if (params.lengthOf() == 1)
+        return;
+
+    if (axis < 0)
+        axis += input.rankOf();
+
+    if (axis < 0 || axis >= input.rankOf())
+        throw std::invalid_argument("quantization: channel axis is out of input rank");
+
+    numChannels = input.sizeAt(axis);
+    for (int e = axis + 1; e < input.rankOf(); e++)
+        innerSize *= input.sizeAt(e);
+}
+
+static FORCEINLINE bool isContiguousC(const NDArray& array) {
+    return array.ordering() == 'c' && array.ews() == 1;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X, typename Z>
+static void quantizeLinear_(const NDArray& input, const std::vector<float>& invScales, const std::vector<int>& zeroPoints, const Nd4jLong numChannels, const Nd4jLong innerSize, NDArray& output) {
+    auto x = input.bufferAsT<X>();
+    auto z = output.bufferAsT<Z>();
+    auto s = invScales.data();
+    auto zp = zeroPoints.data();
+    const auto length = input.lengthOf();
+
+    PRAGMA_OMP_PARALLEL_FOR_SIMD_ARGS(OMP_IF(length > Environment::getInstance()->elementwiseThreshold()))
+    for (Nd4jLong e = 0; e < length; e++) {
+        const auto c = (e / innerSize) % numChannels;
+        z[e] = storeQuantized<Z>(static_cast<float>(x[e]), s[c], zp[c]);
+    }
+}
+
+template <typename X, typename Z>
+static void dequantizeLinear_(const NDArray& input, const std::vector<float>& scales, const std::vector<int>& zeroPoints, const Nd4jLong numChannels, const Nd4jLong innerSize, NDArray& output) {
+    auto x = input.bufferAsT<X>();
+    auto z = output.bufferAsT<Z>();
+    auto s = scales.data();
+    auto zp = zeroPoints.data();
+    const auto length = input.lengthOf();
+
+    PRAGMA_OMP_PARALLEL_FOR_SIMD_ARGS(OMP_IF(length > Environment::getInstance()->elementwiseThreshold()))
+    for (Nd4jLong e = 0; e < length; e++) {
+        const auto c = (e / innerSize) % numChannels;
+        z[e] = static_cast<Z>(static_cast<float>(static_cast<int>(x[e]) - zp[c]) * s[c]);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void quantizeLinear(nd4j::LaunchContext* context, const NDArray& input, const NDArray& scale, const NDArray& zeroPoint, const int axis, NDArray& output) {
+
+    Nd4jLong numChannels, innerSize;
+    channelSizes(input, scale, axis, numChannels, innerSize);
+
+    auto invScales = floatParams(scale, numChannels);
+    for (auto& v : invScales)
+        v = v != 0.f ? 1.f / v : 0.f;
+
+    auto zeroPoints = intParams(zeroPoint, numChannels);
+
+    const NDArray* in = isContiguousC(input) ? &input : input.dup('c');
+    NDArray* out = isContiguousC(output) ? &output : output.dup('c');
+
+    NDArray::preparePrimaryUse({out}, {in});
+    BUILD_DOUBLE_SELECTOR(in->dataType(), out->dataType(), quantizeLinear_, (*in, invScales, zeroPoints, numChannels, innerSize, *out), FLOAT_TYPES, QUANTIZED_TYPES);
+    NDArray::registerPrimaryUse({out}, {in});
+
+    if (out != &output) {
+        output.assign(out);
+        delete out;
+    }
+
+    if (in != &input)
+        delete in;
+}
+
+void dequantizeLinear(nd4j::LaunchContext* context, const NDArray& input, const NDArray& scale, const NDArray& zeroPoint, const int axis, NDArray& output) {
+
+    Nd4jLong numChannels, innerSize;
+    channelSizes(input, scale, axis, numChannels, innerSize);
+
+    auto scales = floatParams(scale, numChannels);
+    auto zeroPoints = intParams(zeroPoint, numChannels);
+
+    const NDArray* in = isContiguousC(input) ? &input : input.dup('c');
+    NDArray* out = isContiguousC(output) ? &output : output.dup('c');
+
+    NDArray::preparePrimaryUse({out}, {in});
+    BUILD_DOUBLE_SELECTOR(in->dataType(), out->dataType(), dequantizeLinear_, (*in, scales, zeroPoints, numChannels, innerSize, *out), QUANTIZED_TYPES, FLOAT_TYPES);
+    NDArray::registerPrimaryUse({out}, {in});
+
+    if (out != &output) {
+        output.assign(out);
+        delete out;
+    }
+
+    if (in != &input)
+        delete in;
+}
+
+BUILD_DOUBLE_TEMPLATE(template void quantizeLinear_, (const NDArray& input, const std::vector<float>& invScales, const std::vector<int>& zeroPoints, const Nd4jLong numChannels, const Nd4jLong innerSize, NDArray& output), FLOAT_TYPES, QUANTIZED_TYPES);
+BUILD_DOUBLE_TEMPLATE(template void dequantizeLinear_, (const NDArray& input, const std::vector<float>& scales, const std::vector<int>& zeroPoints, const Nd4jLong numChannels, const Nd4jLong innerSize, NDArray& output), QUANTIZED_TYPES, FLOAT_TYPES);
+
+//////////////////////////////////////////////////////////////////////////
+// all parameters of quantized gemm, gathered in one place to keep kernel signatures sane
+struct QuantizedGemmParams {
+    Nd4jLong M, N, K;
+    int aZero;
+    float aScale;
+    std::vector<int> bZero;        // [N]
+    std::vector<float> bScale;     // [N]
+    std::vector<float> bias;       // [N] or empty
+    int activation;
+    float zInvScale;
+    int zZero;
+    Nd4jLong zStrideM, zStrideN;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// b is packed transposed: [N, K], so both operands of every dot product are contiguous.
+// Products are accumulated in int32 (widening int8 multiply-add), which compilers lower to pmaddubsw/pmaddwd (or vpdpbusd on VNNI-enabled builds).
+// Zero points are compensated with row/column sums: sum((a - za) * (b - zb)) = sum(a*b) - zb*sum(a) - za*sum(b) + K*za*zb
+template <typename X, typename Y, typename Z>
+static void quantizedGemm_(const X* a, const Y* bT, const QuantizedGemmParams& p, Z* z) {
+
+    const Nd4jLong M = p.M, N = p.N, K = p.K;
+    const auto threshold = Environment::getInstance()->elementwiseThreshold();
+
+    std::vector<int> aSums(M), bSums(N);
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(M * K > threshold)
+    for (Nd4jLong m = 0; m < M; m++) {
+        const X* aRow = a + m * K;
+        int sum = 0;
+        PRAGMA_OMP_SIMD_SUM(sum)
+        for (Nd4jLong k = 0; k < K; k++)
+            sum += static_cast<int>(aRow[k]);
+        aSums[m] = sum;
+    }
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(N * K > threshold)
+    for (Nd4jLong n = 0; n < N; n++) {
+        const Y* bRow = bT + n * K;
+        int sum = 0;
+        PRAGMA_OMP_SIMD_SUM(sum)
+        for (Nd4jLong k = 0; k < K; k++)
+            sum += static_cast<int>(bRow[k]);
+        bSums[n] = sum;
+    }
+
+    // every row of a is reused for 4 columns of b
+    const Nd4jLong nBlocks = (N + 3) / 4;
+
+    PRAGMA_OMP_PARALLEL_FOR_ARGS(OMP_IF(M * N * K > threshold) collapse(2) schedule(guided))
+    for (Nd4jLong m = 0; m < M; m++) {
+        for (Nd4jLong nb = 0; nb < nBlocks; nb++) {
+
+            const X* aRow = a + m * K;
+            const Nd4jLong n0 = nb * 4;
+            const int width = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(4, N - n0));
+
+            int acc[4] = {0, 0, 0, 0};
+
+            if (width == 4) {
+                const Y* b0 = bT + n0 * K;
+                const Y* b1 = b0 + K;
+                const Y* b2 = b1 + K;
+                const Y* b3 = b2 + K;
+                int acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+
+                PRAGMA_OMP_SIMD_ARGS(reduction(+:acc0,acc1,acc2,acc3))
+                for (Nd4jLong k = 0; k < K; k++) {
+                    const int av = static_cast<int>(aRow[k]);
+                    acc0 += av * static_cast<int>(b0[k]);
+                    acc1 += av * static_cast<int>(b1[k]);
+                    acc2 += av * static_cast<int>(b2[k]);
+                    acc3 += av * static_cast<int>(b3[k]);
+                }
+
+                acc[0] = acc0; acc[1] = acc1; acc[2] = acc2; acc[3] = acc3;
+            }
+            else {
+                for (int j = 0; j < width; j++) {
+                    const Y* bRow = bT + (n0 + j) * K;
+                    int sum = 0;
+                    PRAGMA_OMP_SIMD_SUM(sum)
+                    for (Nd4jLong k = 0; k < K; k++)
+                        sum += static_cast<int>(aRow[k]) * static_cast<int>(bRow[k]);
+                    acc[j] = sum;
+                }
+            }
+
+            // fused epilogue: zero points compensation, rescale, bias, activation, requantization
+            for (int j = 0; j < width; j++) {
+                const auto n = n0 + j;
+                const int bZero = p.bZero[n];
+                const int corrected = acc[j] - bZero * aSums[m] - p.aZero * bSums[n] + static_cast<int>(K) * p.aZero * bZero;
+
+                float real = static_cast<float>(corrected) * p.aScale * p.bScale[n];
+                if (!p.bias.empty())
+                    real += p.bias[n];
+
+                z[m * p.zStrideM + n * p.zStrideN] = storeQuantized<Z>(applyActivation(real, p.activation), p.zInvScale, p.zZero);
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// packs [rows, cols] view (arbitrary strides) into contiguous c-ordered buffer
+template <typename T>
+static void packMatrix(const T* src, const Nd4jLong rows, const Nd4jLong cols, const Nd4jLong rowStride, const Nd4jLong colStride, T* dst) {
+    PRAGMA_OMP_PARALLEL_FOR_IF(rows * cols > Environment::getInstance()->elementwiseThreshold())
+    for (Nd4jLong r = 0; r < rows; r++)
+        for (Nd4jLong c = 0; c < cols; c++)
+            dst[r * cols + c] = src[r * rowStride + c * colStride];
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X, typename Y, typename Z>
+static void quantizedMatmul_(const NDArray& x, const NDArray& y, QuantizedGemmParams& p, NDArray& z) {
+
+    // x is [..., K], outer dimensions are collapsed into M
+    std::vector<X> aPacked;
+    const X* a = x.bufferAsT<X>();
+    if (!isContiguousC(x)) {
+        auto xC = x.dup('c');
+        aPacked.assign(xC->bufferAsT<X>(), xC->bufferAsT<X>() + xC->lengthOf());
+        delete xC;
+        a = aPacked.data();
+    }
+
+    // y is [K, N], pack it transposed
+    std::vector<Y> bT(p.N * p.K);
+    packMatrix<Y>(y.bufferAsT<Y>(), p.N, p.K, y.stridesOf()[1], y.stridesOf()[0], bT.data());
+
+    p.zStrideM = p.N;
+    p.zStrideN = 1;
+
+    quantizedGemm_<X, Y, Z>(a, bT.data(), p, z.bufferAsT<Z>());
+}
+
+//////////////////////////////////////////////////////////////////////////
+static void fillOutputParams(const NDArray* zScale, const NDArray* zZero, QuantizedGemmParams& p) {
+    if (zScale != nullptr && zZero != nullptr) {
+        const auto scale = zScale->e<float>(0);
+        p.zInvScale = scale != 0.f ? 1.f / scale : 0.f;
+        p.zZero = zZero->e<int>(0);
+    }
+    else {
+        p.zInvScale = 1.f;
+        p.zZero = 0;
+    }
+}
+
+void quantizedMatmul(nd4j::LaunchContext* context, const NDArray& x, const NDArray& y, const NDArray& xScale, const NDArray& xZero, const NDArray& yScale, const NDArray& yZero, const NDArray* bias, const NDArray* zScale, const NDArray* zZero, const int activation, NDArray& z) {
+
+    QuantizedGemmParams p;
+    p.K = x.sizeAt(-1);
+    p.M = x.lengthOf() / p.K;
+    p.N = y.sizeAt(1);
+    p.aScale = xScale.e<float>(0);
+    p.aZero = xZero.e<int>(0);
+    p.bScale = floatParams(yScale, p.N);
+    p.bZero = intParams(yZero, p.N);
+    if (bias != nullptr)
+        p.bias = floatParams(*bias, p.N);
+    p.activation = activation;
+    fillOutputParams(zScale, zZero, p);
+
+    NDArray* out = isContiguousC(z) ? &z : z.dup('c');
+
+    NDArray::preparePrimaryUse({out}, {&x, &y});
+    BUILD_TRIPLE_SELECTOR(x.dataType(), y.dataType(), out->dataType(), quantizedMatmul_, (x, y, p, *out), QUANTIZED_TYPES, QUANTIZED_TYPES, QUANTIZED_OUTPUT_TYPES);
+    NDArray::registerPrimaryUse({out}, {&x, &y});
+
+    if (out != &z) {
+        z.assign(out);
+        delete out;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X, typename Y, typename Z>
+static void quantizedConv2d_(const NDArray& input, const NDArray& weights, QuantizedGemmParams& p, NDArray& output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+
+    int bS, iC, iH, iW, oC, oH, oW;
+    int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;
+    ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, input, output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWoC, indWkH, indOoH);
+
+    const X* in = input.bufferAsT<X>();
+    const Nd4jLong inStrideB = input.stridesOf()[0];
+    const Nd4jLong inStrideC = input.stridesOf()[indIOioC];
+    const Nd4jLong inStrideH = input.stridesOf()[indIiH];
+    const Nd4jLong inStrideW = input.stridesOf()[indIiH + 1];
+
+    // weights [kH, kW, iC, oC] are [K, oC] matrix, pack transposed as [oC, K]
+    const Nd4jLong K = static_cast<Nd4jLong>(kH) * kW * iC;
+    std::vector<Y> bT(oC * K);
+    {
+        std::vector<Y> w(K * oC);
+        auto wBuffer = weights.bufferAsT<Y>();
+        if (isContiguousC(weights))
+            std::copy(wBuffer, wBuffer + K * oC, w.begin());
+        else {
+            auto wC = weights.dup('c');
+            std::copy(wC->bufferAsT<Y>(), wC->bufferAsT<Y>() + K * oC, w.begin());
+            delete wC;
+        }
+        packMatrix<Y>(w.data(), oC, K, 1, oC, bT.data());
+    }
+
+    // im2col for single image: [oH * oW, kH * kW * iC], padding is filled with input zero point (real zero)
+    const Nd4jLong pixels = static_cast<Nd4jLong>(oH) * oW;
+    std::vector<X> col(pixels * K);
+    const X padValue = static_cast<X>(p.aZero);
+
+    p.M = pixels;
+    p.N = oC;
+    p.K = K;
+    p.zStrideM = isNCHW ? 1 : oC;
+    p.zStrideN = isNCHW ? pixels : 1;
+
+    Z* out = output.bufferAsT<Z>();
+
+    for (int b = 0; b < bS; b++) {
+        const X* image = in + b * inStrideB;
+        X* colBuffer = col.data();
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(OMP_IF(pixels * K > Environment::getInstance()->elementwiseThreshold()) collapse(2))
+        for (int oh = 0; oh < oH; oh++) {
+            for (int ow = 0; ow < oW; ow++) {
+                X* colRow = colBuffer + (static_cast<Nd4jLong>(oh) * oW + ow) * K;
+
+                for (int kh = 0; kh < kH; kh++) {
+                    const int ih = oh * sH - pH + kh * dH;
+
+                    for (int kw = 0; kw < kW; kw++) {
+                        const int iw = ow * sW - pW + kw * dW;
+                        X* colPatch = colRow + (static_cast<Nd4jLong>(kh) * kW + kw) * iC;
+
+                        if (ih < 0 || ih >= iH || iw < 0 || iw >= iW) {
+                            for (int ic = 0; ic < iC; ic++)
+                                colPatch[ic] = padValue;
+                        }
+                        else {
+                            const X* pixel = image + ih * inStrideH + iw * inStrideW;
+                            for (int ic = 0; ic < iC; ic++)
+                                colPatch[ic] = pixel[ic * inStrideC];
+                        }
+                    }
+                }
+            }
+        }
+
+        quantizedGemm_<X, Y, Z>(colBuffer, bT.data(), p, out + b * pixels * oC);
+    }
+}
+
+void quantizedConv2d(nd4j::LaunchContext* context, const NDArray& input, const NDArray& weights, const NDArray& inScale, const NDArray& inZero, const NDArray& wScale, const NDArray& wZero, const NDArray* bias, const NDArray* outScale, const NDArray* outZero, NDArray& output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int isSameMode, const int isNCHW, const int activation) {
+
+    int bS, iC, iH, iW, oC, oH, oW;
+    int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;
+    ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, input, output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWoC, indWkH, indOoH);
+
+    if(isSameMode)
+        ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
+
+    QuantizedGemmParams p;
+    p.aScale = inScale.e<float>(0);
+    p.aZero = inZero.e<int>(0);
+    p.bScale = floatParams(wScale, oC);
+    p.bZero = intParams(wZero, oC);
+    if (bias != nullptr)
+        p.bias = floatParams(*bias, oC);
+    p.activation = activation;
+    fillOutputParams(outScale, outZero, p);
+
+    NDArray* out = isContiguousC(output) ? &output : output.dup('c');
+
+    NDArray::preparePrimaryUse({out}, {&input, &weights});
+    BUILD_TRIPLE_SELECTOR(input.dataType(), weights.dataType(), out->dataType(), quantizedConv2d_, (input, weights, p, *out, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW), QUANTIZED_TYPES, QUANTIZED_TYPES, QUANTIZED_OUTPUT_TYPES);
+    NDArray::registerPrimaryUse({out}, {&input, &weights});
+
+    if (out != &output) {
+        output.assign(out);
+        delete out;
+    }
+}
+
+BUILD_TRIPLE_TEMPLATE(template void quantizedMatmul_, (const NDArray& x, const NDArray& y, QuantizedGemmParams& p, NDArray& z), QUANTIZED_TYPES, QUANTIZED_TYPES, QUANTIZED_OUTPUT_TYPES);
+BUILD_TRIPLE_TEMPLATE(template void quantizedConv2d_, (const NDArray& input, const NDArray& weights, QuantizedGemmParams& p, NDArray& output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW), QUANTIZED_TYPES, QUANTIZED_TYPES, QUANTIZED_OUTPUT_TYPES);
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X>
+static void observedRange_(const NDArray& input, const Nd4jLong numChannels, const Nd4jLong innerSize, std::vector<float>& lo, std::vector<float>& hi) {
+    auto x = input.bufferAsT<X>();
+    const auto outerSize = input.lengthOf() / (numChannels * innerSize);
+
+    for (Nd4jLong c = 0; c < numChannels; c++) {
+        float cMin = DataTypeUtils::max<float>();
+        float cMax = -DataTypeUtils::max<float>();
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(OMP_IF(outerSize * innerSize > Environment::getInstance()->elementwiseThreshold()) reduction(min:cMin) reduction(max:cMax) collapse(2))
+        for (Nd4jLong o = 0; o < outerSize; o++) {
+            for (Nd4jLong i = 0; i < innerSize; i++) {
+                const auto v = static_cast<float>(x[(o * numChannels + c) * innerSize + i]);
+                cMin = v < cMin ? v : cMin;
+                cMax = v > cMax ? v : cMax;
+            }
+        }
+
+        lo[c] = cMin;
+        hi[c] = cMax;
+    }
+}
+
+void calibrateRange(nd4j::LaunchContext* context, const NDArray& input, const int axis, const double momentum, NDArray& min, NDArray& max) {
+
+    Nd4jLong numChannels, innerSize;
+    channelSizes(input, min, axis, numChannels, innerSize);
+
+    std::vector<float> lo(numChannels), hi(numChannels);
+
+    const NDArray* in = isContiguousC(input) ? &input : input.dup('c');
+    NDArray::preparePrimaryUse({}, {in});
+    BUILD_SINGLE_SELECTOR(in->dataType(), observedRange_, (*in, numChannels, innerSize, lo, hi), FLOAT_TYPES);
+    NDArray::registerPrimaryUse({}, {in});
+
+    if (in != &input)
+        delete in;
+
+    min.syncToHost();
+    max.syncToHost();
+
+    for (Nd4jLong c = 0; c < numChannels; c++) {
+        const auto oldMin = min.e<double>(c);
+        const auto oldMax = max.e<double>(c);
+
+        // min > max stands for empty range, i.e. first calibration batch
+        if (oldMin > oldMax) {
+            min.p(c, lo[c]);
+            max.p(c, hi[c]);
+        }
+        else if (momentum == 0.) {
+            min.p(c, nd4j::math::nd4j_min<double>(oldMin, lo[c]));
+            max.p(c, nd4j::math::nd4j_max<double>(oldMax, hi[c]));
+        }
+        else {
+            min.p(c, momentum * oldMin + (1. - momentum) * lo[c]);
+            max.p(c, momentum * oldMax + (1. - momentum) * hi[c]);
+        }
+    }
+}
+
+BUILD_SINGLE_TEMPLATE(template void observedRange_, (const NDArray& input, const Nd4jLong numChannels, const Nd4jLong innerSize, std::vector<float>& lo, std::vector<float>& hi), FLOAT_TYPES);
+
+//////////////////////////////////////////////////////////////////////////
+void chooseQuantizationParams(nd4j::LaunchContext* context, const NDArray& min, const NDArray& max, const nd4j::DataType qType, NDArray& scale, NDArray& zeroPoint) {
+    int qMin, qMax;
+    quantizedRange(qType, qMin, qMax);
+
+    min.syncToHost();
+    max.syncToHost();
+
+    for (Nd4jLong e = 0; e < min.lengthOf(); e++) {
+        // zero must be exactly representable, since it's used for padding and relu
+        const auto lo = nd4j::math::nd4j_min<double>(min.e<double>(e), 0.);
+        const auto hi = nd4j::math::nd4j_max<double>(max.e<double>(e), 0.);
+
+        auto s = (hi - lo) / static_cast<double>(qMax - qMin);
+        if (s <= 0.)
+            s = 1.;
+
+        auto zp = static_cast<int>(nd4j::math::nd4j_round<double, double>(qMin - lo / s));
+        zp = nd4j::math::nd4j_max<int>(qMin, nd4j::math::nd4j_min<int>(qMax, zp));
+
+        scale.p(e, s);
+        zeroPoint.p(e, zp);
+    }
+}
+
+}
+}
+}
@@ -19,29 +19,101 @@
 //
 
 #include <ops/declarable/helpers/unique.h>
+#include <helpers/RadixPartition.h>
+#include <execution/Executor.h>
 #include <Status.h>
+#include <memory>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    // returns array itself if it's contiguous, or c-ordered copy of it stored in holder
+    static const NDArray* contiguous(const NDArray &array, std::unique_ptr<NDArray> &holder) {
+        if (array.ordering() == 'c' && array.ews() == 1)
+            return &array;
+
+        holder.reset(array.dup('c'));
+        holder->syncToHost();
+        return holder.get();
+    }
+
+    static void storeLongs(NDArray *array, const std::vector<Nd4jLong> &values) {
+        if (array->dataType() == nd4j::DataType::INT64 && array->ordering() == 'c' && array->ews() == 1) {
+            std::copy(values.begin(), values.end(), array->bufferAsT<Nd4jLong>());
+        } else {
+            for (Nd4jLong e = 0; e < (Nd4jLong) values.size(); e++)
+                array->p(e, values[e]);
+        }
+    }
+
+    /**
+     * For every element this method finds index of first occurrence of its value.
+     * Big inputs are radix-partitioned by top bits of hash, and every partition is deduplicated with its own table.
+     * Partitions keep original order of elements, so result doesn't depend on number of threads
+     *
+     * @param occurrences - if not nullptr, number of occurrences is stored at index of first occurrence
+     */
     template <typename T>
-    static Nd4jLong uniqueCount_(NDArray* input) {
-        Nd4jLong count = 0;
+    static void firstOccurrences(const T *x, Nd4jLong length, std::vector<Nd4jLong> &firstOf, std::vector<Nd4jLong> *occurrences) {
+        std::vector<uint64_t> hashes(length);
+        Executor::parallel_for(0, length, [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong e = start; e < stop; e++)
+                hashes[e] = ValueHash::hash<T>(x[e]);
+        }, RadixPartition::GRAIN);
+
+        firstOf.resize(length);
+        if (occurrences != nullptr)
+            occurrences->assign(length, 0);
+
+        const int numPartitions = length > 65536 ? 256 : 1;
+        std::vector<Nd4jLong> order;
+        std::vector<Nd4jLong> offsets;
+
+        if (numPartitions > 1) {
+            RadixPartition::partition(length, numPartitions, [&](Nd4jLong e) { return (int) (hashes[e] >> 56); }, order, offsets);
+        } else {
+            order.resize(length);
+            for (Nd4jLong e = 0; e < length; e++)
+                order[e] = e;
+
+            offsets = {0, length};
+        }
 
-        std::vector<T> values;
+        // equal values share partition, so every partition writes its own elements only
+        Executor::parallel_tasks(numPartitions, [&](int p) {
+            OpenHashTable<T> table(offsets[p + 1] - offsets[p]);
 
-        for (int e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(values.begin(), values.end(), v) == values.end()) {
-                values.push_back(v);
-                count++;
+            for (auto i = offsets[p]; i < offsets[p + 1]; i++) {
+                auto e = order[i];
+                auto first = table.insert(x[e], hashes[e], e);
+                firstOf[e] = first;
+
+                if (occurrences != nullptr)
+                    (*occurrences)[first]++;
             }
-        }
-        return count;
+        });
+    }
+
+    template <typename T>
+    static Nd4jLong uniqueCount_(NDArray* input) {
+        std::unique_ptr<NDArray> holder;
+        auto source = contiguous(*input, holder);
+        const auto length = source->lengthOf();
+
+        std::vector<Nd4jLong> firstOf;
+        firstOccurrences<T>(source->bufferAsT<T>(), length, firstOf, nullptr);
+
+        std::vector<Nd4jLong> flags(length);
+        for (Nd4jLong e = 0; e < length; e++)
+            flags[e] = firstOf[e] == e ? 1 : 0;
+
+        return RadixPartition::exclusivePrefix(flags);
     }
 
     Nd4jLong uniqueCount(nd4j::LaunchContext * context, NDArray* input) {
+        input->syncToHost();
+
         BUILD_SINGLE_SELECTOR(input->dataType(), return uniqueCount_, (input), LIBND4J_TYPES);
     }
 
@@ -50,58 +122,69 @@ namespace helpers {
 
     template <typename T>
     static Nd4jStatus uniqueFunctor_(NDArray* input, NDArray* values, NDArray* indices, NDArray* counts) {
-    
-        std::vector<T> valuesVector;
-        std::map<T, int> indicesMap;
-        std::map<T, int> countsMap;
-
-        for (int e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(valuesVector.begin(), valuesVector.end(), v) == valuesVector.end()) {
-                valuesVector.push_back(v);
-                indicesMap[v] = e;
-                countsMap[v] = 1;
+        std::unique_ptr<NDArray> holder;
+        auto source = contiguous(*input, holder);
+        auto x = source->bufferAsT<T>();
+        const auto length = source->lengthOf();
+
+        std::vector<Nd4jLong> firstOf;
+        std::vector<Nd4jLong> occurrences;
+        firstOccurrences<T>(x, length, firstOf, counts != nullptr ? &occurrences : nullptr);
+
+        // position of every unique value in output follows position of its first occurrence in input
+        std::vector<Nd4jLong> ranks(length);
+        Executor::parallel_for(0, length, [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong e = start; e < stop; e++)
+                ranks[e] = firstOf[e] == e ? 1 : 0;
+        }, RadixPartition::GRAIN);
+
+        const auto numUnique = RadixPartition::exclusivePrefix(ranks);
+        if (numUnique != values->lengthOf())
+            throw std::invalid_argument("unique: output/actual size mismatch");
+
+        std::vector<Nd4jLong> valueIndices(length);
+        std::vector<Nd4jLong> valueCounts(counts != nullptr ? numUnique : 0);
+        const bool directValues = values->dataType() == input->dataType() && values->ordering() == 'c' && values->ews() == 1;
+        auto z = directValues ? values->bufferAsT<T>() : nullptr;
+
+        Executor::parallel_for(0, length, [&](Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong e = start; e < stop; e++) {
+                auto rank = ranks[firstOf[e]];
+                valueIndices[e] = rank;
+
+                if (firstOf[e] != e)
+                    continue;
+
+                if (directValues)
+                    z[rank] = x[e];
+                else
+                    values->p(rank, x[e]);
+
+                if (counts != nullptr)
+                    valueCounts[rank] = occurrences[e];
             }
-            else {
-                countsMap[v]++;
-            }
-        }
-
-        PRAGMA_OMP_PARALLEL_FOR_IF(values->lengthOf() > Environment::getInstance()->elementwiseThreshold())
-        for (int e = 0; e < values->lengthOf(); e++) {
-            values->p(e, static_cast<T>(valuesVector[e]));
-            if (counts != nullptr) 
-                counts->p(e, countsMap[valuesVector[e]]);
-        }
+        }, RadixPartition::GRAIN);
 
-        for (int e = 0; e < indices->lengthOf(); e++) {
-            auto posI = std::find(valuesVector.begin(), valuesVector.end(), input->e<T>(e));
-            auto dist = std::distance(valuesVector.begin(), posI);
-            indices->p(e, Nd4jLong(dist));//indicesMap[(*input)(e)];
-        }
+        storeLongs(indices, valueIndices);
+        if (counts != nullptr)
+            storeLongs(counts, valueCounts);
 
         return Status::OK();
     }
 
     Nd4jStatus uniqueFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* values, NDArray* indices, NDArray* counts) {
-        input->syncToHost();
-        values->syncToHost();
-        indices->syncToHost();
+        // outputs are written on host, all of their elements
+        NDArray::preparePrimaryUse({values, indices, counts}, {input});
 
-        if (counts != nullptr)
-            counts->syncToHost();
+        Nd4jStatus result;
+        BUILD_SINGLE_SELECTOR(input->dataType(), result = uniqueFunctor_,(input, values, indices, counts), LIBND4J_TYPES);
 
-        BUILD_SINGLE_SELECTOR(input->dataType(), return uniqueFunctor_,(input, values, indices, counts), LIBND4J_TYPES);
+        NDArray::registerPrimaryUse({values, indices, counts}, {input});
 
-        input->syncToDevice();
-        values->syncToDevice();
-        indices->syncToDevice();
-
-        if (counts != nullptr)
-            counts->syncToDevice();
+        return result;
     }
 
     BUILD_SINGLE_TEMPLATE(template Nd4jStatus uniqueFunctor_, (NDArray* input, NDArray* values, NDArray* indices, NDArray* counts), LIBND4J_TYPES);
 }
 }
-}
\ No newline at end of file
+}
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Linear (affine) int8/uint8 quantization helpers: real = (q - zeroPoint) * scale
+//
+
+#ifndef LIBND4J_QUANTIZATION_H
+#define LIBND4J_QUANTIZATION_H
+
+#include <NDArray.h>
+#include <execution/LaunchContext.h>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    /**
+     * Activations fused into quantized matmul/conv2d epilogues
+     */
+    enum QuantizedActivation {
+        QUANTIZED_ACT_NONE = 0,
+        QUANTIZED_ACT_RELU = 1,
+        QUANTIZED_ACT_RELU6 = 2,
+    };
+
+    /**
+     * Quantization parameters are per-tensor if scale/zeroPoint are scalars,
+     * or per-channel along axis if they are vectors of length input.sizeAt(axis)
+     */
+    void quantizeLinear(nd4j::LaunchContext* context, const NDArray& input, const NDArray& scale, const NDArray& zeroPoint, const int axis, NDArray& output);
+
+    void dequantizeLinear(nd4j::LaunchContext* context, const NDArray& input, const NDArray& scale, const NDArray& zeroPoint, const int axis, NDArray& output);
+
+    /**
+     * x [M, K] (int8/uint8, per-tensor params), y [K, N] (int8/uint8, per-tensor or per-column params)
+     * z [M, N] either FLOAT32 (dequantized) or int8/uint8 (requantized with zScale/zZero)
+     * bias [N] is optional and is added in real domain, before activation
+     */
+    void quantizedMatmul(nd4j::LaunchContext* context, const NDArray& x, const NDArray& y, const NDArray& xScale, const NDArray& xZero, const NDArray& yScale, const NDArray& yZero, const NDArray* bias, const NDArray* zScale, const NDArray* zZero, const int activation, NDArray& z);
+
+    /**
+     * input   [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW), per-tensor params
+     * weights [kH, kW, iC, oC], per-tensor or per-output-channel params
+     * output  [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW)
+     */
+    void quantizedConv2d(nd4j::LaunchContext* context, const NDArray& input, const NDArray& weights, const NDArray& inScale, const NDArray& inZero, const NDArray& wScale, const NDArray& wZero, const NDArray* bias, const NDArray* outScale, const NDArray* outZero, NDArray& output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int isSameMode, const int isNCHW, const int activation);
+
+    /**
+     * Updates running min/max with ranges observed in input (per-tensor if min/max are scalars, per-channel along axis otherwise).
+     * momentum == 0 keeps absolute extremes, otherwise exponential moving average is used: r = momentum * r + (1 - momentum) * observed
+     */
+    void calibrateRange(nd4j::LaunchContext* context, const NDArray& input, const int axis, const double momentum, NDArray& min, NDArray& max);
+
+    /**
+     * Derives scale/zeroPoint covering [min, max] (always including 0) for given quantized type
+     */
+    void chooseQuantizationParams(nd4j::LaunchContext* context, const NDArray& min, const NDArray& max, const nd4j::DataType qType, NDArray& scale, NDArray& zeroPoint);
+
+}
+}
+}
+
+#endif //LIBND4J_QUANTIZATION_H
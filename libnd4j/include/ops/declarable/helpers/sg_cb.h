@@ -32,6 +32,14 @@ namespace nd4j {
 
             void cbow(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &target, NDArray &ngStarter, int nsRounds, NDArray &context, NDArray &lockedWords, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, NDArray &numLabels, NDArray &inferenceVector, const bool trainWords, const int numWorkers);
 
+            /**
+             * Minibatch mode of batched SkipGram/CBOW with negative sampling: [minibatch] consecutive rows share one set of negative samples,
+             * which turns negative sampling into small dense GEMMs. Rows of different minibatches are processed in parallel
+             */
+            void skipgramMinibatch(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &target, NDArray &ngStarter, int nsRounds, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, const int minibatch, const int numWorkers);
+
+            void cbowMinibatch(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &ngStarter, int nsRounds, NDArray &context, NDArray &lockedWords, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, NDArray &numLabels, const bool trainWords, const int minibatch, const int numWorkers);
+
             int binarySearch(const int *haystack, const int needle, const int totalElements);
         }
     }
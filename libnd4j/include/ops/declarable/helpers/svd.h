@@ -23,6 +23,7 @@
 
 #include <ops/declarable/helpers/helpers.h>
 #include "NDArray.h"
+#include <graph/RandomGenerator.h>
 
 namespace nd4j    {
 namespace ops     {
@@ -32,6 +33,10 @@ namespace helpers {
 // svd operation, this function is not method of SVD class, it is standalone function
 void svd(nd4j::LaunchContext* context, const NDArray* x, const std::vector<NDArray*>& outArrs, const bool fullUV, const bool calcUV, const int switchNum);
 
+//////////////////////////////////////////////////////////////////////////
+// truncated svd: top k singular values (and vectors) of each matrix, evaluated with randomized range finder
+void svdRandomized(nd4j::LaunchContext* context, nd4j::graph::RandomGenerator& rng, const NDArray* x, const std::vector<NDArray*>& outArrs, const int k, const bool calcUV);
+
 
 }
 }
@@ -33,6 +33,9 @@ namespace nd4j {
         DeclarableListOp::DeclarableListOp(int numInputs, int numOutputs, const char* opName, int tArgs, int iArgs) : DeclarableOp::DeclarableOp(numInputs, numOutputs, opName, false, tArgs, iArgs) {
             // This kind of operations work with sets: NDArrayList
             this->getOpDescriptor()->setInputType(InputType_NUMERIC_SET);
+
+            // NDArrayList is state shared between ops
+            this->getOpDescriptor()->setPure(false);
         }
 /*
         template <typename T>
@@ -75,6 +78,10 @@ namespace nd4j {
             return this->execute(list, ins, tas, ias);
         }
 
+        bool DeclarableListOp::hasViewOutputs() {
+            return true;
+        }
+
         Nd4jStatus DeclarableListOp::execute(Context* block) {
             if (block == nullptr)
                 throw std::invalid_argument("Block is NULL");
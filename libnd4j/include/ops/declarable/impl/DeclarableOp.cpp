@@ -25,6 +25,8 @@
 #include <exceptions/graph_exception.h>
 #include <exceptions/unresolved_input_exception.h>
 #include <ops/declarable/OpRegistrator.h>
+#include <graph/profiling/TraceRecorder.h>
+#include <memory>
 
 namespace nd4j {
     namespace ops {
@@ -80,6 +82,104 @@ namespace nd4j {
             return _descriptor;
         }
 
+        bool DeclarableOp::hasViewOutputs() {
+            return false;
+        }
+
+        NDArray* DeclarableOp::viewOutput(Context &block, int outputIdx, Nd4jLong *shapeInfo) {
+            return nullptr;
+        }
+
+        NDArray* DeclarableOp::reshapeView(const NDArray &array, const Nd4jLong *shapeInfo) {
+            const int rank = shape::rank(shapeInfo);
+
+            // scalars are cheap to copy, strings have offsets in their buffers
+            if (rank == 0 || array.rankOf() == 0 || array.isEmpty() || array.isS() || shape::isEmpty(const_cast<Nd4jLong*>(shapeInfo)) || shape::length(shapeInfo) != array.lengthOf())
+                return nullptr;
+
+            std::vector<Nd4jLong> shape(shape::shapeOf(const_cast<Nd4jLong*>(shapeInfo)), shape::shapeOf(const_cast<Nd4jLong*>(shapeInfo)) + rank);
+
+            // checking strides first, reshape falls back to copy otherwise
+            std::vector<Nd4jLong> temp(shape::shapeInfoLength(rank));
+            if (!shape::reshapeC(array.rankOf(), array.getShapeInfo(), rank, shape.data(), temp.data()))
+                return nullptr;
+
+            // reshape() doesn't flag shared buffer, and regular outputs may be nullified as a whole buffer
+            auto view = new NDArray(array.reshape('c', shape));
+            view->setView(true);
+
+            return view;
+        }
+
+        int DeclarableOp::prepareViews(Context &ctx) {
+            if (!this->hasViewOutputs() || !ctx.isViewOutputsAllowed() || ctx.isFastPath() || ctx.isInplace() || ctx.getVariableSpace() == nullptr)
+                return 0;
+
+            ShapeList inSha;
+            for (auto p: *ctx.inputs()) {
+                auto var = ctx.variable(p);
+                if (var->variableType() == VariableType::NDARRAY) {
+                    if (var->getNDArray() == nullptr)
+                        return 0;
+
+                    inSha.push_back(var->getNDArray()->getShapeInfo());
+                }
+            }
+
+            std::unique_ptr<ShapeList> outSha(this->calculateOutputShape(&inSha, ctx));
+            const int numOutputs = outSha->size();
+
+            std::vector<NDArray*> views;
+            for (int e = 0; e < numOutputs; e++) {
+                // arrays provided from outside must be filled as usual
+                std::pair<int, int> pair(ctx.nodeId(), e);
+                if (ctx.isValueAvailable(e) && !ctx.variable(pair)->isRemovable())
+                    break;
+
+                auto view = this->viewOutput(ctx, e, outSha->at(e));
+                if (view == nullptr)
+                    break;
+
+                if (!shape::equalsSoft(view->getShapeInfo(), outSha->at(e)) || view->dataType() != ArrayOptions::dataType(outSha->at(e))) {
+                    delete view;
+                    break;
+                }
+
+                views.emplace_back(view);
+            }
+
+            // it's all or nothing
+            if (numOutputs == 0 || (int) views.size() != numOutputs) {
+                for (auto v: views)
+                    delete v;
+
+                // views published by previous runs still share buffers with inputs, so they can't be reused as regular outputs
+                for (int e = 0; e < numOutputs; e++) {
+                    std::pair<int, int> pair(ctx.nodeId(), e);
+                    if (!ctx.isValueAvailable(e) || !ctx.variable(pair)->isRemovable())
+                        continue;
+
+                    auto var = ctx.variable(pair);
+                    if (var->getNDArray() != nullptr && var->getNDArray()->isView()) {
+                        delete var->getNDArray();
+                        var->setNDArray(nullptr);
+                    }
+                }
+
+                return 0;
+            }
+
+            for (int e = 0; e < numOutputs; e++) {
+                std::pair<int, int> pair(ctx.nodeId(), e);
+
+                // published views are recognized by this flag on subsequent runs
+                views[e]->setView(true);
+                ctx.pushNDArrayToVariableSpace(pair, views[e]);
+            }
+
+            return numOutputs;
+        }
+
         std::string *DeclarableOp::getOpName() {
             return _descriptor->getOpName();
         }
@@ -318,13 +418,23 @@ namespace nd4j {
             return true;
         }
 
-        Nd4jStatus nd4j::ops::DeclarableOp::validateDataTypes(Context& block) {
+        void nd4j::ops::DeclarableOp::ensureTypesRegistered() {
             _registrator.lock();
             if (!_registered) {
                 _registered = true;
                 this->registerTypes();
             }
             _registrator.unlock();
+        }
+
+        bool nd4j::ops::DeclarableOp::isPure() {
+            // purity is declared along with types
+            ensureTypesRegistered();
+            return _descriptor->isPure();
+        }
+
+        Nd4jStatus nd4j::ops::DeclarableOp::validateDataTypes(Context& block) {
+            ensureTypesRegistered();
 
             // rolling over inputs first
             int cnt = 0, inT = 0;
@@ -484,6 +594,8 @@ namespace nd4j {
             if (Environment::getInstance()->isProfiling())
                 timeEnter = std::chrono::system_clock::now();
 
+            Nd4jLong traceStart = Environment::getInstance()->isTracing() ? TraceRecorder::currentTime() : 0L;
+
             // basic validation: ensure inputs are set
             REQUIRE_OK(this->validateNonEmptyInput(*block));
 
@@ -494,8 +606,13 @@ namespace nd4j {
             REQUIRE_OK(this->validateDataTypes(*block));
 
 
+            // view-capable op might publish outputs aliasing its input, there's nothing to execute then
+            auto numOutputs = this->prepareViews(*block);
+            const bool isView = numOutputs > 0;
+
             // this method will allocate output NDArrays for this op
-            auto numOutputs = this->prepareOutputs(*block);
+            if (!isView)
+                numOutputs = this->prepareOutputs(*block);
 
             if (Environment::getInstance()->isProfiling()) {
                 timeStart = std::chrono::system_clock::now();
@@ -503,11 +620,11 @@ namespace nd4j {
             }
 
 
-            Nd4jStatus status;
+            Nd4jStatus status = Status::OK();
             bool hasHelper = false;
 
             // if we have platform-specific helper for this op - invoke it
-            if (OpRegistrator::getInstance()->hasHelper(this->getOpHash())) {
+            if (!isView && OpRegistrator::getInstance()->hasHelper(this->getOpHash())) {
                 auto helper =  OpRegistrator::getInstance()->getPlatformHelper(this->getOpHash());
                 if (helper->isUsable(*block)) {
                     status = helper->invokeHelper(*block);
@@ -516,7 +633,7 @@ namespace nd4j {
             }
 
             // if we don't have platform-specific helper - invoke generic implementation
-            if (!hasHelper)
+            if (!hasHelper && !isView)
                 status = this->validateAndExecute(*block);
 
             // optionally saving execution time
@@ -540,6 +657,25 @@ namespace nd4j {
                 }
             }
 
+            // span covers preparation and execution, input shapes are attached
+            if (Environment::getInstance()->isTracing()) {
+                Nd4jLong memoryAfter = block->workspace() == nullptr ? 0L : block->workspace()->getSpilledSize() + block->workspace()->getUsedSize();
+                auto &span = TraceRecorder::getInstance()->beginSpan("op", this->getOpName()->c_str(), block->nodeId(), traceStart, TraceRecorder::currentTime(), memoryAfter - memoryBefore);
+
+                for (int e = 0; e < (int) block->width() && e < TRACE_MAX_SHAPES; e++) {
+                    if (block->isFastPath()) {
+                        if (e < (int) block->fastpath_in().size() && block->fastpath_in()[e] != nullptr)
+                            span.addShape(block->fastpath_in()[e]->getShapeInfo());
+                    } else {
+                        auto var = block->getVariable(e);
+                        if (var != nullptr && var->hasNDArray())
+                            span.addShape(var->getNDArray()->getShapeInfo());
+                    }
+                }
+
+                TraceRecorder::getInstance()->commitSpan();
+            }
+
 
             // now we print out all outputs for this node
             if (nd4j::Environment::getInstance()->isDebugAndVerbose()) {
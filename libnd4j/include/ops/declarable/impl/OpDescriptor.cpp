@@ -275,6 +275,15 @@ namespace nd4j {
             return _sameMode;
         }
 
+        OpDescriptor* OpDescriptor::setPure(bool reallyPure) {
+            _pure = reallyPure;
+            return this;
+        }
+
+        bool OpDescriptor::isPure() {
+            return _pure;
+        }
+
         bool OpDescriptor::isInherit(int index) {
             if (std::find(_allowedOuts.begin(), _allowedOuts.end(), nd4j::DataType::INHERIT) != _allowedOuts.end())
                 return true;
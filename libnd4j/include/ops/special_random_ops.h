@@ -24,7 +24,9 @@
 #include <ops/random_ops.h>
 #include <helpers/shape.h>
 #include <graph/RandomGenerator.h>
+#include <helpers/PhiloxRandom.h>
 #include <specials_cuda.h>
+#include <vector>
 
 namespace randomOps {
 
@@ -298,53 +300,95 @@ namespace randomOps {
 
         static inline void
         specialOp(Nd4jPointer state, T *x, Nd4jLong *xShapeBuffer, T *y, Nd4jLong *yShapeBuffer, T *z, Nd4jLong *zShapeBuffer, T *extraArguments) {
-            const T two_pi = static_cast<T>(2.0f) * static_cast<T>(3.14159265358979323846);
-
             auto zLength = shape::length(zShapeBuffer);
             auto yEWS = shape::elementWiseStride(yShapeBuffer);
             auto zEWS = shape::elementWiseStride(zShapeBuffer);
 
-            auto middle = zLength % 2  + zLength / 2;
+            // chunks are aligned to generator batches, so every batch is generated once
+            const Nd4jLong span = 64 * nd4j::random::PhiloxRandom::LENGTH;
+            const Nd4jLong numChunks = zLength / span + (zLength % span != 0 ? 1 : 0);
 
-            int elementsPerThread = middle / TAD_THRESHOLD;
-            int _threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
+            int _threads = nd4j::math::nd4j_max<int>(1, numChunks);
             _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
 
-            int span = (middle / _threads) + 8;
-
-            // we're enforcing even chunks, since it's mandatory for this algorithm
-            span -= span % 2;
-
-            //nd4j::random::RandomBuffer *buffer = reinterpret_cast<nd4j::random::RandomBuffer *> (state);
             nd4j::graph::RandomGenerator* rng = reinterpret_cast<nd4j::graph::RandomGenerator*>(state);
+            nd4j::random::PhiloxRandom philox(*rng);
+
             const T mean = extraArguments[0];
             const T stddev = extraArguments[1];
 
-            const T epsilon = static_cast<T>(1e-5);
-
             PRAGMA_OMP_PARALLEL_FOR_THREADS(_threads)
-            for (Nd4jLong e = 0; e < middle; e++) {
-                auto epm = e + middle;
+            for (Nd4jLong c = 0; c < numChunks; c++) {
+                auto start = c * span;
+                auto end = nd4j::math::nd4j_min<Nd4jLong>(zLength, start + span);
 
-                // we need to get random values
-                T r0 = rng->relativeT<T>(e, epsilon, static_cast<T>(1.0f));
-                T r1 = rng->relativeT<T>(epm, epsilon, static_cast<T>(1.0f));
-
-                T realMean0 = y == z ? mean : y[e * yEWS];
-
-                auto z0 =  (nd4j::math::nd4j_sqrt<T,T>(static_cast<T>(-2.0f) * nd4j::math::nd4j_log<T,T>(r0)) * nd4j::math::nd4j_cos<T,T>(two_pi * r1)) * stddev + realMean0;
-                z[e * zEWS] = z0;
+                if (y == z) {
+                    philox.gaussian<T>(start, end - start, z + start * zEWS, zEWS, mean, stddev);
+                } else {
+                    philox.gaussian<T>(start, end - start, z + start * zEWS, zEWS, static_cast<T>(0.f), stddev);
 
-                if (epm < zLength) {
-                    T realMean1 = y == z ? mean : y[epm * yEWS];
-                    auto z1 = (nd4j::math::nd4j_sqrt<T,T>(static_cast<T>(-2.0f) * nd4j::math::nd4j_log<T,T>(r0)) * nd4j::math::nd4j_sin<T,T>(two_pi * r1)) * stddev + realMean1;
-                    z[epm * zEWS] = z1;
+                    for (Nd4jLong e = start; e < end; e++)
+                        z[e * zEWS] += y[e * yEWS];
                 }
             }
         }
     };
 
 
+//////////////////////////////////////////////////////////////////////
+    /**
+     * Counts successful trials of every element, trial t of element e uses uniform value number e * trials + t.
+     * Uniform values are generated in bulk, a chunk of elements at a time
+     *
+     * @param perElement - if true, y holds probability of every element, otherwise probability of every trial
+     */
+    template<typename T>
+    static inline void binomialTrials(Nd4jPointer state, T *y, Nd4jLong *yShapeBuffer, T *z, Nd4jLong *zShapeBuffer, int trials, T prob, bool perElement) {
+        Nd4jLong zLength = shape::length(zShapeBuffer);
+
+        auto yEWS = shape::elementWiseStride(yShapeBuffer);
+        auto zEWS = shape::elementWiseStride(zShapeBuffer);
+
+        const Nd4jLong span = 4096;
+        const Nd4jLong numChunks = zLength / span + (zLength % span != 0 ? 1 : 0);
+
+        int _threads = nd4j::math::nd4j_max<int>(1, numChunks);
+        _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
+
+        nd4j::graph::RandomGenerator* rng = reinterpret_cast<nd4j::graph::RandomGenerator*>(state);
+        nd4j::random::PhiloxRandom philox(*rng);
+
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(_threads)
+        for (Nd4jLong c = 0; c < numChunks; c++) {
+            auto start = c * span;
+            auto end = nd4j::math::nd4j_min<Nd4jLong>(zLength, start + span);
+
+            std::vector<int> success(end - start, 0);
+            std::vector<T> values(span);
+
+            // flat range of (element, trial) pairs of this chunk
+            const auto first = start * trials;
+            const auto last = end * trials;
+            for (auto piece = first; piece < last; piece += span) {
+                auto length = nd4j::math::nd4j_min<Nd4jLong>(span, last - piece);
+                philox.uniform<T>(piece, length, values.data(), 1, static_cast<T>(0.f), static_cast<T>(1.f));
+
+                for (Nd4jLong i = 0; i < length; i++) {
+                    auto e = (piece + i) / trials;
+                    auto t = (piece + i) % trials;
+                    auto p = y == z ? prob : perElement ? y[e * yEWS] : y[t * yEWS];
+
+                    if (values[i] < p)
+                        success[e - start]++;
+                }
+            }
+
+            // if trials is set to 0, effectively we just have successful memset
+            for (auto e = start; e < end; e++)
+                z[e * zEWS] = static_cast<T>(success[e - start]);
+        }
+    }
+
 //////////////////////////////////////////////////////////////////////
     /**
     * This Op produces random values within [0..N], Distribuion is binomial
@@ -413,47 +457,7 @@ namespace randomOps {
 #endif
 
         static inline void specialOp(Nd4jPointer state, T *x, Nd4jLong *xShapeBuffer, T *y, Nd4jLong *yShapeBuffer, T *z, Nd4jLong *zShapeBuffer, T *extraArguments) {
-            int trials = (int) extraArguments[0];
-
-            Nd4jLong zLength = shape::length(zShapeBuffer);
-
-            auto yEWS = shape::elementWiseStride(yShapeBuffer);
-            auto zEWS = shape::elementWiseStride(zShapeBuffer);
-
-            int elementsPerThread = zLength / TAD_THRESHOLD;
-            int _threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
-            _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
-
-            auto span = (zLength / _threads) + 8;
-
-            nd4j::graph::RandomGenerator* rng = reinterpret_cast<nd4j::graph::RandomGenerator*>(state);
-            PRAGMA_OMP_PARALLEL_THREADS(_threads)
-            {
-                int tid = omp_get_thread_num();
-                auto start = span * tid;
-                auto end = span * (tid + 1);
-                if (end > zLength) end = zLength;
-
-                T prob = extraArguments[1];
-
-                for (Nd4jLong e = start; e < end; e++) {
-
-                    int success = 0;
-                    for (int t = 1; t <= trials; t++) {
-                        T randVal = rng->relativeT<T>((e+1) * t);
-                        if (y != z) {
-                            // we're using external probs
-                            prob = y[(t-1) * yEWS];
-                        }
-
-                        if (randVal < prob)
-                            success++;
-                    }
-
-                    // if trials is set to 0, effectively we just have successful memset
-                    z[e * zEWS] = static_cast<T>(success);
-                }
-            }
+            binomialTrials<T>(state, y, yShapeBuffer, z, zShapeBuffer, (int) extraArguments[0], extraArguments[1], false);
         }
     };
 
@@ -527,48 +531,7 @@ namespace randomOps {
 #endif
 
         static inline void specialOp(Nd4jPointer state, T *x, Nd4jLong *xShapeBuffer, T *y, Nd4jLong *yShapeBuffer, T *z, Nd4jLong *zShapeBuffer, T *extraArguments) {
-            int trials = (int) extraArguments[0];
-
-            Nd4jLong zLength = shape::length(zShapeBuffer);
-
-            auto yEWS = shape::elementWiseStride(yShapeBuffer);
-            auto zEWS = shape::elementWiseStride(zShapeBuffer);
-
-            int elementsPerThread = zLength / TAD_THRESHOLD;
-            int _threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
-            _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
-
-            auto span = (zLength / _threads) + 8;
-
-            //nd4j::random::RandomBuffer *buffer = reinterpret_cast<nd4j::random::RandomBuffer *> (state);
-            nd4j::graph::RandomGenerator* rng = reinterpret_cast<nd4j::graph::RandomGenerator*>(state);
-            PRAGMA_OMP_PARALLEL_THREADS(_threads)
-            {
-                int tid = omp_get_thread_num();
-                Nd4jLong start = span * tid;
-                Nd4jLong end = span * (tid + 1);
-                if (end > zLength) end = zLength;
-
-                T prob = extraArguments[1];
-
-                for (Nd4jLong e = start; e < end; e++) {
-
-                    int success = 0;
-                    for (int t = 1; t <= trials; t++) {
-                        T randVal = rng->relativeT<T>((e+1) * t);
-                        if (y != z) {
-                            // we're using external probs
-                            prob = y[e * yEWS];
-                        }
-
-                        if (randVal < prob)
-                            success++;
-                    }
-
-                    // if trials is set to 0, effectively we just have successful memset
-                    z[e * zEWS] = static_cast<T>(success);
-                }
-            }
+            binomialTrials<T>(state, y, yShapeBuffer, z, zShapeBuffer, (int) extraArguments[0], extraArguments[1], true);
         }
     };
 
@@ -676,27 +639,27 @@ namespace randomOps {
         specialOp(Nd4jPointer state, T *x, Nd4jLong *xShapeBuffer, T *y, Nd4jLong *yShapeBuffer, T *z, Nd4jLong *zShapeBuffer, T *extraArguments) {
             GaussianDistribution<T>::specialOp(state, x, xShapeBuffer, y, yShapeBuffer, z, zShapeBuffer, extraArguments);
             Nd4jLong zLength = shape::length(zShapeBuffer);
-            //auto yEWS = shape::elementWiseStride(yShapeBuffer);
-            //auto zEWS = shape::elementWiseStride(zShapeBuffer);
             nd4j::graph::RandomGenerator* rng = reinterpret_cast<nd4j::graph::RandomGenerator*>(state);
             T mean = extraArguments[0];
             T stddev = extraArguments[1];
             T ds = nd4j::math::nd4j_abs<T>(stddev) * (T) 2.0f;
-            Nd4jLong middle = zLength / 2 + (zLength % 2);
-            int elementsPerThread = middle / TAD_THRESHOLD;
+            int elementsPerThread = zLength / TAD_THRESHOLD;
             int _threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
             _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
 
-            const T epsilon = static_cast<T>(1e-5);
+            // every resampling round draws from its own stream, so redrawn values don't depend on the rest of array
+            const int rounds = 16;
+            std::vector<nd4j::random::PhiloxRandom> streams;
+            for (int r = 1; r < rounds; r++)
+                streams.emplace_back(*rng, r);
 
             PRAGMA_OMP_PARALLEL_FOR_THREADS(_threads)
             for (Nd4jLong e = 0; e < zLength; ++e) {
-                if (z[e] > mean + ds || z[e] < mean - ds) {
-                    z[e] = step(rng, mean, stddev, e, middle, z[e]);
+                for (int r = 0; r < rounds - 1 && (z[e] > mean + ds || z[e] < mean - ds); r++)
+                    z[e] = streams[r].gaussian<T>(e, mean, stddev);
 
-                    if (z[e] > mean + ds || z[e] < mean - ds)
-                        z[e] = mean + nd4j::DataTypeUtils::min<T>();
-                }
+                if (z[e] > mean + ds || z[e] < mean - ds)
+                    z[e] = mean + nd4j::DataTypeUtils::min<T>();
             }
         }
     };
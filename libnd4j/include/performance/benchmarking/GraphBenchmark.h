@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// End-to-end benchmark of FlatBuffers graphs, with JSON reports and baseline comparison
+//
+
+#ifndef LIBND4J_GRAPHBENCHMARK_H
+#define LIBND4J_GRAPHBENCHMARK_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <array/DataType.h>
+#include <graph/Graph.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace nd4j {
+    /**
+     * Single benchmark configuration result. Latencies are in microseconds
+     */
+    class ND4J_EXPORT GraphBenchmarkResult {
+    public:
+        std::string _name;
+        int _threads = 0;
+        int _batchSize = 0;
+        int _iterations = 0;
+
+        double _mean = 0.0;
+        double _min = 0.0;
+        double _max = 0.0;
+        double _p50 = 0.0;
+        double _p90 = 0.0;
+        double _p99 = 0.0;
+
+        // samples (batch elements) per second
+        double _throughput = 0.0;
+
+        // workspace bytes allocated by single graph run. Workspace memory isn't reused within run, so this is total, not peak usage
+        Nd4jLong _allocatedBytes = 0L;
+    };
+
+    /**
+     * Outcome of comparison against baseline. Only regressions mean that benchmark got worse,
+     * added and missing configurations just can't be compared
+     */
+    class ND4J_EXPORT GraphBenchmarkComparison {
+    public:
+        std::vector<std::string> _regressions;
+        std::vector<std::string> _added;
+        std::vector<std::string> _missing;
+    };
+
+    /**
+     * This class runs imported FlatBuffers graph for all combinations of thread counts and batch sizes.
+     * Placeholders are fed with random arrays of recorded shapes, where first dimension is replaced by batch size
+     *
+     * PLEASE NOTE: thread count is applied globally via OpenMP and Environment, and restored after run
+     */
+    class ND4J_EXPORT GraphBenchmark {
+    private:
+        std::string _fileName;
+        int _warmup;
+        int _iterations;
+
+        std::vector<int> _threads;
+        std::vector<int> _batchSizes;
+
+        std::map<std::string, std::vector<Nd4jLong>> _shapes;
+        nd4j::DataType _dataType = nd4j::DataType::FLOAT32;
+
+        void feedPlaceholders(nd4j::graph::Graph *graph, int batchSize);
+        GraphBenchmarkResult runSingle(int threads, int batchSize);
+
+    public:
+        explicit GraphBenchmark(const char *fileName, int warmup = 10, int iterations = 100);
+        ~GraphBenchmark() = default;
+
+        /**
+         * These methods set configurations to be benchmarked. Empty list means current number of threads and recorded batch size
+         */
+        void setThreads(const std::vector<int> &threads);
+        void setBatchSizes(const std::vector<int> &batchSizes);
+
+        /**
+         * This method overrides shape of the named placeholder, i.e. if graph has no shape recorded
+         */
+        void setInputShape(const std::string &name, const std::vector<Nd4jLong> &shape);
+
+        /**
+         * This method sets data type for placeholders without recorded arrays. Default: FLOAT32
+         */
+        void setDataType(nd4j::DataType dataType);
+
+        std::vector<GraphBenchmarkResult> run();
+
+        /**
+         * This method runs benchmark and returns report as JSON
+         */
+        std::string runAsJson();
+
+        static std::string asJson(const std::string &graphName, const std::vector<GraphBenchmarkResult> &results);
+        static std::vector<GraphBenchmarkResult> fromJson(const std::string &json);
+
+        /**
+         * This method compares current results against baseline, matched by configuration name.
+         * Configuration is reported as regression if p50 or p99 latency exceeds baseline by more than given relative tolerance,
+         * or if throughput drops by more than tolerance.
+         * Configurations present in only one of the lists are reported separately, as added or missing ones
+         *
+         * @return human-readable descriptions of regressions, added and missing configurations
+         */
+        static GraphBenchmarkComparison compare(const std::vector<GraphBenchmarkResult> &baseline, const std::vector<GraphBenchmarkResult> &current, double tolerance = 0.05);
+    };
+}
+
+#endif //LIBND4J_GRAPHBENCHMARK_H
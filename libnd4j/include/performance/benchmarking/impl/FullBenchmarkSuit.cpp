@@ -49,6 +49,7 @@
     int limit10 = 10;
     int limit5 = 5;
     int limit3 = 3;
+    int knnPowLimit = 20;
 #else
     int wIterations = 0;
     int rIterations = 1;
@@ -75,6 +76,7 @@
     int limit10 = 4;
     int limit5 = 3;
     int limit3 = 1;
+    int knnPowLimit = 12;
 #endif
 
 namespace nd4j {
@@ -133,6 +135,12 @@ namespace nd4j {
     }
 
 
+    static std::string knnBenchmark() {
+        // brute force search over 1M points takes seconds, so just a few runs
+        BenchmarkHelper helper(1, 3);
+        return helper.runKnnSuit(1L << knnPowLimit, 128, 1000, 10);
+    }
+
     static std::string maxPool3DBenchmark(){
         std::string output;
         BenchmarkHelper helper(wIterations, rIterations);
@@ -770,6 +778,64 @@ namespace nd4j {
         return output;
     }
 
+    static std::string linalgBenchmark() {
+        std::string output;
+        BenchmarkHelper helper(wIterations, rIterations);
+
+        // many small matrices are processed in parallel, large ones are factorized with blocked kernels
+        IntPowerParameters batch("batch", 2, 0, limit10, 2);        //2^0=1, 2^2=4, ..., 2^10=1024
+        IntPowerParameters length("length", 2, 2, limit10 - 2, 2);  //2^2=4, 2^4=16, ..., 2^8=256
+
+        ParametersBatch b({&batch, &length});
+
+        // diagonally dominant symmetric matrices: invertible and positive definite
+        auto generator = PARAMETRIC_D() {
+            auto batch = p.getIntParam("batch");
+            auto n = p.getIntParam("length");
+            auto ctx = new Context(1);
+
+            auto x = NDArrayFactory::create_<float>('c', {batch, n, n});
+            x->assign(1.0f);
+            for (Nd4jLong e = 0; e < batch; e++)
+                for (Nd4jLong i = 0; i < n; i++)
+                    x->p(e * n * n + i * n + i, (float) (n + 1));
+
+            ctx->setInputArray(0, x, true);
+            ctx->setOutputArray(0, NDArrayFactory::create_<float>('c', {batch, n, n}), true);
+            return ctx;
+        };
+
+        auto generatorDet = PARAMETRIC_D() {
+            auto batch = p.getIntParam("batch");
+            auto n = p.getIntParam("length");
+            auto ctx = new Context(1);
+
+            auto x = NDArrayFactory::create_<float>('c', {batch, n, n});
+            x->assign(1.0f);
+            for (Nd4jLong e = 0; e < batch; e++)
+                for (Nd4jLong i = 0; i < n; i++)
+                    x->p(e * n * n + i * n + i, (float) (n + 1));
+
+            ctx->setInputArray(0, x, true);
+            ctx->setOutputArray(0, NDArrayFactory::create_<float>('c', {batch}), true);
+            return ctx;
+        };
+
+        nd4j::ops::matrix_inverse inverse;
+        DeclarableBenchmark benchInverse(inverse, "matrix_inverse");
+        output += helper.runOperationSuit(&benchInverse, generator, b, "Matrix Inverse - batch x [length, length]");
+
+        nd4j::ops::cholesky cholesky;
+        DeclarableBenchmark benchCholesky(cholesky, "cholesky");
+        output += helper.runOperationSuit(&benchCholesky, generator, b, "Cholesky - batch x [length, length]");
+
+        nd4j::ops::matrix_determinant determinant;
+        DeclarableBenchmark benchDeterminant(determinant, "matrix_determinant");
+        output += helper.runOperationSuit(&benchDeterminant, generatorDet, b, "Matrix Determinant - batch x [length, length]");
+
+        return output;
+    }
+
     static std::string gemmRegularBenchmark() {
         std::string output;
         BenchmarkHelper helper(wIterations, rIterations);
@@ -1888,6 +1954,9 @@ namespace nd4j {
         nd4j_printf("Running FullBenchmarkSuite.gemmIrregularBenchmark\n", "");
         result += gemmIrregularBenchmark();
         start = done(start);
+        nd4j_printf("Running FullBenchmarkSuite.linalgBenchmark\n", "");
+        result += linalgBenchmark();
+        start = done(start);
         nd4j_printf("Running FullBenchmarkSuite.rngBenchmark\n", "");
         result += rngBenchmark();
         start = done(start);
@@ -1910,6 +1979,9 @@ namespace nd4j {
         nd4j_printf("Running FullBenchmarkSuite.maxPool3DBenchmark\n", "");
         result += maxPool3DBenchmark();
         start = done(start);
+        nd4j_printf("Running FullBenchmarkSuite.knnBenchmark\n", "");
+        result += knnBenchmark();
+        start = done(start);
 //        nd4j_printf("Running FullBenchmarkSuite.layerNormBenchmark\n", "");
 //        result += layerNormBenchmark();
 //        start = done(start);
@@ -0,0 +1,398 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <performance/benchmarking/GraphBenchmark.h>
+#include <GraphExecutioner.h>
+#include <Environment.h>
+#include <NDArray.h>
+#include <array/DataTypeUtils.h>
+#include <Status.h>
+#include <memory/Workspace.h>
+#include <helpers/RandomLauncher.h>
+#include <graph/RandomGenerator.h>
+#include <helpers/logger.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <omp.h>
+
+namespace nd4j {
+    GraphBenchmark::GraphBenchmark(const char *fileName, int warmup, int iterations) {
+        if (fileName == nullptr)
+            throw std::invalid_argument("GraphBenchmark: graph file name can't be null");
+
+        if (warmup < 0 || iterations < 1)
+            throw std::invalid_argument("GraphBenchmark: number of iterations should be positive");
+
+        _fileName = fileName;
+        _warmup = warmup;
+        _iterations = iterations;
+    }
+
+    void GraphBenchmark::setThreads(const std::vector<int> &threads) {
+        _threads = threads;
+    }
+
+    void GraphBenchmark::setBatchSizes(const std::vector<int> &batchSizes) {
+        _batchSizes = batchSizes;
+    }
+
+    void GraphBenchmark::setInputShape(const std::string &name, const std::vector<Nd4jLong> &shape) {
+        _shapes[name] = shape;
+    }
+
+    void GraphBenchmark::setDataType(nd4j::DataType dataType) {
+        _dataType = dataType;
+    }
+
+    void GraphBenchmark::feedPlaceholders(nd4j::graph::Graph *graph, int batchSize) {
+        // the same Variable can be mapped both by id and by pair
+        std::set<nd4j::graph::Variable*> visited;
+
+        for (auto v: graph->getVariableSpace()->getVariables()) {
+            if (!visited.insert(v).second)
+                continue;
+
+            auto hasName = v->getName() != nullptr && !v->getName()->empty();
+            auto overridden = hasName && _shapes.count(*v->getName()) > 0;
+
+            if (v->variableType() != nd4j::graph::VariableType::PLACEHOLDER && !v->isPlaceholder() && !overridden)
+                continue;
+
+            std::vector<Nd4jLong> shape;
+            auto dtype = _dataType;
+            if (overridden)
+                shape = _shapes[*v->getName()];
+            else if (v->hasNDArray())
+                shape = v->getNDArray()->getShapeAsVector();
+            else
+                shape = v->shape();
+
+            if (v->hasNDArray())
+                dtype = v->getNDArray()->dataType();
+
+            if (shape.empty())
+                throw std::runtime_error("GraphBenchmark: placeholder [" + (hasName ? *v->getName() : std::to_string(v->id())) + "] has no shape recorded");
+
+            // unknown first dimension is batch dimension
+            if (batchSize > 0 || shape[0] < 1)
+                shape[0] = batchSize > 0 ? batchSize : 1;
+
+            for (auto d: shape)
+                if (d < 1)
+                    throw std::runtime_error("GraphBenchmark: placeholder [" + (hasName ? *v->getName() : std::to_string(v->id())) + "] has unknown dimensions, use setInputShape()");
+
+            auto array = new NDArray('c', shape, dtype);
+            if (DataTypeUtils::isR(dtype)) {
+                nd4j::graph::RandomGenerator rng(119, v->id());
+                RandomLauncher::fillUniform(array->getContext(), rng, array, 0.0, 1.0);
+            } else {
+                // zeros are valid indices for gather-like consumers
+                array->assign(0);
+            }
+
+            if (v->hasNDArray() && v->isRemovable())
+                delete v->getNDArray();
+
+            v->setNDArray(array);
+            v->markRemovable(true);
+        }
+    }
+
+    static double percentile(const std::vector<Nd4jLong> &sorted, double p) {
+        // nearest-rank percentile
+        auto rank = static_cast<Nd4jLong>(std::ceil(p / 100.0 * sorted.size()));
+        auto idx = nd4j::math::nd4j_max<Nd4jLong>(0L, nd4j::math::nd4j_min<Nd4jLong>(rank - 1, sorted.size() - 1));
+        return sorted[idx] / 1000.0;
+    }
+
+    static int recordedBatchSize(nd4j::graph::Graph *graph) {
+        for (auto v: graph->getVariableSpace()->getVariables()) {
+            if (v->variableType() == nd4j::graph::VariableType::PLACEHOLDER && !v->shape().empty() && v->shape()[0] > 0)
+                return static_cast<int>(v->shape()[0]);
+        }
+
+        return 1;
+    }
+
+    GraphBenchmarkResult GraphBenchmark::runSingle(int threads, int batchSize) {
+        GraphBenchmarkResult result;
+
+        auto graph = nd4j::graph::GraphExecutioner::importFromFlatBuffers(_fileName.c_str());
+        if (graph == nullptr)
+            throw std::runtime_error("GraphBenchmark: unable to import graph from [" + _fileName + "]");
+
+        result._threads = threads > 0 ? threads : omp_get_max_threads();
+        result._batchSize = batchSize > 0 ? batchSize : recordedBatchSize(graph);
+        result._iterations = _iterations;
+        result._name = "threads=" + std::to_string(result._threads) + ";batch=" + std::to_string(result._batchSize);
+
+        std::vector<Nd4jLong> timings(_iterations);
+        try {
+            feedPlaceholders(graph, batchSize);
+
+            for (int e = 0; e < _warmup; e++) {
+                auto status = nd4j::graph::GraphExecutioner::execute(graph);
+                if (status != Status::OK())
+                    throw std::runtime_error("GraphBenchmark: graph execution failed during warmup");
+            }
+
+            for (int e = 0; e < _iterations; e++) {
+                auto timeStart = std::chrono::system_clock::now();
+                auto status = nd4j::graph::GraphExecutioner::execute(graph);
+                auto timeEnd = std::chrono::system_clock::now();
+
+                if (status != Status::OK())
+                    throw std::runtime_error("GraphBenchmark: graph execution failed");
+
+                timings[e] = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
+            }
+        } catch (...) {
+            delete graph;
+            throw;
+        }
+
+        delete graph;
+
+        // separate run with Workspace attached, so timings aren't affected by it.
+        // Workspace starts empty, so every allocation is accounted as spill
+        {
+            nd4j::memory::Workspace workspace;
+            auto context = LaunchContext::defaultContext();
+            auto previous = context->getWorkspace();
+
+            graph = nd4j::graph::GraphExecutioner::importFromFlatBuffers(_fileName.c_str());
+            feedPlaceholders(graph, batchSize);
+
+            context->setWorkspace(&workspace);
+            Nd4jStatus status;
+            try {
+                status = nd4j::graph::GraphExecutioner::execute(graph);
+            } catch (...) {
+                context->setWorkspace(previous);
+                delete graph;
+                throw;
+            }
+
+            result._allocatedBytes = workspace.getUsedSize() + workspace.getSpilledSize();
+            context->setWorkspace(previous);
+
+            // arrays pointing to workspace memory have to go before workspace itself
+            delete graph;
+
+            if (status != Status::OK())
+                throw std::runtime_error("GraphBenchmark: graph execution failed");
+        }
+
+        Nd4jLong total = 0L;
+        for (auto t: timings)
+            total += t;
+
+        std::sort(timings.begin(), timings.end());
+
+        result._mean = total / 1000.0 / _iterations;
+        result._min = timings.front() / 1000.0;
+        result._max = timings.back() / 1000.0;
+        result._p50 = percentile(timings, 50.0);
+        result._p90 = percentile(timings, 90.0);
+        result._p99 = percentile(timings, 99.0);
+        result._throughput = result._mean > 0.0 ? result._batchSize * 1e6 / result._mean : 0.0;
+
+        return result;
+    }
+
+    std::vector<GraphBenchmarkResult> GraphBenchmark::run() {
+        std::vector<int> threads(_threads);
+        std::vector<int> batchSizes(_batchSizes);
+
+        if (threads.empty())
+            threads.emplace_back(0);
+
+        if (batchSizes.empty())
+            batchSizes.emplace_back(0);
+
+        auto ompThreads = omp_get_max_threads();
+        auto envThreads = Environment::getInstance()->maxThreads();
+
+        std::vector<GraphBenchmarkResult> results;
+        try {
+            for (auto t: threads) {
+                if (t > 0) {
+                    omp_set_num_threads(t);
+                    Environment::getInstance()->setMaxThreads(t);
+                }
+
+                for (auto b: batchSizes)
+                    results.emplace_back(runSingle(t, b));
+
+                omp_set_num_threads(ompThreads);
+                Environment::getInstance()->setMaxThreads(envThreads);
+            }
+        } catch (...) {
+            omp_set_num_threads(ompThreads);
+            Environment::getInstance()->setMaxThreads(envThreads);
+            throw;
+        }
+
+        return results;
+    }
+
+    std::string GraphBenchmark::runAsJson() {
+        return asJson(_fileName, run());
+    }
+
+    static void appendEscaped(std::string &result, const std::string &str) {
+        for (auto c: str) {
+            if (c == '"' || c == '\\')
+                result += '\\';
+
+            result += c >= 0 && c < 0x20 ? ' ' : c;
+        }
+    }
+
+    std::string GraphBenchmark::asJson(const std::string &graphName, const std::vector<GraphBenchmarkResult> &results) {
+        std::string json("{\"graph\":\"");
+        appendEscaped(json, graphName);
+        json += "\",\"results\":[";
+
+        char buffer[512];
+        for (int e = 0; e < (int) results.size(); e++) {
+            auto &r = results[e];
+
+            json += e > 0 ? ",\n{\"name\":\"" : "\n{\"name\":\"";
+            appendEscaped(json, r._name);
+
+            snprintf(buffer, sizeof(buffer), "\",\"threads\":%i,\"batch\":%i,\"iterations\":%i,\"mean\":%.3f,\"min\":%.3f,\"max\":%.3f,\"p50\":%.3f,\"p90\":%.3f,\"p99\":%.3f,\"throughput\":%.3f,\"allocatedBytes\":%lld}",
+                     r._threads, r._batchSize, r._iterations, r._mean, r._min, r._max, r._p50, r._p90, r._p99, r._throughput, (long long) r._allocatedBytes);
+            json += buffer;
+        }
+
+        json += "\n]}\n";
+        return json;
+    }
+
+    // minimal lookup for flat objects produced by asJson(), no nesting expected within result objects
+    static bool findNumber(const std::string &object, const char *key, double &value) {
+        auto pos = object.find(std::string("\"") + key + "\":");
+        if (pos == std::string::npos)
+            return false;
+
+        value = strtod(object.c_str() + pos + strlen(key) + 3, nullptr);
+        return true;
+    }
+
+    static bool findString(const std::string &object, const char *key, std::string &value) {
+        auto pos = object.find(std::string("\"") + key + "\":\"");
+        if (pos == std::string::npos)
+            return false;
+
+        value.clear();
+        for (auto e = pos + strlen(key) + 4; e < object.size() && object[e] != '"'; e++) {
+            if (object[e] == '\\' && e + 1 < object.size())
+                e++;
+
+            value += object[e];
+        }
+
+        return true;
+    }
+
+    std::vector<GraphBenchmarkResult> GraphBenchmark::fromJson(const std::string &json) {
+        std::vector<GraphBenchmarkResult> results;
+
+        auto start = json.find("\"results\"");
+        if (start == std::string::npos)
+            throw std::invalid_argument("GraphBenchmark: no results found in JSON");
+
+        while ((start = json.find('{', start)) != std::string::npos) {
+            auto end = json.find('}', start);
+            if (end == std::string::npos)
+                break;
+
+            auto object = json.substr(start, end - start + 1);
+            start = end + 1;
+
+            GraphBenchmarkResult r;
+            if (!findString(object, "name", r._name))
+                continue;
+
+            double value = 0.0;
+            if (findNumber(object, "threads", value)) r._threads = static_cast<int>(value);
+            if (findNumber(object, "batch", value)) r._batchSize = static_cast<int>(value);
+            if (findNumber(object, "iterations", value)) r._iterations = static_cast<int>(value);
+            // reports of earlier versions store the same value as peakBytes
+            if (findNumber(object, "allocatedBytes", value) || findNumber(object, "peakBytes", value)) r._allocatedBytes = static_cast<Nd4jLong>(value);
+
+            findNumber(object, "mean", r._mean);
+            findNumber(object, "min", r._min);
+            findNumber(object, "max", r._max);
+            findNumber(object, "p50", r._p50);
+            findNumber(object, "p90", r._p90);
+            findNumber(object, "p99", r._p99);
+            findNumber(object, "throughput", r._throughput);
+
+            results.emplace_back(r);
+        }
+
+        return results;
+    }
+
+    GraphBenchmarkComparison GraphBenchmark::compare(const std::vector<GraphBenchmarkResult> &baseline, const std::vector<GraphBenchmarkResult> &current, double tolerance) {
+        GraphBenchmarkComparison comparison;
+        auto &regressions = comparison._regressions;
+        char buffer[512];
+
+        for (auto &c: current) {
+            auto b = std::find_if(baseline.begin(), baseline.end(), [&](const GraphBenchmarkResult &r) { return r._name == c._name; });
+            if (b == baseline.end()) {
+                snprintf(buffer, sizeof(buffer), "[%s] new configuration, not present in baseline", c._name.c_str());
+                comparison._added.emplace_back(buffer);
+                continue;
+            }
+
+            if (b->_p50 > 0.0 && c._p50 > b->_p50 * (1.0 + tolerance)) {
+                snprintf(buffer, sizeof(buffer), "[%s] p50 latency: %.3f us vs baseline %.3f us (+%.1f%%)", c._name.c_str(), c._p50, b->_p50, (c._p50 / b->_p50 - 1.0) * 100.0);
+                regressions.emplace_back(buffer);
+            }
+
+            if (b->_p99 > 0.0 && c._p99 > b->_p99 * (1.0 + tolerance)) {
+                snprintf(buffer, sizeof(buffer), "[%s] p99 latency: %.3f us vs baseline %.3f us (+%.1f%%)", c._name.c_str(), c._p99, b->_p99, (c._p99 / b->_p99 - 1.0) * 100.0);
+                regressions.emplace_back(buffer);
+            }
+
+            if (b->_throughput > 0.0 && c._throughput < b->_throughput * (1.0 - tolerance)) {
+                snprintf(buffer, sizeof(buffer), "[%s] throughput: %.3f vs baseline %.3f (-%.1f%%)", c._name.c_str(), c._throughput, b->_throughput, (1.0 - c._throughput / b->_throughput) * 100.0);
+                regressions.emplace_back(buffer);
+            }
+        }
+
+        // renamed or dropped configurations can't be compared, so they're reported instead of being skipped silently
+        for (auto &b: baseline) {
+            auto c = std::find_if(current.begin(), current.end(), [&](const GraphBenchmarkResult &r) { return r._name == b._name; });
+            if (c == current.end()) {
+                snprintf(buffer, sizeof(buffer), "[%s] missing configuration, present in baseline only", b._name.c_str());
+                comparison._missing.emplace_back(buffer);
+            }
+        }
+
+        return comparison;
+    }
+}
@@ -591,6 +591,21 @@ namespace nd4j {
         return output;
     }
 
+    static std::string inlinedLambda() {
+        BenchmarkHelper helper(WARMUP, NUM_ITER);
+        return helper.runLambdaSuit({65536, 1048576, 4194304});
+    }
+
+    static std::string fusedChain() {
+        BenchmarkHelper helper(WARMUP, NUM_ITER);
+        return helper.runFusedChainSuit({65536, 1048576, 4194304});
+    }
+
+    static std::string sparseMmul() {
+        BenchmarkHelper helper(WARMUP, NUM_ITER);
+        return helper.runSparseMmulSuit(512, 4096, 256, {0.001, 0.01, 0.05, 0.2});
+    }
+
     std::string LightBenchmarkSuit::runSuit() {
 #ifdef _RELEASE
         std::vector<nd4j::DataType> dtypes({nd4j::DataType::FLOAT32, nd4j::DataType::HALF});
@@ -633,6 +648,12 @@ namespace nd4j {
         result += broadcast2d();
         nd4j_printf("Running LightBenchmarkSuite.mismatchedOrderAssign\n", "");
         result += mismatchedOrderAssign();
+        nd4j_printf("Running LightBenchmarkSuite.inlinedLambda\n", "");
+        result += inlinedLambda();
+        nd4j_printf("Running LightBenchmarkSuite.fusedChain\n", "");
+        result += fusedChain();
+        nd4j_printf("Running LightBenchmarkSuite.sparseMmul\n", "");
+        result += sparseMmul();
 
         return result;
     }
@@ -80,6 +80,16 @@
         (nd4j::DataType::INT32, int32_t), \
         (nd4j::DataType::INT64, Nd4jLong)
 
+#define QUANTIZED_TYPES \
+        (nd4j::DataType::INT8, int8_t), \
+        (nd4j::DataType::UINT8, uint8_t)
+
+#define QUANTIZED_OUTPUT_TYPES \
+        (nd4j::DataType::FLOAT32, float), \
+        (nd4j::DataType::DOUBLE, double), \
+        (nd4j::DataType::INT8, int8_t), \
+        (nd4j::DataType::UINT8, uint8_t)
+
 #define FLOAT_NATIVE \
         (nd4j::DataType::FLOAT32, float), \
         (nd4j::DataType::DOUBLE, double)
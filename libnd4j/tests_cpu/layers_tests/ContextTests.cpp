@@ -353,4 +353,74 @@ TEST_F(ContextTests, test_short_context_3) {
     auto z = ctx.fastpath_out()[0];
 
     ASSERT_EQ(exp, *z);
-}
\ No newline at end of file
+}
+TEST_F(ContextTests, test_view_outputs_1) {
+    VariableSpace variableSpace;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 3, 4});
+    x->linspace(1.f);
+    variableSpace.putVariable(-1, x);
+
+    auto exp = x->reshape('c', {6, 4});
+
+    Context ctx(1, &variableSpace);
+    ctx.pickInput(-1);
+    ctx.getIArguments()->push_back(-'c');
+    ctx.getIArguments()->push_back(6);
+    ctx.getIArguments()->push_back(4);
+    ctx.allowViewOutputs(true);
+
+    nd4j::ops::reshape op;
+    ASSERT_EQ(Status::OK(), op.execute(&ctx));
+
+    auto z = variableSpace.getVariable(1, 0)->getNDArray();
+    ASSERT_EQ(x->getDataBuffer()->primary(), z->getDataBuffer()->primary());
+    ASSERT_EQ(exp, *z);
+
+    // view shares data with input
+    x->p(0, 119.f);
+    ASSERT_NEAR(119.f, z->e<float>(0), 1e-5);
+}
+
+TEST_F(ContextTests, test_view_outputs_2) {
+    VariableSpace variableSpace;
+
+    auto x = NDArrayFactory::create_<float>('c', {4, 5});
+    x->linspace(1.f);
+    variableSpace.putVariable(-1, x);
+
+    auto exp = NDArrayFactory::create<float>('c', {2, 2}, {7.f, 9.f, 12.f, 14.f});
+
+    // strided_slice with positive strides: x[1:3, 1:5:2]
+    Context ctx(1, &variableSpace);
+    ctx.pickInput(-1);
+    for (auto v: {0, 0, 0, 0, 0, 1, 1, 3, 5, 1, 2})
+        ctx.getIArguments()->push_back(v);
+    ctx.allowViewOutputs(true);
+
+    nd4j::ops::strided_slice op;
+    ASSERT_EQ(Status::OK(), op.execute(&ctx));
+
+    auto z = variableSpace.getVariable(1, 0)->getNDArray();
+    ASSERT_EQ(exp, *z);
+    ASSERT_EQ(x->getDataBuffer()->primary(), z->getDataBuffer()->primary());
+
+    // transpose of view is a view as well, but without permission it's a copy
+    Context ctx2(2, &variableSpace);
+    ctx2.pickInput(1, 0);
+    ctx2.allowViewOutputs(true);
+
+    nd4j::ops::transpose transpose;
+    ASSERT_EQ(Status::OK(), transpose.execute(&ctx2));
+    auto t = variableSpace.getVariable(2, 0)->getNDArray();
+    ASSERT_EQ(exp.transpose(), *t);
+    ASSERT_EQ(x->getDataBuffer()->primary(), t->getDataBuffer()->primary());
+
+    Context ctx3(3, &variableSpace);
+    ctx3.pickInput(1, 0);
+
+    ASSERT_EQ(Status::OK(), transpose.execute(&ctx3));
+    auto c = variableSpace.getVariable(3, 0)->getNDArray();
+    ASSERT_EQ(exp.transpose(), *c);
+    ASSERT_NE(x->getDataBuffer()->primary(), c->getDataBuffer()->primary());
+}
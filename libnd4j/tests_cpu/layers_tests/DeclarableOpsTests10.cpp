@@ -1923,6 +1923,31 @@ TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressing_2) {
     delete results;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Image_CombinedNonMaxSuppressing_1) {
+
+    NDArray boxes    = NDArrayFactory::create<float>('c', {1,6,1,4}, {0, 0, 1, 1, 0, 0.1f, 1, 1.1f, 0, -0.1f, 1.f, 0.9f,
+                                         0, 10, 1, 11, 0, 10.1f, 1.f, 11.1f, 0, 100, 1, 101});
+    NDArray scores = NDArrayFactory::create<float>('c', {1,6,2}, {0.9f, 0.1f, .75f, 0.2f, .6f, 0.8f, .95f, 0.05f, .5f, 0.7f, .3f, 0.f});
+    NDArray expBoxes = NDArrayFactory::create<float>('c', {1,4,4}, {0, 10, 1, 11, 0, 0, 1, 1, 0, -0.1f, 1.f, 0.9f, 0, 10.1f, 1.f, 11.1f});
+    NDArray expScores = NDArrayFactory::create<float>('c', {1,4}, {.95f, 0.9f, 0.8f, 0.7f});
+    NDArray expClasses = NDArrayFactory::create<float>('c', {1,4}, {0.f, 0.f, 1.f, 1.f});
+    NDArray expValid = NDArrayFactory::create<int>('c', {1}, {4});
+
+    nd4j::ops::combined_non_max_suppression op;
+    auto results = op.execute({&boxes, &scores}, {0.5}, {3, 4, 0});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    ASSERT_TRUE(expBoxes.isSameShape(results->at(0)));
+    ASSERT_TRUE(expBoxes.equalsTo(results->at(0)));
+    ASSERT_TRUE(expScores.equalsTo(results->at(1)));
+    ASSERT_TRUE(expClasses.equalsTo(results->at(2)));
+    ASSERT_TRUE(expValid.equalsTo(results->at(3)));
+
+    delete results;
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests10, Image_CropAndResize_1) {
     int axis = 0;
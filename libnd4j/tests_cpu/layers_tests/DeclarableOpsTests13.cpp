@@ -402,6 +402,38 @@ TEST_F(DeclarableOpsTests13, BarnesHutTsne_symmetrized_4) {
     delete result;
 }
 
+TEST_F(DeclarableOpsTests13, BarnesHutTsne_RepulsiveForces_1) {
+    auto data = NDArrayFactory::create<double>('c', {5, 2}, {0., 0., 1., 0., 0., 2., 1., 1., -1., 0.5});
+    auto exp = NDArrayFactory::create<double>('c', {5, 2}, {-0.163580, -0.289877, 0.350340, -0.323696, -0.083526, 0.329712, 0.294785, 0.268141, -0.398019, 0.015720});
+    auto expSum = NDArrayFactory::create<double>(6.188049);
+
+    // theta = 0 means no approximation at all
+    nd4j::ops::barnes_repulsive_forces op;
+    auto result = op.execute({&data}, {0.}, {});
+    ASSERT_EQ(result->status(), Status::OK());
+
+    ASSERT_TRUE(exp.isSameShape(result->at(0)));
+    ASSERT_TRUE(exp.equalsTo(result->at(0), 1e-5));
+    ASSERT_TRUE(expSum.equalsTo(result->at(1), 1e-5));
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests13, BarnesHutTsne_RepulsiveForces_2) {
+    auto data = NDArrayFactory::create<float>('c', {200, 2});
+    data.linspace(1.f, 0.37f);
+    data.applyTransform(transform::Sin, nullptr, nullptr);
+
+    nd4j::ops::barnes_repulsive_forces op;
+    auto exact = op.execute({&data}, {0.}, {});
+    auto approx = op.execute({&data}, {0.5}, {});
+    ASSERT_EQ(exact->status(), Status::OK());
+    ASSERT_EQ(approx->status(), Status::OK());
+
+    ASSERT_NEAR(exact->at(1)->e<float>(0), approx->at(1)->e<float>(0), 0.05f * exact->at(1)->e<float>(0));
+    delete exact;
+    delete approx;
+}
+
 TEST_F(DeclarableOpsTests13, CellContains_test_1) {
 
     auto corners = NDArrayFactory::create<double>( {0.5384,    0.5640,    0.3449,    0.5257,    0.5505});
@@ -25,6 +25,7 @@
 #include <ops/ops.h>
 #include <GradCheck.h>
 #include <array>
+#include <loops/fused_chain.h>
 
 
 using namespace nd4j;
@@ -133,4 +134,144 @@ TEST_F(DeclarableOpsTests16, test_hamming_distance_1) {
     ASSERT_EQ(e, *z);
 
     delete result;
-}
\ No newline at end of file
+}
+TEST_F(DeclarableOpsTests16, test_fused_elementwise_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {-3.f, -1.f, 0.f, 1.f, 2.f, 4.f});
+    auto f = NDArrayFactory::create<float>('f', {2, 3});
+    auto b = NDArrayFactory::create<float>('c', {3}, {1.f, -2.f, 0.5f});
+    auto e = NDArrayFactory::create<float>('c', {2, 3}, {0.f, 0.f, 0.5f, 3.f, 2.f, 5.f});
+    f.assign(x);
+
+    // x * 2 + b -> relu -> clip(0, 5)
+    std::vector<Nd4jLong> program({functions::fused::SCALAR, scalar::Multiply, 0, 1,
+                                   functions::fused::PAIRWISE, pairwise::Add, 1, 0,
+                                   functions::fused::SCALAR, scalar::RELU, 0, 1,
+                                   functions::fused::TRANSFORM_SAME, transform::ClipByValue, 0, 2});
+    std::vector<double> tArgs({2.0, 0.0, 0.0, 5.0});
+    std::vector<bool> bArgs;
+
+    nd4j::ops::fused_elementwise op;
+
+    // contiguous arrays go to fused kernel, 'f' ordered input is executed step by step
+    for (auto input: {&x, &f}) {
+        auto z = NDArrayFactory::create<float>('c', {2, 3});
+        std::vector<NDArray*> in({input, &b});
+        std::vector<NDArray*> out({&z});
+
+        ASSERT_EQ(Status::OK(), op.execute(in, out, tArgs, program, bArgs));
+        ASSERT_EQ(e, z);
+    }
+}
+
+TEST_F(DeclarableOpsTests16, test_embedding_bag_1) {
+    auto table = NDArrayFactory::create<float>('c', {4, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f});
+    auto ids = NDArrayFactory::create<Nd4jLong>({1, 3, 1, 0, 2});
+    auto offsets = NDArrayFactory::create<Nd4jLong>({0, 3, 3});
+    auto weights = NDArrayFactory::create<float>({1.f, 2.f, 1.f, 0.5f, 2.f});
+
+    // second bag is empty
+    auto eSum = NDArrayFactory::create<float>('c', {3, 2}, {20.f, 24.f, 0.f, 0.f, 10.5f, 13.f});
+    auto eMean = NDArrayFactory::create<float>('c', {3, 2}, {5.f, 6.f, 0.f, 0.f, 4.2f, 5.2f});
+
+    nd4j::ops::embedding_bag op;
+
+    auto result = op.execute({&table, &ids, &offsets, &weights}, {}, {0});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_EQ(eSum, *result->at(0));
+    delete result;
+
+    result = op.execute({&table, &ids, &offsets, &weights}, {}, {1});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_EQ(eMean, *result->at(0));
+    delete result;
+
+    // 2D ids, one bag per row, no weights
+    auto ids2 = NDArrayFactory::create<int>('c', {2, 2}, {0, 3, 2, 2});
+    auto eSqrtN = NDArrayFactory::create<float>('c', {2, 2}, {8.f / sqrtf(2.f), 10.f / sqrtf(2.f), 10.f / sqrtf(2.f), 12.f / sqrtf(2.f)});
+
+    result = op.execute({&table, &ids2}, {}, {2});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_TRUE(eSqrtN.equalsTo(result->at(0)));
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests16, test_embedding_bag_bp_1) {
+    auto table = NDArrayFactory::create<float>('c', {4, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f});
+    auto ids = NDArrayFactory::create<Nd4jLong>({1, 3, 1, 0, 2});
+    auto offsets = NDArrayFactory::create<Nd4jLong>({0, 3, 3});
+    auto weights = NDArrayFactory::create<float>({1.f, 2.f, 1.f, 0.5f, 2.f});
+    auto gradO = NDArrayFactory::create<float>('c', {3, 2}, {1.f, 1.f, 0.f, 0.f, 1.f, 2.f});
+
+    // repeated id 1 gets one row
+    auto eIds = NDArrayFactory::create<Nd4jLong>({1, 3, 0, 2});
+    auto eRows = NDArrayFactory::create<float>('c', {4, 2}, {2.f, 2.f, 2.f, 2.f, 0.5f, 1.f, 2.f, 4.f});
+    auto eGradW = NDArrayFactory::create<float>({7.f, 15.f, 7.f, 5.f, 17.f});
+
+    nd4j::ops::embedding_bag_bp op;
+    auto result = op.execute({&table, &ids, &offsets, &weights, &gradO}, {}, {0});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_EQ(3, result->size());
+
+    ASSERT_EQ(eIds, *result->at(0));
+    ASSERT_EQ(eRows, *result->at(1));
+    ASSERT_EQ(eGradW, *result->at(2));
+
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests16, test_knn_1) {
+    auto reference = NDArrayFactory::create<float>('c', {4, 2}, {0.f, 0.f, 1.f, 0.f, 3.f, 0.f, 6.f, 0.f});
+    auto query = NDArrayFactory::create<float>('c', {2, 2}, {0.9f, 0.f, 5.f, 0.f});
+
+    auto eIndices = NDArrayFactory::create<Nd4jLong>('c', {2, 2}, {1, 0, 3, 2});
+    auto eDistances = NDArrayFactory::create<float>('c', {2, 2}, {0.1f, 0.9f, 1.f, 2.f});
+
+    nd4j::ops::knn op;
+
+    // euclidean goes through gemm, manhattan is computed directly, both give the same here
+    for (int metric: {0, 2}) {
+        auto result = op.execute({&query, &reference}, {}, {2, metric});
+        ASSERT_EQ(Status::OK(), result->status());
+
+        ASSERT_EQ(eIndices, *result->at(0));
+        ASSERT_TRUE(eDistances.equalsTo(result->at(1), 1e-4));
+
+        delete result;
+    }
+}
+
+TEST_F(DeclarableOpsTests16, test_vptree_1) {
+    auto points = NDArrayFactory::create<float>('c', {300, 3});
+    auto queries = NDArrayFactory::create<float>('c', {20, 3});
+
+    uint32_t state = 17;
+    for (auto array: {&points, &queries}) {
+        for (Nd4jLong e = 0; e < array->lengthOf(); e++) {
+            state = state * 1664525u + 1013904223u;
+            array->p(e, static_cast<float>(state >> 8) / 16777216.0f);
+        }
+    }
+
+    nd4j::ops::vptree_build build;
+    nd4j::ops::vptree_query query;
+    nd4j::ops::knn knn;
+
+    // tree has to find exactly the same neighbours as brute force
+    for (int metric: {0, 2}) {
+        auto tree = build.execute({&points}, {}, {metric});
+        ASSERT_EQ(Status::OK(), tree->status());
+
+        auto result = query.execute({&points, tree->at(0), tree->at(1), &queries}, {}, {5, metric});
+        ASSERT_EQ(Status::OK(), result->status());
+
+        auto expected = knn.execute({&queries, &points}, {}, {5, metric});
+        ASSERT_EQ(Status::OK(), expected->status());
+
+        ASSERT_EQ(*expected->at(0), *result->at(0));
+        ASSERT_TRUE(expected->at(1)->equalsTo(result->at(1), 1e-4));
+
+        delete tree;
+        delete result;
+        delete expected;
+    }
+}
@@ -164,6 +164,45 @@ TEST_F(DeclarableOpsTests3, Test_Unique_2) {
     delete result;
 }
 
+TEST_F(DeclarableOpsTests3, Test_Unique_3) {
+    // big enough to go through partitioned path
+    const Nd4jLong length = 100000;
+    auto x = NDArrayFactory::create<int>('c', {length});
+    for (Nd4jLong e = 0; e < length; e++)
+        x.p(e, (int) ((e * 7919) % 1013));
+
+    std::vector<int> expV;
+    std::vector<Nd4jLong> expI(length);
+    std::map<int, Nd4jLong> positions;
+    for (Nd4jLong e = 0; e < length; e++) {
+        auto v = x.e<int>(e);
+        if (positions.count(v) == 0) {
+            positions[v] = expV.size();
+            expV.emplace_back(v);
+        }
+        expI[e] = positions[v];
+    }
+
+    nd4j::ops::unique_with_counts op;
+    auto result = op.execute({&x}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto v = result->at(0);
+    auto i = result->at(1);
+    auto c = result->at(2);
+
+    ASSERT_EQ((Nd4jLong) expV.size(), v->lengthOf());
+    for (Nd4jLong e = 0; e < v->lengthOf(); e++) {
+        ASSERT_EQ(expV[e], v->e<int>(e));
+        ASSERT_TRUE(c->e<Nd4jLong>(e) == 98 || c->e<Nd4jLong>(e) == 99);
+    }
+
+    for (Nd4jLong e = 0; e < length; e++)
+        ASSERT_EQ(expI[e], i->e<Nd4jLong>(e));
+
+    delete result;
+}
+
 TEST_F(DeclarableOpsTests3, Test_Rint_1) {
     auto x= NDArrayFactory::create<float>('c', {1, 7}, {-1.7, -1.5, -0.2, 0.2, 1.5, 1.7, 2.0});
     auto exp= NDArrayFactory::create<float>('c', {1, 7}, {-2., -2., -0., 0., 2., 2., 2.});
@@ -379,6 +418,116 @@ TEST_F(DeclarableOpsTests3, Test_ListDiff_1) {
     delete result;
 }
 
+TEST_F(DeclarableOpsTests3, Test_ListDiff_2) {
+    // more than 65536 keep values, so keep set is partitioned
+    const Nd4jLong length = 200000;
+    auto x = NDArrayFactory::create<int>('c', {length});
+    auto y = NDArrayFactory::create<int>('c', {length / 2 + 10});
+
+    // x is permutation of [0, length), y holds all even values, and a few values absent in x
+    for (Nd4jLong e = 0; e < length; e++)
+        x.p(e, (int) ((e * 7919) % length));
+
+    for (Nd4jLong e = 0; e < length / 2; e++)
+        y.p(e, (int) (e * 2));
+
+    for (Nd4jLong e = length / 2; e < y.lengthOf(); e++)
+        y.p(e, (int) (-e));
+
+    std::vector<int> expV;
+    std::vector<Nd4jLong> expI;
+    for (Nd4jLong e = 0; e < length; e++) {
+        auto v = x.e<int>(e);
+        if (v % 2 != 0) {
+            expV.emplace_back(v);
+            expI.emplace_back(e);
+        }
+    }
+
+    nd4j::ops::listdiff op;
+    auto result = op.execute({&x, &y}, {}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    auto z0 = result->at(0);
+    auto z1 = result->at(1);
+
+    ASSERT_EQ((Nd4jLong) expV.size(), z0->lengthOf());
+    ASSERT_EQ((Nd4jLong) expI.size(), z1->lengthOf());
+
+    for (Nd4jLong e = 0; e < z0->lengthOf(); e++) {
+        ASSERT_EQ(expV[e], z0->e<int>(e));
+        ASSERT_EQ(expI[e], z1->e<Nd4jLong>(e));
+    }
+
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests3, Test_DynamicPartition_Large_1) {
+    // enough elements to split scatter between threads, TAD branch
+    const Nd4jLong rows = 100000, cols = 8;
+    const int numPartitions = 3;
+    auto x = NDArrayFactory::create<float>('c', {rows, cols});
+    auto y = NDArrayFactory::create<int>('c', {rows});
+    x.linspace(0);
+
+    // uneven partitions
+    std::vector<std::vector<Nd4jLong>> expRows(numPartitions);
+    for (Nd4jLong e = 0; e < rows; e++) {
+        auto p = (int) ((e % 7) % numPartitions);
+        y.p(e, p);
+        expRows[p].emplace_back(e);
+    }
+
+    nd4j::ops::dynamic_partition op;
+    auto result = op.execute({&x, &y}, {}, {numPartitions});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_EQ(numPartitions, result->size());
+
+    for (int p = 0; p < numPartitions; p++) {
+        auto z = result->at(p);
+        ASSERT_EQ(2, z->rankOf());
+        ASSERT_EQ((Nd4jLong) expRows[p].size(), z->sizeAt(0));
+        ASSERT_EQ(cols, z->sizeAt(1));
+
+        for (Nd4jLong r = 0; r < z->sizeAt(0); r++)
+            for (Nd4jLong c = 0; c < cols; c++)
+                ASSERT_EQ((float) (expRows[p][r] * cols + c), z->e<float>(r, c));
+    }
+
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests3, Test_DynamicPartition_Large_2) {
+    // indices have the same shape as input, so elements are scattered one by one
+    const Nd4jLong length = 200000;
+    const int numPartitions = 3;
+    auto x = NDArrayFactory::create<int>('c', {length});
+    auto y = NDArrayFactory::create<int>('c', {length});
+    x.linspace(0);
+
+    std::vector<std::vector<int>> expValues(numPartitions);
+    for (Nd4jLong e = 0; e < length; e++) {
+        auto p = (int) ((e % 7) % numPartitions);
+        y.p(e, p);
+        expValues[p].emplace_back((int) e);
+    }
+
+    nd4j::ops::dynamic_partition op;
+    auto result = op.execute({&x, &y}, {}, {numPartitions});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_EQ(numPartitions, result->size());
+
+    for (int p = 0; p < numPartitions; p++) {
+        auto z = result->at(p);
+        ASSERT_EQ((Nd4jLong) expValues[p].size(), z->lengthOf());
+
+        for (Nd4jLong e = 0; e < z->lengthOf(); e++)
+            ASSERT_EQ(expValues[p][e], z->e<int>(e));
+    }
+
+    delete result;
+}
+
 TEST_F(DeclarableOpsTests3, Test_Range_1) {
     auto start = NDArrayFactory::create<float>(0.3);
     auto stop = NDArrayFactory::create<float>(-5);
@@ -2790,6 +2939,229 @@ TEST_F(DeclarableOpsTests3, svd_test11) {
     delete results;
 }
 
+///////////////////////////////////////////////////////////////////
+// checks that columns of u and v are orthonormal for each matrix in batch, and if exact also that u * diag(s) * v^T == x
+static void checkSvd(NDArray& x, NDArray* s, NDArray* u, NDArray* v, bool exact, double eps) {
+    const Nd4jLong rows = x.sizeAt(-2), cols = x.sizeAt(-1);
+    const Nd4jLong diagSize = s->sizeAt(-1), uCols = u->sizeAt(-1), vCols = v->sizeAt(-1);
+    const Nd4jLong numMatrices = x.lengthOf() / (rows * cols);
+
+    for (Nd4jLong e = 0; e < numMatrices; e++) {
+        for (Nd4jLong k = 1; k < diagSize; k++)
+            ASSERT_TRUE(s->e<double>(e * diagSize + k - 1) >= s->e<double>(e * diagSize + k));
+
+        double maxError = 0.;
+        if (exact)
+            for (Nd4jLong i = 0; i < rows; i++)
+                for (Nd4jLong j = 0; j < cols; j++) {
+                    double sum = 0.;
+                    for (Nd4jLong k = 0; k < diagSize; k++)
+                        sum += u->e<double>(e * rows * uCols + i * uCols + k) * s->e<double>(e * diagSize + k) * v->e<double>(e * cols * vCols + j * vCols + k);
+
+                    maxError = nd4j::math::nd4j_max<double>(maxError, nd4j::math::nd4j_abs<double>(x.e<double>(e * rows * cols + i * cols + j) - sum));
+                }
+        ASSERT_NEAR(0., maxError, eps);
+
+        // u^T * u == I and v^T * v == I
+        for (auto pair : {std::make_pair(u, rows), std::make_pair(v, cols)}) {
+            auto a = pair.first;
+            const Nd4jLong len = pair.second, numCols = a->sizeAt(-1);
+
+            maxError = 0.;
+            for (Nd4jLong p = 0; p < numCols; p++)
+                for (Nd4jLong q = 0; q < numCols; q++) {
+                    double dot = 0.;
+                    for (Nd4jLong i = 0; i < len; i++)
+                        dot += a->e<double>(e * len * numCols + i * numCols + p) * a->e<double>(e * len * numCols + i * numCols + q);
+
+                    maxError = nd4j::math::nd4j_max<double>(maxError, nd4j::math::nd4j_abs<double>(dot - (p == q ? 1. : 0.)));
+                }
+            ASSERT_NEAR(0., maxError, eps);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests3, svd_test12) {
+    // diagSize >= switchNum, so QR + one-sided Jacobi is used
+    const Nd4jLong b = 2, m = 40, n = 30;
+    auto x = NDArrayFactory::create<double>('c', {b, m, n});
+    x.linspace(1);
+    x.applyTransform(transform::Sin, nullptr, nullptr);
+
+    for (Nd4jLong e = 0; e < b; e++)
+        for (Nd4jLong i = 0; i < n; i++)
+            x.p(e * m * n + i * n + i, x.e<double>(e * m * n + i * n + i) + 1.);
+
+    nd4j::ops::svd op;
+    auto results = op.execute({&x}, {}, {0, 1, 16});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    auto s = results->at(0);
+    auto u = results->at(1);
+    auto v = results->at(2);
+
+    ASSERT_TRUE(s->isSameShape({b, n}));
+    ASSERT_TRUE(u->isSameShape({b, m, n}));
+    ASSERT_TRUE(v->isSameShape({b, n, n}));
+
+    for (Nd4jLong e = 0; e < b; e++) {
+        for (Nd4jLong k = 1; k < n; k++)
+            ASSERT_TRUE(s->e<double>(e * n + k - 1) >= s->e<double>(e * n + k));
+
+        // u * diag(s) * v^T == x
+        for (Nd4jLong i = 0; i < m; i++)
+            for (Nd4jLong j = 0; j < n; j++) {
+                double sum = 0.;
+                for (Nd4jLong k = 0; k < n; k++)
+                    sum += u->e<double>(e * m * n + i * n + k) * s->e<double>(e * n + k) * v->e<double>(e * n * n + j * n + k);
+
+                ASSERT_NEAR(x.e<double>(e * m * n + i * n + j), sum, 1e-10);
+            }
+    }
+
+    delete results;
+
+    // wide matrices are routed by diagSize as well: 30 x 40 goes to one-sided Jacobi, 10 x 40 to two-sided Jacobi
+    for (Nd4jLong rows : {30, 10}) {
+        auto w = NDArrayFactory::create<double>('c', {b, rows, m});
+        w.linspace(0.5, 0.7);
+        w.applyTransform(transform::Sin, nullptr, nullptr);
+
+        for (int fullUV = 0; fullUV < 2; fullUV++) {
+            auto wide = op.execute({&w}, {}, {fullUV, 1, 16});
+            ASSERT_EQ(ND4J_STATUS_OK, wide->status());
+
+            ASSERT_TRUE(wide->at(0)->isSameShape({b, rows}));
+            ASSERT_TRUE(wide->at(1)->isSameShape({b, rows, rows}));
+            ASSERT_TRUE(wide->at(2)->isSameShape({b, m, fullUV ? m : rows}));
+
+            checkSvd(w, wide->at(0), wide->at(1), wide->at(2), true, 1e-10);
+
+            delete wide;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests3, svd_test13) {
+    // top-k singular values of randomized svd should match leading values of full svd
+    const Nd4jLong b = 2, m = 60, n = 50, topK = 5;
+    auto x = NDArrayFactory::create<double>('c', {b, m, n});
+
+    // Hilbert-like matrices, singular values decay fast
+    for (Nd4jLong e = 0; e < b; e++)
+        for (Nd4jLong i = 0; i < m; i++)
+            for (Nd4jLong j = 0; j < n; j++)
+                x.p(e * m * n + i * n + j, 1. / (double) (i + j + e + 1));
+
+    nd4j::ops::svd op;
+
+    // randomized path depends on generator state, so svd can't be folded as constant
+    ASSERT_FALSE(op.getOpDescriptor()->isPure());
+
+    auto full = op.execute({&x}, {}, {0, 0, 16});
+    ASSERT_EQ(ND4J_STATUS_OK, full->status());
+
+    auto results = op.execute({&x}, {}, {0, 1, 16, topK});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    auto s = results->at(0);
+    auto u = results->at(1);
+    auto v = results->at(2);
+
+    ASSERT_TRUE(s->isSameShape({b, topK}));
+    ASSERT_TRUE(u->isSameShape({b, m, topK}));
+    ASSERT_TRUE(v->isSameShape({b, n, topK}));
+
+    for (Nd4jLong e = 0; e < b; e++)
+        for (Nd4jLong k = 0; k < topK; k++)
+            ASSERT_NEAR(full->at(0)->e<double>(e * n + k), s->e<double>(e * topK + k), 1e-6);
+
+    checkSvd(x, s, u, v, false, 1e-8);
+
+    delete results;
+    delete full;
+
+    // wide matrices: transposed Hilbert-like ones, same singular values
+    auto w = NDArrayFactory::create<double>('c', {b, n, m});
+    for (Nd4jLong e = 0; e < b; e++)
+        for (Nd4jLong i = 0; i < n; i++)
+            for (Nd4jLong j = 0; j < m; j++)
+                w.p(e * m * n + i * m + j, 1. / (double) (i + j + e + 1));
+
+    full = op.execute({&w}, {}, {0, 0, 16});
+    ASSERT_EQ(ND4J_STATUS_OK, full->status());
+
+    results = op.execute({&w}, {}, {0, 1, 16, topK});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    ASSERT_TRUE(results->at(0)->isSameShape({b, topK}));
+    ASSERT_TRUE(results->at(1)->isSameShape({b, n, topK}));
+    ASSERT_TRUE(results->at(2)->isSameShape({b, m, topK}));
+
+    for (Nd4jLong e = 0; e < b; e++)
+        for (Nd4jLong k = 0; k < topK; k++)
+            ASSERT_NEAR(full->at(0)->e<double>(e * n + k), results->at(0)->e<double>(e * topK + k), 1e-6);
+
+    checkSvd(w, results->at(0), results->at(1), results->at(2), false, 1e-8);
+
+    delete results;
+    delete full;
+}
+
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests3, svd_test14) {
+    // rank deficient square matrices: columns are centered, so ones / 4 is null vector, and missing u columns have to be completed
+    const Nd4jLong b = 2, n = 16;
+    auto x = NDArrayFactory::create<double>('c', {b, n, n});
+    x.linspace(1);
+    x.applyTransform(transform::Sin, nullptr, nullptr);
+
+    auto mean = x.reduceAlongDims(reduce::Mean, {1}, true);
+    x -= mean;
+
+    // second matrix is of rank 2
+    for (Nd4jLong i = 0; i < n; i++)
+        for (Nd4jLong j = 0; j < n; j++)
+            x.p(n * n + i * n + j, (double) ((i + 1) * (j % 3) + (i % 2) * (j + 1)));
+
+    nd4j::ops::svd op;
+    for (int fullUV = 0; fullUV < 2; fullUV++) {
+        auto results = op.execute({&x}, {}, {fullUV, 1, 16});
+        ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+        ASSERT_TRUE(results->at(1)->isSameShape({b, n, n}));
+        ASSERT_TRUE(results->at(2)->isSameShape({b, n, n}));
+
+        checkSvd(x, results->at(0), results->at(1), results->at(2), true, 1e-10);
+
+        delete results;
+    }
+}
+
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests3, svd_test15) {
+    // tall rank deficient matrices with full u: null space of R and columns past diagSize together form orthonormal basis
+    const Nd4jLong m = 40, n = 20;
+    auto x = NDArrayFactory::create<double>('c', {1, m, n});
+    for (Nd4jLong i = 0; i < m; i++)
+        for (Nd4jLong j = 0; j < n; j++)
+            x.p(i * n + j, nd4j::math::nd4j_sin<double, double>((double) (i + 1)) * (j % 4) + (double) (i % 3) * nd4j::math::nd4j_cos<double, double>((double) j));
+
+    nd4j::ops::svd op;
+    auto results = op.execute({&x}, {}, {1, 1, 16});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    ASSERT_TRUE(results->at(0)->isSameShape({1, n}));
+    ASSERT_TRUE(results->at(1)->isSameShape({1, m, m}));
+    ASSERT_TRUE(results->at(2)->isSameShape({1, n, n}));
+
+    checkSvd(x, results->at(0), results->at(1), results->at(2), true, 1e-10);
+
+    delete results;
+}
+
 ///////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests3, elu_test1) {
 
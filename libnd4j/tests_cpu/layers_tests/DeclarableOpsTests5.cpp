@@ -390,6 +390,97 @@ TEST_F(DeclarableOpsTests5, histogram_test2) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, histogram_test3) {
+    // every row gets its own range
+    auto matrix = NDArrayFactory::create<float>('c', {2, 6}, {0, 1, 2, 3, 4, 5,   10, 10, 10, 10, 20, 40});
+    auto exp = NDArrayFactory::create<Nd4jLong>('c', {2, 3}, {2, 2, 2,   4, 1, 1});
+
+    nd4j::ops::histogram op;
+    auto result = op.execute({&matrix}, {}, {3, 1}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto z = result->at(0);
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, histogram_test4) {
+    // batched histograms along non-trailing dimension match histograms of separate TADs, chunked and merged ones included
+    auto input = NDArrayFactory::create<double>('c', {100000, 3});
+    for (Nd4jLong e = 0; e < input.lengthOf(); e++)
+        input.p<double>(e, (double) ((e * 7919) % 1013) - 500.);
+
+    nd4j::ops::histogram op;
+    auto result = op.execute({&input}, {}, {16, 0}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto z = result->at(0);
+    ASSERT_EQ(2, z->rankOf());
+    ASSERT_EQ(3, z->sizeAt(0));
+    ASSERT_EQ(16, z->sizeAt(1));
+
+    std::unique_ptr<ResultSet> columns(input.allTensorsAlongDimension({0}));
+    for (int c = 0; c < 3; c++) {
+        auto column = columns->at(c)->dup('c');
+        auto single = op.execute({column}, {}, {16}, {});
+        ASSERT_EQ(ND4J_STATUS_OK, single->status());
+
+        auto row = (*z)({c, c + 1, 0, 0});
+        ASSERT_TRUE(single->at(0)->equalsTo(row));
+        ASSERT_EQ(100000, single->at(0)->reduceNumber(reduce::Sum).e<Nd4jLong>(0));
+
+        delete single;
+        delete column;
+    }
+
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests5, histogram_test5) {
+    // TADs along dimensions with gap between them have no single stride, in both orders
+    auto c = NDArrayFactory::create<float>('c', {6, 5, 7});
+    auto f = NDArrayFactory::create<float>('f', {5, 6, 7});
+    for (Nd4jLong e = 0; e < c.lengthOf(); e++) {
+        c.p<float>(e, (float) ((e * 7919) % 1013) - 500.f);
+        f.p<float>(e, (float) ((e * 104729) % 997) - 300.f);
+    }
+
+    nd4j::ops::histogram op;
+    for (auto input: {&c, &f}) {
+        const int numTads = (int) input->sizeAt(1);
+        const Nd4jLong tadLength = input->lengthOf() / numTads;
+
+        auto result = op.execute({input}, {}, {8, 0, 2}, {});
+        ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+        auto z = result->at(0);
+        ASSERT_EQ(2, z->rankOf());
+        ASSERT_EQ(numTads, z->sizeAt(0));
+        ASSERT_EQ(8, z->sizeAt(1));
+
+        std::unique_ptr<ResultSet> tads(input->allTensorsAlongDimension({0, 2}));
+        ASSERT_EQ(numTads, tads->size());
+        for (int r = 0; r < numTads; r++) {
+            auto tad = tads->at(r)->dup('c');
+            auto single = op.execute({tad}, {}, {8}, {});
+            ASSERT_EQ(ND4J_STATUS_OK, single->status());
+
+            auto row = (*z)({r, r + 1, 0, 0});
+            ASSERT_TRUE(single->at(0)->equalsTo(row));
+            ASSERT_EQ(tadLength, single->at(0)->reduceNumber(reduce::Sum).e<Nd4jLong>(0));
+
+            delete single;
+            delete tad;
+        }
+
+        delete result;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests5, Identity_test1) {
     auto matrix = NDArrayFactory::create<float>('c', {3, 3}, {-4, -3, -2, -1, 0, 1, 2, 3, 4});
@@ -1920,6 +2011,35 @@ TEST_F(DeclarableOpsTests5, EmbeddingLookup_3) {
 
     delete result;
 }
+TEST_F(DeclarableOpsTests5, EmbeddingLookup_4) {
+    auto y = NDArrayFactory::create<Nd4jLong>('c', {3,2}, {5, 4, 4, 5, 3, 3});
+    auto exp = NDArrayFactory::create<double>('c', {6, 3, 3}, {
+                6, 20, 11,    21, 12, 22,    13, 23, 14,
+                5, 20, 11,    21, 12, 22,    13, 23, 14,
+                5, 20, 11,    21, 12, 22,    13, 23, 14,
+                6, 20, 11,    21, 12, 22,    13, 23, 14,
+                4, 20, 11,    21, 12, 22,    13, 23, 14,
+                4, 20, 11,    21, 12, 22,    13, 23, 14 });
+
+    // params of different type are cast to output type
+    auto p1 = NDArrayFactory::create<double>('c', {3,3}, {1, 20, 11, 21, 12, 22, 13, 23, 14});
+    auto p2 = NDArrayFactory::create<double>('c', {3,3}, {2, 20, 11, 21, 12, 22, 13, 23, 14});
+    auto p3 = NDArrayFactory::create<double>('c', {3,3}, {3, 20, 11, 21, 12, 22, 13, 23, 14});
+    auto p4 = NDArrayFactory::create<float>('c', {3,3}, {4, 20, 11, 21, 12, 22, 13, 23, 14});
+    auto p5 = NDArrayFactory::create<int>('c', {3,3}, {5, 20, 11, 21, 12, 22, 13, 23, 14});
+    auto p6 = NDArrayFactory::create<double>('c', {3,3}, {6, 20, 11, 21, 12, 22, 13, 23, 14});
+
+    nd4j::ops::embedding_lookup op;
+    auto result = op.execute({&p1, &p2, &p3, &p4, &p5, &p6, &y}, {}, {1}, {}, false, nd4j::DataType::DOUBLE);
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto output = result->at(0);
+    ASSERT_TRUE(exp.isSameShape(output));
+    ASSERT_TRUE(exp.equalsTo(output));
+
+    delete result;
+}
+
 /* @Test
     public void testDynamicPartition(){
         INDArray data = Nd4j.createFromArray(2, 1, 2, 0);
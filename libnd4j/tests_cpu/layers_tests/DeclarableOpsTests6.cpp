@@ -1607,6 +1607,36 @@ TEST_F(DeclarableOpsTests6, MatrixInverse_1) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, MatrixInverse_Blocked_1) {
+    // matrices are larger than panel width, so blocked LU and triangular solves are used
+    const Nd4jLong n = 100;
+    auto x = NDArrayFactory::create<double>('c', {3, n, n});
+    auto eye = NDArrayFactory::create<double>('c', {3, n, n});
+    x.linspace(1);
+    x.applyTransform(transform::Sin, nullptr, nullptr);
+    eye.assign(0.);
+
+    for (Nd4jLong e = 0; e < 3; e++)
+        for (Nd4jLong i = 0; i < n; i++) {
+            x.p(e * n * n + i * n + i, x.e<double>(e * n * n + i * n + i) + (double) n);
+            eye.p(e * n * n + i * n + i, 1.);
+        }
+
+    nd4j::ops::matrix_inverse op;
+    auto result = op.execute({&x}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    nd4j::ops::matmul mmul;
+    auto product = mmul.execute({&x, result->at(0)}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, product->status());
+
+    ASSERT_TRUE(eye.equalsTo(product->at(0), 1e-8));
+
+    delete product;
+    delete result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests6, MatrixInverse_010) {
 
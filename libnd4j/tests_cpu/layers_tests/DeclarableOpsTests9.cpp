@@ -1150,14 +1150,14 @@ TEST_F(DeclarableOpsTests9, TestDropout_1) {
     //x.printIndexedBuffer("Input is");
     //res->printIndexedBuffer("Result for Dropout_1");
     auto countZero = res->reduceNumber(reduce::CountZero);
-    ASSERT_NEAR(countZero.e<Nd4jLong>(0), 80, 5);
+    ASSERT_NEAR(countZero.e<Nd4jLong>(0), 80, 12);
     auto ress2 = op.execute({&x}, {0.2f}, {113});
 
     ASSERT_EQ(ND4J_STATUS_OK, ress2->status());
     NDArray* res2 = ress2->at(0);
 
-    countZero = res->reduceNumber(reduce::CountZero);
-    ASSERT_NEAR(countZero.e<Nd4jLong>(0), 80, 5);
+    countZero = res2->reduceNumber(reduce::CountZero);
+    ASSERT_NEAR(countZero.e<Nd4jLong>(0), 80, 12);
     //res2->printIndexedBuffer("Result for Dropout_2");
     ASSERT_TRUE(res->equalsTo(res2));
     //res->printIndexedBuffer("FF dropout");
@@ -1167,6 +1167,33 @@ TEST_F(DeclarableOpsTests9, TestDropout_1) {
     delete ress2;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, TestDropout_2) {
+    // keep rate of Philox mask over large array, 5 sigma of Binomial(2^20, 0.2) is ~0.2% of length
+    const Nd4jLong length = 1048576;
+    NDArray x('c', {1024, 1024}, nd4j::DataType::FLOAT32);
+    x.linspace(1);
+
+    nd4j::ops::dropout op;
+    auto ress = op.execute({&x}, {0.2f}, {113});
+    ASSERT_EQ(ND4J_STATUS_OK, ress->status());
+
+    auto kept = length - ress->at(0)->reduceNumber(reduce::CountZero).e<Nd4jLong>(0);
+    auto sigma = nd4j::math::nd4j_sqrt<double, double>(length * 0.2 * 0.8);
+    ASSERT_NEAR(0.2 * length, (double) kept, 5 * sigma);
+
+    // different seed gives different mask with the same keep rate
+    auto ress2 = op.execute({&x}, {0.2f}, {119});
+    ASSERT_EQ(ND4J_STATUS_OK, ress2->status());
+
+    auto kept2 = length - ress2->at(0)->reduceNumber(reduce::CountZero).e<Nd4jLong>(0);
+    ASSERT_NEAR(0.2 * length, (double) kept2, 5 * sigma);
+    ASSERT_FALSE(ress->at(0)->equalsTo(ress2->at(0)));
+
+    delete ress;
+    delete ress2;
+}
+
 TEST_F(DeclarableOpsTests9, Test_DropoutInverted_01) {
     NDArray x0('c', {10, 10}, nd4j::DataType::FLOAT32);
     NDArray x1('c', {10, 10}, nd4j::DataType::FLOAT32);
@@ -1309,6 +1336,69 @@ TEST_F(DeclarableOpsTests9, Test_AlphaDropout_BP_1) {
     delete ress2;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, TestDropout_Noise_1) {
+    NDArray x('c', {4, 3, 50}, nd4j::DataType::FLOAT32);
+    NDArray eps('c', {4, 3, 50}, nd4j::DataType::FLOAT32);
+    NDArray shape('c', {2}, {3, 1}, nd4j::DataType::INT64);
+    x.linspace(1);
+    eps.assign(1.f);
+
+    nd4j::ops::dropout op;
+    nd4j::ops::dropout_bp opBP;
+
+    auto ress = op.execute({&x, &shape}, {0.5f}, {119});
+    ASSERT_EQ(ND4J_STATUS_OK, ress->status());
+    auto z = ress->at(0);
+
+    auto ressBP = opBP.execute({&x, &eps, &shape}, {0.5f}, {119});
+    ASSERT_EQ(ND4J_STATUS_OK, ressBP->status());
+    auto grad = ressBP->at(0);
+
+    // decision is shared along noise dimensions of size 1, and backprop uses the same decisions
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 3; j++) {
+            bool kept = z->e<float>(i, j, 0) != 0.f;
+            for (int k = 0; k < 50; k++) {
+                ASSERT_NEAR(kept ? x.e<float>(i, j, k) * 2.f : 0.f, z->e<float>(i, j, k), 1e-5f);
+                ASSERT_NEAR(kept ? 2.f : 0.f, grad->e<float>(i, j, k), 1e-5f);
+            }
+        }
+
+    delete ress;
+    delete ressBP;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, Test_AlphaDropout_1) {
+    NDArray x('c', {10, 10}, nd4j::DataType::FLOAT32);
+    NDArray eps('c', {10, 10}, nd4j::DataType::FLOAT32);
+
+    x.linspace(1);
+    eps.assign(1.f);
+
+    nd4j::ops::alpha_dropout op;
+    nd4j::ops::alpha_dropout_bp opBP;
+
+    auto ress = op.execute({&x}, {0.5f, 0.5f, 1.5f, 1.6f}, {119});
+    ASSERT_EQ(ND4J_STATUS_OK, ress->status());
+    auto z = ress->at(0);
+
+    auto ressBP = opBP.execute({&x, &eps}, {0.5f, 0.5f, 1.5f, 1.6f}, {119});
+    ASSERT_EQ(ND4J_STATUS_OK, ressBP->status());
+    auto grad = ressBP->at(0);
+
+    // dropped: alpha * beta + alpha', kept: alpha * x + alpha'
+    for (int e = 0; e < x.lengthOf(); e++) {
+        bool kept = grad->e<float>(e) != 0.f;
+        ASSERT_NEAR(kept ? 0.5f * x.e<float>(e) + 1.5f : 0.5f * 1.6f + 1.5f, z->e<float>(e), 1e-5f);
+        ASSERT_NEAR(kept ? 0.5f : 0.f, grad->e<float>(e), 1e-5f);
+    }
+
+    delete ress;
+    delete ressBP;
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests9, matmul_test10) {
 
@@ -3045,6 +3135,32 @@ TEST_F(DeclarableOpsTests9, Cholesky_Test_3) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, Cholesky_Test_4) {
+    // 2 panels per matrix, so trailing update is involved
+    const Nd4jLong n = 80;
+    NDArray x = NDArrayFactory::create<double>('c', {4, n, n});
+    x.assign(1.);
+
+    for (Nd4jLong e = 0; e < 4; e++)
+        for (Nd4jLong i = 0; i < n; i++)
+            x.p(e * n * n + i * n + i, (double) (n + e + i));
+
+    nd4j::ops::cholesky op;
+    auto result = op.execute({&x}, {}, {});
+    ASSERT_EQ(result->status(), ND4J_STATUS_OK);
+
+    // L * L^T
+    nd4j::ops::matmul mmul;
+    auto product = mmul.execute({result->at(0), result->at(0)}, {}, {0, 1});
+    ASSERT_EQ(product->status(), ND4J_STATUS_OK);
+
+    ASSERT_TRUE(x.equalsTo(product->at(0), 1e-8));
+
+    delete product;
+    delete result;
+}
+
 ////////////////////////////////////////////////////////////////////
 // TEST_F(DeclarableOpsTests9, gru_bp_test1) {
 
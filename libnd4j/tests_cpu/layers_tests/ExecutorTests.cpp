@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Tests for Executor and ThreadPool
+//
+
+#include "testlayers.h"
+#include <NDArray.h>
+#include <execution/Executor.h>
+#include <Environment.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+using namespace nd4j;
+
+class ExecutorTests : public testing::Test {
+public:
+
+};
+
+TEST_F(ExecutorTests, Test_ParallelFor_1) {
+    std::vector<int> hits(10000, 0);
+
+    Executor::parallel_for(0, hits.size(), [&](Nd4jLong from, Nd4jLong to) {
+        for (auto e = from; e < to; e++)
+            hits[e]++;
+    });
+
+    for (auto h: hits)
+        ASSERT_EQ(1, h);
+}
+
+TEST_F(ExecutorTests, Test_ParallelFor_2) {
+    std::atomic<Nd4jLong> chunks;
+    chunks.store(0);
+
+    // grain bigger than range means single chunk
+    Executor::parallel_for(0, 100, [&](Nd4jLong from, Nd4jLong to) {
+        ASSERT_EQ(0, from);
+        ASSERT_EQ(100, to);
+        chunks++;
+    }, 1000);
+
+    ASSERT_EQ(1, chunks.load());
+}
+
+TEST_F(ExecutorTests, Test_ParallelFor_Nested_1) {
+    std::atomic<Nd4jLong> sum;
+    sum.store(0);
+
+    Executor::parallel_tasks(8, [&](int task) {
+        Executor::parallel_for(0, 100, [&](Nd4jLong from, Nd4jLong to) {
+            for (auto e = from; e < to; e++)
+                sum += e;
+        });
+    });
+
+    ASSERT_EQ(8 * 4950, sum.load());
+}
+
+TEST_F(ExecutorTests, Test_ParallelFor_Exception_1) {
+    ASSERT_THROW(Executor::parallel_for(0, 1000, [&](Nd4jLong from, Nd4jLong to) {
+        if (to == 1000)
+            throw std::runtime_error("last chunk failed");
+    }), std::runtime_error);
+
+    // pool must stay usable afterwards
+    std::atomic<Nd4jLong> count;
+    count.store(0);
+    Executor::parallel_for(0, 1000, [&](Nd4jLong from, Nd4jLong to) {
+        count += to - from;
+    });
+
+    ASSERT_EQ(1000, count.load());
+}
+
+TEST_F(ExecutorTests, Test_Budget_1) {
+    auto budget = Executor::concurrencyBudget();
+
+    Executor::setConcurrencyBudget(0);
+    ASSERT_EQ(0, Executor::concurrencyBudget());
+
+    // with no workers allowed caller does everything itself
+    std::atomic<Nd4jLong> count;
+    count.store(0);
+    Executor::parallel_for(0, 1000, [&](Nd4jLong from, Nd4jLong to) {
+        count += to - from;
+    });
+    ASSERT_EQ(1000, count.load());
+
+    Executor::setConcurrencyBudget(budget);
+    ASSERT_EQ(budget, Executor::concurrencyBudget());
+}
+
+TEST_F(ExecutorTests, Test_MaxThreads_1) {
+    auto maxThreads = Environment::getInstance()->maxThreads();
+
+    // pool is created once, but lowered maxThreads still applies to every call
+    Environment::getInstance()->setMaxThreads(1);
+    ASSERT_EQ(0, Executor::numberOfWorkers());
+
+    auto caller = std::this_thread::get_id();
+    std::atomic<int> foreign;
+    foreign.store(0);
+    Executor::parallel_tasks(64, [&](int e) {
+        if (std::this_thread::get_id() != caller)
+            foreign++;
+    });
+
+    Environment::getInstance()->setMaxThreads(maxThreads);
+    ASSERT_EQ(0, foreign.load());
+}
+
+TEST_F(ExecutorTests, Test_Transform_1) {
+    auto x = NDArrayFactory::create<float>('c', {8, 16, 33});
+    x.linspace(1);
+
+    // permuted input goes through strided rank-3 path
+    auto p = x.permute({2, 0, 1});
+    auto z = NDArrayFactory::create<float>('c', {33, 8, 16});
+    p.applyTransform(transform::Neg, &z);
+
+    for (int i = 0; i < 33; i++)
+        for (int j = 0; j < 8; j++)
+            for (int k = 0; k < 16; k++)
+                ASSERT_NEAR(-x.e<float>(j, k, i), z.e<float>(i, j, k), 1e-5f);
+}
+
+TEST_F(ExecutorTests, Test_Reduce_1) {
+    auto x = NDArrayFactory::create<float>('c', {100, 7});
+    x.assign(1.0f);
+
+    auto z = x.reduceAlongDims(reduce::Sum, {1});
+    ASSERT_EQ(100, z.lengthOf());
+
+    for (Nd4jLong e = 0; e < z.lengthOf(); e++)
+        ASSERT_NEAR(7.0f, z.e<float>(e), 1e-5f);
+}
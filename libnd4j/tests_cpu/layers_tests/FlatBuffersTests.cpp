@@ -26,7 +26,9 @@
 #include <graph/Node.h>
 #include <graph/Graph.h>
 #include <GraphExecutioner.h>
+#include <graph/FlatUtils.h>
 #include <ops/declarable/CustomOperations.h>
+#include <fstream>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -603,6 +605,67 @@ TEST_F(FlatBuffersTest, ReduceDim_2) {
 }
  */
 
+TEST_F(FlatBuffersTest, ZeroCopyImport_1) {
+    // FIXME: we must adopt this for CUDA as well
+    if (!Environment::getInstance()->isCPU())
+        return;
+
+    flatbuffers::FlatBufferBuilder builder(4096);
+
+    auto x = NDArrayFactory::create<float>('c', {3, 4});
+    auto y = NDArrayFactory::create<double>('c', {5});
+    x.linspace(1);
+    y.linspace(-2);
+
+    auto fX = FlatUtils::toFlatArray(builder, x, 64);
+    auto fY = FlatUtils::toFlatArray(builder, y, 64);
+
+    std::vector<flatbuffers::Offset<FlatVariable>> variables_vector;
+    variables_vector.push_back(CreateFlatVariable(builder, CreateIntPair(builder, 1), 0, nd4j::graph::DType::DType_FLOAT, 0, fX));
+    variables_vector.push_back(CreateFlatVariable(builder, CreateIntPair(builder, 2), 0, nd4j::graph::DType::DType_DOUBLE, 0, fY, 0, VarType_CONSTANT));
+
+    auto variables = builder.CreateVector(variables_vector);
+
+    FlatGraphBuilder graphBuilder(builder);
+    graphBuilder.add_variables(variables);
+    graphBuilder.add_id(119);
+    builder.Finish(graphBuilder.Finish());
+
+    std::ofstream ofs("zero_copy_1.fb", std::ios::binary | std::ios::out);
+    ofs.write(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+    ofs.close();
+
+    auto graph = GraphExecutioner::importFromFlatBuffers("zero_copy_1.fb", true);
+    auto rX = graph->getVariableSpace()->getVariable(1)->getNDArray();
+    auto rY = graph->getVariableSpace()->getVariable(2)->getNDArray();
+
+    ASSERT_EQ(x, *rX);
+    ASSERT_EQ(y, *rY);
+
+    // payload is used in place, and it was aligned by exporter
+    ASSERT_EQ(0, reinterpret_cast<Nd4jLong>(rX->getBuffer()) % 64);
+    ASSERT_EQ(0, reinterpret_cast<Nd4jLong>(rY->getBuffer()) % 64);
+
+    // and buffers point into mapped file, not into copies
+    auto mapped = graph->getMappedFile();
+    ASSERT_TRUE(mapped != nullptr);
+    ASSERT_TRUE(mapped->contains(rX->getBuffer()));
+    ASSERT_TRUE(mapped->contains(reinterpret_cast<int8_t *>(rX->getBuffer()) + rX->lengthOf() * rX->sizeOfT() - 1));
+    ASSERT_TRUE(mapped->contains(rY->getBuffer()));
+    ASSERT_TRUE(mapped->contains(reinterpret_cast<int8_t *>(rY->getBuffer()) + rY->lengthOf() * rY->sizeOfT() - 1));
+
+    // mapping is private, so in-place changes never reach the file
+    rX->assign(119.f);
+    delete graph;
+
+    graph = GraphExecutioner::importFromFlatBuffers("zero_copy_1.fb");
+    ASSERT_TRUE(graph->getMappedFile() == nullptr);
+    ASSERT_EQ(x, *graph->getVariableSpace()->getVariable(1)->getNDArray());
+    delete graph;
+
+    remove("zero_copy_1.fb");
+}
+
 #ifdef GRAPH_FILES_OK
 TEST_F(FlatBuffersTest, Ae_00) {
     nd4j::ops::rank op1;
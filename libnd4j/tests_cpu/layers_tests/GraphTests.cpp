@@ -28,6 +28,9 @@
 #include <NDArray.h>
 #include <ops/declarable/DeclarableOp.h>
 #include <ops/declarable/generic/parity_ops.cpp>
+#include <graph/optimization/GraphOptimizer.h>
+#include <graph/profiling/TraceRecorder.h>
+#include <performance/benchmarking/GraphBenchmark.h>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -1565,6 +1568,30 @@ TEST_F(GraphTests, Test_Inplace_Execution_2) {
 }
 #endif
 
+TEST_F(GraphTests, Test_Inplace_Execution_3) {
+    Graph graph;
+
+    auto list = new NDArrayList(0, true);
+    auto listVar = new Variable(nullptr, nullptr, -1, 0);
+    listVar->setNDArrayList(list);
+    graph.getVariableSpace()->putVariable(-1, listVar);
+
+    nd4j::ops::stack_list opS;
+    nd4j::ops::relu opR;
+
+    // stacked array shares storage of the list, so relu can't overwrite it
+    auto nodeA = new Node(&opS, 1, {-1}, {2});
+    auto nodeB = new Node(&opR, 2, {1}, {}, {}, 0.0f, {0.0}, {});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+
+    graph.buildGraph();
+    graph.tagInplaceNodes();
+
+    ASSERT_FALSE(graph.nodeById(2)->isInplace());
+}
+
 TEST_F(GraphTests, Test_Inplace_Outputs_1) {
     auto x = NDArrayFactory::create<float>('c', {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
     auto exp = NDArrayFactory::create<float>('c', {6}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
@@ -1600,6 +1627,350 @@ TEST_F(GraphTests, Test_Inplace_Outputs_2) {
 #endif
 }
 
+TEST_F(GraphTests, Test_Optimizer_ConstantFolding_1) {
+    Graph graph;
+    graph.getExecutorConfiguration()->_outputMode = OutputMode_OPTIMIZED;
+
+    auto x = NDArrayFactory::create_<float>('c', {5, 5});
+    x->assign(-2.0);
+
+    auto y = NDArrayFactory::create_<float>('c', {5, 5});
+    y->assign(3.0);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, y);
+    graph.getVariableSpace()->getVariable(-1)->markConstant(true);
+
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2});
+    auto nodeB = new Node(OpType_PAIRWISE, pairwise::Add, 2, {1, -2}, {});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+
+    GraphOptimizer optimizer;
+    ASSERT_EQ(Status::OK(), optimizer.optimize(&graph));
+
+    ASSERT_EQ(std::string("constant_folding"), optimizer.statistics().at(0).name());
+    ASSERT_EQ(1, optimizer.statistics().at(0).affected());
+    ASSERT_EQ(1, graph.totalNodes());
+    ASSERT_TRUE(graph.optimized());
+
+    auto folded = graph.getVariableSpace()->getVariable(1);
+    ASSERT_TRUE(folded->isConstant());
+    ASSERT_NEAR(2.0f, folded->getNDArray()->meanNumber().e<float>(0), 1e-5);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+    ASSERT_NEAR(5.0f, graph.getVariableSpace()->getVariable(2)->getNDArray()->meanNumber().e<float>(0), 1e-5);
+
+    // folded result belongs to the graph, so execution within another VariableSpace still sees it
+    VariableSpace other;
+    other.putVariable(-1, NDArrayFactory::create_<float>('c', {5, 5}));
+    other.putVariable(-2, y->dup());
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph, &other));
+    ASSERT_NEAR(5.0f, other.getVariable(2)->getNDArray()->meanNumber().e<float>(0), 1e-5);
+
+    std::unique_ptr<Graph> clone(graph.clone());
+    ASSERT_TRUE(clone->optimized());
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(clone.get()));
+    ASSERT_NEAR(5.0f, clone->getVariableSpace()->getVariable(2)->getNDArray()->meanNumber().e<float>(0), 1e-5);
+}
+
+TEST_F(GraphTests, Test_Optimizer_ConstantFolding_2) {
+    Graph graph;
+    graph.getExecutorConfiguration()->_outputMode = OutputMode_OPTIMIZED;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 2}, {-1.f, 2.f, -3.f, 4.f});
+    auto shape = NDArrayFactory::create_<int>('c', {2}, {2, 2});
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, shape);
+    graph.getVariableSpace()->getVariable(-1)->markConstant(true);
+    graph.getVariableSpace()->getVariable(-2)->markConstant(true);
+
+    nd4j::ops::randomuniform opU;
+
+    // explicit output, and random op
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {});
+    auto nodeB = new Node(&opU, 2, {-2}, {}, {}, 0.0f, {0.0, 1.0}, {});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+    graph.addOutput(1);
+
+    GraphOptimizer optimizer;
+    ASSERT_EQ(Status::OK(), optimizer.optimize(&graph));
+
+    ASSERT_EQ(0, optimizer.statistics().at(0).affected());
+    ASSERT_TRUE(graph.hasNode(1));
+    ASSERT_TRUE(graph.hasNode(2));
+}
+
+TEST_F(GraphTests, Test_Optimizer_Rewrites_1) {
+    Graph graph;
+    graph.getExecutorConfiguration()->_outputMode = OutputMode_OPTIMIZED;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    auto w = NDArrayFactory::create_<float>('c', {3, 4});
+    auto b = NDArrayFactory::create_<float>('c', {4}, {-7.f, -6.f, 0.f, 1.f});
+    w->assign(1.0);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, w);
+    graph.getVariableSpace()->putVariable(-3, b);
+
+    nd4j::ops::matmul opM;
+    nd4j::ops::biasadd opB;
+    nd4j::ops::identity opI;
+    nd4j::ops::relu opR;
+
+    auto nodeA = new Node(&opM, 1, {-1, -2}, {2});
+    auto nodeB = new Node(&opB, 2, {1, -3}, {3});
+    auto nodeC = new Node(&opI, 3, {2}, {4});
+    auto nodeD = new Node(&opR, 4, {3}, {}, {}, 0.0f, {0.0}, {});
+
+    // nobody uses results of this node
+    auto nodeE = new Node(OpType_TRANSFORM_SAME, transform::Abs, 5, {-1}, {6});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+    graph.addNode(nodeC);
+    graph.addNode(nodeD);
+    graph.addNode(nodeE);
+
+    GraphOptimizer optimizer;
+    ASSERT_EQ(Status::OK(), optimizer.optimize(&graph));
+
+    auto stats = optimizer.statistics();
+    ASSERT_EQ(4, stats.size());
+    ASSERT_EQ(0, stats.at(0).affected());
+    ASSERT_EQ(1, stats.at(1).affected());
+    ASSERT_EQ(2, stats.at(2).affected());
+    ASSERT_EQ(1, stats.at(3).affected());
+    ASSERT_EQ(5, stats.at(0).nodesBefore());
+    ASSERT_EQ(2, stats.at(3).nodesAfter());
+
+    ASSERT_EQ(2, graph.totalNodes());
+    ASSERT_EQ(std::string("xw_plus_b"), *graph.nodeById(2)->getCustomOp()->getOpName());
+    ASSERT_TRUE(graph.nodeById(4)->isInplace());
+    ASSERT_EQ(2, graph.nodeById(4)->input()->at(0).first);
+
+    auto exp = NDArrayFactory::create<float>('c', {2, 4}, {0.f, 0.f, 6.f, 7.f, 8.f, 9.f, 15.f, 16.f});
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto z = graph.getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+TEST_F(GraphTests, Test_Optimizer_Rewrites_2) {
+    Graph graph;
+    graph.getExecutorConfiguration()->_outputMode = OutputMode_OPTIMIZED;
+
+    // batched matmul can't be replaced with xw_plus_b
+    auto x = NDArrayFactory::create_<float>('c', {2, 2, 3});
+    auto w = NDArrayFactory::create_<float>('c', {3, 4});
+    auto b = NDArrayFactory::create_<float>('c', {4});
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, w);
+    graph.getVariableSpace()->putVariable(-3, b);
+
+    nd4j::ops::matmul opM;
+    nd4j::ops::biasadd opB;
+
+    auto nodeA = new Node(&opM, 1, {-1, -2}, {2});
+    auto nodeB = new Node(&opB, 2, {1, -3}, {});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+
+    GraphOptimizer optimizer;
+    ASSERT_EQ(Status::OK(), optimizer.optimize(&graph));
+
+    ASSERT_TRUE(graph.hasNode(1));
+    ASSERT_TRUE(graph.hasNode(2));
+    ASSERT_EQ(std::string("biasadd"), *graph.nodeById(2)->getCustomOp()->getOpName());
+}
+
+TEST_F(GraphTests, Test_Optimizer_Fusion_Chain_1) {
+    Graph graph;
+    graph.getExecutorConfiguration()->_outputMode = OutputMode_OPTIMIZED;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 3}, {-3.f, -1.f, 0.f, 1.f, 2.f, 4.f});
+    auto b = NDArrayFactory::create_<float>('c', {3}, {1.f, -2.f, 0.5f});
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, b);
+
+    nd4j::ops::biasadd opB;
+    nd4j::ops::relu opR;
+
+    // x * 2 + b -> relu -> clip(0, 5)
+    auto nodeA = new Node(OpType_SCALAR, scalar::Multiply, 1, {-1}, {2}, {}, 2.0f);
+    auto nodeB = new Node(&opB, 2, {1, -2}, {3});
+    auto nodeC = new Node(&opR, 3, {2}, {4}, {}, 0.0f, {0.0}, {});
+    auto nodeD = new Node(OpType_TRANSFORM_SAME, transform::ClipByValue, 4, {3}, {}, {}, 0.0f, {0.0, 5.0});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+    graph.addNode(nodeC);
+    graph.addNode(nodeD);
+
+    GraphOptimizer optimizer;
+    ASSERT_EQ(Status::OK(), optimizer.optimize(&graph));
+
+    ASSERT_EQ(std::string("fusion"), optimizer.statistics().at(2).name());
+    ASSERT_EQ(1, optimizer.statistics().at(2).affected());
+
+    ASSERT_EQ(1, graph.totalNodes());
+    ASSERT_EQ(std::string("fused_elementwise"), *graph.nodeById(4)->getCustomOp()->getOpName());
+    ASSERT_EQ(16, graph.nodeById(4)->getContextPrototype()->getIArguments()->size());
+    ASSERT_EQ(2, graph.nodeById(4)->input()->size());
+
+    auto exp = NDArrayFactory::create<float>('c', {2, 3}, {0.f, 0.f, 0.5f, 3.f, 2.f, 5.f});
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto z = graph.getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+TEST_F(GraphTests, Test_Optimizer_Fusion_Chain_2) {
+    Graph graph;
+    graph.getExecutorConfiguration()->_outputMode = OutputMode_OPTIMIZED;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 3}, {-3.f, -1.f, 0.f, 1.f, 2.f, 4.f});
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    nd4j::ops::reshape opS;
+    nd4j::ops::relu opR;
+
+    // reshape publishes view of x, so relu can't be executed in place on it
+    auto nodeA = new Node(&opS, 1, {-1}, {2}, {}, 0.0f, {}, {-99, 3, 2});
+    auto nodeB = new Node(&opR, 2, {1}, {}, {}, 0.0f, {0.0}, {});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+
+    GraphOptimizer optimizer;
+    ASSERT_EQ(Status::OK(), optimizer.optimize(&graph));
+
+    ASSERT_FALSE(graph.nodeById(2)->isInplace());
+
+    auto exp = NDArrayFactory::create<float>('c', {3, 2}, {0.f, 0.f, 0.f, 1.f, 2.f, 4.f});
+    auto xExp = NDArrayFactory::create<float>('c', {2, 3}, {-3.f, -1.f, 0.f, 1.f, 2.f, 4.f});
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto z = graph.getVariableSpace()->getVariable(2)->getNDArray();
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    // input stays intact
+    ASSERT_TRUE(xExp.equalsTo(graph.getVariableSpace()->getVariable(-1)->getNDArray()));
+}
+
+TEST_F(GraphTests, Test_Tracing_1) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {5, 5});
+    x->assign(-2.0);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2});
+    auto nodeB = new Node(OpType_TRANSFORM_SAME, transform::Neg, 2, {1}, {});
+    nodeA->setName("abs_node");
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+
+    TraceRecorder::getInstance()->reset();
+    Environment::getInstance()->setTracing(true);
+
+    auto status = GraphExecutioner::execute(&graph);
+
+    Environment::getInstance()->setTracing(false);
+    ASSERT_EQ(Status::OK(), status);
+
+    // one node span and one op span per node
+    ASSERT_EQ(4, TraceRecorder::getInstance()->size());
+
+    auto json = TraceRecorder::getInstance()->asChromeTrace();
+    ASSERT_NE(std::string::npos, json.find("\"traceEvents\":["));
+    ASSERT_NE(std::string::npos, json.find("\"name\":\"abs_node\",\"cat\":\"node\""));
+    ASSERT_NE(std::string::npos, json.find("\"shapes\":\"[5,5]\""));
+
+    TraceRecorder::getInstance()->reset();
+    ASSERT_EQ(0, TraceRecorder::getInstance()->size());
+}
+
+TEST_F(GraphTests, Test_Benchmark_1) {
+    GraphBenchmark benchmark("./resources/reduce_dim_false.fb", 1, 5);
+    benchmark.setThreads({1, 2});
+
+    auto results = benchmark.run();
+    ASSERT_EQ(2, results.size());
+    ASSERT_EQ(std::string("threads=1;batch=1"), results[0]._name);
+    ASSERT_EQ(5, results[0]._iterations);
+    ASSERT_TRUE(results[0]._min <= results[0]._p50);
+    ASSERT_TRUE(results[0]._p50 <= results[0]._p99);
+    ASSERT_TRUE(results[0]._p99 <= results[0]._max);
+    ASSERT_TRUE(results[0]._throughput > 0.0);
+}
+
+TEST_F(GraphTests, Test_Benchmark_Compare_1) {
+    GraphBenchmarkResult result;
+    result._name = "threads=4;batch=8";
+    result._threads = 4;
+    result._batchSize = 8;
+    result._iterations = 100;
+    result._p50 = 100.0;
+    result._p99 = 150.0;
+    result._throughput = 80000.0;
+    result._allocatedBytes = 4096;
+
+    auto json = GraphBenchmark::asJson("model.fb", {result});
+    auto baseline = GraphBenchmark::fromJson(json);
+
+    ASSERT_EQ(1, baseline.size());
+    ASSERT_EQ(result._name, baseline[0]._name);
+    ASSERT_EQ(8, baseline[0]._batchSize);
+    ASSERT_EQ(4096, baseline[0]._allocatedBytes);
+    ASSERT_NEAR(150.0, baseline[0]._p99, 1e-5);
+
+    auto same = GraphBenchmark::compare(baseline, {result}, 0.05);
+    ASSERT_EQ(0, same._regressions.size());
+    ASSERT_EQ(0, same._added.size());
+    ASSERT_EQ(0, same._missing.size());
+
+    auto slower = result;
+    slower._p50 = 110.0;
+    slower._throughput = 72727.0;
+
+    ASSERT_EQ(2, GraphBenchmark::compare(baseline, {slower}, 0.05)._regressions.size());
+    ASSERT_EQ(0, GraphBenchmark::compare(baseline, {slower}, 0.15)._regressions.size());
+
+    auto renamed = result;
+    renamed._name = "threads=4;batch=16";
+
+    // renamed configuration isn't a regression, but it's reported
+    auto report = GraphBenchmark::compare(baseline, {renamed}, 0.05);
+    ASSERT_EQ(0, report._regressions.size());
+    ASSERT_EQ(1, report._added.size());
+    ASSERT_EQ(1, report._missing.size());
+    ASSERT_NE(std::string::npos, report._added[0].find("[threads=4;batch=16] new configuration"));
+    ASSERT_NE(std::string::npos, report._missing[0].find("[threads=4;batch=8] missing configuration"));
+
+    // old reports name allocated bytes peakBytes
+    auto legacy = GraphBenchmark::fromJson("{\"graph\":\"model.fb\",\"results\":[{\"name\":\"threads=4;batch=8\",\"peakBytes\":2048}]}");
+    ASSERT_EQ(1, legacy.size());
+    ASSERT_EQ(2048, legacy[0]._allocatedBytes);
+}
+
 /*
 TEST_F(GraphTests, Test_Minifier_1) {
     // run preprocessor to produce single header
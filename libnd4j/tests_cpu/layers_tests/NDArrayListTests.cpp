@@ -70,4 +70,38 @@ TEST_F(NDArrayListTests, Test_Stack_UnStack_1) {
     ASSERT_TRUE(input.equalsTo(array));
 
     delete array;
-}
\ No newline at end of file
+}
+TEST_F(NDArrayListTests, Test_Contiguous_1) {
+    NDArrayList list(0, true, true);
+
+    auto exp = NDArrayFactory::create<float>('c', {5, 3, 4});
+    exp.linspace(1);
+
+    auto tads = exp.allTensorsAlongDimension({1, 2});
+    for (int e = 0; e < 5; e++)
+        ASSERT_EQ(ND4J_STATUS_OK, list.writeCopy(e, tads->at(e)));
+
+    ASSERT_TRUE(list.isContiguous());
+    ASSERT_EQ(5, list.elements());
+
+    auto first = list.readRaw(0);
+    auto stacked = list.stack();
+    ASSERT_TRUE(exp.isSameShape(stacked));
+    ASSERT_TRUE(exp.equalsTo(stacked));
+
+    // stacked array shares storage with list, so it must survive next write untouched
+    auto zeros = NDArrayFactory::create<float>('c', {3, 4});
+    ASSERT_EQ(ND4J_STATUS_OK, list.writeCopy(0, &zeros));
+    ASSERT_TRUE(exp.equalsTo(stacked));
+    ASSERT_TRUE(zeros.equalsTo(first));
+
+    // element of other shape switches list back to separate arrays
+    auto other = NDArrayFactory::create<float>('c', {2, 3, 4});
+    ASSERT_EQ(ND4J_STATUS_OK, list.writeCopy(5, &other));
+    ASSERT_FALSE(list.isContiguous());
+    ASSERT_TRUE(tads->at(1)->equalsTo(list.readRaw(1)));
+    ASSERT_TRUE(zeros.equalsTo(first));
+
+    delete stacked;
+    delete tads;
+}
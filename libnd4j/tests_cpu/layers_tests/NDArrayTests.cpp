@@ -2445,6 +2445,45 @@ TEST_F(NDArrayTest, Test_Lambda_3) {
     ASSERT_TRUE(exp.equalsTo(&x));
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest, Test_Lambda_4) {
+    // inlined overload must give the same result as std::function one, for strided arrays too
+    auto x = NDArrayFactory::create<float>('c', {4, 6});
+    auto y = NDArrayFactory::create<float>('c', {4, 6});
+    auto w = NDArrayFactory::create<float>('c', {4, 6});
+    x.linspace(1);
+    y.linspace(2);
+    w.assign(0.25f);
+
+    auto xT = x.transpose();
+    auto yT = y.transpose();
+    auto wT = w.transpose();
+
+    auto blend = LAMBDA_FFF(_g, _h, _c) {
+        return _g * _h + (1.0f - _g) * _c;
+    };
+    std::function<float(float, float, float)> blendF = blend;
+
+    auto z0 = NDArrayFactory::create<float>('c', {6, 4});
+    auto z1 = NDArrayFactory::create<float>('c', {6, 4});
+
+    wT.applyTriplewiseLambda<float>(&xT, &yT, blendF, &z0);
+    wT.applyTriplewiseLambda<float>(&xT, &yT, blend, &z1);
+
+    ASSERT_TRUE(z0.equalsTo(&z1));
+
+    auto indexed = ILAMBDA_F(_x) {
+        return _x + _idx;
+    };
+    std::function<float(Nd4jLong, float)> indexedF = indexed;
+
+    xT.applyIndexedLambda<float>(indexedF, &z0);
+    xT.applyIndexedLambda<float>(indexed, &z1);
+
+    ASSERT_TRUE(z0.equalsTo(&z1));
+    ASSERT_NEAR(1.0f, z1.e<float>(0), 1e-5f);
+}
+
 #endif
 
 //////////////////////////////////////////////////////////////////////
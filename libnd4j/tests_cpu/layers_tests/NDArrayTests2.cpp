@@ -1294,6 +1294,72 @@ TEST_F(NDArrayTest2, reduce3_1) {
     delete z;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest2, reduce_vertical_1) {
+    // long strided columns, goes through LoopKind::VERTICAL
+    auto x = NDArrayFactory::create<float>('c', {20000, 4});
+    for (Nd4jLong e = 0; e < x.lengthOf(); e++)
+        x.p(e, static_cast<float>(e % 4 + 1));
+
+    auto sum = x.reduceAlongDims(reduce::Sum, {0});
+    auto max = x.reduceAlongDims(reduce::Max, {0});
+    auto mean = x.reduceAlongDims(reduce::Mean, {0});
+
+    auto expSum = NDArrayFactory::create<float>({20000.f, 40000.f, 60000.f, 80000.f});
+    auto expMax = NDArrayFactory::create<float>({1.f, 2.f, 3.f, 4.f});
+
+    ASSERT_TRUE(expSum.equalsTo(sum));
+    ASSERT_TRUE(expMax.equalsTo(max));
+    ASSERT_TRUE(expMax.equalsTo(mean));
+
+    // AMax/AMin start from the first element of each column, not from x[0, 0]
+    auto y = -x;
+    y.p(0, -100.f);
+
+    auto amax = y.reduceAlongDims(reduce::AMax, {0});
+    auto amin = y.reduceAlongDims(reduce::AMin, {0});
+
+    auto expAMax = NDArrayFactory::create<float>({100.f, 2.f, 3.f, 4.f});
+    auto expAMin = NDArrayFactory::create<float>({1.f, 2.f, 3.f, 4.f});
+
+    ASSERT_TRUE(expAMax.equalsTo(amax));
+    ASSERT_TRUE(expAMin.equalsTo(amin));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest2, reduce_splitk_1) {
+    // few long tads, goes through LoopKind::SPLITK when there's more than 1 thread
+    auto x = NDArrayFactory::create<double>('c', {3, 100000});
+    x.assign(0.5);
+
+    auto norm = x.reduceAlongDims(reduce::Norm2, {1});
+    auto sum = x.reduceAlongDims(reduce::Sum, {1});
+
+    for (int e = 0; e < 3; e++) {
+        ASSERT_NEAR(sqrt(25000.), norm.e<double>(e), 1e-5);
+        ASSERT_NEAR(50000., sum.e<double>(e), 1e-5);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest2, reduce3_splitk_1) {
+    auto x = NDArrayFactory::create<double>('c', {2, 100000});
+    auto y = NDArrayFactory::create<double>('c', {2, 100000});
+    x.assign(2.);
+    y.assign(3.);
+
+    auto z = x.applyReduce3(nd4j::reduce3::CosineSimilarity, &y, {1}, nullptr);
+    auto d = x.applyReduce3(nd4j::reduce3::Dot, &y, {1}, nullptr);
+
+    for (int e = 0; e < 2; e++) {
+        ASSERT_NEAR(1., z->e<double>(e), 1e-5);
+        ASSERT_NEAR(600000., d->e<double>(e), 1e-5);
+    }
+
+    delete z;
+    delete d;
+}
+
 TEST_F(NDArrayTest2, all_tads_1) {
     auto x = NDArrayFactory::create<float>('c', {3, 5});
 
@@ -1336,4 +1402,23 @@ TEST_F(NDArrayTest2, test_subarray_followed_by_reshape_1) {
     // r.printIndexedBuffer("r");
 
     ASSERT_EQ(e, r);
-}
\ No newline at end of file
+}
+////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest2, test_permute_followed_by_assign_1) {
+
+    // NCHW -> NHWC, innermost dimensions differ, so tiled transpose is used
+    for (auto dtype: {nd4j::DataType::FLOAT32, nd4j::DataType::DOUBLE, nd4j::DataType::INT8}) {
+        NDArray x('c', {2, 3, 37, 35}, dtype);
+        x.linspace(1.);
+
+        auto p = x.permute({0, 2, 3, 1});
+        NDArray z('c', {2, 37, 35, 3}, dtype);
+        z.assign(p);
+
+        for (int n = 0; n < 2; n++)
+            for (int c = 0; c < 3; c++)
+                for (int h = 0; h < 37; h++)
+                    for (int w = 0; w < 35; w++)
+                        ASSERT_EQ(x.e<double>(n, c, h, w), z.e<double>(n, h, w, c));
+    }
+}
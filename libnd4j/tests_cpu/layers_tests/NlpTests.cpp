@@ -475,4 +475,104 @@ TEST_F(NlpTests, test_cbow_hs_batch_1) {
     ASSERT_EQ(exp2, row_s1_6);
 
     delete result;
-}
\ No newline at end of file
+}
+TEST_F(NlpTests, test_sg_ns_minibatch_1) {
+    auto target = NDArrayFactory::create<int>('c', {4}, {0, 5, 7, 11});
+    auto ngStarter = NDArrayFactory::create<int>('c', {4}, {3, 8, 9, 12});
+    auto indices = NDArrayFactory::empty<int>();
+    auto codes = NDArrayFactory::empty<int8_t>();
+    auto syn0 = NDArrayFactory::create<float>('c', {100, 10});
+    auto syn1Neg = NDArrayFactory::create<float>('c', {100, 10});
+    auto syn1 = NDArrayFactory::empty<float>();
+    auto expTable = NDArrayFactory::create<float>('c', {10000});
+    auto negTable = NDArrayFactory::create<float>('c', {100000});
+
+    auto alpha = NDArrayFactory::create<double>('c', {4}, {0.001, 0.024, 0.01, 0.02});
+    auto randomValue = NDArrayFactory::create<Nd4jLong>('c', {4}, {1L, 3L, 5L, 7L});
+    auto inferenceVector = NDArrayFactory::empty<float>();
+    auto neu1e = NDArrayFactory::create<float>('c', {4, 10});
+
+    syn0.linspace(0.0, 0.0001);
+    syn1Neg.linspace(0.01, 0.0001);
+    expTable.assign(0.5);
+    negTable.linspace(0.0);
+
+    auto syn0Mb = syn0.dup();
+    auto syn1NegMb = syn1Neg.dup();
+
+    // regular batch as reference, single worker to avoid races
+    nd4j::ops::skipgram op;
+    auto result = op.execute({&target, &ngStarter, &indices, &codes, &syn0, &syn1, &syn1Neg, &expTable, &negTable, &alpha, &randomValue, &inferenceVector, &neu1e}, {}, {1, 5}, {false, false}, true);
+    ASSERT_EQ(Status::OK(), result->status());
+    delete result;
+
+    // minibatch of 1 row draws the same negatives as regular batch
+    result = op.execute({&target, &ngStarter, &indices, &codes, syn0Mb, &syn1, syn1NegMb, &expTable, &negTable, &alpha, &randomValue, &inferenceVector, &neu1e}, {}, {1, 5, 1}, {false, false}, true);
+    ASSERT_EQ(Status::OK(), result->status());
+    delete result;
+
+    ASSERT_TRUE(syn0.equalsTo(syn0Mb));
+    ASSERT_TRUE(syn1Neg.equalsTo(syn1NegMb));
+
+    // shared negatives, results aren't equal anymore, but all targets are updated
+    auto syn0Copy = syn0.dup();
+    result = op.execute({&target, &ngStarter, &indices, &codes, &syn0, &syn1, &syn1Neg, &expTable, &negTable, &alpha, &randomValue, &inferenceVector, &neu1e}, {}, {2, 5, 3}, {false, false}, true);
+    ASSERT_EQ(Status::OK(), result->status());
+    delete result;
+
+    for (int t = 0; t < 4; t++) {
+        auto idx = target.e<int>(t);
+        auto updated = syn0({idx, idx + 1, 0, 0}, true);
+        auto original = (*syn0Copy)({idx, idx + 1, 0, 0}, true);
+        ASSERT_FALSE(updated.equalsTo(original));
+    }
+
+    // minibatch isn't reproducible, so precise mode rejects it
+    ASSERT_ANY_THROW(op.execute({&target, &ngStarter, &indices, &codes, &syn0, &syn1, &syn1Neg, &expTable, &negTable, &alpha, &randomValue, &inferenceVector, &neu1e}, {}, {2, 5, 3}, {false, true}, true));
+
+    delete syn0Mb;
+    delete syn1NegMb;
+    delete syn0Copy;
+}
+
+TEST_F(NlpTests, test_cbow_ns_minibatch_1) {
+    auto target = NDArrayFactory::empty<int>();
+    auto ngStarter = NDArrayFactory::create<int>('c', {3}, {30, 31, 32});
+    auto context = NDArrayFactory::create<int>('c', {3, 3}, {0, 1, 2,  10, 11, -1,  20, 21, 22});
+    auto locked = NDArrayFactory::create<int>('c', {3, 3});
+    auto indices = NDArrayFactory::empty<int>();
+    auto codes = NDArrayFactory::empty<int8_t>();
+    auto syn0 = NDArrayFactory::create<float>('c', {100, 10});
+    auto syn1 = NDArrayFactory::empty<float>();
+    auto syn1Neg = NDArrayFactory::create<float>('c', {100, 10});
+    auto expTable = NDArrayFactory::create<float>('c', {10000});
+    auto negTable = NDArrayFactory::create<float>('c', {100000});
+    auto numWords = NDArrayFactory::empty<int>();
+
+    syn0.linspace(0.0, 0.0001);
+    syn1Neg.linspace(0.01, 0.0001);
+    expTable.assign(0.5);
+    negTable.linspace(0.0);
+
+    auto alpha = NDArrayFactory::create<double>('c', {3}, {0.025, 0.02, 0.01});
+    auto randomValue = NDArrayFactory::create<Nd4jLong>('c', {3}, {2L, 4L, 6L});
+    auto inferenceVector = NDArrayFactory::empty<float>();
+
+    auto syn0Mb = syn0.dup();
+    auto syn1NegMb = syn1Neg.dup();
+
+    nd4j::ops::cbow op;
+    auto result = op.execute({&target, &ngStarter, &context, &indices, &codes, &syn0, &syn1, &syn1Neg, &expTable, &negTable, &alpha, &randomValue, &numWords, &locked, &inferenceVector}, {}, {1, 5}, {true}, true);
+    ASSERT_EQ(Status::OK(), result->status());
+    delete result;
+
+    result = op.execute({&target, &ngStarter, &context, &indices, &codes, syn0Mb, &syn1, syn1NegMb, &expTable, &negTable, &alpha, &randomValue, &numWords, &locked, &inferenceVector}, {}, {1, 5, 1}, {true}, true);
+    ASSERT_EQ(Status::OK(), result->status());
+    delete result;
+
+    ASSERT_TRUE(syn0.equalsTo(syn0Mb));
+    ASSERT_TRUE(syn1Neg.equalsTo(syn1NegMb));
+
+    delete syn0Mb;
+    delete syn1NegMb;
+}
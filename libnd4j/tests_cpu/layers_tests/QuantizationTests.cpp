@@ -22,6 +22,7 @@
 #include "testlayers.h"
 #include <NDArray.h>
 #include <type_conversions.h>
+#include <ops/declarable/CustomOperations.h>
 
 
 using namespace nd4j;
@@ -67,4 +68,125 @@ TEST_F(QuantizationTests, Compression_Test_1) {
     delete[] q;
 
     #endif
-}
\ No newline at end of file
+}
+
+TEST_F(QuantizationTests, QuantizeLinear_Test_1) {
+    auto x = NDArrayFactory::create<float>('c', {5}, {-1.f, 0.f, 0.5f, 1.f, 200.f});
+    auto scale = NDArrayFactory::create<float>(0.5f);
+    auto zeroPoint = NDArrayFactory::create<uint8_t>(10);
+    auto exp = NDArrayFactory::create<uint8_t>('c', {5}, {8, 10, 11, 12, 255});
+    auto expD = NDArrayFactory::create<float>('c', {5}, {-1.f, 0.f, 0.5f, 1.f, 122.5f});
+
+    nd4j::ops::quantize_linear op;
+    auto result = op.execute({&x, &scale, &zeroPoint}, {}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    auto q = result->at(0);
+    ASSERT_EQ(nd4j::DataType::UINT8, q->dataType());
+    ASSERT_EQ(exp, *q);
+
+    nd4j::ops::dequantize_linear opD;
+    auto resultD = opD.execute({q, &scale, &zeroPoint}, {}, {});
+    ASSERT_EQ(Status::OK(), resultD->status());
+    ASSERT_TRUE(expD.equalsTo(resultD->at(0)));
+
+    delete result;
+    delete resultD;
+}
+
+TEST_F(QuantizationTests, QuantizeLinear_Test_2) {
+    auto x = NDArrayFactory::create<float>('c', {2, 2}, {1.f, 2.f, 3.f, 4.f});
+    auto scale = NDArrayFactory::create<float>('c', {2}, {1.f, 0.5f});
+    auto zeroPoint = NDArrayFactory::create<int8_t>('c', {2}, {0, 0});
+    auto exp = NDArrayFactory::create<int8_t>('c', {2, 2}, {1, 4, 3, 8});
+
+    nd4j::ops::quantize_linear op;
+    auto result = op.execute({&x, &scale, &zeroPoint}, {}, {1});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_EQ(exp, *result->at(0));
+
+    delete result;
+}
+
+TEST_F(QuantizationTests, QuantizedMatmul_Test_1) {
+    // real x = {0, 0.5, 1, 1.5, 2, 2.5}, real y = y
+    auto x = NDArrayFactory::create<uint8_t>('c', {2, 3}, {1, 2, 3, 4, 5, 6});
+    auto y = NDArrayFactory::create<int8_t>('c', {3, 2}, {1, -1, 2, 0, 3, 1});
+    auto xScale = NDArrayFactory::create<float>(0.5f);
+    auto xZero = NDArrayFactory::create<uint8_t>(1);
+    auto yScale = NDArrayFactory::create<float>(1.f);
+    auto yZero = NDArrayFactory::create<int8_t>(0);
+    auto bias = NDArrayFactory::create<float>('c', {2}, {1.f, -2.f});
+    auto exp = NDArrayFactory::create<float>('c', {2, 2}, {5.f, 0.f, 14.f, 0.f});
+
+    nd4j::ops::quantized_matmul op;
+    auto result = op.execute({&x, &y, &xScale, &xZero, &yScale, &yZero, &bias}, {}, {1});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    auto z = result->at(0);
+    ASSERT_EQ(nd4j::DataType::FLOAT32, z->dataType());
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    delete result;
+}
+
+TEST_F(QuantizationTests, QuantizedMatmul_Test_2) {
+    auto x = NDArrayFactory::create<uint8_t>('c', {2, 3}, {1, 2, 3, 4, 5, 6});
+    auto y = NDArrayFactory::create<int8_t>('c', {3, 2}, {1, -1, 2, 0, 3, 1});
+    auto xScale = NDArrayFactory::create<float>(0.5f);
+    auto xZero = NDArrayFactory::create<uint8_t>(1);
+    auto yScale = NDArrayFactory::create<float>('c', {2}, {1.f, 1.f});
+    auto yZero = NDArrayFactory::create<int8_t>('c', {2}, {0, 0});
+    auto bias = NDArrayFactory::create<float>('c', {2}, {1.f, -2.f});
+    auto zScale = NDArrayFactory::create<float>(0.5f);
+    auto zZero = NDArrayFactory::create<uint8_t>(0);
+    auto exp = NDArrayFactory::create<uint8_t>('c', {2, 2}, {10, 0, 28, 0});
+
+    nd4j::ops::quantized_matmul op;
+    auto result = op.execute({&x, &y, &xScale, &xZero, &yScale, &yZero, &bias, &zScale, &zZero}, {}, {1});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    auto z = result->at(0);
+    ASSERT_EQ(nd4j::DataType::UINT8, z->dataType());
+    ASSERT_EQ(exp, *z);
+
+    delete result;
+}
+
+TEST_F(QuantizationTests, QuantizedConv2d_Test_1) {
+    auto input = NDArrayFactory::create<uint8_t>('c', {1, 1, 3, 3}, {0, 1, 2, 3, 4, 5, 6, 7, 8});
+    auto weights = NDArrayFactory::create<int8_t>('c', {2, 2, 1, 1}, {1, 1, 1, 1});
+    auto inScale = NDArrayFactory::create<float>(1.f);
+    auto inZero = NDArrayFactory::create<uint8_t>(0);
+    auto wScale = NDArrayFactory::create<float>(1.f);
+    auto wZero = NDArrayFactory::create<int8_t>(0);
+    auto exp = NDArrayFactory::create<float>('c', {1, 1, 2, 2}, {8.f, 12.f, 20.f, 24.f});
+
+    nd4j::ops::quantized_conv2d op;
+    auto result = op.execute({&input, &weights, &inScale, &inZero, &wScale, &wZero}, {}, {2, 2, 1, 1, 0, 0, 1, 1, 0, 0});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    auto z = result->at(0);
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    delete result;
+}
+
+TEST_F(QuantizationTests, QuantizationCalibrate_Test_1) {
+    auto x = NDArrayFactory::create<float>('c', {3}, {-2.f, 1.f, 3.f});
+    // min > max stands for empty range
+    auto min = NDArrayFactory::create<float>(1.f);
+    auto max = NDArrayFactory::create<float>(-1.f);
+
+    nd4j::ops::quantization_calibrate op;
+    auto result = op.execute({&x, &min, &max}, {}, {-1, nd4j::DataType::UINT8});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    ASSERT_NEAR(-2.f, result->at(0)->e<float>(0), 1e-5);
+    ASSERT_NEAR(3.f, result->at(1)->e<float>(0), 1e-5);
+    ASSERT_NEAR(5.f / 255.f, result->at(2)->e<float>(0), 1e-5);
+    ASSERT_EQ(102, result->at(3)->e<int>(0));
+
+    delete result;
+}
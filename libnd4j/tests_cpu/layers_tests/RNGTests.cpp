@@ -22,6 +22,7 @@
 #include <chrono>
 #include <NDArray.h>
 #include <helpers/RandomLauncher.h>
+#include <helpers/PhiloxRandom.h>
 #include <ops/declarable/LegacyRandomOp.h>
 #include <ops/declarable/CustomOperations.h>
 
@@ -315,6 +316,37 @@ TEST_F(RNGTests, Test_Gaussian_3) {
     ASSERT_TRUE(devExp.equalsTo(stdev, 1.e-3));
 }
 
+TEST_F(RNGTests, Test_Philox_1) {
+    nd4j::random::PhiloxRandom philox(_rngA);
+
+    // bulk generation doesn't depend on how range is split
+    std::vector<float> whole(1000), parts(1000);
+    philox.gaussian<float>(0, 1000, whole.data(), 1, 1.0f, 2.0f);
+    philox.gaussian<float>(0, 37, parts.data(), 1, 1.0f, 2.0f);
+    philox.gaussian<float>(37, 500, parts.data() + 37, 1, 1.0f, 2.0f);
+    philox.gaussian<float>(537, 463, parts.data() + 537, 1, 1.0f, 2.0f);
+
+    for (int e = 0; e < 1000; e++) {
+        ASSERT_EQ(whole[e], parts[e]);
+        ASSERT_NEAR(whole[e], philox.gaussian<float>(e, 1.0f, 2.0f), 1e-5f);
+    }
+
+    // another stream gives another sequence
+    nd4j::random::PhiloxRandom other(_rngA, 1);
+    ASSERT_NE(philox.value(0), other.value(0));
+
+    std::vector<double> uniform(100000);
+    philox.uniform<double>(0, uniform.size(), uniform.data(), 1, -1.0, 1.0);
+
+    double mean = 0.0;
+    for (auto v: uniform) {
+        ASSERT_TRUE(v >= -1.0 && v < 1.0);
+        mean += v;
+    }
+
+    ASSERT_NEAR(0.0, mean / uniform.size(), 1e-2);
+}
+
 TEST_F(RNGTests, Test_LogNormal_1) {
     auto x0 = NDArrayFactory::create<float>('c', {10, 10});
     auto x1 = NDArrayFactory::create<float>('c', {10, 10});
@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <NDArray.h>
+#include <array/SparseNDArray.h>
+#include <helpers/SparseMmulHelper.h>
+#include <MmulHelper.h>
+#include <ops/declarable/CustomOperations.h>
+#include "testlayers.h"
+
+using namespace nd4j;
+
+class SparseNDArrayTests : public testing::Test {
+public:
+
+};
+
+TEST_F(SparseNDArrayTests, Test_Csr_FromDense_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4}, {0.f, 1.f, 0.f, 2.f,
+                                                         0.f, 0.f, 0.f, 0.f,
+                                                         3.f, 0.f, 4.f, 0.f});
+    auto expPointers = NDArrayFactory::create<Nd4jLong>('c', {4}, {0, 2, 2, 4});
+    auto expColumns = NDArrayFactory::create<Nd4jLong>('c', {4}, {1, 3, 0, 2});
+    auto expValues = NDArrayFactory::create<float>('c', {4}, {1.f, 2.f, 3.f, 4.f});
+
+    auto sparse = SparseNDArray::fromDense(x);
+
+    ASSERT_EQ(SparseType::CSR, sparse.format());
+    ASSERT_EQ(4, sparse.nnz());
+    ASSERT_NEAR(1.0 / 3.0, sparse.density(), 1e-6);
+    ASSERT_TRUE(expPointers.equalsTo(sparse.pointers()));
+    ASSERT_TRUE(expColumns.equalsTo(sparse.indices()));
+    ASSERT_TRUE(expValues.equalsTo(sparse.values()));
+
+    auto dense = sparse.toDense('f');
+    ASSERT_TRUE(x.equalsTo(dense));
+}
+
+TEST_F(SparseNDArrayTests, Test_Coo_1) {
+    auto indices = NDArrayFactory::create<int>('c', {3, 3}, {1, 0, 2,
+                                                             0, 1, 1,
+                                                             1, 0, 0});
+    auto values = NDArrayFactory::create<double>('c', {3}, {1., 2., 3.});
+    auto exp = NDArrayFactory::create<double>('c', {2, 2, 3}, {0., 0., 0.,  0., 2., 0.,
+                                                               3., 0., 1.,  0., 0., 0.});
+    auto expIndices = NDArrayFactory::create<Nd4jLong>('c', {3, 3}, {0, 1, 1,
+                                                                     1, 0, 0,
+                                                                     1, 0, 2});
+
+    auto sparse = SparseNDArray::coo({2, 2, 3}, indices, values);
+
+    ASSERT_EQ(SparseType::COO, sparse.format());
+    ASSERT_TRUE(expIndices.equalsTo(sparse.indices()));
+    ASSERT_TRUE(exp.equalsTo(sparse.toDense()));
+
+    auto fromDense = SparseNDArray::fromDense(exp, SparseType::COO);
+    ASSERT_TRUE(expIndices.equalsTo(fromDense.indices()));
+}
+
+TEST_F(SparseNDArrayTests, Test_Conversions_1) {
+    auto x = NDArrayFactory::create<float>('f', {5, 7});
+    x.linspace(1);
+    x.applyScalar(scalar::Mod, 3.f, &x);
+
+    auto csr = SparseNDArray::fromDense(x);
+    auto coo = csr.toCoo();
+    auto back = coo.toCsr();
+
+    ASSERT_TRUE(csr.pointers().equalsTo(back.pointers()));
+    ASSERT_TRUE(csr.indices().equalsTo(back.indices()));
+    ASSERT_TRUE(x.equalsTo(coo.toDense()));
+    ASSERT_TRUE(x.equalsTo(back.toDense()));
+}
+
+TEST_F(SparseNDArrayTests, Test_Multiply_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {0.f, 2.f, 0.f, 1.f, 0.f, 3.f});
+    auto y = NDArrayFactory::create<float>('c', {2, 3}, {5.f, 6.f, 7.f, 8.f, 9.f, 10.f});
+    auto exp = NDArrayFactory::create<float>('c', {2, 3}, {0.f, 12.f, 0.f, 8.f, 0.f, 30.f});
+
+    auto csr = SparseNDArray::fromDense(x).multiply(y);
+    auto coo = SparseNDArray::fromDense(x, SparseType::COO).multiply(y);
+
+    ASSERT_EQ(3, csr.nnz());
+    ASSERT_TRUE(exp.equalsTo(csr.toDense()));
+    ASSERT_TRUE(exp.equalsTo(coo.toDense()));
+}
+
+#ifndef __CUDABLAS__
+
+TEST_F(SparseNDArrayTests, Test_SpMM_1) {
+    auto x = NDArrayFactory::create<float>('c', {6, 5});
+    x.linspace(1);
+    x.applyScalar(scalar::Mod, 4.f, &x);
+    auto y = NDArrayFactory::create<float>('c', {5, 3});
+    y.linspace(-2, 0.5);
+    auto yT = y.transpose();
+    auto exp = NDArrayFactory::create<float>('c', {6, 3});
+    auto z = NDArrayFactory::create<float>('f', {6, 3});
+    MmulHelper::mmul(&x, &y, &exp, 1.0, 0.0);
+
+    auto sparse = SparseNDArray::fromDense(x);
+
+    SparseMmulHelper::mmul(sparse, y, z);
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    // transposed B and beta
+    z.assign(1.f);
+    SparseMmulHelper::mmul(sparse.toCoo(), yT, z, 2.0, 1.0, true);
+    auto exp2 = exp * 2.f + 1.f;
+    ASSERT_TRUE(exp2.equalsTo(z));
+}
+
+TEST_F(SparseNDArrayTests, Test_SpMV_1) {
+    auto x = NDArrayFactory::create<double>('c', {4, 3}, {1., 0., 0.,  0., 0., 2.,  0., 0., 0.,  3., 4., 0.});
+    auto y = NDArrayFactory::create<double>('c', {3}, {1., 2., 3.});
+    auto exp = NDArrayFactory::create<double>('c', {4}, {1., 6., 0., 11.});
+    auto z = NDArrayFactory::create<double>('c', {4});
+
+    SparseMmulHelper::mmul(SparseNDArray::fromDense(x), y, z);
+
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+TEST_F(SparseNDArrayTests, Test_Matmul_Sparse_Input_1) {
+    auto x = NDArrayFactory::create<float>('c', {64, 128});
+    auto y = NDArrayFactory::create<float>('c', {128, 32});
+    auto b = NDArrayFactory::create<float>('c', {32});
+    y.linspace(-1, 0.01);
+    b.linspace(1);
+
+    for (Nd4jLong e = 0; e < x.sizeAt(0); e++)
+        x.p(e, (e * 7) % x.sizeAt(1), 1.f + e);
+
+    auto threshold = Environment::getInstance()->sparseThreshold();
+
+    Environment::getInstance()->setSparseThreshold(0.0);
+    nd4j::ops::matmul matmul;
+    nd4j::ops::xw_plus_b xwb;
+    auto expMatmul = matmul.execute({&x, &y}, {}, {});
+    auto expXwb = xwb.execute({&x, &y, &b}, {}, {});
+
+    Environment::getInstance()->setSparseThreshold(0.05);
+    auto resMatmul = matmul.execute({&x, &y}, {}, {});
+    auto resXwb = xwb.execute({&x, &y, &b}, {}, {});
+
+    Environment::getInstance()->setSparseThreshold(threshold);
+
+    ASSERT_EQ(Status::OK(), resMatmul->status());
+    ASSERT_EQ(Status::OK(), resXwb->status());
+    ASSERT_TRUE(expMatmul->at(0)->equalsTo(resMatmul->at(0)));
+    ASSERT_TRUE(expXwb->at(0)->equalsTo(resXwb->at(0)));
+
+    delete expMatmul;
+    delete expXwb;
+    delete resMatmul;
+    delete resXwb;
+}
+
+#endif
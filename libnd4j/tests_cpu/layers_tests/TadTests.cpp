@@ -26,6 +26,7 @@
 #include <helpers/TAD.h>
 #include <array>
 #include <helpers/ConstantTadHelper.h>
+#include <array/TadSpan.h>
 
 using namespace nd4j;
 
@@ -457,5 +458,37 @@ TEST_F(TadTests, outerArrayIndexes_1) {
 }
 
 
+TEST_F(TadTests, TadSpan_1) {
+    auto x = NDArrayFactory::create<float>('f', {4, 3, 5});
+    x.linspace(1);
+    auto z = NDArrayFactory::create<float>('c', {4, 3, 5});
+
+    TadSpan xTads(x, {1, 2});
+    TadSpan zTads(z, {1, 2});
+
+    ASSERT_EQ(4, xTads.size());
+    ASSERT_EQ(15, xTads.tadLength());
+
+    // reverse order of TADs
+    for (Nd4jLong e = 0; e < xTads.size(); e++)
+        zTads.assign(e, xTads, xTads.size() - 1 - e);
+
+    std::unique_ptr<ResultSet> xList(x.allTensorsAlongDimension({1, 2}));
+    std::unique_ptr<ResultSet> zList(z.allTensorsAlongDimension({1, 2}));
+
+    for (Nd4jLong e = 0; e < xTads.size(); e++) {
+        ASSERT_TRUE(xList->at(xTads.size() - 1 - e)->equalsTo(zList->at(e)));
+
+        for (Nd4jLong i = 0; i < xTads.tadLength(); i++)
+            ASSERT_EQ(xList->at(e)->e<float>(i), xTads.t<float>(e, i));
+    }
+
+    auto row = NDArrayFactory::create<float>('c', {3, 5});
+    row.linspace(100);
+    zTads.assign(2, row);
+
+    ASSERT_TRUE(row.equalsTo(zList->at(2)));
+}
+
 
 #endif //LIBND4J_TADTESTS_H
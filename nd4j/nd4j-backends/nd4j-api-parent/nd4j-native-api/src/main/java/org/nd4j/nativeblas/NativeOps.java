@@ -658,6 +658,14 @@ public interface NativeOps {
 
     void enableVerboseMode(boolean reallyEnable);
 
+    void enableTracing(boolean reallyEnable);
+
+    int dumpTrace(String fileName);
+
+    void setConcurrencyBudget(int budget);
+
+    int getConcurrencyBudget();
+
     void setGridLimit(int gridSize);
 
     OpaqueTadPack tadOnlyShapeInfo(LongPointer shapeInfo, IntPointer dimension, int dimensionLength);